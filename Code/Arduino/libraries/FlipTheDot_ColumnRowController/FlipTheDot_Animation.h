@@ -0,0 +1,416 @@
+/*
+ * FlipTheDot_Animation  -- Play precomputed animations from flash or from a file on a FlipTheDot_ColumnRowController
+ *
+ * An animation is a keyframe followed by the dots which change from one frame to the next. Every change list
+ * is already grouped by the converter on the host (Code/Host/Tools/Animation), so the player only passes the
+ * groups to flipRow(...) and flipColumn(...) in the stored order, which pulse the dots of a group in the order of
+ * the controller (see setOptimizedOrder). It needs no frame buffer and reads the data thru a small buffer
+ * (FlipTheDot_Animation_BUFFER_SIZE bytes), so the length of an animation is limited by the flash or the file only.
+ * If the controller has a frame buffer, the played dots get written into it (and its shadow), like flip(...) does.
+ *
+ * Format (numbers with 2 or 4 bytes are little endian):
+ *
+ *   header   'F' 'A' <cols> <rows> <frame count: 2> <loop offset: 4> <wrap offset: 4>
+ *   records  one per frame, the first one (keyframe) contains every dot of the panel,
+ *            followed by the wrap record (changes from the last frame back to the first one)
+ *
+ *   record   <duration in milliseconds: 2> <groups> 0x00
+ *   group    <type> <line> <first> <mask: 4>
+ *            type 0x80 | 0x01 (show, otherwise hide) | 0x02 (column group, otherwise row group)
+ *            row group: the row <line> stays selected, the columns of the mask get pulsed (flipRow)
+ *            column group: the column <line> stays selected, the rows of the mask get pulsed (flipColumn)
+ *            bit 0 of the mask is the line <first>, the converter stores one group per FP2800a (28 lines)
+ *
+ * The loop offset points to the record of the second frame, the wrap offset to the wrap record. Without loop the
+ * animation ends at the wrap record, with loop the wrap record gets played and the animation continues at the
+ * loop offset. The duration defines how long a frame is shown before the next record gets played.
+ */
+
+
+#ifndef FlipTheDot_Animation_h
+#define FlipTheDot_Animation_h
+
+#include "Arduino.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// bytes which get read from the source at once
+#ifndef FlipTheDot_Animation_BUFFER_SIZE
+#define FlipTheDot_Animation_BUFFER_SIZE 32
+#endif
+
+#define FlipTheDot_Animation_HEADER_SIZE 14
+#define FlipTheDot_Animation_GROUP_SIZE  7
+#define FlipTheDot_Animation_GROUP       0x80
+#define FlipTheDot_Animation_SHOW        0x01
+#define FlipTheDot_Animation_COLUMN      0x02
+
+
+
+/*
+  Storage of an animation, reads length bytes at the current position and moves to any offset.
+*/
+class FlipTheDot_AnimationSource
+{
+    public:
+        virtual unsigned int read(uint8_t *buffer, unsigned int length) = 0;
+        virtual boolean seek(unsigned long offset) = 0;
+};
+
+
+/*
+  Animation in flash, e.g. the array of a header file created by the converter.
+*/
+class FlipTheDot_AnimationProgmem : public FlipTheDot_AnimationSource
+{
+    public:
+        FlipTheDot_AnimationProgmem(const uint8_t *data, unsigned long length)
+        {
+            _data = data;
+            _length = length;
+        }
+
+        unsigned int read(uint8_t *buffer, unsigned int length)
+        {
+            unsigned int count = 0;
+            for ( ; count < length && _position < _length; count++ )
+            {
+                buffer[count] = pgm_read_byte(&_data[_position++]);
+            }
+            return count;
+        }
+
+        boolean seek(unsigned long offset)
+        {
+            if ( offset > _length )
+            {
+                return false;
+            }
+            _position = offset;
+            return true;
+        }
+
+    protected:
+        const uint8_t *_data;
+        unsigned long _length;
+        unsigned long _position = 0;
+};
+
+
+/*
+  Animation in a file, e.g. File of the SD library. FileType needs read(buffer, length) and seek(offset),
+  the file has to stay open while the animation plays.
+*/
+template <class FileType>
+class FlipTheDot_AnimationFile : public FlipTheDot_AnimationSource
+{
+    public:
+        FlipTheDot_AnimationFile(FileType &file) : _file(file) {}
+
+        unsigned int read(uint8_t *buffer, unsigned int length)
+        {
+            int count = _file.read(buffer, length);
+            return count > 0 ? count : 0;
+        }
+
+        boolean seek(unsigned long offset)
+        {
+            return _file.seek(offset);
+        }
+
+    protected:
+        FileType &_file;
+};
+
+
+
+class FlipTheDot_AnimationPlayer
+{
+    public:
+        FlipTheDot_AnimationPlayer(FlipTheDot_ColumnRowController &controller);
+        boolean begin(FlipTheDot_AnimationSource &source);
+        void rewind();
+        void setLoop(boolean isLoop);
+        boolean update();
+        unsigned int playFrame();
+        boolean isDone();
+        unsigned int getFrameCount();
+        unsigned int getFrameIndex();
+        unsigned long getErrorCount();
+
+    protected:
+        boolean _fill();
+        boolean _readByte(uint8_t &value);
+        boolean _seek(unsigned long offset);
+        unsigned int _playGroup(const uint8_t *group);
+
+        FlipTheDot_ColumnRowController *_controller;
+        FlipTheDot_AnimationSource *_source = NULL;
+
+        uint8_t _buffer[FlipTheDot_Animation_BUFFER_SIZE];
+        uint8_t _bufferLength = 0;
+        uint8_t _bufferIndex = 0;
+
+        unsigned int _frameCount = 0;
+        unsigned long _loopOffset = 0;
+        unsigned long _wrapOffset = 0;
+        unsigned long _offset = 0;
+
+        // index of the next record, _frameCount is the wrap record
+        unsigned int _frameIndex = 0;
+        boolean _isLoop = true;
+        boolean _isDone = true;
+
+        unsigned int _durationMillis = 0;
+        unsigned long _frameStartMillis = 0;
+
+        unsigned long _errorCount = 0;
+};
+
+
+FlipTheDot_AnimationPlayer::FlipTheDot_AnimationPlayer(FlipTheDot_ColumnRowController &controller)
+{
+    _controller = &controller;
+}
+
+
+/**
+ * read the header of an animation and start it with the keyframe
+ * returns false if the source is no animation or the size does not match the panel
+ */
+boolean FlipTheDot_AnimationPlayer::begin(FlipTheDot_AnimationSource &source)
+{
+    uint8_t header[FlipTheDot_Animation_HEADER_SIZE];
+
+    _source = &source;
+    _isDone = true;
+
+    if ( !_source->seek(0) || _source->read(header, FlipTheDot_Animation_HEADER_SIZE) != FlipTheDot_Animation_HEADER_SIZE )
+    {
+        return false;
+    }
+
+    // the header stores the panel size in one byte each, larger panels can not play animations
+    if ( header[0] != 'F' || header[1] != 'A' || _controller->getColCount() > 255 || _controller->getRowCount() > 255
+      || header[2] != _controller->getColCount() || header[3] != _controller->getRowCount() )
+    {
+        #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_AnimationPlayer invalid header or panel size") );
+        #endif
+        return false;
+    }
+
+    _frameCount = header[4] | (unsigned int)header[5] << 8;
+    _loopOffset = 0;
+    _wrapOffset = 0;
+    for ( uint8_t i = 0; i < 4; i++ )
+    {
+        _loopOffset |= (unsigned long)header[6 + i] << (8 * i);
+        _wrapOffset |= (unsigned long)header[10 + i] << (8 * i);
+    }
+
+    if ( _frameCount == 0 )
+    {
+        return false;
+    }
+
+    // the source stands behind the header now
+    _bufferLength = 0;
+    _bufferIndex = 0;
+    _offset = FlipTheDot_Animation_HEADER_SIZE;
+
+    rewind();
+    return true;
+}
+
+
+/**
+ * start again with the keyframe, the next update() plays it
+ */
+void FlipTheDot_AnimationPlayer::rewind()
+{
+    if ( _source == NULL || _frameCount == 0 )
+    {
+        return;
+    }
+
+    _isDone = !_seek(FlipTheDot_Animation_HEADER_SIZE);
+    _frameIndex = 0;
+    _durationMillis = 0;
+}
+
+
+/**
+ * repeat the animation (default) or stop after the last frame, see isDone()
+ */
+void FlipTheDot_AnimationPlayer::setLoop(boolean isLoop)
+{
+    _isLoop = isLoop;
+}
+
+
+/**
+ * play the next frame when the duration of the current one has passed, returns true if a frame was played
+ */
+boolean FlipTheDot_AnimationPlayer::update()
+{
+    if ( _isDone || millis() - _frameStartMillis < _durationMillis )
+    {
+        return false;
+    }
+
+    playFrame();
+    return true;
+}
+
+
+/**
+ * play the next frame right now, returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_AnimationPlayer::playFrame()
+{
+    unsigned int pulsed = 0;
+    uint8_t low, high;
+    uint8_t group[FlipTheDot_Animation_GROUP_SIZE];
+
+    if ( _isDone )
+    {
+        return 0;
+    }
+
+    _frameStartMillis = millis();
+
+    if ( !_readByte(low) || !_readByte(high) )
+    {
+        _errorCount++;
+        _isDone = true;
+        return 0;
+    }
+    _durationMillis = low | (unsigned int)high << 8;
+
+    while ( _readByte(group[0]) && group[0] != 0 )
+    {
+        uint8_t i = 1;
+        while ( i < FlipTheDot_Animation_GROUP_SIZE && _readByte(group[i]) )
+        {
+            i++;
+        }
+        if ( (group[0] & FlipTheDot_Animation_GROUP) == 0 || i < FlipTheDot_Animation_GROUP_SIZE )
+        {
+            _errorCount++;
+            _isDone = true;
+            return pulsed;
+        }
+        pulsed += _playGroup(group);
+    }
+
+    if ( _frameIndex == _frameCount )
+    {
+        // the wrap record shows the first frame again, continue with the second one
+        _frameIndex = 1;
+        _isDone = !_seek(_loopOffset);
+    }
+    else if ( ++_frameIndex == _frameCount )
+    {
+        _isDone = !_isLoop || !_seek(_wrapOffset);
+    }
+
+    return pulsed;
+}
+
+
+/**
+ * check if an animation without loop has shown its last frame (or the source could not be read)
+ */
+boolean FlipTheDot_AnimationPlayer::isDone()
+{
+    return _isDone;
+}
+
+
+/**
+ * get the number of frames of the animation
+ */
+unsigned int FlipTheDot_AnimationPlayer::getFrameCount()
+{
+    return _frameCount;
+}
+
+
+/**
+ * get the index of the next frame (0 = keyframe)
+ */
+unsigned int FlipTheDot_AnimationPlayer::getFrameIndex()
+{
+    return _frameIndex;
+}
+
+
+/**
+ * get the number of records which could not be read completely
+ */
+unsigned long FlipTheDot_AnimationPlayer::getErrorCount()
+{
+    return _errorCount;
+}
+
+
+boolean FlipTheDot_AnimationPlayer::_fill()
+{
+    _bufferIndex = 0;
+    _bufferLength = _source->read(_buffer, FlipTheDot_Animation_BUFFER_SIZE);
+    return _bufferLength > 0;
+}
+
+
+boolean FlipTheDot_AnimationPlayer::_readByte(uint8_t &value)
+{
+    if ( _bufferIndex >= _bufferLength && !_fill() )
+    {
+        return false;
+    }
+    value = _buffer[_bufferIndex++];
+    _offset++;
+    return true;
+}
+
+
+boolean FlipTheDot_AnimationPlayer::_seek(unsigned long offset)
+{
+    // the offset can be in the buffer already, e.g. when the wrap record follows the last frame
+    if ( offset >= _offset && offset - _offset <= (unsigned long)(_bufferLength - _bufferIndex) )
+    {
+        _bufferIndex += offset - _offset;
+        _offset = offset;
+        return true;
+    }
+
+    _bufferIndex = 0;
+    _bufferLength = 0;
+    _offset = offset;
+    return _source->seek(offset);
+}
+
+
+/**
+ * pulse the dots of a group with flipRow / flipColumn
+ */
+unsigned int FlipTheDot_AnimationPlayer::_playGroup(const uint8_t *group)
+{
+    boolean show = group[0] & FlipTheDot_Animation_SHOW;
+    unsigned long mask = 0;
+
+    for ( uint8_t i = 0; i < 4; i++ )
+    {
+        mask |= (unsigned long)group[3 + i] << (8 * i);
+    }
+
+    if ( group[0] & FlipTheDot_Animation_COLUMN )
+    {
+        return _controller->flipColumn(group[1], mask, show, group[2]);
+    }
+    return _controller->flipRow(group[1], mask, show, group[2]);
+}
+
+
+#endif // FlipTheDot_Animation_h
@@ -0,0 +1,220 @@
+/*
+ * FlipTheDot_Blitter Class  -- Copy bitmaps and proportional fonts from flash into the frame buffer of a FlipTheDot_ColumnRowController
+ *
+ * The bitmaps use the layout of the frame buffer: row after row, (width + 7) / 8 bytes per row, first column in the
+ * lowest bit. Code/Host/Tools/Assets/AssetConverter creates them from PNG images and BDF fonts as header file with
+ * the data in PROGMEM and constexpr descriptions, e.g.
+ *   const uint8_t logo_DATA[] PROGMEM = { ... };
+ *   constexpr FlipTheDot_Bitmap logo = { logo_DATA, 20, 9 };
+ *
+ * Drawing needs no decoding and no RAM: every byte of a bitmap row gets shifted to the column of the frame buffer
+ * (16 bit wide, so it covers two frame buffer bytes at once) and merged with a mask. The drawn area gets replaced,
+ * hidden dots of the bitmap hide the dots of the frame buffer. Bitmaps may be partly outside of the panel.
+ *
+ * The glyphs of a font (see FlipTheDot_Font.h) are bitmaps as well, drawText(...) places them next to each other
+ * with spacing hidden columns in between.
+ */
+
+
+#ifndef FlipTheDot_Blitter_h
+#define FlipTheDot_Blitter_h
+
+#include "Arduino.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Font.h"
+
+
+struct FlipTheDot_Bitmap
+{
+    const uint8_t *data;        // in flash (PROGMEM), (width + 7) / 8 bytes per row
+    uint8_t width;
+    uint8_t height;
+};
+
+
+
+class FlipTheDot_Blitter
+{
+    public:
+        FlipTheDot_Blitter(FlipTheDot_ColumnRowController &controller);
+        boolean drawBitmap(const FlipTheDot_Bitmap &bitmap, int col, int row);
+        unsigned int drawText(const char *text, int col, int row, const FlipTheDot_Font &font);
+        unsigned int drawText_P(const char *text, int col, int row, const FlipTheDot_Font &font);
+        unsigned int getTextWidth(const char *text, const FlipTheDot_Font &font);
+        unsigned int getTextWidth_P(const char *text, const FlipTheDot_Font &font);
+
+    protected:
+        unsigned int _text(const char *text, boolean isTextInFlash, int col, int row, const FlipTheDot_Font &font, boolean isDrawing);
+        boolean _blit(const uint8_t *data, unsigned int width, unsigned int height, int col, int row);
+        void _merge(uint8_t *target, int index, uint8_t value, uint8_t mask);
+
+        FlipTheDot_ColumnRowController *_controller;
+        unsigned int _rowBytes;
+        // valid columns of the last byte of a frame buffer row
+        uint8_t _lastMask;
+};
+
+
+/**
+ * the controller needs a frame buffer (setFrameBuffer) to draw into
+ */
+FlipTheDot_Blitter::FlipTheDot_Blitter(FlipTheDot_ColumnRowController &controller)
+{
+    _controller = &controller;
+
+    unsigned int cols = controller.getColCount();
+    _rowBytes = (cols + 7) / 8;
+    _lastMask = cols % 8 == 0 ? 0xFF : (1 << (cols % 8)) - 1;
+}
+
+
+/**
+ * draw a bitmap with its top left corner at col, row (1 = first column / row, may be outside of the panel)
+ * returns false without a frame buffer
+ */
+boolean FlipTheDot_Blitter::drawBitmap(const FlipTheDot_Bitmap &bitmap, int col, int row)
+{
+    return _blit(bitmap.data, bitmap.width, bitmap.height, col, row);
+}
+
+
+/**
+ * draw a text from RAM with the top left corner of its first glyph at col, row
+ * returns the width in columns, without spacing behind the last glyph
+ */
+unsigned int FlipTheDot_Blitter::drawText(const char *text, int col, int row, const FlipTheDot_Font &font)
+{
+    return _text(text, false, col, row, font, true);
+}
+
+
+/**
+ * draw a text from flash, e.g. drawText_P(PSTR("Hbf"), 1, 1, font)
+ */
+unsigned int FlipTheDot_Blitter::drawText_P(const char *text, int col, int row, const FlipTheDot_Font &font)
+{
+    return _text(text, true, col, row, font, true);
+}
+
+
+/**
+ * width of a text in columns without drawing it, e.g. to center it
+ */
+unsigned int FlipTheDot_Blitter::getTextWidth(const char *text, const FlipTheDot_Font &font)
+{
+    return _text(text, false, 1, 1, font, false);
+}
+
+unsigned int FlipTheDot_Blitter::getTextWidth_P(const char *text, const FlipTheDot_Font &font)
+{
+    return _text(text, true, 1, 1, font, false);
+}
+
+
+unsigned int FlipTheDot_Blitter::_text(const char *text, boolean isTextInFlash, int col, int row, const FlipTheDot_Font &font, boolean isDrawing)
+{
+    unsigned int width = 0;
+
+    for ( ;; text++ )
+    {
+        uint8_t code = isTextInFlash ? pgm_read_byte(text) : *text;
+        if ( code == '\0' )
+        {
+            break;
+        }
+        if ( code < font.first || code >= font.first + font.count )
+        {
+            continue;
+        }
+
+        uint8_t glyph = pgm_read_byte(&font.glyphs[code - font.first]);
+        if ( glyph == FlipTheDot_Font_MISSING )
+        {
+            continue;
+        }
+
+        // the spacing in front of every glyph but the first one
+        if ( width > 0 && font.spacing > 0 )
+        {
+            if ( isDrawing )
+            {
+                _blit(NULL, font.spacing, font.height, col + (int)width, row);
+            }
+            width += font.spacing;
+        }
+
+        uint8_t glyphWidth = pgm_read_byte(&font.widths[glyph]);
+        if ( isDrawing )
+        {
+            _blit(font.data + pgm_read_word(&font.offsets[glyph]), glyphWidth, font.height, col + (int)width, row);
+        }
+        width += glyphWidth;
+    }
+    return width;
+}
+
+
+/**
+ * copy a bitmap from flash into the frame buffer, NULL hides the area
+ */
+boolean FlipTheDot_Blitter::_blit(const uint8_t *data, unsigned int width, unsigned int height, int col, int row)
+{
+    uint8_t *frame = _controller->getFrameBuffer();
+    int rows = _controller->getRowCount();
+
+    if ( frame == NULL )
+    {
+        return false;
+    }
+
+    unsigned int bitmapRowBytes = (width + 7) / 8;
+    uint8_t lastBitmapMask = width % 8 == 0 ? 0xFF : (1 << (width % 8)) - 1;
+
+    // frame buffer byte of the first column (rounded down, also for columns left of the panel) and the shift into it,
+    // the same for all bytes of the bitmap
+    int x = col - 1;
+    int firstByte = x >= 0 ? x / 8 : -((7 - x) / 8);
+    uint8_t shift = x - firstByte * 8;
+
+    for ( unsigned int y = 0; y < height; y++ )
+    {
+        int frameRow = row - 1 + (int)y;
+        if ( frameRow < 0 || frameRow >= rows )
+        {
+            continue;
+        }
+
+        uint8_t *target = frame + frameRow * _rowBytes;
+        const uint8_t *source = data + y * bitmapRowBytes;
+
+        for ( unsigned int i = 0; i < bitmapRowBytes; i++ )
+        {
+            uint8_t valid = i + 1 == bitmapRowBytes ? lastBitmapMask : 0xFF;
+            uint16_t value = (uint16_t)( data != NULL ? pgm_read_byte(&source[i]) & valid : 0 ) << shift;
+            uint16_t mask = (uint16_t)valid << shift;
+
+            _merge(target, firstByte + (int)i, value, mask);
+            _merge(target, firstByte + (int)i + 1, value >> 8, mask >> 8);
+        }
+    }
+    return true;
+}
+
+
+/**
+ * replace the masked dots of a frame buffer byte, nothing outside of the row or in the unused bits of its last byte
+ */
+void FlipTheDot_Blitter::_merge(uint8_t *target, int index, uint8_t value, uint8_t mask)
+{
+    if ( index < 0 || index >= (int)_rowBytes || mask == 0 )
+    {
+        return;
+    }
+
+    mask &= index + 1 == (int)_rowBytes ? _lastMask : 0xFF;
+    target[index] = (target[index] & ~mask) | (value & mask);
+}
+
+
+
+#endif // FlipTheDot_Blitter_h
@@ -0,0 +1,445 @@
+/*
+ * FlipTheDot_Canvas Class  -- One large frame buffer on several panels
+ *
+ * Places the frame buffers of several FlipTheDot_ColumnRowController objects (one per panel) on a virtual canvas,
+ * each at its own position and rotation. Drawing on the canvas draws into the frame buffers of the panels,
+ * so the canvas itself needs no additional RAM. Canvas dots which are not covered by a panel are ignored.
+ *
+ * flush() updates all panels at the same time: while the dot of one panel gets its pulse, the outputs of the
+ * next dot of another panel get selected and pulsed as well. The refresh time gets close to the one of the
+ * panel with the most changed dots instead of the sum of all panels.
+ * Requirements and side effects:
+ *   - panels are only pulsed at the same time if they use different FP2800a objects, panels which share an
+ *     FP2800a object get pulsed one after another; FP2800a objects of different panels must not share pins
+ *   - the power supply has to deliver the current of all panels at once, see setMaxParallelPulses(...)
+ *   - a pulse can get longer by the time which the selection of the other panels takes (some 10 µs per panel)
+ *   - the dots are walked one by one like flush() of the controllers does it, output groups are not used
+ *   - the power budget of every controller (setPowerBudget) is respected
+ *
+ * Rotation of a panel (clockwise, as mounted):
+ *   ROTATE_0:   column 1, row 1 of the panel is the top left corner
+ *   ROTATE_90:  column 1, row 1 of the panel is the top right corner, the panel columns run downwards
+ *   ROTATE_180: column 1, row 1 of the panel is the bottom right corner
+ *   ROTATE_270: column 1, row 1 of the panel is the bottom left corner, the panel columns run upwards
+ */
+
+
+#ifndef FlipTheDot_Canvas_h
+#define FlipTheDot_Canvas_h
+
+#include "Arduino.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// maximum number of panels of a canvas
+#ifndef FlipTheDot_Canvas_MAX_PANELS
+#define FlipTheDot_Canvas_MAX_PANELS 4
+#endif
+
+
+
+class FlipTheDot_Canvas
+{
+    public:
+        enum Rotation { ROTATE_0 = 0, ROTATE_90 = 1, ROTATE_180 = 2, ROTATE_270 = 3 };
+
+        FlipTheDot_Canvas(unsigned int cols, unsigned int rows);
+        boolean addPanel(FlipTheDot_ColumnRowController &controller, unsigned int col, unsigned int row, uint8_t rotation);
+        uint8_t getPanelCount();
+        unsigned int getColCount();
+        unsigned int getRowCount();
+
+        boolean setDot(unsigned int col, unsigned int row, boolean show);
+        boolean getDot(unsigned int col, unsigned int row);
+        void fill(boolean show);
+        void invalidate();
+        unsigned int flush();
+
+        void setMaxParallelPulses(uint8_t max);
+        uint8_t getMaxParallelPulses();
+
+    protected:
+        // flush progress of a panel
+        enum State { DONE = 0, NEXT = 1, READY = 2, PULSING = 3 };
+
+        struct Panel
+        {
+            FlipTheDot_ColumnRowController *controller;
+            unsigned int col;
+            unsigned int row;
+            uint8_t rotation;
+
+            uint8_t state;
+            FlipTheDot_ColumnRowController::FlushCursor cursor;
+            unsigned int dotCol;
+            unsigned int dotRow;
+            boolean dotShow;
+            unsigned int dotMicros;
+            unsigned long since;
+        };
+
+        boolean _map(Panel &panel, unsigned int col, unsigned int row, unsigned int &panelCol, unsigned int &panelRow);
+        boolean _isSharingChips(uint8_t index);
+        unsigned long _start(Panel &panel);
+        void _finish(Panel &panel);
+
+        unsigned int _cols;
+        unsigned int _rows;
+
+        Panel _panels[FlipTheDot_Canvas_MAX_PANELS];
+        uint8_t _panelCount = 0;
+        uint8_t _maxParallelPulses = FlipTheDot_Canvas_MAX_PANELS;
+};
+
+
+FlipTheDot_Canvas::FlipTheDot_Canvas(unsigned int cols, unsigned int rows)
+{
+    _cols = cols;
+    _rows = rows;
+}
+
+
+/**
+ * place a panel with its top left corner at col, row of the canvas (see the rotations above)
+ * the controller needs a frame buffer (setFrameBuffer) and keeps its own flush(), e.g. to update a single panel
+ */
+boolean FlipTheDot_Canvas::addPanel(FlipTheDot_ColumnRowController &controller, unsigned int col, unsigned int row, uint8_t rotation = ROTATE_0)
+{
+    if ( _panelCount >= FlipTheDot_Canvas_MAX_PANELS || col < 1 || row < 1 || rotation > ROTATE_270 )
+    {
+        return false;
+    }
+
+    Panel &panel = _panels[_panelCount++];
+    panel.controller = &controller;
+    panel.col = col;
+    panel.row = row;
+    panel.rotation = rotation;
+    panel.state = DONE;
+    return true;
+}
+
+
+uint8_t FlipTheDot_Canvas::getPanelCount()
+{
+    return _panelCount;
+}
+
+unsigned int FlipTheDot_Canvas::getColCount()
+{
+    return _cols;
+}
+
+unsigned int FlipTheDot_Canvas::getRowCount()
+{
+    return _rows;
+}
+
+
+/**
+ * map a canvas position to a dot of the panel, returns false if the panel does not cover it
+ */
+boolean FlipTheDot_Canvas::_map(Panel &panel, unsigned int col, unsigned int row, unsigned int &panelCol, unsigned int &panelRow)
+{
+    unsigned int cols = panel.controller->getColCount();
+    unsigned int rows = panel.controller->getRowCount();
+    boolean isTurned = panel.rotation == ROTATE_90 || panel.rotation == ROTATE_270;
+
+    if ( col < panel.col || row < panel.row )
+    {
+        return false;
+    }
+
+    // position inside the area of the panel, starting at 0
+    unsigned int x = col - panel.col;
+    unsigned int y = row - panel.row;
+
+    if ( x >= (isTurned ? rows : cols) || y >= (isTurned ? cols : rows) )
+    {
+        return false;
+    }
+
+    switch ( panel.rotation )
+    {
+        case ROTATE_90:
+            panelCol = y + 1;
+            panelRow = rows - x;
+            break;
+        case ROTATE_180:
+            panelCol = cols - x;
+            panelRow = rows - y;
+            break;
+        case ROTATE_270:
+            panelCol = cols - y;
+            panelRow = x + 1;
+            break;
+        default:
+            panelCol = x + 1;
+            panelRow = y + 1;
+    }
+    return true;
+}
+
+
+/**
+ * change a dot in the frame buffer of the panel which covers it, the panels get updated with the next flush
+ */
+boolean FlipTheDot_Canvas::setDot(unsigned int col, unsigned int row, boolean show)
+{
+    unsigned int panelCol, panelRow;
+
+    if ( col > _cols || row > _rows )
+    {
+        return false;
+    }
+
+    for ( uint8_t i = 0; i < _panelCount; i++ )
+    {
+        if ( _map(_panels[i], col, row, panelCol, panelRow) )
+        {
+            return _panels[i].controller->setDot(panelCol, panelRow, show);
+        }
+    }
+    return false;
+}
+
+
+/**
+ * get a dot of the frame buffers, false if no panel covers it
+ */
+boolean FlipTheDot_Canvas::getDot(unsigned int col, unsigned int row)
+{
+    unsigned int panelCol, panelRow;
+
+    if ( col > _cols || row > _rows )
+    {
+        return false;
+    }
+
+    for ( uint8_t i = 0; i < _panelCount; i++ )
+    {
+        if ( _map(_panels[i], col, row, panelCol, panelRow) )
+        {
+            return _panels[i].controller->getDot(panelCol, panelRow);
+        }
+    }
+    return false;
+}
+
+
+/**
+ * set all dots of all panels to the same state
+ */
+void FlipTheDot_Canvas::fill(boolean show)
+{
+    for ( uint8_t i = 0; i < _panelCount; i++ )
+    {
+        _panels[i].controller->fill(show);
+    }
+}
+
+
+/**
+ * forget the known state of all panels, the next flush pulses every dot
+ */
+void FlipTheDot_Canvas::invalidate()
+{
+    for ( uint8_t i = 0; i < _panelCount; i++ )
+    {
+        _panels[i].controller->invalidate();
+    }
+}
+
+
+/**
+ * define how many panels may be pulsed at the same time (default: all)
+ * every pulsed panel draws the current of one coil, so the power supply limits this value
+ */
+void FlipTheDot_Canvas::setMaxParallelPulses(uint8_t max)
+{
+    _maxParallelPulses = max < 1 ? 1 : max;
+}
+
+/**
+ * get the number of panels which may be pulsed at the same time
+ */
+uint8_t FlipTheDot_Canvas::getMaxParallelPulses()
+{
+    return _maxParallelPulses;
+}
+
+
+/**
+ * check if a panel uses an FP2800a object of a panel which is currently pulsed
+ */
+boolean FlipTheDot_Canvas::_isSharingChips(uint8_t index)
+{
+    FlipTheDot_ColumnRowController *controller = _panels[index].controller;
+
+    for ( uint8_t i = 0; i < _panelCount; i++ )
+    {
+        FlipTheDot_ColumnRowController *other = _panels[i].controller;
+
+        if ( i != index && _panels[i].state == PULSING && (
+            other->_colCtrl == controller->_colCtrl || other->_colCtrl == controller->_rowCtrl ||
+            other->_rowCtrl == controller->_colCtrl || other->_rowCtrl == controller->_rowCtrl ) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/**
+ * select the outputs of the next dot of a panel and enable them if the power budget allows it
+ * returns 0 when the pulse started, otherwise the time to wait for the power budget
+ */
+unsigned long FlipTheDot_Canvas::_start(Panel &panel)
+{
+    FlipTheDot_ColumnRowController *controller = panel.controller;
+
+    panel.dotMicros = controller->_getPulseLength(panel.dotCol, panel.dotRow, panel.dotShow);
+    unsigned long wait = controller->_getBudgetWait(panel.dotCol, panel.dotRow, 1, panel.dotMicros);
+    if ( wait > 0 )
+    {
+        return wait;
+    }
+
+    if ( !controller->_colCtrl->setOutput(panel.dotCol) || !controller->_rowCtrl->setOutput(panel.dotRow) )
+    {
+        controller->_statistics.rejectedFlips++;
+        controller->_rejectDot(panel.dotCol, panel.dotRow, panel.dotShow);
+        panel.state = NEXT;
+        return 0;
+    }
+
+    controller->_rowCtrl->setData(panel.dotShow);
+    controller->_colCtrl->setData(!panel.dotShow);
+
+    controller->_addBudgetPulse(panel.dotCol, panel.dotRow, 1, panel.dotMicros);
+
+    controller->_colCtrl->enable();
+    controller->_rowCtrl->enable();
+    panel.since = micros();
+    panel.state = PULSING;
+    return 0;
+}
+
+
+/**
+ * end the pulse of a panel and remember the new state of the dot
+ */
+void FlipTheDot_Canvas::_finish(Panel &panel)
+{
+    FlipTheDot_ColumnRowController *controller = panel.controller;
+
+    controller->_colCtrl->disable();
+    controller->_rowCtrl->disable();
+    controller->_writeBit(controller->_shadow, panel.dotCol, panel.dotRow, panel.dotShow);
+
+    controller->_statistics.pulses++;
+    controller->_statistics.dots++;
+    controller->_statistics.pulseMicros += panel.dotMicros;
+    panel.state = NEXT;
+}
+
+
+/**
+ * pulse the changed dots of all panels, panels with different FP2800a objects at the same time
+ * returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_Canvas::flush()
+{
+    unsigned int flipped = 0;
+    uint8_t running = 0;
+    unsigned long start = micros();
+
+    for ( uint8_t i = 0; i < _panelCount; i++ )
+    {
+        Panel &panel = _panels[i];
+        FlipTheDot_ColumnRowController::FlushCursor cursor = { 0, false, 0, 0 };
+
+        panel.cursor = cursor;
+        panel.state = panel.controller->_frame != NULL ? NEXT : DONE;
+        running += panel.state != DONE ? 1 : 0;
+
+        if ( panel.state != DONE )
+        {
+            panel.controller->_beginFlush();
+        }
+    }
+
+    while ( running > 0 )
+    {
+        uint8_t pulsing = 0;
+        // time until the next pulse ends or the next power budget allows a pulse, 0 when something happened
+        unsigned long wait = 0xFFFFFFFF;
+
+        for ( uint8_t i = 0; i < _panelCount; i++ )
+        {
+            pulsing += _panels[i].state == PULSING ? 1 : 0;
+        }
+
+        for ( uint8_t i = 0; i < _panelCount; i++ )
+        {
+            Panel &panel = _panels[i];
+            FlipTheDot_ColumnRowController *controller = panel.controller;
+
+            if ( panel.state == PULSING )
+            {
+                unsigned long elapsed = micros() - panel.since;
+                if ( elapsed < panel.dotMicros )
+                {
+                    unsigned long remaining = panel.dotMicros - elapsed;
+                    wait = remaining < wait ? remaining : wait;
+                    continue;
+                }
+
+                _finish(panel);
+                pulsing--;
+                flipped++;
+                wait = 0;
+            }
+
+            if ( panel.state == NEXT )
+            {
+                if ( !controller->_nextChanged(panel.cursor, panel.dotCol, panel.dotRow, panel.dotShow) )
+                {
+                    panel.state = DONE;
+                    controller->_endFlush();
+                    controller->_statistics.busyMicros += micros() - start;
+                    running--;
+                    wait = 0;
+                    continue;
+                }
+                panel.state = READY;
+            }
+
+            if ( panel.state == READY && pulsing < _maxParallelPulses && !_isSharingChips(i) )
+            {
+                unsigned long budgetWait = _start(panel);
+                if ( budgetWait > 0 )
+                {
+                    wait = budgetWait < wait ? budgetWait : wait;
+                    continue;
+                }
+                pulsing += panel.state == PULSING ? 1 : 0;
+                wait = 0;
+            }
+        }
+
+        // nothing to do until a pulse ends or the power budget allows the next one
+        if ( wait > 0 && wait != 0xFFFFFFFF )
+        {
+            // delayMicroseconds is only accurate up to 16383 µs
+            delayMicroseconds(wait > 16000 ? 16000 : wait);
+        }
+    }
+
+    return flipped;
+}
+
+
+
+#endif // FlipTheDot_Canvas_h
@@ -13,27 +13,144 @@
 
 #include "FlipTheDot_FP2800a.h"
 
+/*
+  The hooks below cost code and RAM in every pulse, so they are only compiled with their define before the include:
+
+    #define FlipTheDot_ColumnRowController_POWER_BUDGET         // setPowerBudget(...)
+    #define FlipTheDot_ColumnRowController_PULSE_CALIBRATION    // setPulseCalibration(...)
+    #define FlipTheDot_ColumnRowController_PANEL_STATE          // setPanelState(...)
+*/
+#ifdef FlipTheDot_ColumnRowController_POWER_BUDGET
+#include "FlipTheDot_PowerBudget.h"
+#endif
+#ifdef FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+#include "FlipTheDot_PulseCalibration.h"
+#endif
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+#include "FlipTheDot_PanelState.h"
+#endif
+
+
+// number of bytes required for one bit packed frame buffer (each row starts at a new byte)
+#define FlipTheDot_ColumnRowController_BUFFER_SIZE(cols, rows) ( (((cols) + 7) / 8) * (rows) )
+
+
+/*
+  Counters of the controller, see getStatistics().
+  The time which is neither pulse nor wait time (busyMicros - pulseMicros - waitMicros) goes into selecting
+  the outputs and data states, the FP2800a statistics show the details (address line changes, gaps between pulses).
+*/
+struct FlipTheDot_ColumnRowControllerStatistics
+{
+    unsigned long pulses;            // enable cycles of both controllers
+    unsigned long dots;              // pulsed dots, a pulse of an output group counts every dot
+    unsigned long rejectedFlips;     // flips with an invalid position or outputs which could not be selected
+    unsigned long flushes;           // completed flushes of the frame buffer
+    unsigned long busyMicros;        // time spent in flip, flipRow, flipColumn and flush
+    unsigned long pulseMicros;       // time the controllers were enabled (sum of the pulse lengths)
+    unsigned long waitMicros;        // time spent waiting for the power budget
+};
+
 
 class FlipTheDot_ColumnRowController
 {
     public:
         FlipTheDot_ColumnRowController(FlipTheDot_FP2800a &col_ctrl, FlipTheDot_FP2800a &row_ctrl, unsigned int cols, unsigned int rows, unsigned int pulseLengthMicros);
         FlipTheDot_ColumnRowController(FlipTheDot_FP2800a &col_ctrl, FlipTheDot_FP2800a &row_ctrl, unsigned int pulseLengthMicros);
-        uint8_t getColCount();
-        uint8_t getRowCount();
+        unsigned int getColCount();
+        unsigned int getRowCount();
         void setPulseLength(unsigned int pulseLengthMicros);
         unsigned int getPulseLength();
         boolean show(unsigned int col, unsigned int row);
         boolean hide(unsigned int col, unsigned int row);
         boolean flip(unsigned int col, unsigned int row, boolean show);
+        unsigned int flipRow(unsigned int row, unsigned long colMask, boolean show, unsigned int firstCol = 1);
+        unsigned int flipColumn(unsigned int col, unsigned long rowMask, boolean show, unsigned int firstRow = 1);
+
+        void setFrameBuffer(uint8_t *frame, uint8_t *shadow);
+        uint8_t *getFrameBuffer();
+        boolean setDot(unsigned int col, unsigned int row, boolean show);
+        boolean getDot(unsigned int col, unsigned int row);
+        void fill(boolean show);
+        void invalidate();
+        unsigned int flush();
+        void setOptimizedOrder(boolean optimized);
+        boolean isOptimizedOrder();
+#ifdef FlipTheDot_ColumnRowController_POWER_BUDGET
+        void setPowerBudget(FlipTheDot_PowerBudget *budget);
+        FlipTheDot_PowerBudget *getPowerBudget();
+#endif
+#ifdef FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+        void setPulseCalibration(FlipTheDot_PulseCalibration *calibration);
+        FlipTheDot_PulseCalibration *getPulseCalibration();
+#endif
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+        boolean setPanelState(FlipTheDot_PanelState *state);
+        FlipTheDot_PanelState *getPanelState();
+#endif
+        const FlipTheDot_ColumnRowControllerStatistics &getStatistics();
+        void resetStatistics();
     protected:
+        // flushes several controllers at the same time
+        friend class FlipTheDot_Canvas;
+        // pulses the changes of regions in the order of their deadlines
+        friend class FlipTheDot_Scheduler;
+
+        // position of a flush in the frame buffer
+        struct FlushCursor
+        {
+            uint8_t pass;
+            bool isReversed;
+            unsigned int rowStep;
+            unsigned int colStep;
+        };
+
         FlipTheDot_ColumnRowController(){};
+        boolean _pulse(unsigned int col, unsigned int row, boolean show);
+        void _pulseSelected(boolean show, unsigned int col, unsigned int row, unsigned long colMask = 1);
+        void _pulseEnabled(unsigned int col, unsigned int row, boolean show, unsigned long colMask = 1);
+        unsigned int _getPulseLength(unsigned int col, unsigned int row, boolean show, unsigned long colMask = 1);
+        unsigned long _getBudgetWait(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros);
+        void _addBudgetPulse(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros);
+        unsigned int _sweep(FlipTheDot_FP2800a *ctrl, unsigned int count, unsigned long mask, unsigned int first, unsigned int fixedNo, boolean show, boolean isColumnSweep);
+        unsigned int _flushRowGrouped(unsigned int row, unsigned int maxChips);
+        void _writeBit(uint8_t *buffer, unsigned int col, unsigned int row, boolean show);
+        boolean _readBit(uint8_t *buffer, unsigned int col, unsigned int row);
+        boolean _isRowChanged(unsigned int row);
+        boolean _nextChanged(FlushCursor &cursor, unsigned int &col, unsigned int &row, boolean &show);
+        unsigned int _walk(unsigned int step);
+        void _beginFlush();
+        void _endFlush();
+        void _rejectDot(unsigned int col, unsigned int row, boolean show);
+        void _invalidatePanelState();
+
         FlipTheDot_FP2800a *_colCtrl;
         FlipTheDot_FP2800a *_rowCtrl;
 
         unsigned int _cols = 0;
         unsigned int _rows = 0;
         unsigned int _pulseLengthMicros = 0;
+
+        // bit packed frame buffer (desired state) and its shadow copy (state shown on the panel)
+        uint8_t *_frame = NULL;
+        uint8_t *_shadow = NULL;
+        uint8_t _rowBytes = 0;
+        bool _isShadowValid = false;
+        // a pulse of the running flush could not be selected
+        bool _isFlushRejected = false;
+        bool _isOrderOptimized = true;
+
+#ifdef FlipTheDot_ColumnRowController_POWER_BUDGET
+        FlipTheDot_PowerBudget *_budget = NULL;
+#endif
+#ifdef FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+        FlipTheDot_PulseCalibration *_calibration = NULL;
+#endif
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+        FlipTheDot_PanelState *_panelState = NULL;
+#endif
+
+        FlipTheDot_ColumnRowControllerStatistics _statistics = {};
 };
 
 
@@ -62,6 +179,7 @@ FlipTheDot_ColumnRowController::FlipTheDot_ColumnRowController(FlipTheDot_FP2800
 
 /**
  * define how long the pulse method should enable the controllers
+ * a pulse calibration (see setPulseCalibration) takes precedence, this value is only the fallback without one
  */
 void FlipTheDot_ColumnRowController::setPulseLength(unsigned int pulseLengthMicros)
 {
@@ -76,12 +194,12 @@ unsigned int FlipTheDot_ColumnRowController::getPulseLength()
     return _pulseLengthMicros;
 }
 
-uint8_t FlipTheDot_ColumnRowController::getColCount()
+unsigned int FlipTheDot_ColumnRowController::getColCount()
 {
     return _cols;
 }
 
-uint8_t FlipTheDot_ColumnRowController::getRowCount()
+unsigned int FlipTheDot_ColumnRowController::getRowCount()
 {
     return _rows;
 }
@@ -104,15 +222,13 @@ boolean FlipTheDot_ColumnRowController::hide(unsigned int col, unsigned int row)
 
 boolean FlipTheDot_ColumnRowController::flip(unsigned int col, unsigned int row, boolean show)
 {
-    boolean row_data = show == true;
-    boolean col_data = !row_data;
-
     // invalid range
     if ( row < 1 || row > _rows || col < 1 || col > _cols )
     {
       #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
       FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowController selected row or column number out of range") );
       #endif
+      _statistics.rejectedFlips++;
       return false;
     }
 
@@ -124,26 +240,769 @@ boolean FlipTheDot_ColumnRowController::flip(unsigned int col, unsigned int row,
     FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" row ") );
     FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(row);
     FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" with ") );
-    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(_pulseLengthMicros);
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(_getPulseLength(col, row, show));
     FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F(" microseconds pulse. ") );
     #endif
 
+    unsigned long start = micros();
+    _invalidatePanelState();
+    boolean isPulsed = _pulse(col, row, show);
+
+    // keep both buffers in sync with the panel, otherwise the next flush would revert this dot
+    if ( isPulsed && _frame != NULL )
+    {
+        _writeBit(_frame, col, row, show);
+        _writeBit(_shadow, col, row, show);
+    }
+
+    _statistics.busyMicros += micros() - start;
+    return isPulsed;
+}
+
+
+/**
+ * select the outputs of both controllers and pulse them, without any range check
+ */
+boolean FlipTheDot_ColumnRowController::_pulse(unsigned int col, unsigned int row, boolean show)
+{
     if ( _colCtrl->setOutput(col) && _rowCtrl->setOutput(row) )
     {
-        _rowCtrl->setData(row_data);
-        _colCtrl->setData(col_data);
+        _pulseSelected(show, col, row);
+        return true;
+    }
+    _statistics.rejectedFlips++;
+    return false;
+}
 
-        _colCtrl->enable();
-        _rowCtrl->enable();
-        delayMicroseconds(_pulseLengthMicros);
-        _colCtrl->disable();
-        _rowCtrl->disable();
 
+/**
+ * set the data state of the already selected outputs and pulse both controllers
+ * col, row and colMask describe the selected dots for the power budget (see _pulseEnabled)
+ */
+void FlipTheDot_ColumnRowController::_pulseSelected(boolean show, unsigned int col, unsigned int row, unsigned long colMask)
+{
+    boolean row_data = show == true;
+    boolean col_data = !row_data;
+
+    _rowCtrl->setData(row_data);
+    _colCtrl->setData(col_data);
+
+    _pulseEnabled(col, row, show, colMask);
+}
+
+
+/**
+ * enable both controllers for the pulse length, the outputs and data states have to be selected already
+ * with a power budget, wait until the selected dots (col, col + 28, ... for each bit of colMask) fit into it
+ */
+void FlipTheDot_ColumnRowController::_pulseEnabled(unsigned int col, unsigned int row, boolean show, unsigned long colMask)
+{
+    unsigned int pulseMicros = _getPulseLength(col, row, show, colMask);
+
+    unsigned long wait;
+    while ( (wait = _getBudgetWait(col, row, colMask, pulseMicros)) > 0 )
+    {
+        // delayMicroseconds is only accurate up to 16383 µs
+        wait = wait > 16000 ? 16000 : wait;
+        delayMicroseconds(wait);
+        _statistics.waitMicros += wait;
+    }
+    _addBudgetPulse(col, row, colMask, pulseMicros);
+
+    _colCtrl->enable();
+    _rowCtrl->enable();
+    delayMicroseconds(pulseMicros);
+    _colCtrl->disable();
+    _rowCtrl->disable();
+
+    _statistics.pulses++;
+    _statistics.pulseMicros += pulseMicros;
+    for ( ; colMask != 0; colMask >>= 1 )
+    {
+        _statistics.dots += colMask & 1;
+    }
+}
+
+
+/**
+ * flip up to 32 dots of a row at once, bit 0 of the column mask is the column firstCol
+ * the row output and the data states get selected once, only the column address changes between the pulses
+ * returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_ColumnRowController::flipRow(unsigned int row, unsigned long colMask, boolean show, unsigned int firstCol)
+{
+    if ( row < 1 || row > _rows || firstCol < 1 || firstCol > _cols )
+    {
+      #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+      FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowController selected row or column number out of range") );
+      #endif
+      _statistics.rejectedFlips++;
+      return 0;
+    }
+
+    #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F("FlipTheDot_ColumnRowController flipRow ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(show ? F("(show)") : F("(hide)"));
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" row ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(row);
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" mask ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(colMask);
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" from col ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.println(firstCol);
+    #endif
+
+    if ( !_rowCtrl->setOutput(row) )
+    {
+        _statistics.rejectedFlips++;
+        return 0;
+    }
+
+    return _sweep(_colCtrl, _cols, colMask, firstCol, row, show, true);
+}
+
+
+/**
+ * flip up to 32 dots of a column at once, bit 0 of the row mask is the row firstRow
+ * the column output and the data states get selected once, only the row address changes between the pulses
+ * returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_ColumnRowController::flipColumn(unsigned int col, unsigned long rowMask, boolean show, unsigned int firstRow)
+{
+    if ( col < 1 || col > _cols || firstRow < 1 || firstRow > _rows )
+    {
+      #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+      FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowController selected row or column number out of range") );
+      #endif
+      _statistics.rejectedFlips++;
+      return 0;
+    }
+
+    #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F("FlipTheDot_ColumnRowController flipColumn ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(show ? F("(show)") : F("(hide)"));
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" col ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(col);
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" mask ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(rowMask);
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" from row ") );
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.println(firstRow);
+    #endif
+
+    if ( !_colCtrl->setOutput(col) )
+    {
+        _statistics.rejectedFlips++;
+        return 0;
+    }
+
+    return _sweep(_rowCtrl, _rows, rowMask, firstRow, col, show, false);
+}
+
+
+/**
+ * pulse the lines of the mask on one controller while the other one keeps its output (fixedNo)
+ * the lines get visited in the same order as by flush() (see setOptimizedOrder)
+ */
+unsigned int FlipTheDot_ColumnRowController::_sweep(FlipTheDot_FP2800a *ctrl, unsigned int count, unsigned long mask, unsigned int first, unsigned int fixedNo, boolean show, boolean isColumnSweep)
+{
+    unsigned int flipped = 0;
+    unsigned int steps = _isOrderOptimized ? (count + 27) / 28 * 28 : count;
+    unsigned long start = micros();
+
+    _invalidatePanelState();
+    _rowCtrl->setData(show == true);
+    _colCtrl->setData(show != true);
+
+    for ( unsigned int step = 0; step < steps && mask != 0; step++ )
+    {
+        unsigned int no = _isOrderOptimized ? _walk(step) : step + 1;
+
+        if ( no < first || no > count || no - first >= 32 || ( (mask >> (no - first)) & 1 ) == 0 )
+        {
+            continue;
+        }
+        mask &= ~(1UL << (no - first));
+
+        if ( !ctrl->setOutput(no) )
+        {
+            _statistics.rejectedFlips++;
+            continue;
+        }
+        _pulseEnabled(isColumnSweep ? no : fixedNo, isColumnSweep ? fixedNo : no, show);
+        flipped++;
+
+        if ( _frame != NULL )
+        {
+            unsigned int col = isColumnSweep ? no : fixedNo;
+            unsigned int row = isColumnSweep ? fixedNo : no;
+            _writeBit(_frame, col, row, show);
+            _writeBit(_shadow, col, row, show);
+        }
+    }
+
+    _statistics.busyMicros += micros() - start;
+    return flipped;
+}
+
+
+/**
+ * attach the storage for the frame buffer and its shadow copy
+ * both arrays need FlipTheDot_ColumnRowController_BUFFER_SIZE(cols, rows) bytes, one bit per dot
+ * the panel state is unknown afterwards, so the first flush pulses every dot
+ */
+void FlipTheDot_ColumnRowController::setFrameBuffer(uint8_t *frame, uint8_t *shadow)
+{
+    _frame = frame;
+    _shadow = shadow;
+    _rowBytes = (_cols + 7) / 8;
+
+    if ( _frame != NULL )
+    {
+        memset(_frame, 0, _rowBytes * _rows);
+        memset(_shadow, 0, _rowBytes * _rows);
+    }
+    _isShadowValid = false;
+    _invalidatePanelState();
+}
+
+
+/**
+ * get the raw frame buffer (row after row, first column in the lowest bit of the first byte)
+ */
+uint8_t *FlipTheDot_ColumnRowController::getFrameBuffer()
+{
+    return _frame;
+}
+
+
+void FlipTheDot_ColumnRowController::_writeBit(uint8_t *buffer, unsigned int col, unsigned int row, boolean show)
+{
+    uint8_t *value = buffer + (row - 1) * _rowBytes + ((col - 1) >> 3);
+    uint8_t mask = 1 << ((col - 1) & 7);
+
+    if ( show )
+    {
+        *value |= mask;
+    }
+    else
+    {
+        *value &= ~mask;
+    }
+}
+
+
+boolean FlipTheDot_ColumnRowController::_readBit(uint8_t *buffer, unsigned int col, unsigned int row)
+{
+    return ( buffer[(row - 1) * _rowBytes + ((col - 1) >> 3)] >> ((col - 1) & 7) ) & 1;
+}
+
+
+/**
+ * change a dot in the frame buffer only, the panel gets updated with the next flush
+ */
+boolean FlipTheDot_ColumnRowController::setDot(unsigned int col, unsigned int row, boolean show)
+{
+    if ( _frame == NULL || row < 1 || row > _rows || col < 1 || col > _cols )
+    {
+        return false;
+    }
+
+    _writeBit(_frame, col, row, show);
+    return true;
+}
+
+
+/**
+ * get a dot of the frame buffer
+ */
+boolean FlipTheDot_ColumnRowController::getDot(unsigned int col, unsigned int row)
+{
+    if ( _frame == NULL || row < 1 || row > _rows || col < 1 || col > _cols )
+    {
+        return false;
+    }
+
+    return _readBit(_frame, col, row);
+}
+
+
+/**
+ * set all dots of the frame buffer to the same state
+ * the unused bits behind the last column stay 0, the rows get compared byte by byte with the shadow
+ */
+void FlipTheDot_ColumnRowController::fill(boolean show)
+{
+    if ( _frame == NULL )
+    {
+        return;
+    }
+
+    memset(_frame, show ? 0xFF : 0x00, _rowBytes * _rows);
+    if ( show && _cols % 8 != 0 )
+    {
+        for ( unsigned int row = 1; row <= _rows; row++ )
+        {
+            _frame[row * _rowBytes - 1] = (1 << (_cols % 8)) - 1;
+        }
+    }
+}
+
+
+/**
+ * forget the known panel state, e.g. after the dots were moved by hand or the power was lost
+ * the next flush pulses every dot
+ */
+void FlipTheDot_ColumnRowController::invalidate()
+{
+    _isShadowValid = false;
+    _invalidatePanelState();
+}
+
+
+/**
+ * pulse only the dots which differ between the frame buffer and the shown state
+ * if the column controller allows to enable several ICs at once (FlipTheDot_FP2800aMulti::setMaxEnabledChips),
+ * the dots of a row with the same output number on different ICs get pulsed together
+ * returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_ColumnRowController::flush()
+{
+    unsigned int flipped = 0;
+
+    if ( _frame == NULL )
+    {
+        return 0;
+    }
+
+    #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowController flush") );
+    #endif
+
+    unsigned long start = micros();
+    // the groups need the linear column numbers, a mapped column controller gets pulsed dot by dot
+    unsigned int maxChips = _colCtrl->getOutputMap() == NULL ? _colCtrl->getMaxEnabledChips() : 1;
+
+    _beginFlush();
+
+    if ( maxChips > 1 )
+    {
+        for ( unsigned int row = 1; row <= _rows; row++ )
+        {
+            flipped += _flushRowGrouped(row, maxChips);
+        }
+    }
+    else
+    {
+        FlushCursor cursor = { 0, false, 0, 0 };
+        unsigned int col, row;
+        boolean show;
+
+        while ( _nextChanged(cursor, col, row, show) )
+        {
+            if ( _pulse(col, row, show) )
+            {
+                _writeBit(_shadow, col, row, show);
+                flipped++;
+            }
+            else
+            {
+                _rejectDot(col, row, show);
+            }
+        }
+    }
+
+    _endFlush();
+    _statistics.busyMicros += micros() - start;
+    return flipped;
+}
+
+
+/**
+ * define the order in which flush() pulses the changed dots
+ * optimized (default): all dots which get hidden, then all dots which get shown, the rows and columns
+ * in Gray code order of their FP2800a address lines (see FlipTheDot_FP2800a_GRAY_ORDER) and every
+ * second row backwards, so mostly one address line changes between two pulses and the data state
+ * only changes once per flush
+ * not optimized: row by row, column by column
+ */
+void FlipTheDot_ColumnRowController::setOptimizedOrder(boolean optimized)
+{
+    _isOrderOptimized = optimized;
+}
+
+/**
+ * get flush order
+ */
+boolean FlipTheDot_ColumnRowController::isOptimizedOrder()
+{
+    return _isOrderOptimized;
+}
+
+
+#ifdef FlipTheDot_ColumnRowController_POWER_BUDGET
+/**
+ * let every pulse wait until it fits into the power budget, NULL pulses as fast as possible
+ */
+void FlipTheDot_ColumnRowController::setPowerBudget(FlipTheDot_PowerBudget *budget)
+{
+    _budget = budget;
+}
+
+/**
+ * get power budget
+ */
+FlipTheDot_PowerBudget *FlipTheDot_ColumnRowController::getPowerBudget()
+{
+    return _budget;
+}
+#endif
+
+
+#ifdef FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+/**
+ * give every dot its own pulse length (see FlipTheDot_PulseCalibration), NULL uses the pulse length for all dots
+ */
+void FlipTheDot_ColumnRowController::setPulseCalibration(FlipTheDot_PulseCalibration *calibration)
+{
+    _calibration = calibration;
+}
+
+/**
+ * get pulse calibration
+ */
+FlipTheDot_PulseCalibration *FlipTheDot_ColumnRowController::getPulseCalibration()
+{
+    return _calibration;
+}
+#endif
+
+
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+/**
+ * keep the shown frame in a non-volatile memory (see FlipTheDot_PanelState), NULL stops it
+ * call it after setFrameBuffer(...): the stored frame gets loaded into the frame buffer and its shadow,
+ * so the next flush only pulses the dots which differ from it
+ * if a reset interrupted a flush, the dots of that flush get pulsed right away
+ * returns false if no valid state was stored, the next flush pulses every dot then
+ */
+boolean FlipTheDot_ColumnRowController::setPanelState(FlipTheDot_PanelState *state)
+{
+    _panelState = state;
+
+    if ( _panelState == NULL || _frame == NULL )
+    {
+        return false;
+    }
+
+    uint8_t status = _panelState->_attach(_frame, _shadow, _rowBytes * _rows);
+    if ( status == FlipTheDot_PanelState::NONE )
+    {
+        _isShadowValid = false;
+        return false;
+    }
+
+    _isShadowValid = true;
+    if ( status == FlipTheDot_PanelState::PENDING )
+    {
+        // the dots between both frames may show either state, pulse them again
+        flush();
+    }
+    return true;
+}
+
+/**
+ * get panel state
+ */
+FlipTheDot_PanelState *FlipTheDot_ColumnRowController::getPanelState()
+{
+    return _panelState;
+}
+#endif
+
+
+/**
+ * get the counters since the start or the last resetStatistics()
+ */
+const FlipTheDot_ColumnRowControllerStatistics &FlipTheDot_ColumnRowController::getStatistics()
+{
+    return _statistics;
+}
+
+/**
+ * set all counters to zero
+ */
+void FlipTheDot_ColumnRowController::resetStatistics()
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+}
+
+
+/**
+ * map a step of the optimized walk to a line number (1 to 28 * number of ICs)
+ * the ICs get walked alternately forward and backward, so the address stays the same between two ICs
+ */
+unsigned int FlipTheDot_ColumnRowController::_walk(unsigned int step)
+{
+    unsigned int chip = step / 28;
+    uint8_t index = step - chip * 28;
+
+    if ( chip & 1 )
+    {
+        index = 27 - index;
+    }
+    return chip * 28 + pgm_read_byte(&FlipTheDot_FP2800a_GRAY_ORDER[index]);
+}
+
+
+/**
+ * pulse length for the selected dots (col, col + 28, ... for each bit of colMask), the longest one of a group
+ */
+unsigned int FlipTheDot_ColumnRowController::_getPulseLength(unsigned int col, unsigned int row, boolean show, unsigned long colMask)
+{
+#ifdef FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+    if ( _calibration == NULL )
+    {
+        return _pulseLengthMicros;
+    }
+
+    unsigned int pulseMicros = 0;
+    for ( ; colMask != 0; colMask >>= 1, col += 28 )
+    {
+        if ( colMask & 1 )
+        {
+            unsigned int dotMicros = _calibration->getPulseLength(col, row, show);
+            pulseMicros = dotMicros > pulseMicros ? dotMicros : pulseMicros;
+        }
+    }
+    return pulseMicros;
+#else
+    return _pulseLengthMicros;
+#endif
+}
+
+
+/**
+ * microseconds until the selected dots fit into the power budget, 0 without one
+ */
+unsigned long FlipTheDot_ColumnRowController::_getBudgetWait(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros)
+{
+#ifdef FlipTheDot_ColumnRowController_POWER_BUDGET
+    if ( _budget != NULL )
+    {
+        return _budget->getWaitMicros(col, row, colMask, pulseMicros);
+    }
+#endif
+    return 0;
+}
+
+
+/**
+ * account a pulse of the selected dots in the power budget
+ */
+void FlipTheDot_ColumnRowController::_addBudgetPulse(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros)
+{
+#ifdef FlipTheDot_ColumnRowController_POWER_BUDGET
+    if ( _budget != NULL )
+    {
+        _budget->addPulse(col, row, colMask, pulseMicros);
+    }
+#endif
+}
+
+
+/**
+ * store the frame buffer as pending in the panel state, before the first pulse of a flush
+ */
+void FlipTheDot_ColumnRowController::_beginFlush()
+{
+    _isFlushRejected = false;
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+    if ( _panelState != NULL )
+    {
+        _panelState->_save(_frame, _isShadowValid ? _shadow : NULL);
+    }
+#endif
+}
+
+
+/**
+ * the shadow matches the panel after a complete flush, the frame buffer too if no pulse was rejected
+ * a flush with rejected pulses leaves the panel state pending, the stored frame is not shown
+ */
+void FlipTheDot_ColumnRowController::_endFlush()
+{
+    _isShadowValid = true;
+    _statistics.flushes++;
+
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+    if ( _panelState != NULL && !_isFlushRejected )
+    {
+        _panelState->_commit();
+    }
+#endif
+}
+
+
+/**
+ * a dot of a flush could not be pulsed: keep it different from the frame buffer in the shadow, so the next
+ * flush tries it again also when the shadow was not valid yet
+ */
+void FlipTheDot_ColumnRowController::_rejectDot(unsigned int col, unsigned int row, boolean show)
+{
+    _writeBit(_shadow, col, row, !show);
+    _isFlushRejected = true;
+}
+
+
+/**
+ * the panel state gets outdated by pulses outside of a flush
+ */
+void FlipTheDot_ColumnRowController::_invalidatePanelState()
+{
+#ifdef FlipTheDot_ColumnRowController_PANEL_STATE
+    if ( _panelState != NULL )
+    {
+        _panelState->invalidate();
+    }
+#endif
+}
+
+
+/**
+ * check if any dot of a row differs between the frame buffer and the shown state
+ */
+boolean FlipTheDot_ColumnRowController::_isRowChanged(unsigned int row)
+{
+    if ( !_isShadowValid )
+    {
         return true;
     }
+    return memcmp(_frame + (row - 1) * _rowBytes, _shadow + (row - 1) * _rowBytes, _rowBytes) != 0;
+}
+
+
+/**
+ * move the cursor to the next dot which has to be pulsed (see setOptimizedOrder)
+ * returns false when the whole frame buffer was checked
+ */
+boolean FlipTheDot_ColumnRowController::_nextChanged(FlushCursor &cursor, unsigned int &col, unsigned int &row, boolean &show)
+{
+    uint8_t passes = _isOrderOptimized ? 2 : 1;
+    // the optimized walk covers every output of all used ICs and skips the unused ones
+    unsigned int rowSteps = _isOrderOptimized ? (_rows + 27) / 28 * 28 : _rows;
+    unsigned int colSteps = _isOrderOptimized ? (_cols + 27) / 28 * 28 : _cols;
+
+    for ( ; cursor.pass < passes; cursor.pass++, cursor.rowStep = 0 )
+    {
+        for ( ; cursor.rowStep < rowSteps; cursor.rowStep++, cursor.colStep = 0 )
+        {
+            row = _isOrderOptimized ? _walk(cursor.rowStep) : cursor.rowStep + 1;
+
+            if ( cursor.colStep == 0 )
+            {
+                if ( row > _rows || !_isRowChanged(row) )
+                {
+                    continue;
+                }
+                // walk the columns of every visited row in the opposite direction of the previous one
+                cursor.isReversed = !cursor.isReversed;
+            }
+
+            while ( cursor.colStep < colSteps )
+            {
+                unsigned int step = cursor.colStep++;
+
+                if ( _isOrderOptimized )
+                {
+                    col = _walk( cursor.isReversed ? colSteps - 1 - step : step );
+                }
+                else
+                {
+                    col = step + 1;
+                }
+
+                if ( col > _cols )
+                {
+                    continue;
+                }
+
+                show = _readBit(_frame, col, row);
+                if ( ( _isOrderOptimized && show != cursor.pass ) || ( _isShadowValid && _readBit(_shadow, col, row) == show ) )
+                {
+                    continue;
+                }
+                return true;
+            }
+        }
+    }
     return false;
 }
 
 
+/**
+ * flush one row by pulsing the same output number of several column ICs at once
+ * the dots of a group need the same state, because all column ICs share the data pin
+ */
+unsigned int FlipTheDot_ColumnRowController::_flushRowGrouped(unsigned int row, unsigned int maxChips)
+{
+    unsigned int flipped = 0;
+    unsigned int chips = _colCtrl->getChipCount();
+    unsigned int outputs = _colCtrl->getOutputMax() / chips;
+
+    for ( uint8_t show = 0; show < 2; show++ )
+    {
+        for ( unsigned int output = 1; output <= outputs; output++ )
+        {
+            unsigned long chipMask = 0;
+            unsigned int count = 0;
+
+            for ( unsigned int chip = 0; chip < chips; chip++ )
+            {
+                unsigned int col = chip * outputs + output;
+
+                if ( col <= _cols && _readBit(_frame, col, row) == show && ( !_isShadowValid || _readBit(_shadow, col, row) != show ) )
+                {
+                    chipMask |= 1UL << chip;
+                    count++;
+                }
+
+                // pulse the collected group when it is full or all ICs are checked
+                if ( count > 0 && ( count == maxChips || chip == chips - 1 ) )
+                {
+                    boolean isSelected = _colCtrl->setOutputGroup(output, chipMask) && _rowCtrl->setOutput(row);
+                    if ( isSelected )
+                    {
+                        _pulseSelected(show, output, row, chipMask);
+                    }
+                    else
+                    {
+                        _statistics.rejectedFlips++;
+                    }
+
+                    for ( unsigned int i = 0; i < chips; i++ )
+                    {
+                        if ( (chipMask >> i) & 1 )
+                        {
+                            if ( isSelected )
+                            {
+                                _writeBit(_shadow, i * outputs + output, row, show);
+                                flipped++;
+                            }
+                            else
+                            {
+                                _rejectDot(i * outputs + output, row, show);
+                            }
+                        }
+                    }
+                    chipMask = 0;
+                    count = 0;
+                }
+            }
+        }
+    }
+
+    return flipped;
+}
+
+
 
 #endif // FlipTheDot_ColumnRowController_h
\ No newline at end of file
@@ -0,0 +1,414 @@
+/*
+ * FlipTheDot_ColumnRowControllerAsync Class  -- Pulse the dots in the background, driven by a timer interrupt
+ *
+ * Same wiring and frame buffer as FlipTheDot_ColumnRowController, but queue(...) and flushAsync() return
+ * immediately. The pulses run as a state machine in handleInterrupt(), which has to be called by a one shot
+ * timer: it enables the selected outputs, disables them after the pulse length and selects the next dot.
+ * The foreground code checks isBusy() or gets informed by a callback when all work is done.
+ *
+ * The timer gets started by a function which the sketch passes to setTimer(...) (0 microseconds stop it).
+ * On AVR boards, define FlipTheDot_ColumnRowControllerAsync_TIMER1 before the include to use Timer1
+ * (compare match A interrupt) and pass FlipTheDot_ColumnRowControllerAsync_timer1 to setTimer(...).
+ *
+ * The blocking methods (flip, show, hide and flush) must not be used while isBusy() is true.
+ * The interrupt only writes the shadow (the shown state), so setDot(...) and fill(...) may change the frame
+ * buffer at any time without losing a bit to an interrupt in the middle of their read-modify-write.
+ */
+
+
+
+#ifndef FlipTheDot_ColumnRowControllerAsync_h
+#define FlipTheDot_ColumnRowControllerAsync_h
+
+
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// number of single flips which can wait in the queue
+#ifndef FlipTheDot_ColumnRowControllerAsync_QUEUE_SIZE
+#define FlipTheDot_ColumnRowControllerAsync_QUEUE_SIZE 16
+#endif
+
+
+#ifdef FlipTheDot_ColumnRowControllerAsync_TIMER1
+void FlipTheDot_ColumnRowControllerAsync_timer1(unsigned int micros);
+#endif
+
+
+class FlipTheDot_ColumnRowControllerAsync : public FlipTheDot_ColumnRowController
+{
+    public:
+        FlipTheDot_ColumnRowControllerAsync(FlipTheDot_FP2800a &col_ctrl, FlipTheDot_FP2800a &row_ctrl, unsigned int cols, unsigned int rows, unsigned int pulseLengthMicros);
+        FlipTheDot_ColumnRowControllerAsync(FlipTheDot_FP2800a &col_ctrl, FlipTheDot_FP2800a &row_ctrl, unsigned int pulseLengthMicros);
+        void setTimer(void (*startTimer)(unsigned int micros));
+        void setCallback(void (*callback)());
+        void setGapLength(unsigned int gapLengthMicros);
+        unsigned int getGapLength();
+        boolean queue(unsigned int col, unsigned int row, boolean show);
+        boolean flushAsync();
+        boolean isBusy();
+        void handleInterrupt();
+    protected:
+        enum State { STATE_IDLE = 0, STATE_ENABLE = 1, STATE_DISABLE = 2 };
+
+        struct Job
+        {
+            unsigned int col;
+            unsigned int row;
+            boolean show;
+        };
+
+        void _start();
+        boolean _selectNext();
+        boolean _nextFrameDot(Job &job);
+
+        void (*_startTimer)(unsigned int micros) = NULL;
+        void (*_callback)() = NULL;
+        unsigned int _gapLengthMicros = 10;
+
+        // ring buffer of single flips, written by the foreground and read by the interrupt
+        Job _queue[FlipTheDot_ColumnRowControllerAsync_QUEUE_SIZE];
+        volatile uint8_t _queueHead = 0;
+        volatile uint8_t _queueTail = 0;
+
+        // position of the frame buffer walk of flushAsync()
+        volatile boolean _isFlushing = false;
+        FlushCursor _cursor;
+
+        volatile uint8_t _state = STATE_IDLE;
+        Job _current;
+        unsigned int _currentMicros = 0;
+
+    #ifdef FlipTheDot_ColumnRowControllerAsync_TIMER1
+    public:
+        static FlipTheDot_ColumnRowControllerAsync *_timer1Controller;
+    #endif
+};
+
+
+
+FlipTheDot_ColumnRowControllerAsync::FlipTheDot_ColumnRowControllerAsync(FlipTheDot_FP2800a &col_ctrl, FlipTheDot_FP2800a &row_ctrl, unsigned int pulseLengthMicros = 100)
+    : FlipTheDot_ColumnRowController(col_ctrl, row_ctrl, pulseLengthMicros)
+{
+}
+
+FlipTheDot_ColumnRowControllerAsync::FlipTheDot_ColumnRowControllerAsync(FlipTheDot_FP2800a &col_ctrl, FlipTheDot_FP2800a &row_ctrl, unsigned int cols, unsigned int rows, unsigned int pulseLengthMicros = 100)
+    : FlipTheDot_ColumnRowController(col_ctrl, row_ctrl, cols, rows, pulseLengthMicros)
+{
+}
+
+
+/**
+ * define the function which starts the one shot timer, it gets called with the time until the next
+ * call of handleInterrupt() in microseconds, or with 0 to stop the timer
+ */
+void FlipTheDot_ColumnRowControllerAsync::setTimer(void (*startTimer)(unsigned int micros))
+{
+    _startTimer = startTimer;
+
+    #ifdef FlipTheDot_ColumnRowControllerAsync_TIMER1
+    if ( startTimer == FlipTheDot_ColumnRowControllerAsync_timer1 )
+    {
+        _timer1Controller = this;
+    }
+    #endif
+}
+
+
+/**
+ * define a function which gets called when the queue is empty and the frame buffer is flushed
+ * it runs in the interrupt, so keep it short
+ */
+void FlipTheDot_ColumnRowControllerAsync::setCallback(void (*callback)())
+{
+    _callback = callback;
+}
+
+
+/**
+ * define the time between selecting the next dot and enabling its outputs
+ */
+void FlipTheDot_ColumnRowControllerAsync::setGapLength(unsigned int gapLengthMicros)
+{
+    _gapLengthMicros = gapLengthMicros > 0 ? gapLengthMicros : 1;
+}
+
+/**
+ * get gap length
+ */
+unsigned int FlipTheDot_ColumnRowControllerAsync::getGapLength()
+{
+    return _gapLengthMicros;
+}
+
+
+/**
+ * add a single flip to the queue, it gets pulsed before the remaining dots of a running flushAsync()
+ * returns false if the dot is out of range or the queue is full
+ */
+boolean FlipTheDot_ColumnRowControllerAsync::queue(unsigned int col, unsigned int row, boolean show)
+{
+    if ( row < 1 || row > _rows || col < 1 || col > _cols || _startTimer == NULL )
+    {
+        #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowControllerAsync selected row or column number out of range") );
+        #endif
+        return false;
+    }
+
+    uint8_t next = (_queueTail + 1) % FlipTheDot_ColumnRowControllerAsync_QUEUE_SIZE;
+    if ( next == _queueHead )
+    {
+        #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowControllerAsync queue full") );
+        #endif
+        return false;
+    }
+
+    Job &job = _queue[_queueTail];
+    job.col = col;
+    job.row = row;
+    job.show = show;
+    _invalidatePanelState();
+
+    // the queued flip changes the desired state as well (like flip), here and not in the interrupt
+    if ( _frame != NULL )
+    {
+        _writeBit(_frame, col, row, show);
+    }
+
+    noInterrupts();
+    _queueTail = next;
+    _start();
+    interrupts();
+
+    return true;
+}
+
+
+/**
+ * start pulsing the dots which differ between the frame buffer and the shown state
+ * the dots get pulsed in the same order as by flush() (see setOptimizedOrder)
+ * the frame buffer may be changed while the flush is running, calling flushAsync() again restarts
+ * the walk, so the changes of already passed dots get pulsed as well
+ * if no dot differs, the callback gets called right away (with disabled interrupts, like in the interrupt)
+ */
+boolean FlipTheDot_ColumnRowControllerAsync::flushAsync()
+{
+    if ( _frame == NULL || _startTimer == NULL )
+    {
+        return false;
+    }
+
+    #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+    FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_ColumnRowControllerAsync flush") );
+    #endif
+
+    // writing the panel state takes too long for the interrupt
+    _invalidatePanelState();
+
+    noInterrupts();
+    // a restart with unknown panel state would pulse the passed dots twice
+    if ( !_isFlushing || _isShadowValid )
+    {
+        _cursor.pass = 0;
+        _cursor.isReversed = false;
+        _cursor.rowStep = 0;
+        _cursor.colStep = 0;
+        _isFlushing = true;
+    }
+    _start();
+    // nothing differs, the flush is done already
+    if ( _state == STATE_IDLE && _callback != NULL )
+    {
+        _callback();
+    }
+    interrupts();
+
+    return true;
+}
+
+
+/**
+ * check if there are queued flips or a running flush
+ */
+boolean FlipTheDot_ColumnRowControllerAsync::isBusy()
+{
+    return _state != STATE_IDLE;
+}
+
+
+/**
+ * select the first dot and start the timer, if the state machine is idle
+ * has to be called with disabled interrupts
+ */
+void FlipTheDot_ColumnRowControllerAsync::_start()
+{
+    if ( _state == STATE_IDLE && _selectNext() )
+    {
+        _state = STATE_ENABLE;
+        _startTimer(_gapLengthMicros);
+    }
+}
+
+
+/**
+ * take the next dot from the queue or the frame buffer and select the outputs for it
+ * returns false if there is nothing left to do
+ */
+boolean FlipTheDot_ColumnRowControllerAsync::_selectNext()
+{
+    while ( true )
+    {
+        if ( _queueHead != _queueTail )
+        {
+            _current = _queue[_queueHead];
+            _queueHead = (_queueHead + 1) % FlipTheDot_ColumnRowControllerAsync_QUEUE_SIZE;
+        }
+        else if ( !_isFlushing || !_nextFrameDot(_current) )
+        {
+            return false;
+        }
+
+        if ( _colCtrl->setOutput(_current.col) && _rowCtrl->setOutput(_current.row) )
+        {
+            _rowCtrl->setData(_current.show);
+            _colCtrl->setData(!_current.show);
+            _currentMicros = _getPulseLength(_current.col, _current.row, _current.show);
+            return true;
+        }
+        _statistics.rejectedFlips++;
+        if ( _frame != NULL )
+        {
+            _rejectDot(_current.col, _current.row, _current.show);
+        }
+    }
+}
+
+
+/**
+ * continue the frame buffer walk with the next changed dot
+ * returns false and ends the flush when the whole frame buffer was checked
+ */
+boolean FlipTheDot_ColumnRowControllerAsync::_nextFrameDot(Job &job)
+{
+    unsigned int col, row;
+    boolean show;
+
+    if ( _nextChanged(_cursor, col, row, show) )
+    {
+        job.col = col;
+        job.row = row;
+        job.show = show;
+        return true;
+    }
+
+    // the panel state gets no commit from the interrupt (see flushAsync)
+    _isFlushing = false;
+    _isShadowValid = true;
+    _statistics.flushes++;
+    return false;
+}
+
+
+/**
+ * advance the state machine, has to be called by the timer interrupt
+ */
+void FlipTheDot_ColumnRowControllerAsync::handleInterrupt()
+{
+    switch ( _state )
+    {
+        case STATE_ENABLE:
+        {
+            // extend the gap until the dot fits into the power budget
+            unsigned long wait = _getBudgetWait(_current.col, _current.row, 1, _currentMicros);
+            if ( wait > 0 )
+            {
+                wait = wait > 30000 ? 30000 : wait;
+                _startTimer(wait);
+                _statistics.waitMicros += wait;
+                break;
+            }
+            _addBudgetPulse(_current.col, _current.row, 1, _currentMicros);
+
+            _colCtrl->enable();
+            _rowCtrl->enable();
+            _state = STATE_DISABLE;
+            _startTimer(_currentMicros);
+            break;
+        }
+
+        case STATE_DISABLE:
+            _colCtrl->disable();
+            _rowCtrl->disable();
+
+            _statistics.pulses++;
+            _statistics.dots++;
+            _statistics.pulseMicros += _currentMicros;
+
+            // the dot is shown now, the frame buffer belongs to the foreground (see queue)
+            if ( _frame != NULL )
+            {
+                _writeBit(_shadow, _current.col, _current.row, _current.show);
+            }
+
+            if ( _selectNext() )
+            {
+                _state = STATE_ENABLE;
+                _startTimer(_gapLengthMicros);
+                break;
+            }
+
+            _state = STATE_IDLE;
+            _startTimer(0);
+            if ( _callback != NULL )
+            {
+                _callback();
+            }
+            break;
+
+        default:
+            _startTimer(0);
+            break;
+    }
+}
+
+
+
+#ifdef FlipTheDot_ColumnRowControllerAsync_TIMER1
+
+FlipTheDot_ColumnRowControllerAsync *FlipTheDot_ColumnRowControllerAsync::_timer1Controller = NULL;
+
+/**
+ * one shot timer with Timer1 in CTC mode and a prescaler of 8 (0.5 µs per tick at 16 MHz)
+ */
+void FlipTheDot_ColumnRowControllerAsync_timer1(unsigned int micros)
+{
+    if ( micros == 0 )
+    {
+        TIMSK1 &= ~_BV(OCIE1A);
+        return;
+    }
+
+    unsigned long ticks = micros * (F_CPU / 8000000UL);
+    OCR1A = ticks > 0xFFFF ? 0xFFFF : ticks - 1;
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS11);
+    TCNT1 = 0;
+    TIFR1 = _BV(OCF1A);
+    TIMSK1 |= _BV(OCIE1A);
+}
+
+ISR(TIMER1_COMPA_vect)
+{
+    if ( FlipTheDot_ColumnRowControllerAsync::_timer1Controller != NULL )
+    {
+        FlipTheDot_ColumnRowControllerAsync::_timer1Controller->handleInterrupt();
+    }
+}
+
+#endif // FlipTheDot_ColumnRowControllerAsync_TIMER1
+
+
+
+#endif // FlipTheDot_ColumnRowControllerAsync_h
@@ -0,0 +1,61 @@
+/*
+ * FlipTheDot_ColumnRowControllerStatic Class Template  -- Control the outputs of two FlipTheDot_FP2800aStatic objects
+ *
+ * Same flip logic as FlipTheDot_ColumnRowController, but the types of the column and row controllers are
+ * template parameters. Together with FlipTheDot_FP2800aStatic, the whole flip path can be inlined
+ * without any virtual method call. The frame buffer is only available in FlipTheDot_ColumnRowController.
+ */
+
+
+
+#ifndef FlipTheDot_ColumnRowControllerStatic_h
+#define FlipTheDot_ColumnRowControllerStatic_h
+
+
+#include "FlipTheDot_FP2800aStatic.h"
+
+
+template <class ColCtrl, class RowCtrl>
+class FlipTheDot_ColumnRowControllerStatic
+{
+    public:
+        FlipTheDot_ColumnRowControllerStatic(ColCtrl &col_ctrl, RowCtrl &row_ctrl, unsigned int pulseLengthMicros = 100)
+            : _colCtrl(col_ctrl), _rowCtrl(row_ctrl), _pulseLengthMicros(pulseLengthMicros) {};
+        unsigned int getColCount() { return ColCtrl::outputs; }
+        unsigned int getRowCount() { return RowCtrl::outputs; }
+        void setPulseLength(unsigned int pulseLengthMicros) { _pulseLengthMicros = pulseLengthMicros; }
+        unsigned int getPulseLength() { return _pulseLengthMicros; }
+        boolean show(unsigned int col, unsigned int row) { return flip(col, row, true); }
+        boolean hide(unsigned int col, unsigned int row) { return flip(col, row, false); }
+        boolean flip(unsigned int col, unsigned int row, boolean show);
+    protected:
+        ColCtrl &_colCtrl;
+        RowCtrl &_rowCtrl;
+
+        unsigned int _pulseLengthMicros;
+};
+
+
+template <class ColCtrl, class RowCtrl>
+boolean FlipTheDot_ColumnRowControllerStatic<ColCtrl, RowCtrl>::flip(unsigned int col, unsigned int row, boolean show)
+{
+    // the range gets checked by setOutput
+    if ( _colCtrl.setOutput(col) && _rowCtrl.setOutput(row) )
+    {
+        _rowCtrl.setData(show);
+        _colCtrl.setData(!show);
+
+        _colCtrl.enable();
+        _rowCtrl.enable();
+        delayMicroseconds(_pulseLengthMicros);
+        _colCtrl.disable();
+        _rowCtrl.disable();
+
+        return true;
+    }
+    return false;
+}
+
+
+
+#endif // FlipTheDot_ColumnRowControllerStatic_h
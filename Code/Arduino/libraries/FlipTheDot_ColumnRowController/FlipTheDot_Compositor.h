@@ -0,0 +1,620 @@
+/*
+ * FlipTheDot_Compositor Class  -- Independent layers and sprites on the frame buffer of a FlipTheDot_ColumnRowController
+ *
+ * Every FlipTheDot_Layer keeps its own 1-bit image, either in RAM (drawable, e.g. a route number or a text which
+ * scrolls thru a window of the layer) or in flash (a sprite, setImage_P). A layer sits at a position of the panel,
+ * can be hidden (blink) and gets combined with the layers below it:
+ *   OPAQUE:      the dots of the layer window replace the dots below
+ *   TRANSPARENT: shown dots of the layer get shown, hidden dots let the layers below shine thru
+ *   INVERT:      shown dots of the layer invert the dots below
+ *
+ * Every change of a layer (dots, image, position, scroll offset, visibility, mode) widens the dirty rectangle of the
+ * layer. update() composes only the dots within the dirty rectangles into the frame buffer of the controller and
+ * flushes it, the flush skips all rows which did not change. A blinking dot in one corner costs a few composed dots
+ * and one pulse instead of composing the whole panel.
+ *
+ * Example:
+ *   uint8_t routeBuffer[FlipTheDot_Layer_BUFFER_SIZE(12, 7)];
+ *   FlipTheDot_Layer route(12, 7, routeBuffer);
+ *   FlipTheDot_Compositor compositor(controller);
+ *
+ *   compositor.addLayer(route);
+ *   route.drawText(1, 1, "42", FlipTheDot_Font5x7);
+ *   compositor.update();
+ */
+
+
+#ifndef FlipTheDot_Compositor_h
+#define FlipTheDot_Compositor_h
+
+#include "Arduino.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Font.h"
+
+
+// maximum number of layers of a compositor
+#ifndef FlipTheDot_Compositor_MAX_LAYERS
+#define FlipTheDot_Compositor_MAX_LAYERS 8
+#endif
+
+// bytes of a layer image, rows of (cols + 7) / 8 bytes like the frame buffer of the controller
+#define FlipTheDot_Layer_BUFFER_SIZE(cols, rows) ( (((cols) + 7) / 8) * (rows) )
+
+
+
+class FlipTheDot_Layer
+{
+    public:
+        enum Mode { OPAQUE = 0, TRANSPARENT = 1, INVERT = 2 };
+
+        FlipTheDot_Layer(unsigned int cols, unsigned int rows, uint8_t *buffer);
+        unsigned int getColCount();
+        unsigned int getRowCount();
+
+        boolean setDot(unsigned int col, unsigned int row, boolean show);
+        boolean getDot(unsigned int col, unsigned int row);
+        void fill(boolean show);
+        unsigned int drawText(int col, int row, const char *text, const FlipTheDot_Font &font);
+        void setImage_P(const uint8_t *image);
+        void invalidate();
+
+        void setPosition(int col, int row);
+        int getPositionCol();
+        int getPositionRow();
+        void setWindow(unsigned int cols, unsigned int rows);
+        void setScroll(unsigned int col, unsigned int row);
+        void setVisible(boolean isVisible);
+        boolean isVisible();
+        void setMode(uint8_t mode);
+        uint8_t getMode();
+
+    protected:
+        friend class FlipTheDot_Compositor;
+
+        boolean _readWindow(unsigned int col, unsigned int row);
+        void _markContent(unsigned int col, unsigned int row);
+        void _markWindow();
+        void _markDirty(int col1, int row1, int col2, int row2);
+
+        unsigned int _cols;
+        unsigned int _rows;
+        unsigned int _rowBytes;
+        uint8_t *_buffer;
+        const uint8_t *_image = NULL;
+
+        // top left corner on the panel, 1 = first column / row, may be outside of the panel
+        int _col = 1;
+        int _row = 1;
+        // visible part of the image and the image dot at its top left corner, starting at 0
+        unsigned int _windowCols;
+        unsigned int _windowRows;
+        unsigned int _scrollCol = 0;
+        unsigned int _scrollRow = 0;
+
+        boolean _isVisible = true;
+        uint8_t _mode = OPAQUE;
+
+        // panel area which needs to be composed again, inclusive
+        boolean _isDirty = false;
+        int _dirtyCol1;
+        int _dirtyRow1;
+        int _dirtyCol2;
+        int _dirtyRow2;
+};
+
+
+
+class FlipTheDot_Compositor
+{
+    public:
+        FlipTheDot_Compositor(FlipTheDot_ColumnRowController &controller);
+        boolean addLayer(FlipTheDot_Layer &layer);
+        uint8_t getLayerCount();
+        void setBackground(boolean show);
+
+        void compose();
+        unsigned int update();
+        void invalidate();
+        unsigned long getComposedCount();
+        void resetComposedCount();
+
+    protected:
+        void _compose(int col1, int row1, int col2, int row2);
+
+        FlipTheDot_ColumnRowController *_controller;
+        FlipTheDot_Layer *_layers[FlipTheDot_Compositor_MAX_LAYERS];
+        uint8_t _layerCount = 0;
+        boolean _background = false;
+        boolean _isInvalid = true;
+        unsigned long _composedCount = 0;
+};
+
+
+/**
+ * the buffer needs FlipTheDot_Layer_BUFFER_SIZE(cols, rows) bytes, NULL for a sprite (see setImage_P)
+ * the layer starts at the top left corner of the panel, visible, opaque and with a window of the full image
+ */
+FlipTheDot_Layer::FlipTheDot_Layer(unsigned int cols, unsigned int rows, uint8_t *buffer)
+{
+    _cols = cols;
+    _rows = rows;
+    _rowBytes = (cols + 7) / 8;
+    _buffer = buffer;
+    _windowCols = cols;
+    _windowRows = rows;
+
+    if ( _buffer != NULL )
+    {
+        memset(_buffer, 0, _rowBytes * _rows);
+    }
+    _markWindow();
+}
+
+
+unsigned int FlipTheDot_Layer::getColCount()
+{
+    return _cols;
+}
+
+unsigned int FlipTheDot_Layer::getRowCount()
+{
+    return _rows;
+}
+
+
+/**
+ * change a dot of the image in RAM, col and row start at 1 in the top left corner of the image
+ */
+boolean FlipTheDot_Layer::setDot(unsigned int col, unsigned int row, boolean show)
+{
+    if ( _buffer == NULL || _image != NULL || row < 1 || row > _rows || col < 1 || col > _cols )
+    {
+        return false;
+    }
+
+    uint8_t *value = _buffer + (row - 1) * _rowBytes + ((col - 1) >> 3);
+    uint8_t mask = 1 << ((col - 1) & 7);
+
+    if ( ( (*value & mask) != 0 ) != show )
+    {
+        *value ^= mask;
+        _markContent(col, row);
+    }
+    return true;
+}
+
+
+boolean FlipTheDot_Layer::getDot(unsigned int col, unsigned int row)
+{
+    if ( row < 1 || row > _rows || col < 1 || col > _cols )
+    {
+        return false;
+    }
+
+    unsigned int index = (row - 1) * _rowBytes + ((col - 1) >> 3);
+    uint8_t value = _image != NULL ? pgm_read_byte(&_image[index]) : ( _buffer != NULL ? _buffer[index] : 0 );
+    return ( value >> ((col - 1) & 7) ) & 1;
+}
+
+
+/**
+ * set all dots of the image in RAM to the same state
+ */
+void FlipTheDot_Layer::fill(boolean show)
+{
+    if ( _buffer == NULL || _image != NULL )
+    {
+        return;
+    }
+
+    memset(_buffer, show ? 0xFF : 0x00, _rowBytes * _rows);
+    // the unused bits behind the last column stay 0
+    if ( show && _cols % 8 != 0 )
+    {
+        for ( unsigned int row = 1; row <= _rows; row++ )
+        {
+            _buffer[row * _rowBytes - 1] = (1 << (_cols % 8)) - 1;
+        }
+    }
+    _markWindow();
+}
+
+
+/**
+ * draw a text into the image in RAM with its top left corner at col, row (may start outside of the image)
+ * shown dots of the font get shown, the rest is hidden, returns the width in columns including the spacing
+ * columns behind every character, characters which are not in the font get skipped
+ */
+unsigned int FlipTheDot_Layer::drawText(int col, int row, const char *text, const FlipTheDot_Font &font)
+{
+    unsigned int width = 0;
+
+    for ( ; *text != '\0'; text++ )
+    {
+        uint8_t code = (uint8_t)*text;
+        if ( code < font.first || code >= font.first + font.count )
+        {
+            continue;
+        }
+
+        uint8_t glyph = pgm_read_byte(&font.glyphs[code - font.first]);
+        if ( glyph == FlipTheDot_Font_MISSING )
+        {
+            continue;
+        }
+
+        uint8_t glyphWidth = pgm_read_byte(&font.widths[glyph]);
+        uint8_t rowBytes = (glyphWidth + 7) / 8;
+        const uint8_t *data = font.data + pgm_read_word(&font.offsets[glyph]);
+
+        for ( uint8_t x = 0; x < glyphWidth + font.spacing; x++ )
+        {
+            int dotCol = col + (int)width + x;
+
+            for ( uint8_t y = 0; y < font.height; y++ )
+            {
+                int dotRow = row + y;
+                if ( dotCol >= 1 && dotRow >= 1 )
+                {
+                    boolean show = x < glyphWidth && ( ( pgm_read_byte(&data[y * rowBytes + (x >> 3)]) >> (x & 7) ) & 1 );
+                    setDot(dotCol, dotRow, show);
+                }
+            }
+        }
+        width += glyphWidth + font.spacing;
+    }
+    return width;
+}
+
+
+/**
+ * show an image from flash instead of the buffer (a sprite), same size and bit order as the buffer,
+ * e.g. to switch between the frames of an animated sprite; NULL returns to the buffer
+ */
+void FlipTheDot_Layer::setImage_P(const uint8_t *image)
+{
+    if ( image != _image )
+    {
+        _image = image;
+        _markWindow();
+    }
+}
+
+
+/**
+ * compose the whole window again, e.g. after the buffer got changed directly
+ */
+void FlipTheDot_Layer::invalidate()
+{
+    _markWindow();
+}
+
+
+/**
+ * move the top left corner of the window to col, row of the panel, it can be partly or completely outside
+ */
+void FlipTheDot_Layer::setPosition(int col, int row)
+{
+    if ( col == _col && row == _row )
+    {
+        return;
+    }
+
+    // the old and the new area
+    _markWindow();
+    _col = col;
+    _row = row;
+    _markWindow();
+}
+
+
+int FlipTheDot_Layer::getPositionCol()
+{
+    return _col;
+}
+
+int FlipTheDot_Layer::getPositionRow()
+{
+    return _row;
+}
+
+
+/**
+ * show only a part of the image, e.g. a text wider than its place on the panel, see setScroll(...)
+ */
+void FlipTheDot_Layer::setWindow(unsigned int cols, unsigned int rows)
+{
+    _markWindow();
+    _windowCols = cols;
+    _windowRows = rows;
+    _markWindow();
+}
+
+
+/**
+ * image dot at the top left corner of the window, starting at 0, the image repeats on all sides
+ */
+void FlipTheDot_Layer::setScroll(unsigned int col, unsigned int row)
+{
+    col %= _cols;
+    row %= _rows;
+    if ( col != _scrollCol || row != _scrollRow )
+    {
+        _scrollCol = col;
+        _scrollRow = row;
+        _markWindow();
+    }
+}
+
+
+/**
+ * a hidden layer lets the layers below shine thru, toggle it for a blinking layer
+ */
+void FlipTheDot_Layer::setVisible(boolean isVisible)
+{
+    if ( isVisible != _isVisible )
+    {
+        _isVisible = isVisible;
+        _markWindow();
+    }
+}
+
+
+boolean FlipTheDot_Layer::isVisible()
+{
+    return _isVisible;
+}
+
+
+void FlipTheDot_Layer::setMode(uint8_t mode)
+{
+    if ( mode != _mode && mode <= INVERT )
+    {
+        _mode = mode;
+        _markWindow();
+    }
+}
+
+
+uint8_t FlipTheDot_Layer::getMode()
+{
+    return _mode;
+}
+
+
+/**
+ * dot of the window, col and row start at 0 in its top left corner
+ */
+boolean FlipTheDot_Layer::_readWindow(unsigned int col, unsigned int row)
+{
+    col += _scrollCol;
+    row += _scrollRow;
+    col = col >= _cols ? col % _cols : col;
+    row = row >= _rows ? row % _rows : row;
+
+    unsigned int index = row * _rowBytes + (col >> 3);
+    uint8_t value = _image != NULL ? pgm_read_byte(&_image[index]) : ( _buffer != NULL ? _buffer[index] : 0 );
+    return ( value >> (col & 7) ) & 1;
+}
+
+
+/**
+ * mark the panel dot which shows a dot of the image, nothing if it is outside of the window
+ */
+void FlipTheDot_Layer::_markContent(unsigned int col, unsigned int row)
+{
+    // position in the window, the image repeats
+    unsigned int x = (col - 1 + _cols - _scrollCol) % _cols;
+    unsigned int y = (row - 1 + _rows - _scrollRow) % _rows;
+
+    // a window larger than the image shows the dot several times
+    if ( _windowCols > _cols || _windowRows > _rows )
+    {
+        _markWindow();
+    }
+    else if ( x < _windowCols && y < _windowRows )
+    {
+        _markDirty(_col + (int)x, _row + (int)y, _col + (int)x, _row + (int)y);
+    }
+}
+
+
+void FlipTheDot_Layer::_markWindow()
+{
+    if ( _windowCols > 0 && _windowRows > 0 )
+    {
+        _markDirty(_col, _row, _col + (int)_windowCols - 1, _row + (int)_windowRows - 1);
+    }
+}
+
+
+/**
+ * widen the dirty rectangle to cover the area from col1, row1 to col2, row2 of the panel
+ */
+void FlipTheDot_Layer::_markDirty(int col1, int row1, int col2, int row2)
+{
+    if ( !_isDirty )
+    {
+        _isDirty = true;
+        _dirtyCol1 = col1;
+        _dirtyRow1 = row1;
+        _dirtyCol2 = col2;
+        _dirtyRow2 = row2;
+        return;
+    }
+
+    _dirtyCol1 = col1 < _dirtyCol1 ? col1 : _dirtyCol1;
+    _dirtyRow1 = row1 < _dirtyRow1 ? row1 : _dirtyRow1;
+    _dirtyCol2 = col2 > _dirtyCol2 ? col2 : _dirtyCol2;
+    _dirtyRow2 = row2 > _dirtyRow2 ? row2 : _dirtyRow2;
+}
+
+
+
+/**
+ * the controller needs a frame buffer (setFrameBuffer), the compositor owns all of its dots
+ */
+FlipTheDot_Compositor::FlipTheDot_Compositor(FlipTheDot_ColumnRowController &controller)
+{
+    _controller = &controller;
+}
+
+
+/**
+ * add a layer on top of the layers added before
+ */
+boolean FlipTheDot_Compositor::addLayer(FlipTheDot_Layer &layer)
+{
+    if ( _layerCount >= FlipTheDot_Compositor_MAX_LAYERS )
+    {
+        return false;
+    }
+
+    _layers[_layerCount++] = &layer;
+    layer._markWindow();
+    return true;
+}
+
+
+uint8_t FlipTheDot_Compositor::getLayerCount()
+{
+    return _layerCount;
+}
+
+
+/**
+ * state of the dots which are not covered by any layer (default: hidden)
+ */
+void FlipTheDot_Compositor::setBackground(boolean show)
+{
+    if ( show != _background )
+    {
+        _background = show;
+        _isInvalid = true;
+    }
+}
+
+
+/**
+ * compose the whole panel with the next update, e.g. after drawing into the frame buffer directly
+ */
+void FlipTheDot_Compositor::invalidate()
+{
+    _isInvalid = true;
+}
+
+
+/**
+ * compose the dirty rectangles of all layers into the frame buffer without flushing it
+ */
+void FlipTheDot_Compositor::compose()
+{
+    if ( _isInvalid )
+    {
+        _compose(1, 1, _controller->getColCount(), _controller->getRowCount());
+    }
+
+    for ( uint8_t i = 0; i < _layerCount; i++ )
+    {
+        FlipTheDot_Layer *layer = _layers[i];
+        if ( layer->_isDirty )
+        {
+            if ( !_isInvalid )
+            {
+                _compose(layer->_dirtyCol1, layer->_dirtyRow1, layer->_dirtyCol2, layer->_dirtyRow2);
+            }
+            layer->_isDirty = false;
+        }
+    }
+    _isInvalid = false;
+}
+
+
+/**
+ * compose the changes of the layers and flush them, returns the number of flipped dots
+ */
+unsigned int FlipTheDot_Compositor::update()
+{
+    compose();
+    return _controller->flush();
+}
+
+
+/**
+ * panel dots which have been composed, the CPU time of update() besides the flush grows with it
+ */
+unsigned long FlipTheDot_Compositor::getComposedCount()
+{
+    return _composedCount;
+}
+
+
+void FlipTheDot_Compositor::resetComposedCount()
+{
+    _composedCount = 0;
+}
+
+
+/**
+ * compose the dots from col1, row1 to col2, row2 (inclusive, clipped to the panel) from all layers
+ */
+void FlipTheDot_Compositor::_compose(int col1, int row1, int col2, int row2)
+{
+    int cols = _controller->getColCount();
+    int rows = _controller->getRowCount();
+
+    col1 = col1 < 1 ? 1 : col1;
+    row1 = row1 < 1 ? 1 : row1;
+    col2 = col2 > cols ? cols : col2;
+    row2 = row2 > rows ? rows : row2;
+
+    for ( int row = row1; row <= row2; row++ )
+    {
+        // layers which cover this row
+        FlipTheDot_Layer *covering[FlipTheDot_Compositor_MAX_LAYERS];
+        uint8_t count = 0;
+
+        for ( uint8_t i = 0; i < _layerCount; i++ )
+        {
+            FlipTheDot_Layer *layer = _layers[i];
+            if ( layer->_isVisible && row >= layer->_row && row < layer->_row + (int)layer->_windowRows )
+            {
+                covering[count++] = layer;
+            }
+        }
+
+        for ( int col = col1; col <= col2; col++ )
+        {
+            boolean show = _background;
+
+            for ( uint8_t i = 0; i < count; i++ )
+            {
+                FlipTheDot_Layer *layer = covering[i];
+                if ( col < layer->_col || col >= layer->_col + (int)layer->_windowCols )
+                {
+                    continue;
+                }
+
+                boolean dot = layer->_readWindow(col - layer->_col, row - layer->_row);
+                switch ( layer->_mode )
+                {
+                    case FlipTheDot_Layer::TRANSPARENT:
+                        show = show || dot;
+                        break;
+                    case FlipTheDot_Layer::INVERT:
+                        show = show != dot;
+                        break;
+                    default:
+                        show = dot;
+                }
+            }
+
+            _controller->setDot(col, row, show);
+        }
+        _composedCount += col2 >= col1 ? col2 - col1 + 1 : 0;
+    }
+}
+
+
+
+#endif // FlipTheDot_Compositor_h
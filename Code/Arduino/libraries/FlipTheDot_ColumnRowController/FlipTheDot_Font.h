@@ -0,0 +1,167 @@
+/*
+ * FlipTheDot_Font  -- Fonts in flash for the FlipTheDot_Blitter, FlipTheDot_Ticker and FlipTheDot_Layer
+ *
+ * Every glyph is a bitmap in the layout of the frame buffer: row after row, (width + 7) / 8 bytes per row,
+ * first column in the lowest bit. Glyphs can have different widths (proportional fonts), glyphs with the same
+ * dots can be stored once:
+ *   glyphs   one byte per character (first to first + count - 1), index of its glyph, 0xFF for a missing one
+ *   widths   columns of every glyph
+ *   offsets  position of every glyph in data (16 bit)
+ * The text functions place the glyphs next to each other with spacing hidden columns in between and skip
+ * characters which are not in the font.
+ *
+ * FlipTheDot_Font5x7 is built in, Code/Host/Tools/Assets/AssetConverter creates fonts from BDF files.
+ */
+
+
+#ifndef FlipTheDot_Font_h
+#define FlipTheDot_Font_h
+
+#include "Arduino.h"
+
+
+struct FlipTheDot_Font
+{
+    const uint8_t *data;        // in flash (PROGMEM), the bitmaps of all glyphs
+    const uint16_t *offsets;    // in flash, position of every glyph in data
+    const uint8_t *widths;      // in flash, columns of every glyph
+    const uint8_t *glyphs;      // in flash, glyph of every character, 0xFF: not in the font
+    uint8_t first;              // code of the first character
+    uint8_t count;              // number of characters
+    uint8_t height;             // rows of every glyph
+    uint8_t spacing;            // hidden columns between two glyphs
+};
+
+
+// glyph index of a character which is not in the font
+#define FlipTheDot_Font_MISSING 0xFF
+
+
+// ASCII 32 (space) to 126 (~), 5 columns x 7 rows, one byte per row
+const uint8_t FlipTheDot_Font5x7_DATA[95 * 7] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   // space
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04,   // !
+    0x0A, 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00,   // "
+    0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A,   // #
+    0x04, 0x1E, 0x05, 0x0E, 0x14, 0x0F, 0x04,   // $
+    0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18,   // %
+    0x06, 0x09, 0x05, 0x02, 0x15, 0x09, 0x16,   // &
+    0x06, 0x04, 0x02, 0x00, 0x00, 0x00, 0x00,   // '
+    0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08,   // (
+    0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02,   // )
+    0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00,   // *
+    0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00,   // +
+    0x00, 0x00, 0x00, 0x00, 0x06, 0x04, 0x02,   // ,
+    0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00,   // -
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x06,   // .
+    0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00,   // /
+    0x0E, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0E,   // 0
+    0x04, 0x06, 0x04, 0x04, 0x04, 0x04, 0x0E,   // 1
+    0x0E, 0x11, 0x10, 0x08, 0x04, 0x02, 0x1F,   // 2
+    0x1F, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0E,   // 3
+    0x08, 0x0C, 0x0A, 0x09, 0x1F, 0x08, 0x08,   // 4
+    0x1F, 0x01, 0x0F, 0x10, 0x10, 0x11, 0x0E,   // 5
+    0x0C, 0x02, 0x01, 0x0F, 0x11, 0x11, 0x0E,   // 6
+    0x1F, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02,   // 7
+    0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E,   // 8
+    0x0E, 0x11, 0x11, 0x1E, 0x10, 0x08, 0x06,   // 9
+    0x00, 0x06, 0x06, 0x00, 0x06, 0x06, 0x00,   // :
+    0x00, 0x06, 0x06, 0x00, 0x06, 0x04, 0x02,   // ;
+    0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08,   // <
+    0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00,   // =
+    0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02,   // >
+    0x0E, 0x11, 0x10, 0x08, 0x04, 0x00, 0x04,   // ?
+    0x0E, 0x11, 0x10, 0x16, 0x15, 0x15, 0x0E,   // @
+    0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11,   // A
+    0x0F, 0x11, 0x11, 0x0F, 0x11, 0x11, 0x0F,   // B
+    0x0E, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0E,   // C
+    0x07, 0x09, 0x11, 0x11, 0x11, 0x09, 0x07,   // D
+    0x1F, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x1F,   // E
+    0x1F, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x01,   // F
+    0x0E, 0x11, 0x01, 0x1D, 0x11, 0x11, 0x1E,   // G
+    0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11,   // H
+    0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E,   // I
+    0x1C, 0x08, 0x08, 0x08, 0x08, 0x09, 0x06,   // J
+    0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11,   // K
+    0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1F,   // L
+    0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11,   // M
+    0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11,   // N
+    0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E,   // O
+    0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x01,   // P
+    0x0E, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16,   // Q
+    0x0F, 0x11, 0x11, 0x0F, 0x05, 0x09, 0x11,   // R
+    0x1E, 0x01, 0x01, 0x0E, 0x10, 0x10, 0x0F,   // S
+    0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,   // T
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E,   // U
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04,   // V
+    0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A,   // W
+    0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11,   // X
+    0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04,   // Y
+    0x1F, 0x10, 0x08, 0x04, 0x02, 0x01, 0x1F,   // Z
+    0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E,   // [
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00,   // backslash
+    0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E,   // ]
+    0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00,   // ^
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F,   // _
+    0x02, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00,   // `
+    0x00, 0x00, 0x0E, 0x10, 0x1E, 0x11, 0x1E,   // a
+    0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x0F,   // b
+    0x00, 0x00, 0x0E, 0x01, 0x01, 0x11, 0x0E,   // c
+    0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1E,   // d
+    0x00, 0x00, 0x0E, 0x11, 0x1F, 0x01, 0x0E,   // e
+    0x0C, 0x12, 0x02, 0x07, 0x02, 0x02, 0x02,   // f
+    0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x0E,   // g
+    0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x11,   // h
+    0x04, 0x00, 0x06, 0x04, 0x04, 0x04, 0x0E,   // i
+    0x08, 0x00, 0x0C, 0x08, 0x08, 0x09, 0x06,   // j
+    0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09,   // k
+    0x06, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E,   // l
+    0x00, 0x00, 0x0B, 0x15, 0x15, 0x11, 0x11,   // m
+    0x00, 0x00, 0x0D, 0x13, 0x11, 0x11, 0x11,   // n
+    0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E,   // o
+    0x00, 0x00, 0x0F, 0x11, 0x0F, 0x01, 0x01,   // p
+    0x00, 0x00, 0x16, 0x19, 0x1E, 0x10, 0x10,   // q
+    0x00, 0x00, 0x0D, 0x13, 0x01, 0x01, 0x01,   // r
+    0x00, 0x00, 0x0E, 0x01, 0x0E, 0x10, 0x0F,   // s
+    0x02, 0x02, 0x07, 0x02, 0x02, 0x12, 0x0C,   // t
+    0x00, 0x00, 0x11, 0x11, 0x11, 0x19, 0x16,   // u
+    0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04,   // v
+    0x00, 0x00, 0x11, 0x11, 0x15, 0x15, 0x0A,   // w
+    0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11,   // x
+    0x00, 0x00, 0x11, 0x11, 0x1E, 0x10, 0x0E,   // y
+    0x00, 0x00, 0x1F, 0x08, 0x04, 0x02, 0x1F,   // z
+    0x08, 0x04, 0x04, 0x02, 0x04, 0x04, 0x08,   // {
+    0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,   // |
+    0x02, 0x04, 0x04, 0x08, 0x04, 0x04, 0x02,   // }
+    0x00, 0x00, 0x02, 0x15, 0x08, 0x00, 0x00    // ~
+};
+
+const uint16_t FlipTheDot_Font5x7_OFFSETS[95] PROGMEM = {
+    0, 7, 14, 21, 28, 35, 42, 49, 56, 63, 70, 77, 84, 91, 98, 105,
+    112, 119, 126, 133, 140, 147, 154, 161, 168, 175, 182, 189, 196, 203, 210, 217,
+    224, 231, 238, 245, 252, 259, 266, 273, 280, 287, 294, 301, 308, 315, 322, 329,
+    336, 343, 350, 357, 364, 371, 378, 385, 392, 399, 406, 413, 420, 427, 434, 441,
+    448, 455, 462, 469, 476, 483, 490, 497, 504, 511, 518, 525, 532, 539, 546, 553,
+    560, 567, 574, 581, 588, 595, 602, 609, 616, 623, 630, 637, 644, 651, 658
+};
+
+const uint8_t FlipTheDot_Font5x7_WIDTHS[95] PROGMEM = {
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5
+};
+
+const uint8_t FlipTheDot_Font5x7_GLYPHS[95] PROGMEM = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+    24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71,
+    72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94
+};
+
+const FlipTheDot_Font FlipTheDot_Font5x7 = { FlipTheDot_Font5x7_DATA, FlipTheDot_Font5x7_OFFSETS, FlipTheDot_Font5x7_WIDTHS,
+    FlipTheDot_Font5x7_GLYPHS, 32, 95, 7, 1 };
+
+
+
+#endif // FlipTheDot_Font_h
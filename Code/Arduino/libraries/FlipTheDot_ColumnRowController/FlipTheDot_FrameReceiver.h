@@ -0,0 +1,309 @@
+/*
+ * FlipTheDot_FrameReceiver Class  -- Decode frames from a serial connection into the frame buffer of a FlipTheDot_ColumnRowController
+ *
+ * Every received byte gets passed to receive(...), which decodes it into a receive buffer of the same size as
+ * the frame buffer. Only a frame with a valid CRC gets copied into the frame buffer of the controller, so a
+ * flushAsync() of FlipTheDot_ColumnRowControllerAsync can walk the frame buffer while the next frame arrives,
+ * and a broken frame never reaches the panel. When a frame is complete, the sketch calls flush() or flushAsync().
+ *
+ *   uint8_t received[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+ *   FlipTheDot_FrameReceiver receiver(controller, received);
+ *
+ * Wire format (all frames start with the sync byte 0xA5 and a type byte):
+ *
+ *   0xA5 'F' <frame buffer bytes> <crc>   full frame, same layout as the frame buffer (row after row,
+ *                                         (cols + 7) / 8 bytes per row, first column in the lowest bit)
+ *   0xA5 'D' <spans> 0x00 0x00 <crc>      delta frame, every span is <gap> <length> and toggles <length> dots
+ *                                         after skipping <gap> unchanged dots, counted row after row from the
+ *                                         first dot or the end of the previous span, a span of length 0 ends the list
+ *
+ * gap and length are unsigned LEB128 numbers (7 bits per byte, lowest bits first, bit 7 set if more bytes follow).
+ * crc is a CRC-8 (polynomial 0x07, start value 0) of all bytes after the type byte.
+ * A delta frame gets applied to the receive buffer, which holds the last valid frame. After a CRC error the
+ * receive buffer is unknown: receive(...) returns FRAME_ERROR and delta frames get ignored (and answered with
+ * FRAME_ERROR as well) until the next full frame arrived, the frame buffer keeps the last valid frame meanwhile.
+ */
+
+
+
+#ifndef FlipTheDot_FrameReceiver_h
+#define FlipTheDot_FrameReceiver_h
+
+
+#include "FlipTheDot_ColumnRowController.h"
+
+
+#define FlipTheDot_FrameReceiver_SYNC  0xA5
+#define FlipTheDot_FrameReceiver_FULL  'F'
+#define FlipTheDot_FrameReceiver_DELTA 'D'
+
+
+class FlipTheDot_FrameReceiver
+{
+    public:
+        enum Result { RECEIVING = 0, FRAME_DONE = 1, FRAME_ERROR = 2 };
+
+        FlipTheDot_FrameReceiver(FlipTheDot_ColumnRowController &controller, uint8_t *buffer);
+        uint8_t receive(uint8_t value);
+        boolean isSynced();
+        unsigned long getFrameCount();
+        unsigned long getErrorCount();
+        static uint8_t crc8(uint8_t crc, uint8_t value);
+    protected:
+        enum State { STATE_SYNC, STATE_TYPE, STATE_FULL, STATE_GAP, STATE_LENGTH, STATE_CRC };
+
+        uint8_t _finish(boolean isValid);
+        void _skip(unsigned long dots);
+        void _toggle(unsigned long dots);
+
+        FlipTheDot_ColumnRowController *_controller;
+        // receive buffer, same layout as the frame buffer of the controller
+        uint8_t *_buffer;
+
+        uint8_t _state = STATE_SYNC;
+        uint8_t _crc = 0;
+        boolean _isFull = false;
+        boolean _isSynced = false;
+        boolean _isValid = true;
+
+        // position in the receive buffer
+        unsigned int _index = 0;
+        unsigned int _col = 0;
+        unsigned int _row = 0;
+
+        // LEB128 number in progress and the gap of the current span
+        unsigned long _number = 0;
+        uint8_t _shift = 0;
+        unsigned long _gap = 0;
+
+        unsigned long _frameCount = 0;
+        unsigned long _errorCount = 0;
+};
+
+
+
+FlipTheDot_FrameReceiver::FlipTheDot_FrameReceiver(FlipTheDot_ColumnRowController &controller, uint8_t *buffer)
+{
+    _controller = &controller;
+    _buffer = buffer;
+}
+
+
+/**
+ * CRC-8 with the polynomial 0x07, used by the sender as well
+ */
+uint8_t FlipTheDot_FrameReceiver::crc8(uint8_t crc, uint8_t value)
+{
+    crc ^= value;
+    for ( uint8_t i = 0; i < 8; i++ )
+    {
+        crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+    return crc;
+}
+
+
+/**
+ * check if the receive buffer matches the sender, false before the first full frame and after an error
+ */
+boolean FlipTheDot_FrameReceiver::isSynced()
+{
+    return _isSynced;
+}
+
+/**
+ * get the number of received frames with a valid CRC
+ */
+unsigned long FlipTheDot_FrameReceiver::getFrameCount()
+{
+    return _frameCount;
+}
+
+/**
+ * get the number of frames with an invalid CRC or content
+ */
+unsigned long FlipTheDot_FrameReceiver::getErrorCount()
+{
+    return _errorCount;
+}
+
+
+/**
+ * decode the next received byte
+ * returns FRAME_DONE when a frame is complete and copied into the frame buffer (it can be flushed now),
+ * FRAME_ERROR for a broken frame (the sender should send a full frame) and RECEIVING otherwise
+ */
+uint8_t FlipTheDot_FrameReceiver::receive(uint8_t value)
+{
+    switch ( _state )
+    {
+        case STATE_SYNC:
+            if ( value == FlipTheDot_FrameReceiver_SYNC )
+            {
+                _state = STATE_TYPE;
+            }
+            return RECEIVING;
+
+        case STATE_TYPE:
+            _crc = 0;
+            _index = 0;
+            _col = 0;
+            _row = 0;
+            _number = 0;
+            _shift = 0;
+            _isValid = _buffer != NULL && _controller->getFrameBuffer() != NULL;
+
+            if ( value == FlipTheDot_FrameReceiver_FULL )
+            {
+                _isFull = true;
+                _state = STATE_FULL;
+            }
+            else if ( value == FlipTheDot_FrameReceiver_DELTA )
+            {
+                _isFull = false;
+                _state = STATE_GAP;
+            }
+            else
+            {
+                _state = value == FlipTheDot_FrameReceiver_SYNC ? STATE_TYPE : STATE_SYNC;
+            }
+            return RECEIVING;
+
+        case STATE_FULL:
+            _crc = crc8(_crc, value);
+            if ( _isValid )
+            {
+                // the unused bits behind the last column of a row stay 0, like in the shadow of the controller
+                unsigned int cols = _controller->getColCount();
+                boolean isLastByte = _index % ((cols + 7) / 8) == (cols - 1) / 8;
+                _buffer[_index] = isLastByte && cols % 8 != 0 ? value & ((1 << (cols % 8)) - 1) : value;
+            }
+            if ( ++_index >= (unsigned int)FlipTheDot_ColumnRowController_BUFFER_SIZE(_controller->getColCount(), _controller->getRowCount()) )
+            {
+                _state = STATE_CRC;
+            }
+            return RECEIVING;
+
+        case STATE_GAP:
+        case STATE_LENGTH:
+            _crc = crc8(_crc, value);
+            if ( _shift < 32 )
+            {
+                _number |= (unsigned long)(value & 0x7F) << _shift;
+            }
+            _shift += 7;
+            if ( value & 0x80 )
+            {
+                return RECEIVING;
+            }
+
+            if ( _state == STATE_GAP )
+            {
+                _gap = _number;
+                _state = STATE_LENGTH;
+            }
+            else if ( _number == 0 )
+            {
+                _state = STATE_CRC;
+            }
+            else
+            {
+                // an unsynced receive buffer would get even more wrong by toggling
+                if ( _isSynced && _isValid )
+                {
+                    _skip(_gap);
+                    _toggle(_number);
+                }
+                _state = STATE_GAP;
+            }
+            _number = 0;
+            _shift = 0;
+            return RECEIVING;
+
+        case STATE_CRC:
+            _state = STATE_SYNC;
+            return _finish( _isValid && value == _crc );
+    }
+
+    _state = STATE_SYNC;
+    return RECEIVING;
+}
+
+
+uint8_t FlipTheDot_FrameReceiver::_finish(boolean isValid)
+{
+    if ( !isValid )
+    {
+        // the spans of a broken delta frame may be applied already
+        _isSynced = false;
+        _errorCount++;
+        return FRAME_ERROR;
+    }
+
+    if ( _isFull )
+    {
+        _isSynced = true;
+    }
+    else if ( !_isSynced )
+    {
+        // the delta was ignored, the sender has to send a full frame
+        return FRAME_ERROR;
+    }
+
+    // an interrupt of FlipTheDot_ColumnRowControllerAsync must not walk a half copied frame
+    noInterrupts();
+    memcpy(_controller->getFrameBuffer(), _buffer, FlipTheDot_ColumnRowController_BUFFER_SIZE(_controller->getColCount(), _controller->getRowCount()));
+    interrupts();
+
+    _frameCount++;
+    return FRAME_DONE;
+}
+
+
+/**
+ * move the position over unchanged dots
+ */
+void FlipTheDot_FrameReceiver::_skip(unsigned long dots)
+{
+    unsigned int cols = _controller->getColCount();
+
+    _row += dots / cols;
+    _col += dots % cols;
+    if ( _col >= cols )
+    {
+        _col -= cols;
+        _row++;
+    }
+}
+
+
+/**
+ * toggle the dots at the position and move behind them
+ */
+void FlipTheDot_FrameReceiver::_toggle(unsigned long dots)
+{
+    unsigned int cols = _controller->getColCount();
+    unsigned int rows = _controller->getRowCount();
+    unsigned int rowBytes = (cols + 7) / 8;
+
+    for ( ; dots > 0; dots-- )
+    {
+        if ( _row >= rows )
+        {
+            _isValid = false;
+            return;
+        }
+
+        _buffer[_row * rowBytes + (_col >> 3)] ^= 1 << (_col & 7);
+
+        if ( ++_col >= cols )
+        {
+            _col = 0;
+            _row++;
+        }
+    }
+}
+
+
+
+#endif // FlipTheDot_FrameReceiver_h
@@ -0,0 +1,430 @@
+/*
+ * FlipTheDot_PanelState Class  -- Remember the shown frame across resets
+ *
+ * After a reset the controller does not know which dots are shown, so the first flush pulses every dot.
+ * A panel state attached with setPanelState(...) of the controller keeps the shown frame in a non-volatile memory
+ * (e.g. the EEPROM, see FlipTheDot_PanelStateEEPROM). On the next start setPanelState(...) loads it into the
+ * frame buffer and its shadow, so the first flush only pulses the dots which differ from the new content.
+ * setPanelState(...) needs #define FlipTheDot_ColumnRowController_PANEL_STATE before the controller gets included.
+ *
+ * The memory region gets split into slots of FlipTheDot_PanelState_SLOT_SIZE(cols, rows) bytes, which are
+ * written in turns (wear levelling). Every flush writes the new frame into the next slot and marks it as
+ * pending before the first pulse, and marks it as committed afterwards. Only bytes which differ from the
+ * current content of the memory get written. A flush which does not change any dot writes nothing.
+ * If the reset interrupted a flush, the dots are somewhere between the committed and the pending frame:
+ * setPanelState(...) loads both and pulses the differing dots once more.
+ *
+ * Slot: <sequence: 2> <status> <CRC-16: 2> <frame buffer bytes>
+ *   the sequence number increases with every written slot, the newest slot is the current state
+ *   status PENDING, COMMITTED or INVALID (the stored frame does not match the panel any more)
+ *   the CRC (CCITT, start value 0xFFFF) covers the sequence number and the frame, the sequence number gets
+ *   written last: a slot cut by a reset keeps its old sequence number or fails the CRC check
+ *
+ * Pulses which do not go thru flush() (flip, flipRow, flipColumn, flushAsync, queue, the animation player,
+ * the scheduler) make the stored state invalid once, until the next flush() stores the frame again.
+ *
+ * Every written byte of an AVR EEPROM takes about 3.3 ms, which adds to the flush: a changed 28x13 frame
+ * (59 bytes) costs about 195 ms. The EEPROM of an ATmega328P lasts about 100000 writes per byte, more slots
+ * spread them over more bytes, but the status byte of every slot gets written at every save. Content which
+ * flushes several times per second (ticker, animation, compositor, scheduler) must not save every frame: either
+ * do not attach a panel state or limit the saves with setSaveInterval(...). A flush within the interval marks the
+ * stored state invalid and writes nothing else, the next flush after the interval (also one without changed
+ * dots) stores the frame again.
+ */
+
+
+#ifndef FlipTheDot_PanelState_h
+#define FlipTheDot_PanelState_h
+
+#include "Arduino.h"
+
+
+// bytes of one slot for a panel with the given size (same layout as the frame buffer plus 5 bytes)
+#define FlipTheDot_PanelState_SLOT_SIZE(cols, rows) ( (((cols) + 7) / 8) * (rows) + 5 )
+
+#define FlipTheDot_PanelState_PENDING   0x50
+#define FlipTheDot_PanelState_COMMITTED 0xC0
+#define FlipTheDot_PanelState_INVALID   0x00
+
+
+
+class FlipTheDot_PanelState
+{
+    public:
+        // result of loading the state
+        enum Status { NONE = 0, COMMITTED = 1, PENDING = 2 };
+
+        FlipTheDot_PanelState(unsigned int address, unsigned int length);
+        virtual ~FlipTheDot_PanelState() {};
+        void invalidate();
+        boolean isValid();
+        void setSaveInterval(unsigned long intervalMillis);
+        unsigned long getSaveInterval();
+        unsigned long getSkippedCount();
+        uint8_t getSlotCount();
+        unsigned long getWriteCount();
+        static uint16_t crc16(uint16_t crc, uint8_t value);
+
+    protected:
+        // the controller loads, saves and commits the frames
+        friend class FlipTheDot_ColumnRowController;
+
+        // access to the memory, address is relative to the start of the memory
+        virtual uint8_t _read(unsigned int address) = 0;
+        virtual void _write(unsigned int address, uint8_t value) = 0;
+
+        uint8_t _attach(uint8_t *frame, uint8_t *shadow, unsigned int size);
+        void _save(const uint8_t *frame, const uint8_t *shadow);
+        void _commit();
+
+        void _writeByte(unsigned int address, uint8_t value);
+        unsigned int _slotAddress(uint8_t slot);
+        boolean _isSlotValid(uint8_t slot, uint16_t &sequence, uint8_t &status);
+        boolean _isSlotEqual(uint8_t slot, const uint8_t *frame);
+        void _readSlot(uint8_t slot, uint8_t *frame);
+        void _writeSlot(const uint8_t *frame, uint8_t status);
+
+        unsigned int _address;
+        unsigned int _length;
+        unsigned int _size = 0;
+        uint8_t _slotCount = 0;
+
+        // newest slot
+        uint8_t _slot = 0;
+        uint16_t _sequence = 0;
+        uint8_t _status = FlipTheDot_PanelState_INVALID;
+
+        unsigned long _saveIntervalMillis = 0;
+        unsigned long _savedMillis = 0;
+        bool _hasSaved = false;
+
+        unsigned long _writeCount = 0;
+        unsigned long _skippedCount = 0;
+};
+
+
+/**
+ * use length bytes of the memory, starting at address
+ * at least two slots have to fit, see FlipTheDot_PanelState_SLOT_SIZE(cols, rows)
+ */
+FlipTheDot_PanelState::FlipTheDot_PanelState(unsigned int address, unsigned int length)
+{
+    _address = address;
+    _length = length;
+}
+
+
+/**
+ * forget the stored state, the next start pulses every dot
+ */
+void FlipTheDot_PanelState::invalidate()
+{
+    if ( _slotCount > 0 && _status != FlipTheDot_PanelState_INVALID )
+    {
+        _writeByte(_slotAddress(_slot) + 2, FlipTheDot_PanelState_INVALID);
+        _status = FlipTheDot_PanelState_INVALID;
+    }
+}
+
+
+/**
+ * check if the stored frame matches the panel
+ */
+boolean FlipTheDot_PanelState::isValid()
+{
+    return _status == FlipTheDot_PanelState_COMMITTED;
+}
+
+
+/**
+ * store at most one frame per intervalMillis, the flushes in between leave the stored state invalid
+ * 0 (default) stores every flush which changes dots
+ */
+void FlipTheDot_PanelState::setSaveInterval(unsigned long intervalMillis)
+{
+    _saveIntervalMillis = intervalMillis;
+}
+
+/**
+ * get save interval
+ */
+unsigned long FlipTheDot_PanelState::getSaveInterval()
+{
+    return _saveIntervalMillis;
+}
+
+/**
+ * get the number of flushes which were not stored because of the save interval
+ */
+unsigned long FlipTheDot_PanelState::getSkippedCount()
+{
+    return _skippedCount;
+}
+
+
+/**
+ * get the number of slots, 0 before the state was attached to a controller
+ */
+uint8_t FlipTheDot_PanelState::getSlotCount()
+{
+    return _slotCount;
+}
+
+
+/**
+ * get the number of written bytes (bytes which already had the value are not written)
+ */
+unsigned long FlipTheDot_PanelState::getWriteCount()
+{
+    return _writeCount;
+}
+
+
+/**
+ * CRC-16 with the polynomial 0x1021 (CCITT)
+ */
+uint16_t FlipTheDot_PanelState::crc16(uint16_t crc, uint8_t value)
+{
+    crc ^= (uint16_t)value << 8;
+    for ( uint8_t i = 0; i < 8; i++ )
+    {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+
+/**
+ * find the newest slot and load it into the buffers of the controller (size bytes each)
+ * COMMITTED: frame and shadow get the shown frame
+ * PENDING: shadow gets the committed frame, frame the frame of the interrupted flush
+ * NONE: no valid state, the buffers stay unchanged
+ */
+uint8_t FlipTheDot_PanelState::_attach(uint8_t *frame, uint8_t *shadow, unsigned int size)
+{
+    _size = size;
+    _slotCount = _length / (size + 5) > 255 ? 255 : _length / (size + 5);
+    _status = FlipTheDot_PanelState_INVALID;
+
+    if ( _slotCount < 2 )
+    {
+        #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_PanelState memory too small for two slots") );
+        #endif
+        _slotCount = 0;
+        return NONE;
+    }
+
+    boolean isFound = false;
+    for ( uint8_t slot = 0; slot < _slotCount; slot++ )
+    {
+        uint16_t sequence;
+        uint8_t status;
+
+        // compare the sequence numbers with overflow, the newest one wins
+        if ( _isSlotValid(slot, sequence, status) && ( !isFound || (int16_t)(sequence - _sequence) > 0 ) )
+        {
+            _slot = slot;
+            _sequence = sequence;
+            _status = status;
+            isFound = true;
+        }
+    }
+
+    if ( !isFound )
+    {
+        _slot = _slotCount - 1;
+        return NONE;
+    }
+
+    if ( _status == FlipTheDot_PanelState_COMMITTED )
+    {
+        _readSlot(_slot, frame);
+        memcpy(shadow, frame, size);
+        return COMMITTED;
+    }
+
+    // the committed frame before an interrupted flush is in the previous slot
+    uint8_t previous = _slot > 0 ? _slot - 1 : _slotCount - 1;
+    uint16_t sequence;
+    uint8_t status;
+    if ( _status == FlipTheDot_PanelState_PENDING && _isSlotValid(previous, sequence, status)
+         && sequence == (uint16_t)(_sequence - 1) && status == FlipTheDot_PanelState_COMMITTED )
+    {
+        _readSlot(previous, shadow);
+        _readSlot(_slot, frame);
+        return PENDING;
+    }
+
+    return NONE;
+}
+
+
+/**
+ * store the frame of the next flush as pending, shadow is NULL if the shown frame is unknown
+ */
+void FlipTheDot_PanelState::_save(const uint8_t *frame, const uint8_t *shadow)
+{
+    if ( _slotCount == 0 )
+    {
+        return;
+    }
+
+    // nothing to pulse, the committed frame stays valid
+    if ( _status == FlipTheDot_PanelState_COMMITTED && shadow != NULL && memcmp(frame, shadow, _size) == 0 )
+    {
+        return;
+    }
+
+    // continue an interrupted flush of the same frame
+    if ( _status == FlipTheDot_PanelState_PENDING && _isSlotEqual(_slot, frame) )
+    {
+        return;
+    }
+
+    // too early after the last save, one status byte instead of a slot
+    if ( _saveIntervalMillis > 0 && _hasSaved && millis() - _savedMillis < _saveIntervalMillis )
+    {
+        invalidate();
+        _skippedCount++;
+        return;
+    }
+    _savedMillis = millis();
+    _hasSaved = true;
+
+    // the panel already shows the frame (e.g. the first flush after skipped saves)
+    if ( shadow != NULL && memcmp(frame, shadow, _size) == 0 )
+    {
+        _writeSlot(frame, FlipTheDot_PanelState_COMMITTED);
+        return;
+    }
+
+    // the frame which is shown right now becomes the base for the pending frame
+    if ( _status != FlipTheDot_PanelState_COMMITTED && shadow != NULL )
+    {
+        _writeSlot(shadow, FlipTheDot_PanelState_COMMITTED);
+    }
+
+    _writeSlot(frame, FlipTheDot_PanelState_PENDING);
+}
+
+
+/**
+ * mark the pending frame as shown
+ */
+void FlipTheDot_PanelState::_commit()
+{
+    if ( _slotCount > 0 && _status == FlipTheDot_PanelState_PENDING )
+    {
+        _writeByte(_slotAddress(_slot) + 2, FlipTheDot_PanelState_COMMITTED);
+        _status = FlipTheDot_PanelState_COMMITTED;
+    }
+}
+
+
+void FlipTheDot_PanelState::_writeByte(unsigned int address, uint8_t value)
+{
+    if ( _read(address) != value )
+    {
+        _write(address, value);
+        _writeCount++;
+    }
+}
+
+
+unsigned int FlipTheDot_PanelState::_slotAddress(uint8_t slot)
+{
+    return _address + slot * (_size + 5);
+}
+
+
+/**
+ * read sequence number and status of a slot, false for an empty slot or a wrong CRC
+ * INVALID slots count without CRC check, they hide all older slots
+ */
+boolean FlipTheDot_PanelState::_isSlotValid(uint8_t slot, uint16_t &sequence, uint8_t &status)
+{
+    unsigned int address = _slotAddress(slot);
+
+    sequence = _read(address) | (uint16_t)_read(address + 1) << 8;
+    status = _read(address + 2);
+
+    if ( status == FlipTheDot_PanelState_INVALID )
+    {
+        return true;
+    }
+    if ( status != FlipTheDot_PanelState_PENDING && status != FlipTheDot_PanelState_COMMITTED )
+    {
+        return false;
+    }
+
+    uint16_t crc = crc16(crc16(0xFFFF, sequence), sequence >> 8);
+    for ( unsigned int i = 0; i < _size; i++ )
+    {
+        crc = crc16(crc, _read(address + 5 + i));
+    }
+    return crc == ( _read(address + 3) | (uint16_t)_read(address + 4) << 8 );
+}
+
+
+boolean FlipTheDot_PanelState::_isSlotEqual(uint8_t slot, const uint8_t *frame)
+{
+    unsigned int address = _slotAddress(slot) + 5;
+
+    for ( unsigned int i = 0; i < _size; i++ )
+    {
+        if ( _read(address + i) != frame[i] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void FlipTheDot_PanelState::_readSlot(uint8_t slot, uint8_t *frame)
+{
+    unsigned int address = _slotAddress(slot) + 5;
+
+    for ( unsigned int i = 0; i < _size; i++ )
+    {
+        frame[i] = _read(address + i);
+    }
+}
+
+
+/**
+ * write the frame into the next slot, the new sequence number comes last
+ * a reset before it leaves the slot with its older sequence number or a wrong CRC, the previous slot stays the
+ * newest one, so the slot needs no INVALID status while it gets written
+ */
+void FlipTheDot_PanelState::_writeSlot(const uint8_t *frame, uint8_t status)
+{
+    uint8_t slot = _slot + 1 < _slotCount ? _slot + 1 : 0;
+    unsigned int address = _slotAddress(slot);
+    uint16_t sequence = _sequence + 1;
+
+    uint16_t crc = crc16(crc16(0xFFFF, sequence), sequence >> 8);
+    for ( unsigned int i = 0; i < _size; i++ )
+    {
+        crc = crc16(crc, frame[i]);
+    }
+
+    for ( unsigned int i = 0; i < _size; i++ )
+    {
+        _writeByte(address + 5 + i, frame[i]);
+    }
+    _writeByte(address + 3, crc);
+    _writeByte(address + 4, crc >> 8);
+    _writeByte(address + 2, status);
+    _writeByte(address, sequence);
+    _writeByte(address + 1, sequence >> 8);
+
+    _slot = slot;
+    _sequence = sequence;
+    _status = status;
+}
+
+
+
+#endif // FlipTheDot_PanelState_h
@@ -0,0 +1,42 @@
+/*
+ * FlipTheDot_PanelStateEEPROM Class  -- Keep the panel state in the EEPROM of the microcontroller
+ *
+ * Example for a 28x13 panel with 8 slots (8 x 57 bytes) at the start of the EEPROM, with
+ * #define FlipTheDot_ColumnRowController_PANEL_STATE before including FlipTheDot_ColumnRowController.h:
+ *   FlipTheDot_PanelStateEEPROM panelState(0, 8 * FlipTheDot_PanelState_SLOT_SIZE(28, 13));
+ *   controller.setFrameBuffer(frame, shadow);
+ *   controller.setPanelState(&panelState);
+ *
+ * See FlipTheDot_PanelState.h for the details.
+ */
+
+
+#ifndef FlipTheDot_PanelStateEEPROM_h
+#define FlipTheDot_PanelStateEEPROM_h
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "FlipTheDot_PanelState.h"
+
+
+
+class FlipTheDot_PanelStateEEPROM : public FlipTheDot_PanelState
+{
+    public:
+        FlipTheDot_PanelStateEEPROM(unsigned int address, unsigned int length) : FlipTheDot_PanelState(address, length) {};
+
+    protected:
+        uint8_t _read(unsigned int address)
+        {
+            return EEPROM.read(address);
+        }
+
+        void _write(unsigned int address, uint8_t value)
+        {
+            EEPROM.write(address, value);
+        }
+};
+
+
+
+#endif // FlipTheDot_PanelStateEEPROM_h
@@ -0,0 +1,365 @@
+/*
+ * FlipTheDot_PowerBudget Class  -- Limit the average current of the FP2800a ICs and the dot coils
+ *
+ * Every coil pulse moves a charge of pulse current x pulse length thru one column IC, one row IC and one coil
+ * (e.g. 350 mA for 100 µs = 35 µC). The budget keeps a heat bucket per IC and optionally per coil:
+ * each pulse fills the buckets of the used ICs and coil, the buckets cool down with a configurable average
+ * current. A pulse has to wait until all of its buckets have room for it, so the flips run as fast as the
+ * sustained average current allows, with bursts up to the bucket size.
+ *
+ * The ICs are counted per side with 28 lines each (column IC 1 drives the columns 1 to 28 and so on).
+ * The two row ICs of a FlipTheDot_FP2800aFixed share one bucket, which is on the safe side.
+ *
+ * Example (the define before including FlipTheDot_ColumnRowController.h):
+ *   #define FlipTheDot_ColumnRowController_POWER_BUDGET
+ *   FlipTheDot_PowerBudget budget(28, 13);
+ *   budget.setChipBudget(120, 350);  // 120 mA average, bursts of 10 pulses
+ *   controller.setPowerBudget(&budget);
+ */
+
+
+
+#ifndef FlipTheDot_PowerBudget_h
+#define FlipTheDot_PowerBudget_h
+
+
+#include "Arduino.h"
+
+
+// maximum number of column plus row ICs
+#ifndef FlipTheDot_PowerBudget_MAX_CHIPS
+#define FlipTheDot_PowerBudget_MAX_CHIPS 8
+#endif
+
+
+class FlipTheDot_PowerBudget
+{
+    public:
+        FlipTheDot_PowerBudget(unsigned int cols, unsigned int rows, unsigned int pulseMilliamps);
+        void setPulseCurrent(unsigned int pulseMilliamps);
+        unsigned int getPulseCurrent();
+        void setChipBudget(unsigned int averageMilliamps, unsigned int burstMicrocoulombs);
+        void setCoilBudget(unsigned int averageMilliamps, uint8_t burstMicrocoulombs, uint8_t *coilHeat);
+        unsigned long getWaitMicros(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros);
+        void addPulse(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros);
+        void reset();
+        unsigned long getPulseCount();
+        unsigned long getThrottledCount();
+    protected:
+        unsigned int _getCharge(unsigned int pulseMicros);
+        unsigned int _cool(unsigned long &since, unsigned int averageMilliamps);
+        void _coolChips();
+        void _coolCoils();
+        unsigned long _getWait(unsigned int heat, unsigned long charge, unsigned int burst, unsigned int averageMilliamps);
+
+        unsigned int _cols;
+        unsigned int _rows;
+        uint8_t _colChips;
+        uint8_t _chips;
+        unsigned int _pulseMilliamps;
+
+        // charge in µC which is still "warm" in every IC, column ICs first
+        uint16_t _chipHeat[FlipTheDot_PowerBudget_MAX_CHIPS];
+        unsigned int _chipAverageMilliamps = 0;
+        unsigned int _chipBurst = 0;
+        unsigned long _chipCooledMicros = 0;
+
+        // one byte per dot (row after row), provided by the sketch
+        uint8_t *_coilHeat = NULL;
+        unsigned int _coilAverageMilliamps = 0;
+        uint8_t _coilBurst = 0;
+        unsigned long _coilCooledMicros = 0;
+
+        unsigned long _pulseCount = 0;
+        unsigned long _throttledCount = 0;
+        bool _isThrottled = false;
+};
+
+
+
+FlipTheDot_PowerBudget::FlipTheDot_PowerBudget(unsigned int cols, unsigned int rows, unsigned int pulseMilliamps = 350)
+{
+    _cols = cols;
+    _rows = rows;
+    _colChips = (cols + 27) / 28;
+    _chips = _colChips + (rows + 27) / 28;
+    if ( _chips > FlipTheDot_PowerBudget_MAX_CHIPS )
+    {
+        _chips = FlipTheDot_PowerBudget_MAX_CHIPS;
+    }
+    _pulseMilliamps = pulseMilliamps;
+
+    reset();
+}
+
+
+/**
+ * define the current of one coil pulse
+ */
+void FlipTheDot_PowerBudget::setPulseCurrent(unsigned int pulseMilliamps)
+{
+    _pulseMilliamps = pulseMilliamps;
+}
+
+/**
+ * get pulse current
+ */
+unsigned int FlipTheDot_PowerBudget::getPulseCurrent()
+{
+    return _pulseMilliamps;
+}
+
+
+/**
+ * limit every IC to an average current and a burst of charge (µC = mA x ms), 0 mA disables the limit
+ */
+void FlipTheDot_PowerBudget::setChipBudget(unsigned int averageMilliamps, unsigned int burstMicrocoulombs)
+{
+    _chipAverageMilliamps = averageMilliamps;
+    _chipBurst = burstMicrocoulombs;
+    _chipCooledMicros = micros();
+}
+
+
+/**
+ * limit every coil to an average current and a burst of charge, 0 mA disables the limit
+ * coilHeat needs one byte per dot (cols x rows)
+ */
+void FlipTheDot_PowerBudget::setCoilBudget(unsigned int averageMilliamps, uint8_t burstMicrocoulombs, uint8_t *coilHeat)
+{
+    _coilAverageMilliamps = coilHeat != NULL ? averageMilliamps : 0;
+    _coilBurst = burstMicrocoulombs;
+    _coilHeat = coilHeat;
+    _coilCooledMicros = micros();
+
+    if ( _coilHeat != NULL )
+    {
+        memset(_coilHeat, 0, _cols * _rows);
+    }
+}
+
+
+/**
+ * forget the heat of all ICs and coils and reset the statistics
+ */
+void FlipTheDot_PowerBudget::reset()
+{
+    memset(_chipHeat, 0, sizeof(_chipHeat));
+    if ( _coilHeat != NULL )
+    {
+        memset(_coilHeat, 0, _cols * _rows);
+    }
+    _chipCooledMicros = micros();
+    _coilCooledMicros = _chipCooledMicros;
+
+    _pulseCount = 0;
+    _throttledCount = 0;
+    _isThrottled = false;
+}
+
+
+/**
+ * get the number of pulses added to the budget
+ */
+unsigned long FlipTheDot_PowerBudget::getPulseCount()
+{
+    return _pulseCount;
+}
+
+/**
+ * get the number of pulses which had to wait for the budget
+ */
+unsigned long FlipTheDot_PowerBudget::getThrottledCount()
+{
+    return _throttledCount;
+}
+
+
+unsigned int FlipTheDot_PowerBudget::_getCharge(unsigned int pulseMicros)
+{
+    unsigned long charge = (unsigned long)_pulseMilliamps * pulseMicros / 1000;
+    return charge > 0 ? charge : 1;
+}
+
+
+/**
+ * get the charge which cooled down since the given time with the average current
+ * the time only moves forward by the returned charge, so no fraction gets lost
+ */
+unsigned int FlipTheDot_PowerBudget::_cool(unsigned long &since, unsigned int averageMilliamps)
+{
+    unsigned long elapsed = micros() - since;
+
+    // everything is cold after a minute
+    if ( elapsed > 60000000UL )
+    {
+        since += elapsed;
+        return 0xFFFF;
+    }
+
+    unsigned long cooled = (elapsed / 1000) * averageMilliamps + (elapsed % 1000) * averageMilliamps / 1000;
+    if ( cooled > 0xFFFF )
+    {
+        cooled = 0xFFFF;
+    }
+    since += cooled * 1000 / averageMilliamps;
+
+    return cooled;
+}
+
+
+void FlipTheDot_PowerBudget::_coolChips()
+{
+    unsigned int cooled = _cool(_chipCooledMicros, _chipAverageMilliamps);
+
+    for ( uint8_t i = 0; i < _chips && cooled > 0; i++ )
+    {
+        _chipHeat[i] = _chipHeat[i] > cooled ? _chipHeat[i] - cooled : 0;
+    }
+}
+
+
+/**
+ * walks all dots, so it only runs when a coil is too warm or a few milliseconds passed
+ */
+void FlipTheDot_PowerBudget::_coolCoils()
+{
+    unsigned int cooled = _cool(_coilCooledMicros, _coilAverageMilliamps);
+    uint8_t step = cooled > 0xFF ? 0xFF : cooled;
+
+    for ( unsigned int i = 0; i < _cols * _rows && step > 0; i++ )
+    {
+        _coilHeat[i] = _coilHeat[i] > step ? _coilHeat[i] - step : 0;
+    }
+}
+
+
+/**
+ * time until a bucket has room for the charge
+ */
+unsigned long FlipTheDot_PowerBudget::_getWait(unsigned int heat, unsigned long charge, unsigned int burst, unsigned int averageMilliamps)
+{
+    // a pulse larger than the burst has to wait for an empty bucket
+    unsigned long limit = charge > burst ? charge : burst;
+
+    if ( heat + charge <= limit )
+    {
+        return 0;
+    }
+    return ( (heat + charge - limit) * 1000UL + averageMilliamps - 1 ) / averageMilliamps;
+}
+
+
+/**
+ * get the time to wait before the dot(s) may be pulsed, 0 if the pulse fits into the budget
+ * colMask selects several columns (col, col + 28, col + 56, ...) for ICs which are enabled together
+ */
+unsigned long FlipTheDot_PowerBudget::getWaitMicros(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros)
+{
+    unsigned long wait = 0;
+    unsigned int charge = _getCharge(pulseMicros);
+    uint8_t count = 0;
+
+    if ( _chipAverageMilliamps > 0 )
+    {
+        _coolChips();
+    }
+
+    for ( uint8_t i = 0; i < 32; i++ )
+    {
+        if ( ( (colMask >> i) & 1 ) == 0 )
+        {
+            continue;
+        }
+        count++;
+
+        unsigned int c = col + i * 28;
+        if ( _chipAverageMilliamps > 0 )
+        {
+            uint8_t chip = (c - 1) / 28;
+            if ( chip < _chips )
+            {
+                unsigned long chipWait = _getWait(_chipHeat[chip], charge, _chipBurst, _chipAverageMilliamps);
+                wait = chipWait > wait ? chipWait : wait;
+            }
+        }
+
+        if ( _coilAverageMilliamps > 0 && c <= _cols && row <= _rows )
+        {
+            unsigned int index = (row - 1) * _cols + c - 1;
+
+            if ( micros() - _coilCooledMicros > 4000 || (unsigned long)_coilHeat[index] + charge > _coilBurst )
+            {
+                _coolCoils();
+            }
+            unsigned long coilWait = _getWait(_coilHeat[index], charge, _coilBurst, _coilAverageMilliamps);
+            wait = coilWait > wait ? coilWait : wait;
+        }
+    }
+
+    // the row line carries the current of all columns
+    uint8_t rowChip = _colChips + (row - 1) / 28;
+    if ( _chipAverageMilliamps > 0 && rowChip < _chips )
+    {
+        unsigned long rowWait = _getWait(_chipHeat[rowChip], (unsigned long)charge * count, _chipBurst, _chipAverageMilliamps);
+        wait = rowWait > wait ? rowWait : wait;
+    }
+
+    if ( wait > 0 )
+    {
+        _isThrottled = true;
+    }
+    return wait;
+}
+
+
+/**
+ * account a pulse of the dot(s), call it right before the pulse
+ */
+void FlipTheDot_PowerBudget::addPulse(unsigned int col, unsigned int row, unsigned long colMask, unsigned int pulseMicros)
+{
+    unsigned int charge = _getCharge(pulseMicros);
+    uint8_t count = 0;
+
+    for ( uint8_t i = 0; i < 32; i++ )
+    {
+        if ( ( (colMask >> i) & 1 ) == 0 )
+        {
+            continue;
+        }
+        count++;
+
+        unsigned int c = col + i * 28;
+        uint8_t chip = (c - 1) / 28;
+        if ( chip < _colChips )
+        {
+            unsigned long heat = (unsigned long)_chipHeat[chip] + charge;
+            _chipHeat[chip] = heat > 0xFFFF ? 0xFFFF : heat;
+        }
+
+        if ( _coilHeat != NULL && c <= _cols && row <= _rows )
+        {
+            unsigned int index = (row - 1) * _cols + c - 1;
+            unsigned long heat = (unsigned long)_coilHeat[index] + charge;
+            _coilHeat[index] = heat > 0xFF ? 0xFF : heat;
+        }
+    }
+
+    uint8_t rowChip = _colChips + (row - 1) / 28;
+    if ( rowChip < _chips )
+    {
+        unsigned long heat = (unsigned long)_chipHeat[rowChip] + (unsigned long)charge * count;
+        _chipHeat[rowChip] = heat > 0xFFFF ? 0xFFFF : heat;
+    }
+
+    _pulseCount += count;
+    if ( _isThrottled )
+    {
+        _throttledCount += count;
+        _isThrottled = false;
+    }
+}
+
+
+
+#endif // FlipTheDot_PowerBudget_h
@@ -0,0 +1,235 @@
+/*
+ * FlipTheDot_PulseCalibration Class  -- Pulse length per dot, polarity and supply voltage
+ *
+ * Without a calibration every pulse of the controller takes the same time (setPulseLength), which has to be
+ * long enough for the weakest dot. Most dots flip with much less, coils at the far end of long traces or on
+ * older panels need more. A calibration attached with setPulseCalibration(...) of the controller gives every
+ * dot the pulse length
+ *
+ *   (base of the polarity + extra of the row + extra of the column) x nominal voltage / supply voltage
+ *
+ * limited to the range of setLimits(...). The tables have one byte per row or column with the extra
+ * microseconds, in RAM or in flash (the _P methods), without a table the extra is 0.
+ * The coil current grows with the supply voltage, so a higher voltage needs a shorter pulse for the same
+ * charge. setSupplyVoltage(...) can follow a measured voltage at any time (e.g. analogRead of a divider).
+ *
+ * Finding the values: flip a row or column back and forth with a decreasing pulse length and note the
+ * shortest one which still flips every dot of it, then add a margin of 10 to 20 %.
+ * Code/Host/Tools/PulseCalibrationDemo shows how the tables follow from measured dots.
+ *
+ * Example (the define before including FlipTheDot_ColumnRowController.h):
+ *   #define FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+ *   const uint8_t rowExtra[13] PROGMEM = { 0, 0, 0, 0, 0, 2, 4, 6, 8, 10, 12, 14, 16 };
+ *   FlipTheDot_PulseCalibration calibration(28, 13, 40);   // 40 µs for the best dots
+ *   calibration.setPolarity(40, 50);                        // hiding needs 10 µs more
+ *   calibration.setRowTable_P(rowExtra);
+ *   calibration.setVoltage(24000, 24000);                   // values calibrated at 24 V
+ *   controller.setPulseCalibration(&calibration);
+ */
+
+
+
+#ifndef FlipTheDot_PulseCalibration_h
+#define FlipTheDot_PulseCalibration_h
+
+
+#include "Arduino.h"
+
+
+class FlipTheDot_PulseCalibration
+{
+    public:
+        FlipTheDot_PulseCalibration(unsigned int cols, unsigned int rows, unsigned int pulseLengthMicros);
+        void setPolarity(unsigned int showMicros, unsigned int hideMicros);
+        unsigned int getPolarity(boolean show);
+        void setRowTable(const uint8_t *extraMicros);
+        void setRowTable_P(const uint8_t *extraMicros);
+        void setColumnTable(const uint8_t *extraMicros);
+        void setColumnTable_P(const uint8_t *extraMicros);
+        void setVoltage(unsigned int nominalMillivolts, unsigned int supplyMillivolts);
+        void setSupplyVoltage(unsigned int supplyMillivolts);
+        unsigned int getSupplyVoltage();
+        void setLimits(unsigned int minMicros, unsigned int maxMicros);
+        unsigned int getPulseLength(unsigned int col, unsigned int row, boolean show);
+    protected:
+        uint8_t _readExtra(const uint8_t *table, boolean isProgmem, unsigned int index);
+
+        unsigned int _cols;
+        unsigned int _rows;
+        unsigned int _showMicros;
+        unsigned int _hideMicros;
+
+        const uint8_t *_rowTable = NULL;
+        const uint8_t *_colTable = NULL;
+        bool _isRowProgmem = false;
+        bool _isColProgmem = false;
+
+        unsigned int _nominalMillivolts = 0;
+        unsigned int _supplyMillivolts = 0;
+        // nominal / supply voltage in 1/256
+        unsigned long _scale = 256;
+
+        unsigned int _minMicros = 1;
+        unsigned int _maxMicros = 1000;
+};
+
+
+
+/**
+ * cols and rows of the panel, pulseLengthMicros is the base of both polarities (see setPolarity)
+ */
+FlipTheDot_PulseCalibration::FlipTheDot_PulseCalibration(unsigned int cols, unsigned int rows, unsigned int pulseLengthMicros = 100)
+{
+    _cols = cols;
+    _rows = rows;
+    _showMicros = pulseLengthMicros;
+    _hideMicros = pulseLengthMicros;
+}
+
+
+/**
+ * define the base pulse length for showing and for hiding a dot, at the nominal voltage
+ */
+void FlipTheDot_PulseCalibration::setPolarity(unsigned int showMicros, unsigned int hideMicros)
+{
+    _showMicros = showMicros;
+    _hideMicros = hideMicros;
+}
+
+/**
+ * get base pulse length of a polarity
+ */
+unsigned int FlipTheDot_PulseCalibration::getPolarity(boolean show)
+{
+    return show ? _showMicros : _hideMicros;
+}
+
+
+/**
+ * extra microseconds for every row (one byte per row, first row first), NULL for none
+ * the table stays in use, it must not be a temporary array
+ */
+void FlipTheDot_PulseCalibration::setRowTable(const uint8_t *extraMicros)
+{
+    _rowTable = extraMicros;
+    _isRowProgmem = false;
+}
+
+/**
+ * extra microseconds for every row from a PROGMEM table
+ */
+void FlipTheDot_PulseCalibration::setRowTable_P(const uint8_t *extraMicros)
+{
+    _rowTable = extraMicros;
+    _isRowProgmem = true;
+}
+
+
+/**
+ * extra microseconds for every column (one byte per column, first column first), NULL for none
+ */
+void FlipTheDot_PulseCalibration::setColumnTable(const uint8_t *extraMicros)
+{
+    _colTable = extraMicros;
+    _isColProgmem = false;
+}
+
+/**
+ * extra microseconds for every column from a PROGMEM table
+ */
+void FlipTheDot_PulseCalibration::setColumnTable_P(const uint8_t *extraMicros)
+{
+    _colTable = extraMicros;
+    _isColProgmem = true;
+}
+
+
+/**
+ * the pulse lengths were calibrated at nominalMillivolts, the panel runs at supplyMillivolts
+ */
+void FlipTheDot_PulseCalibration::setVoltage(unsigned int nominalMillivolts, unsigned int supplyMillivolts)
+{
+    _nominalMillivolts = nominalMillivolts;
+    setSupplyVoltage(supplyMillivolts);
+}
+
+
+/**
+ * update the supply voltage, e.g. from a measurement
+ * 0 (or a voltage below half the nominal one) results in the maximum pulse length of setLimits
+ */
+void FlipTheDot_PulseCalibration::setSupplyVoltage(unsigned int supplyMillivolts)
+{
+    _supplyMillivolts = supplyMillivolts;
+
+    if ( _nominalMillivolts == 0 )
+    {
+        _scale = 256;
+    }
+    else if ( supplyMillivolts < _nominalMillivolts / 2 )
+    {
+        _scale = 0xFFFF;
+    }
+    else
+    {
+        _scale = ((unsigned long)_nominalMillivolts * 256 + supplyMillivolts / 2) / supplyMillivolts;
+    }
+}
+
+/**
+ * get supply voltage
+ */
+unsigned int FlipTheDot_PulseCalibration::getSupplyVoltage()
+{
+    return _supplyMillivolts;
+}
+
+
+/**
+ * keep every pulse between minMicros and maxMicros, whatever the tables and the voltage say
+ * (default: 1 to 1000 µs)
+ */
+void FlipTheDot_PulseCalibration::setLimits(unsigned int minMicros, unsigned int maxMicros)
+{
+    _minMicros = minMicros;
+    _maxMicros = maxMicros;
+}
+
+
+/**
+ * get the pulse length for a dot and polarity
+ */
+unsigned int FlipTheDot_PulseCalibration::getPulseLength(unsigned int col, unsigned int row, boolean show)
+{
+    unsigned long pulseMicros = show ? _showMicros : _hideMicros;
+
+    if ( _rowTable != NULL && row >= 1 && row <= _rows )
+    {
+        pulseMicros += _readExtra(_rowTable, _isRowProgmem, row - 1);
+    }
+    if ( _colTable != NULL && col >= 1 && col <= _cols )
+    {
+        pulseMicros += _readExtra(_colTable, _isColProgmem, col - 1);
+    }
+
+    if ( _scale != 256 )
+    {
+        pulseMicros = _scale == 0xFFFF ? _maxMicros : (pulseMicros * _scale + 128) >> 8;
+    }
+
+    if ( pulseMicros < _minMicros )
+    {
+        return _minMicros;
+    }
+    return pulseMicros > _maxMicros ? _maxMicros : pulseMicros;
+}
+
+
+uint8_t FlipTheDot_PulseCalibration::_readExtra(const uint8_t *table, boolean isProgmem, unsigned int index)
+{
+    return isProgmem ? pgm_read_byte(&table[index]) : table[index];
+}
+
+
+
+#endif // FlipTheDot_PulseCalibration_h
@@ -0,0 +1,489 @@
+/*
+ * FlipTheDot_Scheduler Class  -- Pulse the changes of panel regions in the order of their deadlines
+ *
+ * flush() pulses the whole frame buffer in one go, a clock digit which changes while a large animation frame
+ * is being pulsed has to wait for the end of it. The scheduler splits the panel into regions (rectangles with
+ * a priority). The sketch draws into the frame buffer of the controller as usual and calls schedule(...) with
+ * the time until the changed dots of a region have to be shown. update() pulses the changed dots of the
+ * scheduled regions, earliest deadline first (the higher priority on equal deadlines).
+ * The priority decides which region slips when there are more changes than pulses: a region which missed its
+ * deadline goes before all regions with the same or a lower priority, but behind the regions with a higher
+ * priority, so an overloaded animation can not delay a clock digit. Between regions which missed their
+ * deadline, the higher priority wins.
+ *
+ * With a pulse rate limit (setPulseRate) update() pulses at most as many dots as the rate allows since the last
+ * call and returns, so loop() stays responsive and a new region schedule(...) preempts a running refresh after
+ * the next pulse. Without a limit update() pulses until all scheduled regions are shown.
+ *
+ * Every region counts its scheduled and completed refreshes, the missed deadlines and the worst latency
+ * (schedule until the last dot) and lateness (deadline until the last dot), see getStatistics(...).
+ *
+ * The shown state has to be known (flush() once, e.g. in setup). Changed dots outside of the scheduled regions
+ * stay in the frame buffer until a region covering them gets scheduled or flush() gets called.
+ *
+ * Example:
+ *   FlipTheDot_Scheduler scheduler(controller);
+ *   int clock = scheduler.addRegion(17, 4, 12, 7, 1);
+ *
+ *   drawSeconds();
+ *   scheduler.schedule(clock, 20000);     // shown within 20 ms
+ *   scheduler.update();                   // in every loop()
+ */
+
+
+#ifndef FlipTheDot_Scheduler_h
+#define FlipTheDot_Scheduler_h
+
+#include "Arduino.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// maximum number of regions of a scheduler
+#ifndef FlipTheDot_Scheduler_MAX_REGIONS
+#define FlipTheDot_Scheduler_MAX_REGIONS 8
+#endif
+
+
+/*
+  Counters of one region, see getStatistics(...).
+*/
+struct FlipTheDot_SchedulerStatistics
+{
+    unsigned long scheduled;         // calls of schedule(...)
+    unsigned long completed;         // refreshes which were shown completely
+    unsigned long replaced;          // refreshes which got scheduled again before they were shown completely
+    unsigned long missed;            // refreshes which were not shown completely at their deadline
+    unsigned long dots;              // pulsed dots
+    unsigned long maxLatencyMicros;  // longest time from schedule(...) until the refresh was shown completely
+    unsigned long maxLatenessMicros; // longest time from the deadline until the refresh was shown completely
+};
+
+
+class FlipTheDot_Scheduler
+{
+    public:
+        FlipTheDot_Scheduler(FlipTheDot_ColumnRowController &controller);
+        int addRegion(unsigned int col, unsigned int row, unsigned int cols, unsigned int rows, uint8_t priority);
+        uint8_t getRegionCount();
+        boolean schedule(uint8_t region, unsigned long deadlineMicros);
+        boolean isPending(uint8_t region);
+        boolean isIdle();
+        void setPulseRate(unsigned int pulsesPerSecond, unsigned int burstPulses);
+        unsigned int update();
+        const FlipTheDot_SchedulerStatistics &getStatistics(uint8_t region);
+        unsigned long getMissedCount();
+        void resetStatistics();
+
+    protected:
+        struct Region
+        {
+            unsigned int col;
+            unsigned int row;
+            unsigned int cols;
+            unsigned int rows;
+            uint8_t priority;
+            bool isPending;
+            bool isMissed;
+            // position of the next dot to check, relative to the region, one pass per refresh
+            unsigned int cursorCol;
+            unsigned int cursorRow;
+            unsigned long scheduledMicros;
+            unsigned long deadlineMicros;
+            unsigned long shownMicros;
+            FlipTheDot_SchedulerStatistics statistics;
+        };
+
+        void _checkDeadlines(unsigned long now);
+        Region *_selectNext();
+        void _completeShown();
+        boolean _nextChanged(Region &region);
+        void _advance(Region &region, unsigned int dots);
+        void _complete(Region &region);
+        void _refill(unsigned long now);
+
+        FlipTheDot_ColumnRowController *_controller;
+
+        Region _regions[FlipTheDot_Scheduler_MAX_REGIONS];
+        uint8_t _regionCount = 0;
+
+        // pulse rate limit as bucket of microseconds, 0 pulses per second: no limit
+        unsigned long _pulseCostMicros = 0;
+        unsigned long _burstMicros = 0;
+        unsigned long _creditMicros = 0;
+        unsigned long _refilledMicros = 0;
+};
+
+
+
+FlipTheDot_Scheduler::FlipTheDot_Scheduler(FlipTheDot_ColumnRowController &controller)
+{
+    _controller = &controller;
+}
+
+
+/**
+ * add a region of cols x rows dots with the top left dot at col, row, a higher priority wins after missed deadlines
+ * regions may overlap, a changed dot gets pulsed by the first scheduled region which reaches it
+ * returns the number of the region for schedule(...), -1 if the region is outside of the panel or there are
+ * already FlipTheDot_Scheduler_MAX_REGIONS regions
+ */
+int FlipTheDot_Scheduler::addRegion(unsigned int col, unsigned int row, unsigned int cols, unsigned int rows, uint8_t priority = 0)
+{
+    if ( _regionCount >= FlipTheDot_Scheduler_MAX_REGIONS || col < 1 || row < 1 || cols < 1 || rows < 1
+        || col + cols - 1 > _controller->getColCount() || row + rows - 1 > _controller->getRowCount() )
+    {
+        #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.println( F("FlipTheDot_Scheduler region out of range or too many regions") );
+        #endif
+        return -1;
+    }
+
+    Region &region = _regions[_regionCount];
+    memset(&region, 0, sizeof(Region));
+    region.col = col;
+    region.row = row;
+    region.cols = cols;
+    region.rows = rows;
+    region.priority = priority;
+    return _regionCount++;
+}
+
+/**
+ * get number of regions
+ */
+uint8_t FlipTheDot_Scheduler::getRegionCount()
+{
+    return _regionCount;
+}
+
+
+/**
+ * show the changed dots of a region within deadlineMicros from now
+ * a region which is still pending gets the new deadline and starts over, its previous refresh counts as replaced
+ * returns false for an unknown region or without frame buffer
+ */
+boolean FlipTheDot_Scheduler::schedule(uint8_t region, unsigned long deadlineMicros)
+{
+    if ( region >= _regionCount || _controller->_frame == NULL )
+    {
+        return false;
+    }
+
+    Region &r = _regions[region];
+    unsigned long now = micros();
+
+    if ( r.isPending )
+    {
+        _checkDeadlines(now);
+        r.statistics.replaced++;
+    }
+    r.isPending = true;
+    r.isMissed = false;
+    r.cursorCol = 0;
+    r.cursorRow = 0;
+    r.scheduledMicros = now;
+    r.deadlineMicros = now + deadlineMicros;
+    r.shownMicros = now;
+    r.statistics.scheduled++;
+    return true;
+}
+
+/**
+ * check if a region waits for pulses
+ */
+boolean FlipTheDot_Scheduler::isPending(uint8_t region)
+{
+    return region < _regionCount && _regions[region].isPending;
+}
+
+/**
+ * check if all scheduled regions are shown
+ */
+boolean FlipTheDot_Scheduler::isIdle()
+{
+    for ( uint8_t i = 0; i < _regionCount; i++ )
+    {
+        if ( _regions[i].isPending )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/**
+ * limit update() to an average of pulsesPerSecond with bursts of up to burstPulses, 0 pulses per second
+ * disables the limit
+ */
+void FlipTheDot_Scheduler::setPulseRate(unsigned int pulsesPerSecond, unsigned int burstPulses = 1)
+{
+    _pulseCostMicros = pulsesPerSecond > 0 ? 1000000UL / pulsesPerSecond : 0;
+    _burstMicros = _pulseCostMicros * (burstPulses > 0 ? burstPulses : 1);
+    _creditMicros = _burstMicros;
+    _refilledMicros = micros();
+}
+
+
+/**
+ * pulse the changed dots of the scheduled regions in the order of their deadlines, as many as the pulse
+ * rate allows, call it in every loop()
+ * returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_Scheduler::update()
+{
+    unsigned int flipped = 0;
+    boolean isInvalidated = false;
+
+    if ( _controller->_frame == NULL )
+    {
+        return 0;
+    }
+
+    unsigned long start = micros();
+    _refill(start);
+
+    Region *region;
+    for ( ; ; )
+    {
+        _completeShown();
+        _checkDeadlines(micros());
+        if ( (region = _selectNext()) == NULL || ( _pulseCostMicros > 0 && _creditMicros < _pulseCostMicros ) )
+        {
+            break;
+        }
+
+        unsigned int col = region->col + region->cursorCol;
+        unsigned int row = region->row + region->cursorRow;
+        boolean show = _controller->_readBit(_controller->_frame, col, row);
+
+        #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F("FlipTheDot_Scheduler region ") );
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(region - _regions);
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" col ") );
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.print(col);
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.print( F(" row ") );
+        FlipTheDot_ColumnRowController_DEBUG_SERIAL.println(row);
+        #endif
+
+        // the stored panel state gets invalid with the first pulse, once per update()
+        if ( !isInvalidated )
+        {
+            _controller->_invalidatePanelState();
+            isInvalidated = true;
+        }
+        if ( _controller->_pulse(col, row, show) )
+        {
+            _controller->_writeBit(_controller->_shadow, col, row, show);
+            region->statistics.dots++;
+            flipped++;
+        }
+        region->shownMicros = micros();
+        _creditMicros -= _pulseCostMicros;
+
+        // a dot which could not be pulsed gets skipped like in flush()
+        _advance(*region, 1);
+    }
+
+    _controller->_statistics.busyMicros += micros() - start;
+    return flipped;
+}
+
+
+/**
+ * get the counters of a region
+ */
+const FlipTheDot_SchedulerStatistics &FlipTheDot_Scheduler::getStatistics(uint8_t region)
+{
+    return _regions[region < _regionCount ? region : 0].statistics;
+}
+
+/**
+ * get the missed deadlines of all regions
+ */
+unsigned long FlipTheDot_Scheduler::getMissedCount()
+{
+    unsigned long missed = 0;
+    for ( uint8_t i = 0; i < _regionCount; i++ )
+    {
+        missed += _regions[i].statistics.missed;
+    }
+    return missed;
+}
+
+/**
+ * set the counters of all regions to 0
+ */
+void FlipTheDot_Scheduler::resetStatistics()
+{
+    for ( uint8_t i = 0; i < _regionCount; i++ )
+    {
+        memset(&_regions[i].statistics, 0, sizeof(FlipTheDot_SchedulerStatistics));
+    }
+}
+
+
+/**
+ * count the pending regions which passed their deadline, once per refresh
+ */
+void FlipTheDot_Scheduler::_checkDeadlines(unsigned long now)
+{
+    for ( uint8_t i = 0; i < _regionCount; i++ )
+    {
+        Region &r = _regions[i];
+        // the difference handles the overflow of micros()
+        if ( r.isPending && !r.isMissed && (long)(now - r.deadlineMicros) >= 0 )
+        {
+            r.isMissed = true;
+            r.statistics.missed++;
+        }
+    }
+}
+
+
+/**
+ * the pending region which gets the next pulse, NULL if all regions are shown
+ * the most important region which missed its deadline goes first, unless a region with a higher priority can
+ * still meet its deadline, see the class description
+ */
+FlipTheDot_Scheduler::Region *FlipTheDot_Scheduler::_selectNext()
+{
+    Region *missed = NULL;
+    Region *next = NULL;
+    for ( uint8_t i = 0; i < _regionCount; i++ )
+    {
+        Region &r = _regions[i];
+        if ( !r.isPending )
+        {
+            continue;
+        }
+
+        // the difference handles the overflow of micros()
+        long deadlines;
+        if ( r.isMissed )
+        {
+            deadlines = missed != NULL ? (long)(r.deadlineMicros - missed->deadlineMicros) : 0;
+            if ( missed == NULL || r.priority > missed->priority || ( r.priority == missed->priority && deadlines < 0 ) )
+            {
+                missed = &r;
+            }
+        }
+        else
+        {
+            deadlines = next != NULL ? (long)(r.deadlineMicros - next->deadlineMicros) : 0;
+            if ( next == NULL || deadlines < 0 || ( deadlines == 0 && r.priority > next->priority ) )
+            {
+                next = &r;
+            }
+        }
+    }
+    return missed != NULL && ( next == NULL || missed->priority >= next->priority ) ? missed : next;
+}
+
+
+/**
+ * complete the pending regions without changed dots left
+ */
+void FlipTheDot_Scheduler::_completeShown()
+{
+    for ( uint8_t i = 0; i < _regionCount; i++ )
+    {
+        if ( _regions[i].isPending && !_nextChanged(_regions[i]) )
+        {
+            _complete(_regions[i]);
+        }
+    }
+}
+
+
+/**
+ * move the cursor of a region to its next dot which differs from the shown state, row by row,
+ * the cursor stays on that dot until it got pulsed
+ * returns false at the end of the region
+ */
+boolean FlipTheDot_Scheduler::_nextChanged(Region &region)
+{
+    uint8_t rowBytes = _controller->_rowBytes;
+
+    while ( region.cursorRow < region.rows )
+    {
+        unsigned int col = region.col + region.cursorCol;
+        unsigned int index = (region.row + region.cursorRow - 1) * rowBytes + (col - 1) / 8;
+        uint8_t bit = (col - 1) % 8;
+        uint8_t changed = (_controller->_frame[index] ^ _controller->_shadow[index]) >> bit;
+
+        if ( changed & 1 )
+        {
+            return true;
+        }
+        // skip the rest of a byte without changes
+        _advance(region, changed == 0 ? 8 - bit : 1);
+    }
+    return false;
+}
+
+
+/**
+ * move the cursor of a region by up to dots columns, not beyond the end of the row
+ */
+void FlipTheDot_Scheduler::_advance(Region &region, unsigned int dots)
+{
+    if ( dots >= region.cols - region.cursorCol )
+    {
+        region.cursorCol = 0;
+        region.cursorRow++;
+    }
+    else
+    {
+        region.cursorCol += dots;
+    }
+}
+
+
+/**
+ * all dots of a region are shown, update its counters
+ */
+void FlipTheDot_Scheduler::_complete(Region &region)
+{
+    region.isPending = false;
+    region.statistics.completed++;
+
+    unsigned long latency = region.shownMicros - region.scheduledMicros;
+    if ( latency > region.statistics.maxLatencyMicros )
+    {
+        region.statistics.maxLatencyMicros = latency;
+    }
+
+    // shown after the deadline, also when update() was called too late to notice it before
+    long lateness = (long)(region.shownMicros - region.deadlineMicros);
+    if ( lateness > 0 )
+    {
+        if ( !region.isMissed )
+        {
+            region.statistics.missed++;
+        }
+        if ( (unsigned long)lateness > region.statistics.maxLatenessMicros )
+        {
+            region.statistics.maxLatenessMicros = lateness;
+        }
+    }
+}
+
+
+/**
+ * add the time since the last update to the pulse credit, up to the burst
+ */
+void FlipTheDot_Scheduler::_refill(unsigned long now)
+{
+    if ( _pulseCostMicros == 0 )
+    {
+        return;
+    }
+
+    unsigned long elapsed = now - _refilledMicros;
+    _refilledMicros = now;
+    _creditMicros = _burstMicros - _creditMicros > elapsed ? _creditMicros + elapsed : _burstMicros;
+}
+
+
+#endif // FlipTheDot_Scheduler_h
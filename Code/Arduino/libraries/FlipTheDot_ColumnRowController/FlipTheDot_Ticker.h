@@ -0,0 +1,328 @@
+/*
+ * FlipTheDot_Ticker Class  -- Scrolling text on a FlipTheDot_ColumnRowController
+ *
+ * The text scrolls from the right to the left, one column per step. The ticker keeps a window with one byte
+ * per panel column (the dots of the text rows) and creates the next column from the font while scrolling,
+ * so the RAM usage depends on the panel width only. The text is not copied and can be stored in flash (setText_P).
+ * The font (see FlipTheDot_Font.h) may be up to 8 rows high, characters which are not in the font get skipped.
+ *
+ * Every step compares each column of the window with its right neighbour, only the dots which change get pulsed:
+ *   - with a frame buffer (setFrameBuffer of the controller), the changed dots get written into it and
+ *     one flush() pulses all of them in the optimized order, other content of the frame buffer stays untouched
+ *   - without a frame buffer, the changed dots of each column get pulsed with flipColumn(...) (up to two calls per column)
+ *
+ * Call update() in the loop, it steps whenever the step interval has passed (0: as fast as the coils allow).
+ */
+
+
+#ifndef FlipTheDot_Ticker_h
+#define FlipTheDot_Ticker_h
+
+#include "Arduino.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Font.h"
+
+
+
+class FlipTheDot_Ticker
+{
+    public:
+        FlipTheDot_Ticker(FlipTheDot_ColumnRowController &controller, uint8_t *window, const FlipTheDot_Font &font, unsigned int row);
+        void setText(const char *text);
+        void setText_P(const char *text);
+        void setLoop(boolean isLoop);
+        void setGap(unsigned int columns);
+        void setStepInterval(unsigned long intervalMicros);
+        unsigned long getStepInterval();
+        boolean update();
+        unsigned int step();
+        boolean isDone();
+        unsigned long getStepCount();
+
+    protected:
+        char _readChar();
+        uint8_t _readGlyph();
+        uint8_t _nextColumn();
+        void _restart();
+
+        FlipTheDot_ColumnRowController *_controller;
+        const FlipTheDot_Font *_font;
+        unsigned int _row;
+
+        // dots of the text rows for every panel column, bit 0 is the row _row
+        uint8_t *_window;
+        unsigned int _cols;
+
+        const char *_text = NULL;
+        boolean _isTextInFlash = false;
+        unsigned int _charIndex = 0;
+        uint8_t _glyphCol = 0;
+        unsigned int _blankColumns = 0;
+
+        boolean _isLoop = true;
+        boolean _isDone = false;
+        unsigned int _gap = 0;
+
+        unsigned long _intervalMicros = 0;
+        unsigned long _lastStepMicros = 0;
+        unsigned long _stepCount = 0;
+};
+
+
+/**
+ * the window needs one byte per column of the controller, the text rows start at row (1 = top row)
+ */
+FlipTheDot_Ticker::FlipTheDot_Ticker(FlipTheDot_ColumnRowController &controller, uint8_t *window, const FlipTheDot_Font &font, unsigned int row = 1)
+{
+    _controller = &controller;
+    _window = window;
+    _font = &font;
+    _row = row;
+    _cols = controller.getColCount();
+    _gap = _cols;
+
+    // the dots are unknown until the text scrolled thru, assume a blank panel
+    memset(_window, 0, _cols);
+}
+
+
+/**
+ * scroll a text from RAM, it has to stay unchanged while it is shown
+ * the text starts behind the current content, which scrolls out of the panel first
+ */
+void FlipTheDot_Ticker::setText(const char *text)
+{
+    _text = text;
+    _isTextInFlash = false;
+    _restart();
+}
+
+
+/**
+ * scroll a text from flash, e.g. setText_P(PSTR("Bus 42"))
+ */
+void FlipTheDot_Ticker::setText_P(const char *text)
+{
+    _text = text;
+    _isTextInFlash = true;
+    _restart();
+}
+
+
+/**
+ * repeat the text (default) or stop when it left the panel, see isDone()
+ */
+void FlipTheDot_Ticker::setLoop(boolean isLoop)
+{
+    _isLoop = isLoop;
+}
+
+
+/**
+ * blank columns between the end of the text and its repetition (default: width of the panel)
+ */
+void FlipTheDot_Ticker::setGap(unsigned int columns)
+{
+    _gap = columns;
+}
+
+
+/**
+ * define the minimal time from one step to the next, 0 steps as fast as possible
+ */
+void FlipTheDot_Ticker::setStepInterval(unsigned long intervalMicros)
+{
+    _intervalMicros = intervalMicros;
+}
+
+
+/**
+ * get the step interval
+ */
+unsigned long FlipTheDot_Ticker::getStepInterval()
+{
+    return _intervalMicros;
+}
+
+
+/**
+ * step if the step interval has passed, returns true if it stepped
+ */
+boolean FlipTheDot_Ticker::update()
+{
+    if ( _text == NULL || _isDone || ( _stepCount > 0 && micros() - _lastStepMicros < _intervalMicros ) )
+    {
+        return false;
+    }
+
+    _lastStepMicros = micros();
+    step();
+    return true;
+}
+
+
+/**
+ * scroll by one column and pulse the dots which change, returns the number of pulsed dots
+ */
+unsigned int FlipTheDot_Ticker::step()
+{
+    uint8_t incoming = _nextColumn();
+    uint8_t rowMask = _font->height >= 8 ? 0xFF : (1 << _font->height) - 1;
+    boolean hasFrameBuffer = _controller->getFrameBuffer() != NULL;
+    unsigned int pulsed = 0;
+
+    for ( unsigned int col = 0; col < _cols; col++ )
+    {
+        uint8_t next = col + 1 < _cols ? _window[col + 1] : incoming;
+        uint8_t changed = (_window[col] ^ next) & rowMask;
+
+        _window[col] = next;
+        if ( changed == 0 )
+        {
+            continue;
+        }
+
+        if ( hasFrameBuffer )
+        {
+            for ( uint8_t bit = 0; changed >> bit != 0; bit++ )
+            {
+                if ( (changed >> bit) & 1 )
+                {
+                    _controller->setDot(col + 1, _row + bit, (next >> bit) & 1);
+                }
+            }
+        }
+        else
+        {
+            // the column output and the data states get selected once for all dots of a state
+            if ( (changed & next) != 0 )
+            {
+                pulsed += _controller->flipColumn(col + 1, changed & next, true, _row);
+            }
+            if ( (changed & ~next) != 0 )
+            {
+                pulsed += _controller->flipColumn(col + 1, changed & ~next, false, _row);
+            }
+        }
+    }
+
+    if ( hasFrameBuffer )
+    {
+        pulsed = _controller->flush();
+    }
+
+    _stepCount++;
+    return pulsed;
+}
+
+
+/**
+ * check if a text without loop has left the panel
+ */
+boolean FlipTheDot_Ticker::isDone()
+{
+    return _isDone;
+}
+
+
+/**
+ * get the number of steps since the start
+ */
+unsigned long FlipTheDot_Ticker::getStepCount()
+{
+    return _stepCount;
+}
+
+
+void FlipTheDot_Ticker::_restart()
+{
+    _charIndex = 0;
+    _glyphCol = 0;
+    _blankColumns = 0;
+    _isDone = false;
+}
+
+
+char FlipTheDot_Ticker::_readChar()
+{
+    return _isTextInFlash ? pgm_read_byte(&_text[_charIndex]) : _text[_charIndex];
+}
+
+
+/**
+ * glyph of the current character, FlipTheDot_Font_MISSING if it is not in the font
+ */
+uint8_t FlipTheDot_Ticker::_readGlyph()
+{
+    uint8_t code = (uint8_t)_readChar();
+
+    if ( code < _font->first || code - _font->first >= _font->count )
+    {
+        return FlipTheDot_Font_MISSING;
+    }
+    return pgm_read_byte(&_font->glyphs[code - _font->first]);
+}
+
+
+/**
+ * get the next column of the text, followed by the gap (or the panel width without loop)
+ */
+uint8_t FlipTheDot_Ticker::_nextColumn()
+{
+    if ( _text == NULL || _isDone )
+    {
+        return 0;
+    }
+
+    // characters which are not in the font get skipped
+    while ( _glyphCol == 0 && _readChar() != '\0' && _readGlyph() == FlipTheDot_Font_MISSING )
+    {
+        _charIndex++;
+    }
+
+    if ( _blankColumns == 0 && _readChar() == '\0' )
+    {
+        // end of the text, continue at its start after the blank columns
+        _restart();
+        _blankColumns = _isLoop ? _gap : _cols;
+
+        if ( _blankColumns == 0 && _readChar() == '\0' )
+        {
+            return 0;
+        }
+    }
+
+    if ( _blankColumns > 0 )
+    {
+        _blankColumns--;
+        _isDone = _blankColumns == 0 && !_isLoop;
+        return 0;
+    }
+
+    uint8_t bits = 0;
+    uint8_t glyph = _readGlyph();
+    uint8_t width = glyph == FlipTheDot_Font_MISSING ? 0 : pgm_read_byte(&_font->widths[glyph]);
+
+    // the spacing columns after the glyph stay blank
+    if ( _glyphCol < width )
+    {
+        uint8_t rowBytes = (width + 7) / 8;
+        const uint8_t *data = _font->data + pgm_read_word(&_font->offsets[glyph]) + (_glyphCol >> 3);
+
+        for ( uint8_t y = 0; y < _font->height && y < 8; y++, data += rowBytes )
+        {
+            bits |= ( (pgm_read_byte(data) >> (_glyphCol & 7)) & 1 ) << y;
+        }
+    }
+
+    if ( ++_glyphCol >= width + _font->spacing )
+    {
+        _glyphCol = 0;
+        _charIndex++;
+    }
+    return bits;
+}
+
+
+
+#endif // FlipTheDot_Ticker_h
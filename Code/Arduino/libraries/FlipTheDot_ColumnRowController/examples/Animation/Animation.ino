@@ -0,0 +1,59 @@
+/*
+  Animation
+  Play a bouncing ball from flash, without frame buffer.
+
+  The wiring is identical to the example "FixedDefault". Bounce.h was created on the host from an animated GIF:
+    Code/Host/Tools/Animation/AnimationConverter --name bounce -o Bounce.h Code/Host/Tools/Animation/bounce.gif
+  It contains a keyframe and the dots which change from one frame to the next, already in the pulse order.
+  The player reads it thru a buffer of 32 bytes, so longer animations need more flash but no additional RAM.
+
+  To play an animation from an SD card instead, convert it with "--format binary" and use the file as source:
+    File file = SD.open("bounce.fda");
+    FlipTheDot_AnimationFile<File> source(file);
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Animation.h"
+
+#include "Bounce.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// the animation in flash and its player
+FlipTheDot_AnimationProgmem source(bounce, sizeof(bounce));
+FlipTheDot_AnimationPlayer player(controller);
+
+
+void setup() {
+  // fails if the animation was converted for another panel size
+  player.begin(source);
+}
+
+
+void loop() {
+  // plays the next frame when the duration of the current one has passed
+  player.update();
+}
@@ -0,0 +1,132 @@
+// created by AnimationConverter: 28x13 dots, 16 frames, 2039 bytes
+
+const uint8_t bounce[] PROGMEM = {
+    0x46, 0x41, 0x1C, 0x0D, 0x10, 0x00, 0x96, 0x00, 0x00, 0x00, 0xB5, 0x07, 0x00, 0x00, 0xF4, 0x01,
+    0x80, 0x01, 0x01, 0xFF, 0xFF, 0xFF, 0x0F, 0x80, 0x03, 0x01, 0xFF, 0xFF, 0xFF, 0x0F, 0x80, 0x02,
+    0x01, 0xFF, 0xFF, 0xFF, 0x0F, 0x80, 0x06, 0x01, 0xFF, 0xFF, 0xFF, 0x0F, 0x80, 0x07, 0x01, 0xFF,
+    0xFF, 0xFF, 0x0F, 0x80, 0x05, 0x01, 0xFF, 0xFF, 0xFF, 0x0F, 0x80, 0x04, 0x01, 0xFF, 0xFF, 0xFF,
+    0x0F, 0x80, 0x0B, 0x01, 0xC1, 0xFF, 0xFF, 0x0F, 0x80, 0x0C, 0x01, 0xE3, 0xFF, 0xFF, 0x0F, 0x80,
+    0x0D, 0x01, 0x88, 0x88, 0x88, 0x08, 0x80, 0x09, 0x01, 0xC1, 0xFF, 0xFF, 0x0F, 0x80, 0x0A, 0x01,
+    0xC1, 0xFF, 0xFF, 0x0F, 0x80, 0x08, 0x01, 0xE3, 0xFF, 0xFF, 0x0F, 0x81, 0x0B, 0x01, 0x3E, 0x00,
+    0x00, 0x00, 0x81, 0x0C, 0x01, 0x1C, 0x00, 0x00, 0x00, 0x81, 0x0D, 0x01, 0x77, 0x77, 0x77, 0x07,
+    0x81, 0x09, 0x01, 0x3E, 0x00, 0x00, 0x00, 0x81, 0x0A, 0x01, 0x3E, 0x00, 0x00, 0x00, 0x81, 0x08,
+    0x01, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x81, 0x08, 0x01, 0x20, 0x00, 0x00, 0x00, 0x81,
+    0x0D, 0x01, 0x88, 0x88, 0x88, 0x08, 0x81, 0x07, 0x01, 0x7C, 0x00, 0x00, 0x00, 0x81, 0x06, 0x01,
+    0x3C, 0x00, 0x00, 0x00, 0x80, 0x0A, 0x01, 0x3E, 0x00, 0x00, 0x00, 0x80, 0x09, 0x01, 0x06, 0x00,
+    0x00, 0x00, 0x80, 0x0D, 0x01, 0x44, 0x44, 0x44, 0x04, 0x80, 0x0C, 0x01, 0x1C, 0x00, 0x00, 0x00,
+    0x80, 0x0B, 0x01, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x80, 0x06, 0x01, 0x1C, 0x00, 0x00,
+    0x00, 0x80, 0x07, 0x01, 0x1C, 0x00, 0x00, 0x00, 0x80, 0x0D, 0x01, 0x22, 0x22, 0x22, 0x02, 0x80,
+    0x09, 0x01, 0x38, 0x00, 0x00, 0x00, 0x80, 0x08, 0x01, 0x3C, 0x00, 0x00, 0x00, 0x81, 0x03, 0x01,
+    0x40, 0x00, 0x00, 0x00, 0x81, 0x06, 0x01, 0xC0, 0x01, 0x00, 0x00, 0x81, 0x07, 0x01, 0x80, 0x00,
+    0x00, 0x00, 0x81, 0x05, 0x01, 0xF0, 0x01, 0x00, 0x00, 0x81, 0x04, 0x01, 0xE0, 0x01, 0x00, 0x00,
+    0x81, 0x0D, 0x01, 0x44, 0x44, 0x44, 0x04, 0x00, 0x78, 0x00, 0x82, 0x01, 0x01, 0x00, 0x10, 0x00,
+    0x00, 0x82, 0x06, 0x01, 0x78, 0x00, 0x00, 0x00, 0x82, 0x07, 0x01, 0x7C, 0x00, 0x00, 0x00, 0x82,
+    0x05, 0x01, 0x10, 0x10, 0x00, 0x00, 0x82, 0x0D, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x09, 0x01,
+    0x20, 0x10, 0x00, 0x00, 0x82, 0x08, 0x01, 0x78, 0x00, 0x00, 0x00, 0x82, 0x19, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x82, 0x15, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x11, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x83, 0x02, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x06, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0B,
+    0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x0C, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x0E, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x83, 0x09, 0x01, 0x06, 0x00, 0x00, 0x00, 0x83, 0x0A, 0x01, 0x1E, 0x10, 0x00,
+    0x00, 0x83, 0x16, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x1A, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83,
+    0x12, 0x01, 0x00, 0x10, 0x00, 0x00, 0x00, 0x78, 0x00, 0x82, 0x04, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x82, 0x0B, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x82, 0x0C, 0x01, 0x1E, 0x10, 0x00, 0x00, 0x82, 0x09,
+    0x01, 0x1E, 0x00, 0x00, 0x00, 0x82, 0x0A, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x82, 0x08, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x82, 0x18, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x1C, 0x01, 0x00, 0x10, 0x00,
+    0x00, 0x82, 0x14, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x10, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83,
+    0x01, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x05, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0E, 0x01,
+    0x1F, 0x00, 0x00, 0x00, 0x83, 0x0D, 0x01, 0x0E, 0x10, 0x00, 0x00, 0x83, 0x09, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x83, 0x19, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x15, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x83, 0x10, 0x01, 0x0E, 0x00, 0x00, 0x00, 0x83, 0x11, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0F,
+    0x01, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x82, 0x0F, 0x01, 0x1F, 0x10, 0x00, 0x00, 0x82,
+    0x10, 0x01, 0x0E, 0x00, 0x00, 0x00, 0x82, 0x13, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x1B, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x82, 0x17, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0D, 0x01, 0x0E, 0x00,
+    0x00, 0x00, 0x82, 0x0E, 0x01, 0x1F, 0x00, 0x00, 0x00, 0x82, 0x0B, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x82, 0x07, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x03, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x11,
+    0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x10, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x14, 0x01, 0x1E,
+    0x10, 0x00, 0x00, 0x83, 0x13, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x12, 0x01, 0x1E, 0x00, 0x00,
+    0x00, 0x83, 0x1C, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x18, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83,
+    0x08, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0C, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x04, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x00, 0x78, 0x00, 0x83, 0x03, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x07,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0B, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x16, 0x01, 0x7C,
+    0x00, 0x00, 0x00, 0x83, 0x18, 0x01, 0x10, 0x00, 0x00, 0x00, 0x83, 0x17, 0x01, 0x78, 0x10, 0x00,
+    0x00, 0x83, 0x1B, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x13, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83,
+    0x15, 0x01, 0x78, 0x00, 0x00, 0x00, 0x83, 0x14, 0x01, 0x20, 0x00, 0x00, 0x00, 0x83, 0x0F, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x82, 0x02, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x06, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x82, 0x0E, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0A, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x82, 0x16, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x1A, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x12,
+    0x01, 0x1E, 0x10, 0x00, 0x00, 0x82, 0x13, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x82, 0x14, 0x01, 0x06,
+    0x00, 0x00, 0x00, 0x82, 0x11, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x78, 0x00, 0x82, 0x11, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x82, 0x14, 0x01, 0x38, 0x00, 0x00, 0x00, 0x82, 0x15, 0x01, 0x78, 0x10,
+    0x00, 0x00, 0x82, 0x19, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x17, 0x01, 0x18, 0x00, 0x00, 0x00,
+    0x82, 0x18, 0x01, 0x10, 0x00, 0x00, 0x00, 0x82, 0x16, 0x01, 0x3C, 0x00, 0x00, 0x00, 0x82, 0x09,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0D, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x05, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x82, 0x01, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x12, 0x01, 0x00, 0x10, 0x00,
+    0x00, 0x83, 0x19, 0x01, 0xE0, 0x01, 0x00, 0x00, 0x83, 0x1A, 0x01, 0xE0, 0x10, 0x00, 0x00, 0x83,
+    0x17, 0x01, 0x80, 0x01, 0x00, 0x00, 0x83, 0x18, 0x01, 0xE0, 0x01, 0x00, 0x00, 0x83, 0x16, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x83, 0x0A, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0E, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x83, 0x06, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x02, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x00, 0x78, 0x00, 0x80, 0x06, 0x01, 0x00, 0x00, 0xC0, 0x03, 0x80, 0x07, 0x01, 0x00, 0x00, 0xE0,
+    0x03, 0x80, 0x0D, 0x01, 0x88, 0x88, 0x88, 0x08, 0x80, 0x08, 0x01, 0x00, 0x00, 0x40, 0x00, 0x81,
+    0x0B, 0x01, 0x00, 0x00, 0xC0, 0x07, 0x81, 0x0C, 0x01, 0x00, 0x00, 0x80, 0x03, 0x81, 0x0D, 0x01,
+    0x11, 0x11, 0x11, 0x01, 0x81, 0x09, 0x01, 0x00, 0x00, 0x00, 0x06, 0x81, 0x0A, 0x01, 0x00, 0x00,
+    0xC0, 0x07, 0x00, 0x78, 0x00, 0x81, 0x06, 0x01, 0x00, 0x00, 0xC0, 0x03, 0x81, 0x07, 0x01, 0x00,
+    0x00, 0xE0, 0x03, 0x81, 0x0D, 0x01, 0x88, 0x88, 0x88, 0x08, 0x81, 0x08, 0x01, 0x00, 0x00, 0x40,
+    0x00, 0x80, 0x0B, 0x01, 0x00, 0x00, 0xC0, 0x07, 0x80, 0x0C, 0x01, 0x00, 0x00, 0x80, 0x03, 0x80,
+    0x0D, 0x01, 0x44, 0x44, 0x44, 0x04, 0x80, 0x09, 0x01, 0x00, 0x00, 0x00, 0x06, 0x80, 0x0A, 0x01,
+    0x00, 0x00, 0xC0, 0x07, 0x00, 0x78, 0x00, 0x82, 0x02, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x06,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0E, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0A, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x82, 0x16, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x18, 0x01, 0xE0, 0x01, 0x00,
+    0x00, 0x82, 0x17, 0x01, 0x80, 0x01, 0x00, 0x00, 0x82, 0x1A, 0x01, 0xE0, 0x10, 0x00, 0x00, 0x82,
+    0x19, 0x01, 0xE0, 0x01, 0x00, 0x00, 0x82, 0x12, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x03, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x83, 0x07, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0B, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x83, 0x16, 0x01, 0x3C, 0x00, 0x00, 0x00, 0x83, 0x18, 0x01, 0x10, 0x00, 0x00, 0x00,
+    0x83, 0x17, 0x01, 0x18, 0x10, 0x00, 0x00, 0x83, 0x1B, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x13,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x15, 0x01, 0x78, 0x00, 0x00, 0x00, 0x83, 0x14, 0x01, 0x38,
+    0x00, 0x00, 0x00, 0x83, 0x0F, 0x01, 0x00, 0x10, 0x00, 0x00, 0x00, 0x78, 0x00, 0x83, 0x11, 0x01,
+    0x1E, 0x00, 0x00, 0x00, 0x83, 0x14, 0x01, 0x06, 0x00, 0x00, 0x00, 0x83, 0x13, 0x01, 0x1E, 0x00,
+    0x00, 0x00, 0x83, 0x12, 0x01, 0x1E, 0x10, 0x00, 0x00, 0x83, 0x1A, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x83, 0x16, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0A, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0E,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x06, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x02, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x82, 0x11, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x14, 0x01, 0x20, 0x00, 0x00,
+    0x00, 0x82, 0x15, 0x01, 0x78, 0x10, 0x00, 0x00, 0x82, 0x19, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82,
+    0x17, 0x01, 0x78, 0x00, 0x00, 0x00, 0x82, 0x18, 0x01, 0x10, 0x00, 0x00, 0x00, 0x82, 0x16, 0x01,
+    0x7C, 0x00, 0x00, 0x00, 0x82, 0x09, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0D, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x82, 0x05, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x01, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x00, 0x78, 0x00, 0x82, 0x04, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0C, 0x01, 0x00, 0x10, 0x00,
+    0x00, 0x82, 0x08, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x18, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82,
+    0x1C, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x12, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x82, 0x13, 0x01,
+    0x1E, 0x00, 0x00, 0x00, 0x82, 0x14, 0x01, 0x1E, 0x10, 0x00, 0x00, 0x82, 0x10, 0x01, 0x00, 0x10,
+    0x00, 0x00, 0x82, 0x11, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x01, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x83, 0x05, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0E, 0x01, 0x1F, 0x00, 0x00, 0x00, 0x83, 0x0D,
+    0x01, 0x0E, 0x10, 0x00, 0x00, 0x83, 0x09, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x19, 0x01, 0x00,
+    0x10, 0x00, 0x00, 0x83, 0x15, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x10, 0x01, 0x0E, 0x00, 0x00,
+    0x00, 0x83, 0x11, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0F, 0x01, 0x1F, 0x00, 0x00, 0x00, 0x00,
+    0x78, 0x00, 0x82, 0x0F, 0x01, 0x1F, 0x10, 0x00, 0x00, 0x82, 0x10, 0x01, 0x0E, 0x00, 0x00, 0x00,
+    0x82, 0x13, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x1B, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x17,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0D, 0x01, 0x0E, 0x00, 0x00, 0x00, 0x82, 0x0E, 0x01, 0x1F,
+    0x00, 0x00, 0x00, 0x82, 0x0B, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x07, 0x01, 0x00, 0x10, 0x00,
+    0x00, 0x82, 0x03, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x10, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83,
+    0x14, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x1C, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x18, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x83, 0x08, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0A, 0x01, 0x1E, 0x00,
+    0x00, 0x00, 0x83, 0x09, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x0C, 0x01, 0x1E, 0x10, 0x00, 0x00,
+    0x83, 0x0B, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x83, 0x04, 0x01, 0x00, 0x10, 0x00, 0x00, 0x00, 0x78,
+    0x00, 0x83, 0x03, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x06, 0x01, 0x78, 0x00, 0x00, 0x00, 0x83,
+    0x07, 0x01, 0x7C, 0x10, 0x00, 0x00, 0x83, 0x05, 0x01, 0x10, 0x00, 0x00, 0x00, 0x83, 0x0B, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x83, 0x09, 0x01, 0x20, 0x00, 0x00, 0x00, 0x83, 0x08, 0x01, 0x78, 0x00,
+    0x00, 0x00, 0x83, 0x17, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x1B, 0x01, 0x00, 0x10, 0x00, 0x00,
+    0x83, 0x13, 0x01, 0x00, 0x10, 0x00, 0x00, 0x83, 0x0F, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x02,
+    0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x06, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x0B, 0x01, 0x1E,
+    0x00, 0x00, 0x00, 0x82, 0x0C, 0x01, 0x1E, 0x00, 0x00, 0x00, 0x82, 0x0E, 0x01, 0x00, 0x10, 0x00,
+    0x00, 0x82, 0x09, 0x01, 0x06, 0x00, 0x00, 0x00, 0x82, 0x0A, 0x01, 0x1E, 0x10, 0x00, 0x00, 0x82,
+    0x16, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x1A, 0x01, 0x00, 0x10, 0x00, 0x00, 0x82, 0x12, 0x01,
+    0x00, 0x10, 0x00, 0x00, 0x00, 0x78, 0x00, 0x80, 0x03, 0x01, 0x40, 0x00, 0x00, 0x00, 0x80, 0x06,
+    0x01, 0xC0, 0x01, 0x00, 0x00, 0x80, 0x07, 0x01, 0x80, 0x00, 0x00, 0x00, 0x80, 0x05, 0x01, 0xF0,
+    0x01, 0x00, 0x00, 0x80, 0x04, 0x01, 0xE0, 0x01, 0x00, 0x00, 0x80, 0x0D, 0x01, 0x11, 0x11, 0x11,
+    0x01, 0x81, 0x06, 0x01, 0x1C, 0x00, 0x00, 0x00, 0x81, 0x07, 0x01, 0x1C, 0x00, 0x00, 0x00, 0x81,
+    0x0D, 0x01, 0x22, 0x22, 0x22, 0x02, 0x81, 0x09, 0x01, 0x38, 0x00, 0x00, 0x00, 0x81, 0x08, 0x01,
+    0x3C, 0x00, 0x00, 0x00, 0x00, 0xF4, 0x01, 0x81, 0x0A, 0x01, 0x3E, 0x00, 0x00, 0x00, 0x81, 0x09,
+    0x01, 0x06, 0x00, 0x00, 0x00, 0x81, 0x0D, 0x01, 0x11, 0x11, 0x11, 0x01, 0x81, 0x0C, 0x01, 0x1C,
+    0x00, 0x00, 0x00, 0x81, 0x0B, 0x01, 0x3E, 0x00, 0x00, 0x00, 0x80, 0x08, 0x01, 0x20, 0x00, 0x00,
+    0x00, 0x80, 0x0D, 0x01, 0x88, 0x88, 0x88, 0x08, 0x80, 0x07, 0x01, 0x7C, 0x00, 0x00, 0x00, 0x80,
+    0x06, 0x01, 0x3C, 0x00, 0x00, 0x00, 0x00
+};
@@ -0,0 +1,82 @@
+/*
+  Assets
+  Draw a bus icon and a text in a proportional font which were converted from image and font files.
+
+  The wiring is identical to the example "FrameBuffer". The file assets.h is created by the host tool
+  AssetConverter (Code/Host/Tools/Assets) from bus.png and font5x7.bdf:
+    AssetConverter --name font5x7 font5x7.bdf --name busIcon bus.png -o assets.h
+  Bitmaps and glyphs stay in flash in the layout of the frame buffer, FlipTheDot_Blitter copies them with a few
+  shifts per byte instead of one setDot(...) per dot. Empty glyph columns got removed, so narrow characters
+  like "1" or "i" take less space.
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Blitter.h"
+
+// the converted icon and font
+#include "assets.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+// draws the converted assets into the frame buffer of the controller
+FlipTheDot_Blitter blitter(controller);
+
+// the text is stored in flash, too
+const char route[] PROGMEM = "11";
+
+
+void setup() {
+  controller.setFrameBuffer(frame, shadow);
+}
+
+
+void loop() {
+  // the bus drives in from the left
+  for ( int col = 1 - busIcon.width; col <= 5; col++ )
+  {
+    controller.fill(false);
+    blitter.drawBitmap(busIcon, col, 3);
+    controller.flush();
+    delay(100);
+  }
+  delay(2000);
+
+  // the route number centered below the bus
+  int width = blitter.getTextWidth_P(route, font5x7);
+  controller.fill(false);
+  blitter.drawText_P(route, (columns - width) / 2 + 1, 4, font5x7);
+  controller.flush();
+  delay(2000);
+
+  controller.fill(false);
+  blitter.drawText("Hbf", 1, 4, font5x7);
+  controller.flush();
+  delay(2000);
+}
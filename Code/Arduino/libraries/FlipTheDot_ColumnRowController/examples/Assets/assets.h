@@ -0,0 +1,108 @@
+// created by AssetConverter, layout of the frame buffer: row after row, first column in the lowest bit
+
+#ifndef assets_h
+#define assets_h
+
+#include "FlipTheDot_Blitter.h"
+
+
+// 20x9 dots, 27 bytes
+const uint8_t busIcon_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0xFE, 0xFF, 0x07, 0x92, 0x24, 0x03, 0x92, 0x24, 0x07,
+    0xFE, 0xFF, 0x07, 0xFE, 0xFF, 0x07, 0xFE, 0xFF, 0x07, 0x18, 0xC0, 0x00,
+    0x18, 0xC0, 0x00
+};
+constexpr FlipTheDot_Bitmap busIcon = { busIcon_DATA, 20, 9 };
+
+// 95 characters (32 - 126), 7 rows, 95 glyphs (0 duplicates), 146 empty columns removed, 1045 bytes
+const uint8_t font5x7_DATA[] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x00, 0x01, 0x05, 0x05, 0x05, 0x00, 0x00, 0x00, 0x00, 0x0A, 0x0A, 0x1F,
+    0x0A, 0x1F, 0x0A, 0x0A, 0x04, 0x1E, 0x05, 0x0E, 0x14, 0x0F, 0x04, 0x03,
+    0x13, 0x08, 0x04, 0x02, 0x19, 0x18, 0x06, 0x09, 0x05, 0x02, 0x15, 0x09,
+    0x16, 0x03, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x04, 0x02, 0x01, 0x01,
+    0x01, 0x02, 0x04, 0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01, 0x00, 0x04,
+    0x15, 0x0E, 0x15, 0x04, 0x00, 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x00, 0x00, 0x1F, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x10, 0x08,
+    0x04, 0x02, 0x01, 0x00, 0x0E, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0E, 0x02,
+    0x03, 0x02, 0x02, 0x02, 0x02, 0x07, 0x0E, 0x11, 0x10, 0x08, 0x04, 0x02,
+    0x1F, 0x1F, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0E, 0x08, 0x0C, 0x0A, 0x09,
+    0x1F, 0x08, 0x08, 0x1F, 0x01, 0x0F, 0x10, 0x10, 0x11, 0x0E, 0x0C, 0x02,
+    0x01, 0x0F, 0x11, 0x11, 0x0E, 0x1F, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02,
+    0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x0E, 0x11, 0x11, 0x1E, 0x10,
+    0x08, 0x06, 0x00, 0x03, 0x03, 0x00, 0x03, 0x03, 0x00, 0x00, 0x03, 0x03,
+    0x00, 0x03, 0x02, 0x01, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00,
+    0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00, 0x01, 0x02, 0x04, 0x08, 0x04, 0x02,
+    0x01, 0x0E, 0x11, 0x10, 0x08, 0x04, 0x00, 0x04, 0x0E, 0x11, 0x10, 0x16,
+    0x15, 0x15, 0x0E, 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x0F, 0x11,
+    0x11, 0x0F, 0x11, 0x11, 0x0F, 0x0E, 0x11, 0x01, 0x01, 0x01, 0x11, 0x0E,
+    0x07, 0x09, 0x11, 0x11, 0x11, 0x09, 0x07, 0x1F, 0x01, 0x01, 0x0F, 0x01,
+    0x01, 0x1F, 0x1F, 0x01, 0x01, 0x0F, 0x01, 0x01, 0x01, 0x0E, 0x11, 0x01,
+    0x1D, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x07,
+    0x02, 0x02, 0x02, 0x02, 0x02, 0x07, 0x1C, 0x08, 0x08, 0x08, 0x08, 0x09,
+    0x06, 0x11, 0x09, 0x05, 0x03, 0x05, 0x09, 0x11, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x1F, 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+    0x13, 0x15, 0x19, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E,
+    0x0F, 0x11, 0x11, 0x0F, 0x01, 0x01, 0x01, 0x0E, 0x11, 0x11, 0x11, 0x15,
+    0x09, 0x16, 0x0F, 0x11, 0x11, 0x0F, 0x05, 0x09, 0x11, 0x1E, 0x01, 0x01,
+    0x0E, 0x10, 0x10, 0x0F, 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x11,
+    0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A,
+    0x04, 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A, 0x11, 0x11, 0x0A, 0x04,
+    0x0A, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x1F, 0x10,
+    0x08, 0x04, 0x02, 0x01, 0x1F, 0x07, 0x01, 0x01, 0x01, 0x01, 0x01, 0x07,
+    0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x07, 0x04, 0x04, 0x04, 0x04,
+    0x04, 0x07, 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x1F, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x0E, 0x10, 0x1E, 0x11, 0x1E, 0x01, 0x01, 0x0D, 0x13, 0x11, 0x11,
+    0x0F, 0x00, 0x00, 0x0E, 0x01, 0x01, 0x11, 0x0E, 0x10, 0x10, 0x16, 0x19,
+    0x11, 0x11, 0x1E, 0x00, 0x00, 0x0E, 0x11, 0x1F, 0x01, 0x0E, 0x0C, 0x12,
+    0x02, 0x07, 0x02, 0x02, 0x02, 0x00, 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x0E,
+    0x01, 0x01, 0x0D, 0x13, 0x11, 0x11, 0x11, 0x02, 0x00, 0x03, 0x02, 0x02,
+    0x02, 0x07, 0x08, 0x00, 0x0C, 0x08, 0x08, 0x09, 0x06, 0x01, 0x01, 0x09,
+    0x05, 0x03, 0x05, 0x09, 0x03, 0x02, 0x02, 0x02, 0x02, 0x02, 0x07, 0x00,
+    0x00, 0x0B, 0x15, 0x15, 0x11, 0x11, 0x00, 0x00, 0x0D, 0x13, 0x11, 0x11,
+    0x11, 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00, 0x00, 0x0F, 0x11,
+    0x0F, 0x01, 0x01, 0x00, 0x00, 0x16, 0x19, 0x1E, 0x10, 0x10, 0x00, 0x00,
+    0x0D, 0x13, 0x01, 0x01, 0x01, 0x00, 0x00, 0x0E, 0x01, 0x0E, 0x10, 0x0F,
+    0x02, 0x02, 0x07, 0x02, 0x02, 0x12, 0x0C, 0x00, 0x00, 0x11, 0x11, 0x11,
+    0x19, 0x16, 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00, 0x00, 0x11,
+    0x11, 0x15, 0x15, 0x0A, 0x00, 0x00, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x00,
+    0x00, 0x11, 0x11, 0x1E, 0x10, 0x0E, 0x00, 0x00, 0x1F, 0x08, 0x04, 0x02,
+    0x1F, 0x04, 0x02, 0x02, 0x01, 0x02, 0x02, 0x04, 0x01, 0x01, 0x01, 0x01,
+    0x01, 0x01, 0x01, 0x01, 0x02, 0x02, 0x04, 0x02, 0x02, 0x01, 0x00, 0x00,
+    0x02, 0x15, 0x08, 0x00, 0x00
+};
+const uint16_t font5x7_OFFSETS[] PROGMEM = {
+    0, 7, 14, 21, 28, 35, 42, 49, 56, 63, 70, 77,
+    84, 91, 98, 105, 112, 119, 126, 133, 140, 147, 154, 161,
+    168, 175, 182, 189, 196, 203, 210, 217, 224, 231, 238, 245,
+    252, 259, 266, 273, 280, 287, 294, 301, 308, 315, 322, 329,
+    336, 343, 350, 357, 364, 371, 378, 385, 392, 399, 406, 413,
+    420, 427, 434, 441, 448, 455, 462, 469, 476, 483, 490, 497,
+    504, 511, 518, 525, 532, 539, 546, 553, 560, 567, 574, 581,
+    588, 595, 602, 609, 616, 623, 630, 637, 644, 651, 658
+};
+const uint8_t font5x7_WIDTHS[] PROGMEM = {
+    5, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5,
+    2, 5, 2, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 2, 2, 4, 5, 4, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3,
+    5, 3, 5, 5, 3, 5, 5, 5, 5, 5, 5, 5,
+    5, 3, 4, 4, 3, 5, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5
+};
+const uint8_t font5x7_GLYPHS[] PROGMEM = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+    12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23,
+    24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35,
+    36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59,
+    60, 61, 62, 63, 64, 65, 66, 67, 68, 69, 70, 71,
+    72, 73, 74, 75, 76, 77, 78, 79, 80, 81, 82, 83,
+    84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94
+};
+constexpr FlipTheDot_Font font5x7 = { font5x7_DATA, font5x7_OFFSETS, font5x7_WIDTHS, font5x7_GLYPHS, 32, 95, 7, 1 };
+
+#endif // assets_h
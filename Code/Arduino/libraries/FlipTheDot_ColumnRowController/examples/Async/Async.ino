@@ -0,0 +1,89 @@
+/*
+  Async
+  Let a timer interrupt pulse the dots while the loop keeps reading the serial connection.
+
+  The wiring is identical to the example "FixedDefault". flushAsync() only starts the refresh of the
+  frame buffer, Timer1 calls the controller for every step of every pulse (enable, disable, select the
+  next dot). The loop echoes every received character and draws the next frame as soon as the
+  previous one is shown (isBusy() is false). The callback counts the finished frames.
+
+  Timer1 is used by the controller, so the Servo library and PWM on pin 9 and 10 are not available.
+
+
+  This example code is in the public domain.
+ */
+
+
+// let the library drive Timer1, has to be defined before the include
+#define FlipTheDot_ColumnRowControllerAsync_TIMER1
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowControllerAsync.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object which pulses in the background
+FlipTheDot_ColumnRowControllerAsync controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+// helper variables
+int barColumn = 1;
+volatile unsigned int framesShown = 0;
+
+
+// runs in the interrupt when the frame is shown
+void frameShown() {
+  framesShown++;
+}
+
+
+void setup() {
+  Serial.begin(9600);
+
+  controller.setFrameBuffer(frame, shadow);
+  controller.setTimer(FlipTheDot_ColumnRowControllerAsync_timer1);
+  controller.setCallback(frameShown);
+
+  delay(1000);
+}
+
+
+void loop() {
+  // the serial connection gets served while the dots are pulsed
+  while ( Serial.available() > 0 ) {
+    Serial.write(Serial.read());
+  }
+
+  if ( controller.isBusy() ) {
+    return;
+  }
+
+  // draw the next frame and start to show it
+  controller.fill(false);
+  for ( int row = 1; row <= rows; row++ )
+  {
+    controller.setDot(barColumn, row, true);
+  }
+  controller.flushAsync();
+
+  barColumn = barColumn >= columns ? 1 : barColumn + 1;
+}
@@ -0,0 +1,91 @@
+/*
+  Canvas
+  Two panels as one display: a 28x13 panel and a 14x16 panel which is mounted upside down (rotated by 180°)
+  on its right side form a canvas of 42x16 dots. A bar moves across both panels.
+
+  Every panel has its own FP2800a chips and its own controller with a frame buffer. The canvas maps its dots
+  onto the frame buffers and its flush() pulses both panels at the same time, so a frame takes about as long
+  as the refresh of the panel with the most changed dots.
+
+  28 pins are needed, so this example is wired for an Arduino Mega:
+  28x13 panel like the example "FrameBuffer", 14x16 panel on the pins 22 - 35.
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Canvas.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the canvas
+const int columns = 42;
+const int rows    = 16;
+
+// setup the objects for the first panel (28x13)
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController1(  A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController1(    A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+// setup the objects for the second panel (14x16)
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController2(  22,           23,          24, 25, 26, 27, 28,  fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController2(    29,           30,          31, 32, 33, 34, 35,  fp2800a_pulse_length);
+
+FlipTheDot_ColumnRowController panel1(columnController1, rowController1, 28, 13, fp2800a_pulse_length);
+FlipTheDot_ColumnRowController panel2(columnController2, rowController2, 14, 16, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panels
+uint8_t frame1[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+uint8_t shadow1[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+uint8_t frame2[FlipTheDot_ColumnRowController_BUFFER_SIZE(14, 16)];
+uint8_t shadow2[FlipTheDot_ColumnRowController_BUFFER_SIZE(14, 16)];
+
+// one display made of both panels
+FlipTheDot_Canvas canvas(columns, rows);
+
+
+// helper variables
+int barColumn = 1;
+
+
+void setup() {
+  panel1.setFrameBuffer(frame1, shadow1);
+  panel2.setFrameBuffer(frame2, shadow2);
+
+  // top left corner of the panels on the canvas
+  canvas.addPanel(panel1, 1, 1, FlipTheDot_Canvas::ROTATE_0);
+  canvas.addPanel(panel2, 29, 1, FlipTheDot_Canvas::ROTATE_180);
+
+  // both panels draw the current of a coil at the same time, use 1 for a weak power supply
+  canvas.setMaxParallelPulses(2);
+
+  canvas.fill(false);
+  canvas.flush();
+
+  delay(1000);
+}
+
+
+void loop() {
+  // draw the next frame, the dots below the first panel are not covered and get ignored
+  canvas.fill(false);
+  for ( int row = 1; row <= rows; row++ )
+  {
+    canvas.setDot(barColumn, row, true);
+  }
+  canvas.flush();
+
+  barColumn = barColumn >= columns ? 1 : barColumn + 1;
+
+  delay(100);
+}
@@ -0,0 +1,102 @@
+/*
+  Compositor
+  Build a destination sign from independent layers: the route number on the left, the destination scrolling
+  thru the space to its right and a blinking arrow in the top right corner.
+
+  The wiring is identical to the example "FrameBuffer". Every layer keeps its own image and remembers which
+  part of the panel it changed. update() composes only those dots into the frame buffer and pulses the dots
+  which differ, the blinking arrow alone costs a few pulses and almost no time.
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Compositor.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+// the route number: two characters of the 5x7 font
+uint8_t routeImage[FlipTheDot_Layer_BUFFER_SIZE(12, 7)];
+FlipTheDot_Layer route(12, 7, routeImage);
+
+// the destination: 16 characters, 16 columns of them are visible
+uint8_t destinationImage[FlipTheDot_Layer_BUFFER_SIZE(96, 7)];
+FlipTheDot_Layer destination(96, 7, destinationImage);
+
+// the arrow stays in flash, one byte per row
+const uint8_t arrowImage[3] PROGMEM = { 0x02, 0x07, 0x02 };
+FlipTheDot_Layer arrow(3, 3, NULL);
+
+FlipTheDot_Compositor compositor(controller);
+
+unsigned long lastScroll = 0;
+unsigned long lastBlink = 0;
+unsigned int scroll = 0;
+
+
+void setup() {
+  controller.setFrameBuffer(frame, shadow);
+
+  route.setPosition(1, 4);
+  route.drawText(1, 1, "42", FlipTheDot_Font5x7);
+
+  destination.setPosition(13, 4);
+  destination.setWindow(16, 7);
+  destination.drawText(1, 1, "Hauptbahnhof    ", FlipTheDot_Font5x7);
+
+  arrow.setImage_P(arrowImage);
+  arrow.setPosition(26, 1);
+  arrow.setMode(FlipTheDot_Layer::TRANSPARENT);
+
+  // from the bottom to the top
+  compositor.addLayer(route);
+  compositor.addLayer(destination);
+  compositor.addLayer(arrow);
+  compositor.update();
+}
+
+
+void loop() {
+  unsigned long now = millis();
+
+  // 10 columns per second
+  if ( now - lastScroll >= 100 )
+  {
+    lastScroll = now;
+    scroll++;
+    destination.setScroll(scroll, 0);
+  }
+
+  if ( now - lastBlink >= 500 )
+  {
+    lastBlink = now;
+    arrow.setVisible(!arrow.isVisible());
+  }
+
+  compositor.update();
+}
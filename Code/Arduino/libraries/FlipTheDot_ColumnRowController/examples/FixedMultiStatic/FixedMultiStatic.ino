@@ -0,0 +1,63 @@
+/*
+  Fixed-Multi Controller (compile time configuration)
+  Iterate thru the output numbers of multiple controllers in a row and multi column group configuration.
+
+  The script is identical to the example "FixedMulti", but all pin numbers are template parameters
+  of FlipTheDot_FP2800aStatic. No pin number is stored in RAM, no method is virtual and the compiler
+  can inline the whole flip path, which saves flash and RAM on small boards.
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800aStatic.h"
+#include "FlipTheDot_ColumnRowControllerStatic.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// setup the objects for the fixed FP2800a rows controller and FP2800aMulti columns controller
+// Template parameter order:                          Enable Reset, Enable Set                       A0, A1, A2, B0, B1
+FlipTheDot_FP2800aStatic< FlipTheDot_FP2800aPinsFixed<A0,           2>,                              3,  4,  5,  6,  7 > rowController(fp2800a_pulse_length);
+// Template parameter order:                          Data,         Enable List (one pin per group)  A0, A1, A2, B0, B1
+FlipTheDot_FP2800aStatic< FlipTheDot_FP2800aPinsMulti<8,            A1, A2, A3>,                     9,  10, 11, 12, 13 > columnController(fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowControllerStatic< decltype(columnController), decltype(rowController) > controller(columnController, rowController, fp2800a_pulse_length);
+
+
+// helper variables
+int rowOutputNo = 0;
+int rowOutputNoMax = controller.getRowCount();
+
+int columnOutputNo = 0;
+int columnOutputNoMax = controller.getColCount();
+
+boolean dataStatus = false;
+
+
+void setup() {
+  delay(1000);
+}
+
+
+void loop() {
+  // iterate thru all rows
+  for ( rowOutputNo = 1; rowOutputNo <= rowOutputNoMax; rowOutputNo++ )
+  {
+    // iterate thru all columns in the current row
+    for ( columnOutputNo = 1; columnOutputNo <= columnOutputNoMax; columnOutputNo++ )
+    {
+      controller.flip(columnOutputNo, rowOutputNo, dataStatus);
+
+      // remove/decrease this delay to speedup the process
+      delay(1000);
+    }
+  }
+
+  // invert data flag
+  dataStatus = !dataStatus;
+}
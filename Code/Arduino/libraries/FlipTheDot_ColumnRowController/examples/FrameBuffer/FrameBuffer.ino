@@ -0,0 +1,81 @@
+/*
+  Frame Buffer
+  Draw into a bit packed frame buffer and let the controller pulse only the dots which changed.
+
+  The wiring is identical to the example "FixedDefault". Instead of calling flip(...) for every dot,
+  the sketch draws a moving vertical bar into the frame buffer with setDot(...) and calls flush().
+  The controller remembers which dots are already shown (shadow copy) and skips all dots which
+  already have the requested state. The first flush pulses every dot because the state of the
+  panel is unknown after power on.
+
+
+  This example code is in the public domain.
+ */
+
+
+// uncomment these lines to get some debug informations via the defined Serial connection
+/*
+#ifndef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+#define FlipTheDot_ColumnRowController_DEBUG_SERIAL Serial
+#endif
+*/
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+// helper variables
+int barColumn = 1;
+
+
+void setup() {
+  // initialize debug Serial connection if defined
+  #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+  FlipTheDot_ColumnRowController_DEBUG_SERIAL.begin(9600);
+  #endif
+
+  controller.setFrameBuffer(frame, shadow);
+
+  delay(1000);
+}
+
+
+void loop() {
+  // draw the next frame
+  controller.fill(false);
+  for ( int row = 1; row <= rows; row++ )
+  {
+    controller.setDot(barColumn, row, true);
+  }
+
+  // only the old and the new bar position get pulsed (2 * 13 dots instead of 364)
+  controller.flush();
+
+  barColumn = barColumn >= columns ? 1 : barColumn + 1;
+
+  delay(100);
+}
@@ -0,0 +1,79 @@
+/*
+  FrameStream
+  Show the frames which a computer streams over the serial connection.
+
+  The wiring is identical to the example "FixedDefault". Every received byte is decoded by the
+  FlipTheDot_FrameReceiver into its own receive buffer, a complete frame with a valid CRC gets copied into the
+  frame buffer and shown with flushAsync(), so Timer1 pulses the dots while the next frame is still arriving.
+  Frames which arrive faster than the panel can flip are merged: the refresh restarts with the latest frame.
+  A complete frame is answered with 'A'. A broken frame is answered with 'N', then the sender sends the next frame
+  as full frame.
+
+  Use Code/Host/Tools/FrameStream/FrameSender on a Linux computer to send an animation, e.g.
+    FrameSender /dev/ttyACM0 115200 1000 scroll
+  or RenderDaemon (Code/Host/Tools/RenderDaemon), which waits for the 'A' before it sends the next frame:
+    RenderDaemon /dev/ttyACM0 --seconds 60
+
+  Timer1 is used by the controller, so the Servo library and PWM on pin 9 and 10 are not available.
+
+
+  This example code is in the public domain.
+ */
+
+
+// let the library drive Timer1, has to be defined before the include
+#define FlipTheDot_ColumnRowControllerAsync_TIMER1
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowControllerAsync.h"
+#include "FlipTheDot_FrameReceiver.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display, has to match the sender
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object which pulses in the background
+FlipTheDot_ColumnRowControllerAsync controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+// decode the serial stream into a receive buffer, complete frames get copied into the frame buffer
+uint8_t received[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+FlipTheDot_FrameReceiver receiver(controller, received);
+
+
+void setup() {
+  Serial.begin(115200);
+
+  controller.setFrameBuffer(frame, shadow);
+  controller.setTimer(FlipTheDot_ColumnRowControllerAsync_timer1);
+}
+
+
+void loop() {
+  while ( Serial.available() > 0 ) {
+    uint8_t result = receiver.receive(Serial.read());
+
+    if ( result == FlipTheDot_FrameReceiver::FRAME_DONE ) {
+      Serial.write('A');
+      controller.flushAsync();
+    } else if ( result == FlipTheDot_FrameReceiver::FRAME_ERROR ) {
+      Serial.write('N');
+    }
+  }
+}
@@ -0,0 +1,82 @@
+/*
+  Output Map
+  Draw with linear row numbers on a panel whose rows are not wired in order to the FP2800a outputs.
+
+  The wiring is identical to the example "FrameBuffer", but the panel has 24 rows on a split connector:
+  the rows 1 - 12 are connected to the outputs 15 - 26 of the row FP2800a, the rows 13 - 24 to the outputs 1 - 12.
+  A table in flash translates every row number to its FP2800a output once when it gets selected,
+  so setDot(...), flush() and everything else keep using the rows 1 - 24 from top to bottom.
+
+  Every entry is written with FlipTheDot_FP2800a_MAP(chip, output). For a FlipTheDot_FP2800aMulti the chip
+  selects the IC (0 for the first enable pin of the list, up to 7), for a single FP2800a it is always 0.
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 24;
+
+// FP2800a output of every row, from row 1 to row 24
+const uint8_t rowMap[rows] PROGMEM = {
+  FlipTheDot_FP2800a_MAP(0, 15), FlipTheDot_FP2800a_MAP(0, 16), FlipTheDot_FP2800a_MAP(0, 17), FlipTheDot_FP2800a_MAP(0, 18),
+  FlipTheDot_FP2800a_MAP(0, 19), FlipTheDot_FP2800a_MAP(0, 20), FlipTheDot_FP2800a_MAP(0, 21), FlipTheDot_FP2800a_MAP(0, 22),
+  FlipTheDot_FP2800a_MAP(0, 23), FlipTheDot_FP2800a_MAP(0, 24), FlipTheDot_FP2800a_MAP(0, 25), FlipTheDot_FP2800a_MAP(0, 26),
+  FlipTheDot_FP2800a_MAP(0,  1), FlipTheDot_FP2800a_MAP(0,  2), FlipTheDot_FP2800a_MAP(0,  3), FlipTheDot_FP2800a_MAP(0,  4),
+  FlipTheDot_FP2800a_MAP(0,  5), FlipTheDot_FP2800a_MAP(0,  6), FlipTheDot_FP2800a_MAP(0,  7), FlipTheDot_FP2800a_MAP(0,  8),
+  FlipTheDot_FP2800a_MAP(0,  9), FlipTheDot_FP2800a_MAP(0, 10), FlipTheDot_FP2800a_MAP(0, 11), FlipTheDot_FP2800a_MAP(0, 12)
+};
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+// helper variables
+int barRow = 1;
+
+
+void setup() {
+  // translate the row numbers from now on
+  rowController.setOutputMap(rowMap, rows);
+
+  controller.setFrameBuffer(frame, shadow);
+
+  delay(1000);
+}
+
+
+void loop() {
+  // a horizontal bar moves from the top to the bottom
+  controller.fill(false);
+  for ( int col = 1; col <= columns; col++ )
+  {
+    controller.setDot(col, barRow, true);
+  }
+  controller.flush();
+
+  barRow = barRow >= rows ? 1 : barRow + 1;
+
+  delay(100);
+}
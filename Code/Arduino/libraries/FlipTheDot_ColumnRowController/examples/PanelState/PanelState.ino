@@ -0,0 +1,89 @@
+/*
+  PanelState
+  Keep the shown frame in the EEPROM, so a reset (e.g. by the watchdog) does not pulse every dot again.
+
+  The wiring is identical to the example "FrameBuffer". The sketch switches between two pages every ten minutes.
+  After a reset, setPanelState(...) loads the last shown page into the frame buffer, so the first flush only
+  pulses the dots which differ from it. Without a stored state (first start, other sketch before) it returns
+  false and the first flush pulses every dot, like without panel state.
+
+  Every flush which changes dots writes the new frame into the EEPROM (about 3.3 ms per changed byte).
+  The 8 slots spread the writes: with a new page every ten minutes, every byte gets written once in 80 minutes.
+  Avoid a panel state for content which changes every few seconds, the EEPROM would wear out within days,
+  or store at most one frame per minute with panelState.setSaveInterval(60000).
+
+
+  This example code is in the public domain.
+ */
+
+
+// compile setPanelState(...) into the controller
+#define FlipTheDot_ColumnRowController_PANEL_STATE
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_PanelStateEEPROM.h"
+#include "FlipTheDot_Blitter.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// time from one page to the next
+const unsigned long page_interval = 600000; // milliseconds
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+// draws the texts into the frame buffer
+FlipTheDot_Blitter blitter(controller);
+
+// 8 slots at the start of the EEPROM (456 bytes)
+FlipTheDot_PanelStateEEPROM panelState(0, 8 * FlipTheDot_PanelState_SLOT_SIZE(columns, rows));
+
+uint8_t page = 0;
+unsigned long pageMillis = 0;
+
+
+void drawPage() {
+  controller.fill(false);
+  blitter.drawText(page == 0 ? "Bus" : "42", page == 0 ? 6 : 9, 4, FlipTheDot_Font5x7);
+  controller.flush();
+}
+
+
+void setup() {
+  controller.setFrameBuffer(frame, shadow);
+
+  // loads the frame which was shown before the reset
+  controller.setPanelState(&panelState);
+
+  drawPage();
+}
+
+
+void loop() {
+  if ( millis() - pageMillis >= page_interval )
+  {
+    pageMillis = millis();
+    page = 1 - page;
+    drawPage();
+  }
+}
@@ -0,0 +1,85 @@
+/*
+  Power Budget
+  Show random frames as fast as the configured average currents of the FP2800a ICs and the coils allow.
+
+  The wiring is identical to the example "FixedDefault". Instead of a fixed delay between the flips, every
+  pulse waits until it fits into the power budget: each pulse of 350 mA for 100 µs adds 35 µC to the
+  buckets of its column IC, its row IC and its coil, and the buckets drain with the allowed average current.
+  Bursts up to the bucket size run at full speed, the sustained rate is limited by the average current.
+  Measure the pulse current of your display and choose the averages according to the cooling of the ICs.
+
+
+  This example code is in the public domain.
+ */
+
+
+// compile setPowerBudget(...) into the controller
+#define FlipTheDot_ColumnRowController_POWER_BUDGET
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_PowerBudget.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// Parameter order:                 Columns,  Rows,  Pulse current (mA)
+FlipTheDot_PowerBudget budget(      columns,  rows,  350);
+
+// storage for the frame buffer, its shadow copy and the heat of every coil
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t coilHeat[columns * rows];
+
+
+void setup() {
+  Serial.begin(9600);
+
+  // each IC: 120 mA average, bursts of 350 µC (10 pulses)
+  budget.setChipBudget(120, 350);
+  // each coil: 1 mA average, bursts of 70 µC (2 pulses)
+  budget.setCoilBudget(1, 70, coilHeat);
+
+  controller.setFrameBuffer(frame, shadow);
+  controller.setPowerBudget(&budget);
+
+  delay(1000);
+}
+
+
+void loop() {
+  // draw a random frame
+  for ( int row = 1; row <= rows; row++ )
+  {
+    for ( int col = 1; col <= columns; col++ )
+    {
+      controller.setDot(col, row, random(2) == 1);
+    }
+  }
+
+  unsigned long start = millis();
+  unsigned int flipped = controller.flush();
+
+  Serial.print(flipped);
+  Serial.print(F(" dots in "));
+  Serial.print(millis() - start);
+  Serial.print(F(" ms, throttled pulses: "));
+  Serial.println(budget.getThrottledCount());
+}
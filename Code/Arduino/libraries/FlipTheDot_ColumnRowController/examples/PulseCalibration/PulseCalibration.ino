@@ -0,0 +1,113 @@
+/*
+  Pulse Calibration
+  Give every dot the shortest pulse which flips it reliably, instead of 100 µs for all dots.
+
+  The wiring is identical to the example "FixedDefault", plus a voltage divider (100 kΩ / 22 kΩ) from the
+  supply voltage of the panel to A2. The tables below are examples, measure your own panel: flip each row and
+  each column back and forth with a decreasing pulse length (setPulseLength) and note the shortest one which
+  still flips every dot of it. The shortest one of all dots becomes the base, the rest goes into the tables.
+  Add a margin of 10 to 20 %. The values are valid for the voltage at the time of the calibration (nominal),
+  the pulses get longer when the supply voltage drops and shorter when it rises.
+
+
+  This example code is in the public domain.
+ */
+
+
+// compile setPulseCalibration(...) into the controller
+#define FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_PulseCalibration.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// supply voltage at the time of the calibration
+const unsigned int nominal_millivolts = 24000;
+
+// millivolts per step of analogRead: 5000 mV / 1023 x (100 kΩ + 22 kΩ) / 22 kΩ, times 1000
+const unsigned long divider_microvolts = 27106;
+
+// extra microseconds for every row and every column
+const uint8_t rowExtra[rows] PROGMEM = { 4, 6, 8, 10, 10, 14, 17, 18, 19, 21, 22, 22, 26 };
+const uint8_t colExtra[columns] PROGMEM = { 0, 2, 0, 5, 2, 7, 4, 4, 5, 8, 6, 5, 8, 6,
+                                            9, 13, 9, 11, 10, 28, 30, 30, 31, 15, 18, 14, 18, 16 };
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// Parameter order:                          Columns,  Rows,  Base pulse length
+FlipTheDot_PulseCalibration calibration(     columns,  rows,  33);
+
+// storage for the frame buffer and its shadow copy
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+unsigned int readSupply() {
+  return (unsigned long)analogRead(A2) * divider_microvolts / 1000;
+}
+
+
+void setup() {
+  Serial.begin(9600);
+
+  // showing a dot needs 33 µs at least, hiding it 42 µs
+  calibration.setPolarity(33, 42);
+  calibration.setRowTable_P(rowExtra);
+  calibration.setColumnTable_P(colExtra);
+  calibration.setVoltage(nominal_millivolts, readSupply());
+  // never shorter than 20 µs or longer than 200 µs, e.g. if the supply is missing
+  calibration.setLimits(20, 200);
+
+  controller.setFrameBuffer(frame, shadow);
+  controller.setPulseCalibration(&calibration);
+
+  delay(1000);
+}
+
+
+void loop() {
+  // draw a random frame
+  for ( int row = 1; row <= rows; row++ )
+  {
+    for ( int col = 1; col <= columns; col++ )
+    {
+      controller.setDot(col, row, random(2) == 1);
+    }
+  }
+
+  // follow the supply voltage
+  calibration.setSupplyVoltage(readSupply());
+
+  controller.resetStatistics();
+  unsigned long start = millis();
+  unsigned int flipped = controller.flush();
+
+  Serial.print(flipped);
+  Serial.print(F(" dots in "));
+  Serial.print(millis() - start);
+  Serial.print(F(" ms, "));
+  Serial.print(controller.getStatistics().pulseMicros / 1000);
+  Serial.print(F(" ms pulses at "));
+  Serial.print(calibration.getSupplyVoltage());
+  Serial.println(F(" mV"));
+
+  delay(1000);
+}
@@ -0,0 +1,79 @@
+/*
+  Row Batch
+  Flip a whole row with one call instead of one flip(...) per dot.
+
+  The wiring is identical to the example "FixedDefault". flipRow(...) gets a row number, a bit mask of the
+  columns (bit 0 is the first column) and the data state. The row output and the data states are selected
+  once per call and only the column address changes between the pulses, so a checkerboard on the 28x13
+  display takes 13 calls instead of 364. flipColumn(...) works the same way with a mask of rows.
+  Displays with more than 32 columns need one call per 32 columns (see the last parameter).
+
+
+  This example code is in the public domain.
+ */
+
+
+// uncomment these lines to get some debug informations via the defined Serial connection
+/*
+#ifndef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+#define FlipTheDot_ColumnRowController_DEBUG_SERIAL Serial
+#endif
+*/
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+
+// every second column (1, 3, 5, ...) and the remaining ones
+const unsigned long oddColumns  = 0x05555555UL;
+const unsigned long evenColumns = 0x0AAAAAAAUL;
+
+// helper variables
+boolean inverted = false;
+
+
+void setup() {
+  // initialize debug Serial connection if defined
+  #ifdef FlipTheDot_ColumnRowController_DEBUG_SERIAL
+  FlipTheDot_ColumnRowController_DEBUG_SERIAL.begin(9600);
+  #endif
+
+  delay(1000);
+}
+
+
+void loop() {
+  // draw a checkerboard, one row per call for the shown dots and one for the hidden dots
+  for ( int row = 1; row <= rows; row++ )
+  {
+    boolean odd = (row % 2 == 1) != inverted;
+
+    controller.flipRow(row, odd ? oddColumns : evenColumns, true);
+    controller.flipRow(row, odd ? evenColumns : oddColumns, false);
+  }
+
+  // invert the checkerboard
+  inverted = !inverted;
+
+  delay(1000);
+}
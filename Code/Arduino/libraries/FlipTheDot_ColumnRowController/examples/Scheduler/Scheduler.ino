@@ -0,0 +1,116 @@
+/*
+  Scheduler
+  Show the seconds of a clock next to an animation of falling dots. The clock digits flip within 20 ms of every
+  second, also while a frame of the animation is being pulsed.
+
+  The wiring is identical to the example "FrameBuffer". Both parts draw into the frame buffer and schedule their
+  region with a deadline, the scheduler pulses the changed dots earliest deadline first. The animation has the
+  lower priority, when there are more changes than the pulse rate limit allows, its frames slip and get replaced
+  before they are complete. Every 10 seconds the missed deadlines of both
+  regions get printed on the serial monitor.
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Scheduler.h"
+#include "FlipTheDot_Blitter.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+FlipTheDot_Scheduler scheduler(controller);
+FlipTheDot_Blitter blitter(controller);
+int clockRegion;
+int animationRegion;
+
+unsigned long lastSecond = 0;
+unsigned long lastFrame = 0;
+unsigned long lastReport = 0;
+unsigned int seconds = 0;
+
+
+void drawDigit(int col, int digit) {
+  char text[2] = { (char)('0' + digit), '\0' };
+  blitter.drawText(text, col, 4, FlipTheDot_Font5x7);
+}
+
+
+void setup() {
+  Serial.begin(9600);
+
+  controller.setFrameBuffer(frame, shadow);
+  // the scheduler needs the shown state
+  controller.invalidate();
+  controller.flush();
+
+  // Parameter order:                  Column, Row, Columns, Rows, Priority
+  clockRegion = scheduler.addRegion(    17,     4,   12,      7,    1);
+  animationRegion = scheduler.addRegion(1,      1,   16,      13,   0);
+
+  // at most 2000 dots per second, bursts of 10 dots
+  scheduler.setPulseRate(2000, 10);
+}
+
+
+void loop() {
+  unsigned long now = millis();
+
+  if ( now - lastSecond >= 1000 )
+  {
+    lastSecond += 1000;
+    seconds = (seconds + 1) % 60;
+    drawDigit(18, seconds / 10);
+    drawDigit(24, seconds % 10);
+    scheduler.schedule(clockRegion, 20000);
+  }
+
+  // every dot falls one row, new dots on top
+  if ( now - lastFrame >= 100 )
+  {
+    lastFrame = now;
+    for ( int col = 1; col <= 16; col++ )
+    {
+      for ( int row = rows; row > 1; row-- )
+      {
+        controller.setDot(col, row, controller.getDot(col, row - 1));
+      }
+      controller.setDot(col, 1, random(2) == 0);
+    }
+    scheduler.schedule(animationRegion, 100000);
+  }
+
+  scheduler.update();
+
+  if ( now - lastReport >= 10000 )
+  {
+    lastReport = now;
+    Serial.print(F("clock missed: "));       Serial.print(scheduler.getStatistics(clockRegion).missed);
+    Serial.print(F(", max latency: "));      Serial.print(scheduler.getStatistics(clockRegion).maxLatencyMicros);
+    Serial.print(F(" us, animation missed: ")); Serial.println(scheduler.getStatistics(animationRegion).missed);
+  }
+}
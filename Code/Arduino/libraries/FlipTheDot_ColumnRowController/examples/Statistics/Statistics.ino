@@ -0,0 +1,130 @@
+/*
+  Statistics
+  Show where the refresh time goes: counters of the controllers and histograms of the pulse timing.
+
+  The wiring is identical to the example "FrameBuffer". Every ten frames the sketch prints
+  - the controller counters: pulses, dots, the time spent in flush() split into pulse time,
+    power budget waits and the rest (selecting outputs and data states),
+  - the counters of the column FP2800a: redundant setOutput(...) calls, rejected calls, address line changes,
+  - the histograms of the enable high time and of the time between two pulses of the column FP2800a.
+  Then all counters get reset.
+
+  The counters are always available, the histograms cost about 100 bytes of RAM and two micros() calls
+  per pulse for every FP2800a, so they are only compiled with FlipTheDot_FP2800a_HISTOGRAM defined before the include.
+
+
+  This example code is in the public domain.
+ */
+
+
+// compile the histograms of the pulse timing
+#define FlipTheDot_FP2800a_HISTOGRAM
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+// helper variables
+int barColumn = 1;
+int frameNo = 0;
+
+
+void printHistogram(const char *name, const unsigned long *histogram) {
+  Serial.println(name);
+  for ( uint8_t bin = 0; bin < FlipTheDot_FP2800a_HISTOGRAM_BINS; bin++ )
+  {
+    Serial.print(F("  >= "));
+    Serial.print(FlipTheDot_FP2800a::getHistogramBinStart(bin));
+    Serial.print(F(" us: "));
+    Serial.println(histogram[bin]);
+  }
+}
+
+
+void printStatistics() {
+  const FlipTheDot_ColumnRowControllerStatistics &stats = controller.getStatistics();
+
+  Serial.print(F("flushes: "));        Serial.print(stats.flushes);
+  Serial.print(F(", pulses: "));       Serial.print(stats.pulses);
+  Serial.print(F(", dots: "));         Serial.print(stats.dots);
+  Serial.print(F(", rejected: "));     Serial.println(stats.rejectedFlips);
+  Serial.print(F("busy: "));           Serial.print(stats.busyMicros);
+  Serial.print(F(" us, pulsing: "));   Serial.print(stats.pulseMicros);
+  Serial.print(F(" us, waiting: "));   Serial.print(stats.waitMicros);
+  Serial.print(F(" us, selecting: ")); Serial.print(stats.busyMicros - stats.pulseMicros - stats.waitMicros);
+  Serial.println(F(" us"));
+
+  const FlipTheDot_FP2800aStatistics &column = columnController.getStatistics();
+
+  Serial.print(F("columns: pulses: "));       Serial.print(column.pulses);
+  Serial.print(F(", redundant outputs: "));   Serial.print(column.redundantOutputs);
+  Serial.print(F(", rejected: "));            Serial.print(column.rejectedCalls);
+  Serial.print(F(", address changes: "));     Serial.println(column.addressToggles);
+
+  #ifdef FlipTheDot_FP2800a_HISTOGRAM
+  Serial.print(F("pulse length: "));   Serial.print(column.minPulseMicros);
+  Serial.print(F(" - "));              Serial.print(column.maxPulseMicros);
+  Serial.print(F(" us, shortest gap: ")); Serial.print(column.minGapMicros);
+  Serial.println(F(" us"));
+  printHistogram("pulse length", column.pulseHistogram);
+  printHistogram("gap between pulses", column.gapHistogram);
+  #endif
+
+  controller.resetStatistics();
+  columnController.resetStatistics();
+  rowController.resetStatistics();
+}
+
+
+void setup() {
+  Serial.begin(9600);
+
+  controller.setFrameBuffer(frame, shadow);
+
+  delay(1000);
+}
+
+
+void loop() {
+  // draw the next frame
+  controller.fill(false);
+  for ( int row = 1; row <= rows; row++ )
+  {
+    controller.setDot(barColumn, row, true);
+  }
+  controller.flush();
+
+  barColumn = barColumn >= columns ? 1 : barColumn + 1;
+
+  if ( ++frameNo >= 10 )
+  {
+    frameNo = 0;
+    printStatistics();
+  }
+
+  delay(100);
+}
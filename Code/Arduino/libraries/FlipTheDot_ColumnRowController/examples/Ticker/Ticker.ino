@@ -0,0 +1,71 @@
+/*
+  Ticker
+  Scroll a route text thru the middle of the panel with the built-in 5x7 font.
+
+  The wiring is identical to the example "FrameBuffer". The ticker keeps one byte per panel column and creates
+  the columns of the text while scrolling, so a long text in flash needs no additional RAM.
+  Only the dots which differ from the previous step get pulsed. The rows above and below the text belong
+  to the sketch: a line is drawn on the top and the bottom row once and stays untouched by the ticker.
+
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Ticker.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// size of the display
+const int columns = 28;
+const int rows    = 13;
+
+// setup the objects for the fixed FP2800a rows controller and FP2800a columns controller
+// Parameter order:                      Enable Reset, Enable Set,  A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800aFixed rowController(   A0,           2,           3,  4,  5,  6,  7,   fp2800a_pulse_length);
+// Parameter order:                      Enable,       Data,        A0, A1, A2, B0, B1,  Pulse length
+FlipTheDot_FP2800a columnController(     A1,           8,           9,  10, 11, 12, 13,  fp2800a_pulse_length);
+
+
+// wrap independent column and row controllers in one object for easier usage
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows, fp2800a_pulse_length);
+
+// storage for the desired frame and the state which is currently shown on the panel
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+// one byte per column for the ticker, the text rows start at row 4
+uint8_t window[columns];
+FlipTheDot_Ticker ticker(controller, window, FlipTheDot_Font5x7, 4);
+
+// the text stays in flash
+const char routeText[] PROGMEM = "Line 42 - Hauptbahnhof via Rathaus, Marktplatz und Stadion";
+
+
+void setup() {
+  controller.setFrameBuffer(frame, shadow);
+
+  controller.fill(false);
+  for ( int col = 1; col <= columns; col++ )
+  {
+    controller.setDot(col, 1, true);
+    controller.setDot(col, rows, true);
+  }
+  controller.flush();
+
+  ticker.setText_P(routeText);
+
+  // 25 steps per second, use 0 to scroll as fast as the coils allow
+  ticker.setStepInterval(40000);
+}
+
+
+void loop() {
+  ticker.update();
+}
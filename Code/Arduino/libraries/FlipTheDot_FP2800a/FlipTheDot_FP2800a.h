@@ -92,14 +92,88 @@
 #define FlipTheDot_FP2800a_h
 
 #include "Arduino.h"
+#include "FlipTheDot_FP2800aTrace.h"
+#include "FlipTheDot_FP2800aBackend.h"
+
+
+// address line levels for the outputs 1 to 28 (bit 0: A0, 1: A1, 2: A2, 3: B0, 4: B1)
+const uint8_t FlipTheDot_FP2800a_ADDRESS_TABLE[28] PROGMEM = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+    0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+};
+
+// order of the outputs 1 to 28 in which only one address line changes from one output to the next
+// (reflected Gray code of A0 - A2 inside each B0/B1 block, the blocks in Gray code order as well)
+const uint8_t FlipTheDot_FP2800a_GRAY_ORDER[28] PROGMEM = {
+     1,  3,  2,  6,  7,  5,  4,
+    11, 12, 14, 13,  9, 10,  8,
+    22, 24, 23, 27, 28, 26, 25,
+    18, 19, 21, 20, 16, 17, 15
+};
+
+
+// entry of an output map (see setOutputMap): the IC (0 - 7) in the upper 3 bits, its output (1 - 28) in the lower 5 bits
+#define FlipTheDot_FP2800a_MAP(chip, output) ( (uint8_t)( ((chip) << 5) | (output) ) )
+
+
+// number of bins of the pulse and gap histograms (see FlipTheDot_FP2800aStatistics)
+#ifndef FlipTheDot_FP2800a_HISTOGRAM_BINS
+#define FlipTheDot_FP2800a_HISTOGRAM_BINS 10
+#endif
+
+/*
+  Counters of every FP2800a object, always available thru getStatistics().
+  The pulse and gap times need two micros() calls per pulse and the RAM of the histograms, so they are only
+  compiled with FlipTheDot_FP2800a_HISTOGRAM defined before including the library.
+  The times are measured with micros() (4 µs resolution on a 16 MHz AVR).
+  Histogram bin 0 counts durations up to 7 µs, bin n (n > 0) from 4 * 2^n to 4 * 2^(n+1) - 1 µs
+  (8, 16, 32, 64, 128, ...) and the last bin everything above.
+*/
+struct FlipTheDot_FP2800aStatistics
+{
+    unsigned long pulses;            // enable() calls
+    unsigned long redundantOutputs;  // setOutput(...) calls for the already selected output
+    unsigned long rejectedCalls;     // rejected setOutput(...), setOutputGroup(...) and setData(...) calls
+    unsigned long addressToggles;    // level changes of the address lines A0, A1, A2, B0 and B1
+
+    #ifdef FlipTheDot_FP2800a_HISTOGRAM
+    unsigned int minPulseMicros;     // shortest and longest time the enable pin was HIGH
+    unsigned int maxPulseMicros;
+    unsigned int minGapMicros;       // shortest time from the end of a pulse to the start of the next one
+    unsigned long pulseHistogram[FlipTheDot_FP2800a_HISTOGRAM_BINS];
+    unsigned long gapHistogram[FlipTheDot_FP2800a_HISTOGRAM_BINS];
+    #endif
+};
+
+
+#ifdef FlipTheDot_FP2800a_PORT_IO
+/*
+  Direct port register access:
+  Define FlipTheDot_FP2800a_PORT_IO before including the library to write the pins thru their
+  port registers instead of digitalWrite(...). The register and bit mask of every pin gets resolved
+  once and the address lines are updated with one masked write per port.
+*/
+#ifndef portOutputRegister
+#error "FlipTheDot_FP2800a_PORT_IO requires an architecture with portOutputRegister(...) like AVR"
+#endif
+
+struct FlipTheDot_FP2800aPortPin
+{
+    volatile uint8_t *reg;
+    uint8_t mask;
+};
+
+#endif
 
 
 
 class FlipTheDot_FP2800a
 {
     public:
-        FlipTheDot_FP2800a(){};
-        FlipTheDot_FP2800a(unsigned int pinEnable, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMicros);
+        FlipTheDot_FP2800a(){ resetStatistics(); };
+        FlipTheDot_FP2800a(unsigned int pinEnable, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMicros, FlipTheDot_FP2800aBackend *backend);
         ~FlipTheDot_FP2800a();
         virtual void pulse();
         virtual bool setOutput(unsigned int no);
@@ -111,9 +185,24 @@ class FlipTheDot_FP2800a
         virtual void enable();
         virtual void disable();
         virtual bool isEnabled();
+        virtual unsigned int getChipCount();
+        virtual unsigned int getMaxEnabledChips();
+        virtual bool setOutputGroup(unsigned int no, unsigned long chipMask);
+        void setOutputMap(const uint8_t *map, unsigned int length);
+        const uint8_t *getOutputMap();
+        const FlipTheDot_FP2800aStatistics &getStatistics();
+        void resetStatistics();
+        static unsigned long getHistogramBinStart(uint8_t bin);
 
     protected:
         virtual void _initPins();
+        bool _selectOutput(unsigned int no);
+        uint8_t _readOutputMap(unsigned int no);
+        void _initPin(unsigned int pin);
+        void _write(unsigned int pin, bool is_high);
+        void _countEnable();
+        void _countDisable();
+        static uint8_t _histogramBin(unsigned long micros);
 
         virtual bool _hasDuplicatePins();
         unsigned int _pulseLengthMicros;
@@ -130,15 +219,41 @@ class FlipTheDot_FP2800a
 
         unsigned int _selectedOutput;
 
+        // logical output numbers to IC and output, in flash (see setOutputMap)
+        const uint8_t *_outputMap = NULL;
+        unsigned int _outputMapLength = 0;
+        unsigned int _mappedOutput = 0;
+
         bool _isEnabled = false;
 
         const unsigned int _maxOutputsOnChip = 28;
+
+        // pins are written thru the backend if set, see FlipTheDot_FP2800aBackend
+        FlipTheDot_FP2800aBackend *_backend = NULL;
+
+        FlipTheDot_FP2800aStatistics _statistics;
+        #ifdef FlipTheDot_FP2800a_HISTOGRAM
+        unsigned long _enabledMicros = 0;
+        unsigned long _disabledMicros = 0;
+        bool _hasPulsed = false;
+        #endif
+
+        #ifdef FlipTheDot_FP2800a_PORT_IO
+        void _resolvePin(FlipTheDot_FP2800aPortPin &pin, unsigned int no);
+        void _writePin(FlipTheDot_FP2800aPortPin &pin, bool is_high);
+        void _writeAddress(uint8_t lines);
+
+        FlipTheDot_FP2800aPortPin _portData;
+        FlipTheDot_FP2800aPortPin _portEnable;
+        FlipTheDot_FP2800aPortPin _portAddress[5]; // A0, A1, A2, B0, B1
+        #endif
 };
 
 
-FlipTheDot_FP2800a::FlipTheDot_FP2800a(unsigned int pinEnable, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMicros = 100)
+FlipTheDot_FP2800a::FlipTheDot_FP2800a(unsigned int pinEnable, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMicros = 100, FlipTheDot_FP2800aBackend *backend = NULL)
 {
     _pulseLengthMicros = pulseLengthMicros;
+    _backend = backend;
 
     _pinData = pinData;
     _pinEnable = pinEnable;
@@ -161,6 +276,7 @@ FlipTheDot_FP2800a::FlipTheDot_FP2800a(unsigned int pinEnable, unsigned int pinD
     }
 
     _selectedOutput = 0;
+    resetStatistics();
 
     _initPins();
 }
@@ -169,15 +285,15 @@ FlipTheDot_FP2800a::FlipTheDot_FP2800a(unsigned int pinEnable, unsigned int pinD
 FlipTheDot_FP2800a::~FlipTheDot_FP2800a()
 {
     // set all pins low to avoid burnout of the chip
-    digitalWrite(_pinData, LOW);
-    digitalWrite(_pinEnable, LOW);
+    _write(_pinData, LOW);
+    _write(_pinEnable, LOW);
 
-    digitalWrite(_pinA0, LOW);
-    digitalWrite(_pinA1, LOW);
-    digitalWrite(_pinA2, LOW);
+    _write(_pinA0, LOW);
+    _write(_pinA1, LOW);
+    _write(_pinA2, LOW);
 
-    digitalWrite(_pinB0, LOW);
-    digitalWrite(_pinEnable, LOW);
+    _write(_pinB0, LOW);
+    _write(_pinEnable, LOW);
 }
 
 
@@ -203,23 +319,31 @@ bool FlipTheDot_FP2800a::_hasDuplicatePins()
 
 void FlipTheDot_FP2800a::_initPins()
 {
-    pinMode(_pinData, OUTPUT);
-    digitalWrite(_pinData, LOW);
+    _initPin(_pinData);
+    _initPin(_pinEnable);
 
-    pinMode(_pinEnable, OUTPUT);
-    digitalWrite(_pinEnable, LOW);
+    _initPin(_pinA0);
+    _initPin(_pinA1);
+    _initPin(_pinA2);
 
-    pinMode(_pinA0, OUTPUT);
-    digitalWrite(_pinA0, LOW);
-    pinMode(_pinA1, OUTPUT);
-    digitalWrite(_pinA1, LOW);
-    pinMode(_pinA2, OUTPUT);
-    digitalWrite(_pinA2, LOW);
+    _initPin(_pinB0);
+    _initPin(_pinB1);
 
-    pinMode(_pinB0, OUTPUT);
-    digitalWrite(_pinB0, LOW);
-    pinMode(_pinB1, OUTPUT);
-    digitalWrite(_pinB1, LOW);
+    if ( _backend != NULL )
+    {
+        _backend->commit();
+        return;
+    }
+
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    _resolvePin(_portData, _pinData);
+    _resolvePin(_portEnable, _pinEnable);
+    _resolvePin(_portAddress[0], _pinA0);
+    _resolvePin(_portAddress[1], _pinA1);
+    _resolvePin(_portAddress[2], _pinA2);
+    _resolvePin(_portAddress[3], _pinB0);
+    _resolvePin(_portAddress[4], _pinB1);
+    #endif
 
     #ifdef FlipTheDot_FP2800a_DEBUG_SERIAL
     //FlipTheDot_FP2800a_DEBUG_SERIAL.println( F("FlipTheDot_FP2800a pins initialized") );
@@ -227,6 +351,38 @@ void FlipTheDot_FP2800a::_initPins()
 }
 
 
+/**
+ * set a pin to output with LOW level, thru the backend if there is one (applied with its next commit)
+ */
+void FlipTheDot_FP2800a::_initPin(unsigned int pin)
+{
+    if ( _backend != NULL )
+    {
+        _backend->initPin(pin);
+        return;
+    }
+
+    pinMode(pin, OUTPUT);
+    digitalWrite(pin, LOW);
+}
+
+
+/**
+ * write a single pin with digitalWrite(...) or thru the backend, which applies it immediately
+ */
+void FlipTheDot_FP2800a::_write(unsigned int pin, bool is_high)
+{
+    if ( _backend != NULL )
+    {
+        _backend->writePin(pin, is_high);
+        _backend->commit();
+        return;
+    }
+
+    digitalWrite(pin, is_high == true ? HIGH : LOW);
+}
+
+
 /**
  * define if the output should source or sink current
  * can only be changed when enabled is low
@@ -238,6 +394,8 @@ bool FlipTheDot_FP2800a::setData(bool is_high)
         #ifdef FlipTheDot_FP2800a_DEBUG_SERIAL
         FlipTheDot_FP2800a_DEBUG_SERIAL.println( F("FlipTheDot_FP2800a data cannot be changed when IC is already enabled") );
         #endif
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_DATA, _pinData, is_high);
+        _statistics.rejectedCalls++;
         return false;
     }
 
@@ -248,7 +406,17 @@ bool FlipTheDot_FP2800a::setData(bool is_high)
     FlipTheDot_FP2800a_DEBUG_SERIAL.println( F(")") );
     #endif
 
-    digitalWrite(_pinData, is_high == true ? HIGH : LOW);
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        _writePin(_portData, is_high);
+    }
+    else
+    #endif
+    {
+        _write(_pinData, is_high);
+    }
+    FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_DATA, _pinData, is_high);
 
     return true;
 }
@@ -274,15 +442,38 @@ unsigned int FlipTheDot_FP2800a::getPulseLength()
 
 /**
  * switch pins (A0, A1, A2, B0, B1) to HIGH/LOW to define which pin should be enabled during F2800::pulse
+ * with an output map, no is the logical output number which gets translated by the map
  * can only be changed when enabled is low
  */
 bool FlipTheDot_FP2800a::setOutput(unsigned int no)
+{
+    if ( _outputMap == NULL )
+    {
+        return _selectOutput(no);
+    }
+
+    // a single IC only accepts entries of IC 0, other entries are out of range
+    if ( !_selectOutput( _readOutputMap(no) ) )
+    {
+        return false;
+    }
+    _mappedOutput = no;
+    return true;
+}
+
+
+/**
+ * select the output (1 to 28) of the IC, without output map
+ */
+bool FlipTheDot_FP2800a::_selectOutput(unsigned int no)
 {
     if ( isEnabled() == true )
     {
         #ifdef FlipTheDot_FP2800a_DEBUG_SERIAL
         FlipTheDot_FP2800a_DEBUG_SERIAL.println( F("FlipTheDot_FP2800a output cannot be selected when IC is already enabled") );
         #endif
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_OUTPUT, _pinA0, no);
+        _statistics.rejectedCalls++;
         return false;
     }
 
@@ -292,6 +483,7 @@ bool FlipTheDot_FP2800a::setOutput(unsigned int no)
         FlipTheDot_FP2800a_DEBUG_SERIAL.print( F("FlipTheDot_FP2800a Output already selected: ") );
         FlipTheDot_FP2800a_DEBUG_SERIAL.println(no);
         #endif
+        _statistics.redundantOutputs++;
         return true;
     }
     else if ( no < 1 || no > _maxOutputsOnChip )
@@ -302,73 +494,57 @@ bool FlipTheDot_FP2800a::setOutput(unsigned int no)
         FlipTheDot_FP2800a_DEBUG_SERIAL.print( F(" is out of range 1 to ") );
         FlipTheDot_FP2800a_DEBUG_SERIAL.println(_maxOutputsOnChip);
         #endif
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_OUTPUT, _pinA0, no);
+        _statistics.rejectedCalls++;
         return false;
     }
     else
     {
+        // all address lines are LOW before the first output gets selected
+        uint8_t previousLines = _selectedOutput > 0 ? pgm_read_byte(&FlipTheDot_FP2800a_ADDRESS_TABLE[_selectedOutput - 1]) : 0;
+        uint8_t lines = pgm_read_byte(&FlipTheDot_FP2800a_ADDRESS_TABLE[no - 1]);
+        uint8_t changed = lines ^ previousLines;
+
         _selectedOutput = no;
-        if ( no > 14 )
-        {
-            // 1????
-            digitalWrite(_pinB1, HIGH);
-            no = no-14;
-        }
-        else
-        {
-            // 0????
-            digitalWrite(_pinB1, LOW);
-        }
 
-        if ( no > 7 )
+        #ifdef FlipTheDot_FP2800a_PORT_IO
+        if ( _backend == NULL )
         {
-            // ?1???
-            digitalWrite(_pinB0, HIGH);
-            no = no-7;
+            _writeAddress(lines);
+            for ( ; changed != 0; changed >>= 1 )
+            {
+                _statistics.addressToggles += changed & 1;
+            }
         }
         else
+        #endif
         {
-            // ?0???
-            digitalWrite(_pinB0, LOW);
-        }
-
-        switch (no)
-        {
-            case 1: // ??001
-                digitalWrite(_pinA2, LOW);
-                digitalWrite(_pinA1, LOW);
-                digitalWrite(_pinA0, HIGH);
-            break;
-            case 2: // ??010
-                digitalWrite(_pinA2, LOW);
-                digitalWrite(_pinA1, HIGH);
-                digitalWrite(_pinA0, LOW);
-            break;
-            case 3: // ??011
-                digitalWrite(_pinA2, LOW);
-                digitalWrite(_pinA1, HIGH);
-                digitalWrite(_pinA0, HIGH);
-            break;
-            case 4: // ??100
-                digitalWrite(_pinA2, HIGH);
-                digitalWrite(_pinA1, LOW);
-                digitalWrite(_pinA0, LOW);
-            break;
-            case 5: // ??101
-                digitalWrite(_pinA2, HIGH);
-                digitalWrite(_pinA1, LOW);
-                digitalWrite(_pinA0, HIGH);
-            break;
-            case 6: // ??110
-                digitalWrite(_pinA2, HIGH);
-                digitalWrite(_pinA1, HIGH);
-                digitalWrite(_pinA0, LOW);
-            break;
-            case 7: // ??111
-                digitalWrite(_pinA2, HIGH);
-                digitalWrite(_pinA1, HIGH);
-                digitalWrite(_pinA0, HIGH);
-            break;
+            // only write the address lines which differ from the previously selected output
+            unsigned int pins[5] = { _pinA0, _pinA1, _pinA2, _pinB0, _pinB1 };
+
+            for ( uint8_t i = 0; changed != 0; i++, changed >>= 1 )
+            {
+                if ( changed & 1 )
+                {
+                    if ( _backend != NULL )
+                    {
+                        _backend->writePin(pins[i], (lines >> i) & 1);
+                    }
+                    else
+                    {
+                        digitalWrite(pins[i], (lines >> i) & 1 ? HIGH : LOW);
+                    }
+                    _statistics.addressToggles++;
+                }
+            }
+
+            // all address lines change at once
+            if ( _backend != NULL )
+            {
+                _backend->commit();
+            }
         }
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_ADDRESS, _pinA0, no);
 
         #ifdef FlipTheDot_FP2800a_DEBUG_SERIAL
         FlipTheDot_FP2800a_DEBUG_SERIAL.print( F("FlipTheDot_FP2800a output ") );
@@ -386,7 +562,7 @@ bool FlipTheDot_FP2800a::setOutput(unsigned int no)
  */
 unsigned int FlipTheDot_FP2800a::getOutput()
 {
-    return _selectedOutput;
+    return _outputMap != NULL ? _mappedOutput : _selectedOutput;
 }
 
 
@@ -395,7 +571,38 @@ unsigned int FlipTheDot_FP2800a::getOutput()
  */
 unsigned int FlipTheDot_FP2800a::getOutputMax()
 {
-    return _maxOutputsOnChip;
+    return _outputMap != NULL ? _outputMapLength : _maxOutputsOnChip;
+}
+
+
+/**
+ * translate the output numbers 1 to length of setOutput(...) with a table in flash (PROGMEM), NULL removes the map
+ * entry n - 1 is the IC and output of the logical output n, see FlipTheDot_FP2800a_MAP(chip, output)
+ * so the wiring of a panel is resolved at compile time and the drawing code keeps its linear numbers
+ */
+void FlipTheDot_FP2800a::setOutputMap(const uint8_t *map, unsigned int length)
+{
+    _outputMap = length > 0 ? map : NULL;
+    _outputMapLength = _outputMap != NULL ? length : 0;
+    _mappedOutput = 0;
+}
+
+
+/**
+ * get the output map, NULL if the output numbers are not translated
+ */
+const uint8_t *FlipTheDot_FP2800a::getOutputMap()
+{
+    return _outputMap;
+}
+
+
+/**
+ * get the map entry of a logical output, 0 (invalid output) if it is out of range
+ */
+uint8_t FlipTheDot_FP2800a::_readOutputMap(unsigned int no)
+{
+    return no >= 1 && no <= _outputMapLength ? pgm_read_byte(&_outputMap[no - 1]) : 0;
 }
 
 
@@ -409,7 +616,18 @@ void FlipTheDot_FP2800a::enable()
     FlipTheDot_FP2800a_DEBUG_SERIAL.println( F("FlipTheDot_FP2800a enabling") );
     #endif
     _isEnabled = true;
-    digitalWrite(_pinEnable, HIGH);
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        _writePin(_portEnable, true);
+    }
+    else
+    #endif
+    {
+        _write(_pinEnable, HIGH);
+    }
+    FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_ENABLE, _pinEnable, HIGH);
+    _countEnable();
 }
 
 
@@ -418,7 +636,18 @@ void FlipTheDot_FP2800a::enable()
  */
 void FlipTheDot_FP2800a::disable()
 {
-    digitalWrite(_pinEnable, LOW);
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        _writePin(_portEnable, false);
+    }
+    else
+    #endif
+    {
+        _write(_pinEnable, LOW);
+    }
+    FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_DISABLE, _pinEnable, LOW);
+    _countDisable();
     _isEnabled = false;
     #ifdef FlipTheDot_FP2800a_DEBUG_SERIAL
     FlipTheDot_FP2800a_DEBUG_SERIAL.println( F("FlipTheDot_FP2800a disabled") );
@@ -438,6 +667,128 @@ bool FlipTheDot_FP2800a::isEnabled()
 }
 
 
+/**
+ * get the number of ICs which are controlled by this object
+ */
+unsigned int FlipTheDot_FP2800a::getChipCount()
+{
+    return 1;
+}
+
+
+/**
+ * get the number of ICs which are allowed to be enabled at the same time (see setOutputGroup)
+ */
+unsigned int FlipTheDot_FP2800a::getMaxEnabledChips()
+{
+    return 1;
+}
+
+
+/**
+ * select the output no (1 to 28) on all ICs of the chip mask (bit 0 = first IC), which get enabled together
+ * a single IC only supports the chip mask 1
+ */
+bool FlipTheDot_FP2800a::setOutputGroup(unsigned int no, unsigned long chipMask)
+{
+    if ( chipMask != 1 )
+    {
+        _statistics.rejectedCalls++;
+        return false;
+    }
+    return setOutput(no);
+}
+
+
+/**
+ * get the counters and histograms since the initialization or the last resetStatistics()
+ */
+const FlipTheDot_FP2800aStatistics &FlipTheDot_FP2800a::getStatistics()
+{
+    return _statistics;
+}
+
+
+/**
+ * set all counters and histograms to zero
+ */
+void FlipTheDot_FP2800a::resetStatistics()
+{
+    memset(&_statistics, 0, sizeof(_statistics));
+
+    #ifdef FlipTheDot_FP2800a_HISTOGRAM
+    _statistics.minPulseMicros = 0xFFFF;
+    _statistics.minGapMicros = 0xFFFF;
+    _hasPulsed = false;
+    #endif
+}
+
+
+/**
+ * get the shortest duration (µs) which gets counted in a histogram bin
+ */
+unsigned long FlipTheDot_FP2800a::getHistogramBinStart(uint8_t bin)
+{
+    return bin == 0 ? 0 : 4UL << bin;
+}
+
+
+uint8_t FlipTheDot_FP2800a::_histogramBin(unsigned long micros)
+{
+    uint8_t bin = 0;
+
+    for ( micros >>= 3; micros != 0 && bin < FlipTheDot_FP2800a_HISTOGRAM_BINS - 1; micros >>= 1 )
+    {
+        bin++;
+    }
+    return bin;
+}
+
+
+/**
+ * count a rising enable pin, called right after the pin(s) got HIGH
+ */
+void FlipTheDot_FP2800a::_countEnable()
+{
+    _statistics.pulses++;
+
+    #ifdef FlipTheDot_FP2800a_HISTOGRAM
+    _enabledMicros = micros();
+    if ( _hasPulsed )
+    {
+        unsigned long gap = _enabledMicros - _disabledMicros;
+        _statistics.gapHistogram[_histogramBin(gap)]++;
+        _statistics.minGapMicros = gap < _statistics.minGapMicros ? gap : _statistics.minGapMicros;
+    }
+    #endif
+}
+
+
+/**
+ * measure the enable time, called right after the pin(s) got LOW
+ */
+void FlipTheDot_FP2800a::_countDisable()
+{
+    #ifdef FlipTheDot_FP2800a_HISTOGRAM
+    if ( !_isEnabled )
+    {
+        return;
+    }
+
+    _disabledMicros = micros();
+    _hasPulsed = true;
+
+    unsigned long length = _disabledMicros - _enabledMicros;
+    _statistics.pulseHistogram[_histogramBin(length)]++;
+    _statistics.minPulseMicros = length < _statistics.minPulseMicros ? length : _statistics.minPulseMicros;
+    if ( length > _statistics.maxPulseMicros )
+    {
+        _statistics.maxPulseMicros = length > 0xFFFF ? 0xFFFF : length;
+    }
+    #endif
+}
+
+
 /**
  * enable the selected port for a given time (defined by the pulse length)
  */
@@ -462,5 +813,70 @@ void FlipTheDot_FP2800a::pulse()
 }
 
 
+#ifdef FlipTheDot_FP2800a_PORT_IO
+/**
+ * lookup the port register and bit mask of an Arduino pin number
+ */
+void FlipTheDot_FP2800a::_resolvePin(FlipTheDot_FP2800aPortPin &pin, unsigned int no)
+{
+    pin.reg = portOutputRegister( digitalPinToPort(no) );
+    pin.mask = digitalPinToBitMask(no);
+}
+
+
+/**
+ * set a single pin thru its port register
+ * interrupts are blocked like in digitalWrite(...), because an ISR could change other pins of the same port
+ */
+void FlipTheDot_FP2800a::_writePin(FlipTheDot_FP2800aPortPin &pin, bool is_high)
+{
+    uint8_t oldSREG = SREG;
+    cli();
+
+    if ( is_high )
+    {
+        *pin.reg |= pin.mask;
+    }
+    else
+    {
+        *pin.reg &= ~pin.mask;
+    }
+
+    SREG = oldSREG;
+}
+
+
+/**
+ * set all address lines (A0, A1, A2, B0, B1) at once
+ * following pins on the same port are combined into one masked register update
+ */
+void FlipTheDot_FP2800a::_writeAddress(uint8_t lines)
+{
+    uint8_t oldSREG = SREG;
+    cli();
+
+    for ( uint8_t i = 0; i < 5; )
+    {
+        volatile uint8_t *reg = _portAddress[i].reg;
+        uint8_t mask = 0;
+        uint8_t value = 0;
+
+        for ( ; i < 5 && _portAddress[i].reg == reg; i++ )
+        {
+            mask |= _portAddress[i].mask;
+            if ( (lines >> i) & 1 )
+            {
+                value |= _portAddress[i].mask;
+            }
+        }
+
+        *reg = (*reg & ~mask) | value;
+    }
+
+    SREG = oldSREG;
+}
+#endif
+
+
 
 #endif // FlipTheDot_FP2800a_h
\ No newline at end of file
@@ -0,0 +1,37 @@
+/*
+ * FlipTheDot_FP2800aBackend Class  -- Interface for pins which are not wired to the microcontroller directly
+ *
+ * By default the FP2800a classes write their pins with digitalWrite(...) (or the port registers, see
+ * FlipTheDot_FP2800a_PORT_IO). A backend passed as last constructor parameter takes over all pin writes,
+ * the pin numbers are then numbers of the backend, e.g. the outputs of a shift register chain
+ * (see FlipTheDot_FP2800aShiftRegister).
+ *
+ * The FP2800a classes call writePin(...) for every line which changes and commit() once afterwards,
+ * so a backend can collect all changes of a setOutput(...), setData(...), enable() or disable() call
+ * and apply them at once. The lines have to be applied in call order of commit(): address and data
+ * before the enable line rises.
+ */
+
+
+#ifndef FlipTheDot_FP2800aBackend_h
+#define FlipTheDot_FP2800aBackend_h
+
+#include "Arduino.h"
+
+
+
+class FlipTheDot_FP2800aBackend
+{
+    public:
+        virtual ~FlipTheDot_FP2800aBackend() {};
+        // use the pin as output with LOW level (applied with the next commit)
+        virtual void initPin(unsigned int pin) = 0;
+        // change the level of a pin (applied with the next commit)
+        virtual void writePin(unsigned int pin, bool is_high) = 0;
+        // apply all pending pin changes at once
+        virtual void commit() = 0;
+};
+
+
+
+#endif // FlipTheDot_FP2800aBackend_h
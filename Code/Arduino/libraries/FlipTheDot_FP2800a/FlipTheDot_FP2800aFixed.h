@@ -22,7 +22,7 @@ class FlipTheDot_FP2800aFixed : public FlipTheDot_FP2800a
 {
     public:
         // identical to FP2800a but with renamed parameters and different interal handling
-        FlipTheDot_FP2800aFixed(unsigned int pinEnableReset, unsigned int pinEnableSet, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis);
+        FlipTheDot_FP2800aFixed(unsigned int pinEnableReset, unsigned int pinEnableSet, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis, FlipTheDot_FP2800aBackend *backend);
         bool setData(bool is_high);
 
     protected:
@@ -30,10 +30,15 @@ class FlipTheDot_FP2800aFixed : public FlipTheDot_FP2800a
         // the _pinEnable variable of the parent class get changed in the method setData(...) when needed
         unsigned int _pinEnableReset;
         unsigned int _pinEnableSet;
+
+        #ifdef FlipTheDot_FP2800a_PORT_IO
+        FlipTheDot_FP2800aPortPin _portEnableReset;
+        FlipTheDot_FP2800aPortPin _portEnableSet;
+        #endif
 };
 
 
-FlipTheDot_FP2800aFixed::FlipTheDot_FP2800aFixed(unsigned int pinEnableReset, unsigned int pinEnableSet, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis = 100) : FlipTheDot_FP2800a(pinEnableReset, pinEnableSet, pinA0, pinA1, pinA2, pinB0, pinB1, pulseLengthMillis)
+FlipTheDot_FP2800aFixed::FlipTheDot_FP2800aFixed(unsigned int pinEnableReset, unsigned int pinEnableSet, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis = 100, FlipTheDot_FP2800aBackend *backend = NULL) : FlipTheDot_FP2800a(pinEnableReset, pinEnableSet, pinA0, pinA1, pinA2, pinB0, pinB1, pulseLengthMillis, backend)
 {
     // The first parameter is defined as reset, because this matches the default behaviour of the parent class where the _pinData
     // is default LOW and a call to enable() or pulse() results in a reset action - without previous calling setData(...).
@@ -43,6 +48,14 @@ FlipTheDot_FP2800aFixed::FlipTheDot_FP2800aFixed(unsigned int pinEnableReset, un
     // initialize all pins (mode and default state).
     _pinEnableReset = pinEnableReset;
     _pinEnableSet   = pinEnableSet;
+
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        _resolvePin(_portEnableReset, _pinEnableReset);
+        _resolvePin(_portEnableSet, _pinEnableSet);
+    }
+    #endif
 }
 
 
@@ -57,10 +70,16 @@ bool FlipTheDot_FP2800aFixed::setData(bool is_high)
         #ifdef FlipTheDot_FP2800a_DEBUG_SERIAL
         FlipTheDot_FP2800a_DEBUG_SERIAL.println( F("FlipTheDot_FP2800a data cannot be changed when IC is already enabled") );
         #endif
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_DATA, _pinEnable, is_high);
+        _statistics.rejectedCalls++;
         return false;
     }
 
     _pinEnable = is_high == true ? _pinEnableSet : _pinEnableReset;
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    _portEnable = is_high == true ? _portEnableSet : _portEnableReset;
+    #endif
+    FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_DATA, _pinEnable, is_high);
     
     #ifdef FlipTheDot_FP2800aFixed_DEBUG_SERIAL
     FlipTheDot_FP2800aFixed_DEBUG_SERIAL.print( F("FlipTheDot_FP2800aFixed data updated by switching enable pin numbers (") );
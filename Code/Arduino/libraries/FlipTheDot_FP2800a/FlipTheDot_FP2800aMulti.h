@@ -16,26 +16,53 @@
 #include "FlipTheDot_FP2800a.h"
 
 
+#ifdef FlipTheDot_FP2800a_PORT_IO
+// number of ICs whose enable pins get resolved to port registers
+#ifndef FlipTheDot_FP2800aMulti_MAX_CHIPS
+#define FlipTheDot_FP2800aMulti_MAX_CHIPS 8
+#endif
+#endif
+
+
 
 class FlipTheDot_FP2800aMulti : public FlipTheDot_FP2800a
 {
     public:
         // nearly identical parameters like FP2800a but with enable pin list and its length informations
-        FlipTheDot_FP2800aMulti(unsigned int pinEnableList[], unsigned int pinEnableListLength, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis);
+        FlipTheDot_FP2800aMulti(unsigned int pinEnableList[], unsigned int pinEnableListLength, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis, FlipTheDot_FP2800aBackend *backend);
         bool setOutput(unsigned int no);
         unsigned int getOutput();
         unsigned int getOutputMax();
+        void enable();
+        void disable();
+        unsigned int getChipCount();
+        unsigned int getMaxEnabledChips();
+        void setMaxEnabledChips(unsigned int max);
+        bool setOutputGroup(unsigned int no, unsigned long chipMask);
     
     protected:
+        bool _selectChipOutput(byte enable_no, unsigned int no);
+        void _writeEnableGroup(uint8_t level);
+
         byte _selectedEnableNo = 0;
+        unsigned long _enableMask = 0;
+        unsigned int _maxEnabledChips = 1;
         unsigned int *_pinEnableList;
         unsigned int _pinEnableListLength = 0;
         bool _hasDuplicatePins();
         void _initPins();
+
+        #ifdef FlipTheDot_FP2800a_PORT_IO
+        // port register and bit mask of every enable pin, resolved once in the constructor
+        FlipTheDot_FP2800aPortPin _portEnableList[FlipTheDot_FP2800aMulti_MAX_CHIPS];
+        // enable pins of the output group combined per port register (see setOutputGroup)
+        FlipTheDot_FP2800aPortPin _portEnableGroup[FlipTheDot_FP2800aMulti_MAX_CHIPS];
+        byte _portEnableGroupLength = 0;
+        #endif
 };
 
 
-FlipTheDot_FP2800aMulti::FlipTheDot_FP2800aMulti(unsigned int pinEnableList[], unsigned int pinEnableListLength, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis = 100) : FlipTheDot_FP2800a(pinEnableList[0], pinData, pinA0, pinA1, pinA2, pinB0, pinB1, pulseLengthMillis)
+FlipTheDot_FP2800aMulti::FlipTheDot_FP2800aMulti(unsigned int pinEnableList[], unsigned int pinEnableListLength, unsigned int pinData, unsigned int pinA0, unsigned int pinA1, unsigned int pinA2, unsigned int pinB0, unsigned int pinB1, unsigned int pulseLengthMillis = 100, FlipTheDot_FP2800aBackend *backend = NULL) : FlipTheDot_FP2800a(pinEnableList[0], pinData, pinA0, pinA1, pinA2, pinB0, pinB1, pulseLengthMillis, backend)
 {
     // the value for key 0 of pinEnableList gets immediatly forwarded to the parent constructor
 
@@ -58,6 +85,25 @@ FlipTheDot_FP2800aMulti::FlipTheDot_FP2800aMulti(unsigned int pinEnableList[], u
         // call initPins again, like in the parent constructor, to check the whole list of enable pins
         _initPins();
     }
+
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        if ( _pinEnableListLength > FlipTheDot_FP2800aMulti_MAX_CHIPS )
+        {
+          // more ICs than port pins to resolve => increase FlipTheDot_FP2800aMulti_MAX_CHIPS
+          #ifdef FlipTheDot_FP2800aMulti_DEBUG_SERIAL
+          //FlipTheDot_FP2800aMulti_DEBUG_SERIAL.println( F("FlipTheDot_FP2800aMulti has more enable pins than FlipTheDot_FP2800aMulti_MAX_CHIPS") );
+          #endif
+          while(1);
+        }
+
+        for ( byte i = 0; i < _pinEnableListLength; i++ )
+        {
+            _resolvePin(_portEnableList[i], _pinEnableList[i]);
+        }
+    }
+    #endif
 }
 
 
@@ -69,8 +115,12 @@ void FlipTheDot_FP2800aMulti::_initPins()
     // loop thru all enable pins, except the first one which was initialized in the parent _initPins call
     for ( byte i=0; i < _pinEnableListLength; i++)
     {
-        pinMode(_pinEnableList[i], OUTPUT);
-        digitalWrite(_pinEnableList[i], LOW);
+        _initPin(_pinEnableList[i]);
+    }
+
+    if ( _backend != NULL )
+    {
+        _backend->commit();
     }
 }
 
@@ -106,24 +156,41 @@ bool FlipTheDot_FP2800aMulti::_hasDuplicatePins()
 
 /**
  * Map the output no to the corresponding enable pin and its outputs.
+ * With an output map (see setOutputMap) the IC and its output are read from the map.
  */
 bool FlipTheDot_FP2800aMulti::setOutput(unsigned int no)
 {
-    // calculate which enable pin (chip / display) should be selected
-    byte enable_no = no / _maxOutputsOnChip;
+    byte enable_no = 0;
 
-    // recalculation of the output in relation to the selected enable pin
-    no = no % _maxOutputsOnChip;
-    
-    // special handling if previous calculation returning zero
-    if ( no == 0 )
+    if ( _outputMap != NULL )
     {
-        enable_no -= enable_no > 0 ? 1 : 0;
-        no = _maxOutputsOnChip;
+        uint8_t entry = _readOutputMap(no);
+
+        if ( !_selectChipOutput(entry >> 5, entry & 0x1F) )
+        {
+            return false;
+        }
+        _mappedOutput = no;
+        return true;
     }
-    
-    // check if the enable_no is out of range
-    if ( enable_no >= _pinEnableListLength )
+
+    // calculate which enable pin (chip / display) should be selected, subtracting is cheaper than / and % on AVR
+    for ( ; no > _maxOutputsOnChip && enable_no < _pinEnableListLength; enable_no++ )
+    {
+        no -= _maxOutputsOnChip;
+    }
+
+    return _selectChipOutput(enable_no, no);
+}
+
+
+/**
+ * Select the output no (1 to 28) of the IC with the enable pin enable_no (starting at 0).
+ */
+bool FlipTheDot_FP2800aMulti::_selectChipOutput(byte enable_no, unsigned int no)
+{
+    // check if the enable_no or the output is out of range
+    if ( enable_no >= _pinEnableListLength || no < 1 || no > _maxOutputsOnChip )
     {
         #ifdef FlipTheDot_FP2800aMulti_DEBUG_SERIAL
         FlipTheDot_FP2800aMulti_DEBUG_SERIAL.print( F("FlipTheDot_FP2800aMulti selected enable pin ") );
@@ -131,21 +198,44 @@ bool FlipTheDot_FP2800aMulti::setOutput(unsigned int no)
         FlipTheDot_FP2800aMulti_DEBUG_SERIAL.print( F(" is out of range 0 to ") );
         FlipTheDot_FP2800aMulti_DEBUG_SERIAL.println(_pinEnableListLength-1);
         #endif
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_OUTPUT, _pinA0, enable_no * _maxOutputsOnChip + no);
+        _statistics.rejectedCalls++;
         return false;
     }
     
+    // neither the output nor the enable pin can be changed when enabled
+    if ( isEnabled() == true )
+    {
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_OUTPUT, _pinA0, enable_no * _maxOutputsOnChip + no);
+        _statistics.rejectedCalls++;
+        return false;
+    }
+
+    // a regular selection ends a previous output group
+    _enableMask = 0;
+
     // check if the desired output is not already selected (ignoring the previously selected enable pin)
     if ( _selectedOutput != no )
     {
         // try to set the recalculated output no like defined in the parent implementation
-        if ( !FlipTheDot_FP2800a::setOutput(no) )
+        if ( !FlipTheDot_FP2800a::_selectOutput(no) )
         {
             // output could not be set, the enable pin was maybe active
             return false;
         }
     }
+    else if ( _selectedEnableNo == enable_no )
+    {
+        _statistics.redundantOutputs++;
+    }
 
     // change enable pin
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        _portEnable = _portEnableList[enable_no];
+    }
+    #endif
     _selectedEnableNo = enable_no;
     _pinEnable = _pinEnableList[_selectedEnableNo];
     
@@ -167,6 +257,10 @@ bool FlipTheDot_FP2800aMulti::setOutput(unsigned int no)
  */
 unsigned int FlipTheDot_FP2800aMulti::getOutput()
 {
+    if ( _outputMap != NULL )
+    {
+        return _mappedOutput;
+    }
     return _selectedOutput + (_selectedEnableNo * _maxOutputsOnChip);
 }
 
@@ -188,9 +282,195 @@ unsigned int FlipTheDot_FP2800aMulti::getOutputMax()
     FlipTheDot_FP2800aMulti_DEBUG_SERIAL.println( F(")") );
     #endif
     */
+    if ( _outputMap != NULL )
+    {
+        return _outputMapLength;
+    }
     return _maxOutputsOnChip * _pinEnableListLength;
 }
 
+/**
+ * get the number of ICs
+ */
+unsigned int FlipTheDot_FP2800aMulti::getChipCount()
+{
+    return _pinEnableListLength;
+}
+
+
+/**
+ * get the number of ICs which are allowed to be enabled at the same time
+ */
+unsigned int FlipTheDot_FP2800aMulti::getMaxEnabledChips()
+{
+    return _maxEnabledChips;
+}
+
+
+/**
+ * define how many ICs may be enabled at the same time by setOutputGroup (default 1)
+ * every enabled IC drives its own coil, so the current of the power supply rises with this value
+ */
+void FlipTheDot_FP2800aMulti::setMaxEnabledChips(unsigned int max)
+{
+    _maxEnabledChips = max < 1 ? 1 : max;
+}
+
+
+/**
+ * Select the same output no (1 to 28) on several ICs, which get enabled together by enable(), disable() or pulse().
+ * Possible because all ICs share the address and data pins, only the enable pins are separated.
+ * Bit 0 of the chip mask is the first enable pin of the list. The number of ICs is limited by setMaxEnabledChips(...).
+ * A regular setOutput(...) call ends the group.
+ */
+bool FlipTheDot_FP2800aMulti::setOutputGroup(unsigned int no, unsigned long chipMask)
+{
+    byte first = 0;
+    unsigned int count = 0;
+
+    if ( no < 1 || no > _maxOutputsOnChip || chipMask == 0 || (_pinEnableListLength < 32 && (chipMask >> _pinEnableListLength) != 0) )
+    {
+        _statistics.rejectedCalls++;
+        return false;
+    }
+
+    for ( byte i = 0; i < _pinEnableListLength; i++ )
+    {
+        if ( (chipMask >> i) & 1 )
+        {
+            first = count == 0 ? i : first;
+            count++;
+        }
+    }
+
+    if ( count > _maxEnabledChips )
+    {
+        #ifdef FlipTheDot_FP2800aMulti_DEBUG_SERIAL
+        FlipTheDot_FP2800aMulti_DEBUG_SERIAL.print( F("FlipTheDot_FP2800aMulti output group exceeds the limit of ") );
+        FlipTheDot_FP2800aMulti_DEBUG_SERIAL.println(_maxEnabledChips);
+        #endif
+        FlipTheDot_FP2800a_trace(FlipTheDot_FP2800a_TRACE_REJECT_OUTPUT, _pinA0, no);
+        _statistics.rejectedCalls++;
+        return false;
+    }
+
+    // select the output and the enable pin of the first IC like usual (the output numbers of a group are never mapped)
+    if ( !_selectChipOutput(first, no) )
+    {
+        return false;
+    }
+
+    _enableMask = count > 1 ? chipMask : 0;
+
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    // combine the enable pins per port once, so enable() and disable() need one masked write per port
+    _portEnableGroupLength = 0;
+    for ( byte i = 0; _backend == NULL && i < _pinEnableListLength; i++ )
+    {
+        if ( (_enableMask >> i) & 1 )
+        {
+            byte port = 0;
+            while ( port < _portEnableGroupLength && _portEnableGroup[port].reg != _portEnableList[i].reg )
+            {
+                port++;
+            }
+            if ( port == _portEnableGroupLength )
+            {
+                _portEnableGroup[port].reg = _portEnableList[i].reg;
+                _portEnableGroup[port].mask = 0;
+                _portEnableGroupLength++;
+            }
+            _portEnableGroup[port].mask |= _portEnableList[i].mask;
+        }
+    }
+    #endif
+    return true;
+}
+
+
+void FlipTheDot_FP2800aMulti::_writeEnableGroup(uint8_t level)
+{
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    if ( _backend == NULL )
+    {
+        // all enable pins of the group switch at the same time, interrupts are blocked like in _writePin(...)
+        uint8_t oldSREG = SREG;
+        noInterrupts();
+
+        for ( byte port = 0; port < _portEnableGroupLength; port++ )
+        {
+            if ( level == HIGH )
+            {
+                *_portEnableGroup[port].reg |= _portEnableGroup[port].mask;
+            }
+            else
+            {
+                *_portEnableGroup[port].reg &= ~_portEnableGroup[port].mask;
+            }
+        }
+
+        SREG = oldSREG;
+    }
+    #endif
+
+    for ( byte i = 0; i < _pinEnableListLength; i++ )
+    {
+        if ( (_enableMask >> i) & 1 )
+        {
+            if ( _backend != NULL )
+            {
+                _backend->writePin(_pinEnableList[i], level == HIGH);
+            }
+            #ifndef FlipTheDot_FP2800a_PORT_IO
+            else
+            {
+                digitalWrite(_pinEnableList[i], level);
+            }
+            #endif
+            FlipTheDot_FP2800a_trace(level == HIGH ? FlipTheDot_FP2800a_TRACE_ENABLE : FlipTheDot_FP2800a_TRACE_DISABLE, _pinEnableList[i], level);
+        }
+    }
+
+    // all enable lines of the group change with one transfer
+    if ( _backend != NULL )
+    {
+        _backend->commit();
+    }
+}
+
+
+/**
+ * enable the selected IC or all ICs of the output group
+ */
+void FlipTheDot_FP2800aMulti::enable()
+{
+    if ( _enableMask == 0 )
+    {
+        FlipTheDot_FP2800a::enable();
+        return;
+    }
+
+    _isEnabled = true;
+    _writeEnableGroup(HIGH);
+    _countEnable();
+}
+
+
+/**
+ * disable the selected IC or all ICs of the output group
+ */
+void FlipTheDot_FP2800aMulti::disable()
+{
+    if ( _enableMask == 0 )
+    {
+        FlipTheDot_FP2800a::disable();
+        return;
+    }
+
+    _writeEnableGroup(LOW);
+    _countDisable();
+    _isEnabled = false;
+}
 
 
 
@@ -0,0 +1,221 @@
+/*
+ * FlipTheDot_FP2800aShiftRegister Class  -- Drive the FP2800a lines thru chained 74HC595 shift registers
+ *
+ * A backend (see FlipTheDot_FP2800aBackend) for the FP2800a classes: address, data and enable lines are
+ * outputs of a chain of 74HC595, which gets written with the hardware SPI. Only three microcontroller pins
+ * are needed for any number of FP2800a chips (MOSI, SCK and the latch pin), e.g. a FlipTheDot_FP2800aMulti
+ * with 16 enable lines fits on three shift registers.
+ *
+ * Wiring of the 74HC595 chain:
+ *   SER (14) of the first register  <=  MOSI (pin 11 of an Arduino Uno)
+ *   SRCLK (11) of all registers      <=  SCK (pin 13)
+ *   RCLK (12) of all registers       <=  latch pin
+ *   QH' (9)                          =>  SER (14) of the next register
+ *   OE (13) of all registers         <=  output enable pin with a pull-up resistor, or GND
+ *   SRCLR (10) of all registers      <=  5V
+ *
+ * The pin numbers of the FP2800a classes are the outputs of the chain: 0 - 7 are QA - QH of the first register
+ * (next to the microcontroller), 8 - 15 the ones of the second register and so on.
+ *
+ * The state of all outputs is kept in a buffer of one byte per register. Every commit() of a changed state
+ * shifts the whole buffer out in one SPI transaction and latches it, so all lines of a setOutput(...)
+ * change at the same time. With interrupts blocked during the transfer, the ISR of the
+ * FlipTheDot_ColumnRowControllerAsync can share the chain with the foreground.
+ *
+ * After power on the outputs of a 74HC595 are undefined, which can enable an FP2800a. Use the output enable
+ * pin with a pull-up resistor on OE, it gets LOW after the first complete transfer.
+ */
+
+
+#ifndef FlipTheDot_FP2800aShiftRegister_h
+#define FlipTheDot_FP2800aShiftRegister_h
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "FlipTheDot_FP2800a.h"
+
+
+// no output enable pin, OE of the shift registers is wired to GND
+#define FlipTheDot_FP2800aShiftRegister_NO_PIN 0xFF
+
+
+
+class FlipTheDot_FP2800aShiftRegister : public FlipTheDot_FP2800aBackend
+{
+    public:
+        FlipTheDot_FP2800aShiftRegister(uint8_t *buffer, unsigned int registerCount, unsigned int pinLatch, unsigned int pinOutputEnable, unsigned long clockHz);
+        void initPin(unsigned int pin);
+        void writePin(unsigned int pin, bool is_high);
+        void commit();
+        bool getPin(unsigned int pin);
+        unsigned int getPinCount();
+        unsigned long getTransferCount();
+
+    protected:
+        void _begin();
+
+        uint8_t *_buffer;
+        unsigned int _registerCount;
+        unsigned int _pinLatch;
+        unsigned int _pinOutputEnable;
+        SPISettings _settings;
+
+        bool _isBegun = false;
+        bool _isChanged = true;
+        unsigned long _transferCount = 0;
+
+        #ifdef FlipTheDot_FP2800a_PORT_IO
+        FlipTheDot_FP2800aPortPin _portLatch;
+        #endif
+};
+
+
+FlipTheDot_FP2800aShiftRegister::FlipTheDot_FP2800aShiftRegister(uint8_t *buffer, unsigned int registerCount, unsigned int pinLatch, unsigned int pinOutputEnable = FlipTheDot_FP2800aShiftRegister_NO_PIN, unsigned long clockHz = 8000000)
+    : _settings(clockHz, MSBFIRST, SPI_MODE0)
+{
+    _buffer = buffer;
+    _registerCount = registerCount;
+    _pinLatch = pinLatch;
+    _pinOutputEnable = pinOutputEnable;
+
+    memset(_buffer, 0, _registerCount);
+}
+
+
+/**
+ * setup the latch pin and the SPI, called with the first pin of a FP2800a object
+ * the constructors of the FP2800a classes initialize their pins, so this happens before setup()
+ */
+void FlipTheDot_FP2800aShiftRegister::_begin()
+{
+    if ( _isBegun )
+    {
+        return;
+    }
+    _isBegun = true;
+
+    // keep the undefined outputs disabled until the first transfer
+    if ( _pinOutputEnable != FlipTheDot_FP2800aShiftRegister_NO_PIN )
+    {
+        pinMode(_pinOutputEnable, OUTPUT);
+        digitalWrite(_pinOutputEnable, HIGH);
+    }
+
+    pinMode(_pinLatch, OUTPUT);
+    digitalWrite(_pinLatch, LOW);
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    _portLatch.reg = portOutputRegister( digitalPinToPort(_pinLatch) );
+    _portLatch.mask = digitalPinToBitMask(_pinLatch);
+    #endif
+
+    SPI.begin();
+}
+
+
+/**
+ * use an output of the chain, it stays LOW until it gets written
+ */
+void FlipTheDot_FP2800aShiftRegister::initPin(unsigned int pin)
+{
+    _begin();
+    writePin(pin, false);
+}
+
+
+/**
+ * change an output in the buffer, it gets shifted out with the next commit()
+ */
+void FlipTheDot_FP2800aShiftRegister::writePin(unsigned int pin, bool is_high)
+{
+    if ( pin >= _registerCount * 8 )
+    {
+        return;
+    }
+
+    uint8_t &value = _buffer[pin >> 3];
+    uint8_t mask = 1 << (pin & 7);
+
+    if ( ((value & mask) != 0) != is_high )
+    {
+        value ^= mask;
+        _isChanged = true;
+    }
+}
+
+
+/**
+ * shift the buffer out and latch it, if any output changed since the last commit
+ */
+void FlipTheDot_FP2800aShiftRegister::commit()
+{
+    if ( !_isChanged )
+    {
+        return;
+    }
+    _begin();
+
+    uint8_t oldSREG = SREG;
+    cli();
+
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    *_portLatch.reg &= ~_portLatch.mask;
+    #else
+    digitalWrite(_pinLatch, LOW);
+    #endif
+
+    SPI.beginTransaction(_settings);
+    // the first byte ends up in the last register of the chain
+    for ( unsigned int i = _registerCount; i > 0; i-- )
+    {
+        SPI.transfer(_buffer[i - 1]);
+    }
+    SPI.endTransaction();
+
+    // the rising edge copies the shift stages to the outputs
+    #ifdef FlipTheDot_FP2800a_PORT_IO
+    *_portLatch.reg |= _portLatch.mask;
+    #else
+    digitalWrite(_pinLatch, HIGH);
+    #endif
+
+    _isChanged = false;
+    _transferCount++;
+
+    SREG = oldSREG;
+
+    if ( _transferCount == 1 && _pinOutputEnable != FlipTheDot_FP2800aShiftRegister_NO_PIN )
+    {
+        digitalWrite(_pinOutputEnable, LOW);
+    }
+}
+
+
+/**
+ * get the level of an output like it gets shifted out with the next commit()
+ */
+bool FlipTheDot_FP2800aShiftRegister::getPin(unsigned int pin)
+{
+    return pin < _registerCount * 8 && ( _buffer[pin >> 3] >> (pin & 7) ) & 1;
+}
+
+
+/**
+ * get the number of outputs of the chain
+ */
+unsigned int FlipTheDot_FP2800aShiftRegister::getPinCount()
+{
+    return _registerCount * 8;
+}
+
+
+/**
+ * get the number of transfers (SPI transactions) since the start
+ */
+unsigned long FlipTheDot_FP2800aShiftRegister::getTransferCount()
+{
+    return _transferCount;
+}
+
+
+
+#endif // FlipTheDot_FP2800aShiftRegister_h
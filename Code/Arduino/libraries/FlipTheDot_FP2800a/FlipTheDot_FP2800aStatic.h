@@ -0,0 +1,386 @@
+/*
+ * FlipTheDot_FP2800aStatic Class Template
+ *
+ * Compile time variant of FlipTheDot_FP2800a, FlipTheDot_FP2800aFixed and FlipTheDot_FP2800aMulti.
+ * All pin numbers (and the number of ICs) are template parameters, so they are not stored in RAM
+ * and the compiler can inline the calls, because none of the methods is virtual.
+ * The differences between the default, fixed and multi setups are defined by a pin policy:
+ *
+ *   FlipTheDot_FP2800aPinsDefault<Enable, Data>             like FlipTheDot_FP2800a
+ *   FlipTheDot_FP2800aPinsFixed<EnableReset, EnableSet>     like FlipTheDot_FP2800aFixed
+ *   FlipTheDot_FP2800aPinsMulti<Data, Enable1, Enable2...>  like FlipTheDot_FP2800aMulti
+ *
+ * Example:
+ *   FlipTheDot_FP2800aStatic< FlipTheDot_FP2800aPinsFixed<A0, 2>, 3, 4, 5, 6, 7 > rowController;
+ *
+ * Duplicate pins are detected at compile time.
+ */
+
+
+#ifndef FlipTheDot_FP2800aStatic_h
+#define FlipTheDot_FP2800aStatic_h
+
+#include "Arduino.h"
+
+
+
+/**
+ * check at compile time if a pin is part of a list of pins
+ */
+template <uint8_t Pin, uint8_t... Pins>
+struct FlipTheDot_FP2800aHasPin
+{
+    static const bool value = false;
+};
+
+template <uint8_t Pin, uint8_t First, uint8_t... Pins>
+struct FlipTheDot_FP2800aHasPin<Pin, First, Pins...>
+{
+    static const bool value = Pin == First || FlipTheDot_FP2800aHasPin<Pin, Pins...>::value;
+};
+
+
+/**
+ * check at compile time if all pins of a list are different
+ */
+template <uint8_t... Pins>
+struct FlipTheDot_FP2800aUniquePins
+{
+    static const bool value = true;
+};
+
+template <uint8_t First, uint8_t... Pins>
+struct FlipTheDot_FP2800aUniquePins<First, Pins...>
+{
+    static const bool value = !FlipTheDot_FP2800aHasPin<First, Pins...>::value && FlipTheDot_FP2800aUniquePins<Pins...>::value;
+};
+
+
+
+/**
+ * one IC with an enable pin and a data pin which gets toggled
+ */
+template <uint8_t PinEnable, uint8_t PinData>
+class FlipTheDot_FP2800aPinsDefault
+{
+    public:
+        static const uint8_t chips = 1;
+
+        template <uint8_t... AddressPins>
+        struct isUnique
+        {
+            static const bool value = FlipTheDot_FP2800aUniquePins<PinEnable, PinData, AddressPins...>::value;
+        };
+
+    protected:
+        void _initPins()
+        {
+            pinMode(PinData, OUTPUT);
+            digitalWrite(PinData, LOW);
+            pinMode(PinEnable, OUTPUT);
+            digitalWrite(PinEnable, LOW);
+        }
+
+        void _writeData(bool is_high)
+        {
+            digitalWrite(PinData, is_high == true ? HIGH : LOW);
+        }
+
+        void _selectChip(uint8_t chip)
+        {
+        }
+
+        uint8_t _getChip()
+        {
+            return 0;
+        }
+
+        void _writeEnable(uint8_t level)
+        {
+            digitalWrite(PinEnable, level);
+        }
+};
+
+
+/**
+ * two ICs with shared address pins and fixed data pins (reset LOW, set HIGH)
+ * the data state decides which enable pin gets used
+ */
+template <uint8_t PinEnableReset, uint8_t PinEnableSet>
+class FlipTheDot_FP2800aPinsFixed
+{
+    public:
+        static const uint8_t chips = 1;
+
+        template <uint8_t... AddressPins>
+        struct isUnique
+        {
+            static const bool value = FlipTheDot_FP2800aUniquePins<PinEnableReset, PinEnableSet, AddressPins...>::value;
+        };
+
+    protected:
+        bool _isSet = false;
+
+        void _initPins()
+        {
+            pinMode(PinEnableReset, OUTPUT);
+            digitalWrite(PinEnableReset, LOW);
+            pinMode(PinEnableSet, OUTPUT);
+            digitalWrite(PinEnableSet, LOW);
+        }
+
+        void _writeData(bool is_high)
+        {
+            _isSet = is_high;
+        }
+
+        void _selectChip(uint8_t chip)
+        {
+        }
+
+        uint8_t _getChip()
+        {
+            return 0;
+        }
+
+        void _writeEnable(uint8_t level)
+        {
+            digitalWrite(_isSet ? PinEnableSet : PinEnableReset, level);
+        }
+};
+
+
+/**
+ * multiple ICs with shared address and data pins but individual enable pins
+ */
+template <uint8_t PinData, uint8_t... PinsEnable>
+class FlipTheDot_FP2800aPinsMulti
+{
+    public:
+        static const uint8_t chips = sizeof...(PinsEnable);
+
+        template <uint8_t... AddressPins>
+        struct isUnique
+        {
+            static const bool value = FlipTheDot_FP2800aUniquePins<PinData, PinsEnable..., AddressPins...>::value;
+        };
+
+    protected:
+        uint8_t _chip = 0;
+
+        static uint8_t _pinEnable(uint8_t chip)
+        {
+            static const uint8_t pins[] PROGMEM = { PinsEnable... };
+            return pgm_read_byte(&pins[chip]);
+        }
+
+        void _initPins()
+        {
+            pinMode(PinData, OUTPUT);
+            digitalWrite(PinData, LOW);
+            for ( uint8_t i = 0; i < chips; i++ )
+            {
+                pinMode(_pinEnable(i), OUTPUT);
+                digitalWrite(_pinEnable(i), LOW);
+            }
+        }
+
+        void _writeData(bool is_high)
+        {
+            digitalWrite(PinData, is_high == true ? HIGH : LOW);
+        }
+
+        void _selectChip(uint8_t chip)
+        {
+            _chip = chip;
+        }
+
+        uint8_t _getChip()
+        {
+            return _chip;
+        }
+
+        void _writeEnable(uint8_t level)
+        {
+            digitalWrite(_pinEnable(_chip), level);
+        }
+};
+
+
+
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+class FlipTheDot_FP2800aStatic : public Pins
+{
+    static_assert(Pins::template isUnique<PinA0, PinA1, PinA2, PinB0, PinB1>::value, "Pin configuration for FlipTheDot_FP2800aStatic is not valid: duplicate pin detected");
+    static_assert(Pins::chips > 0, "FlipTheDot_FP2800aStatic requires at least one enable pin");
+
+    public:
+        static const unsigned int outputsOnChip = 28;
+        static const unsigned int outputs = outputsOnChip * Pins::chips;
+
+        FlipTheDot_FP2800aStatic(unsigned int pulseLengthMicros = 100);
+        void pulse();
+        bool setOutput(unsigned int no);
+        unsigned int getOutput();
+        unsigned int getOutputMax() { return outputs; }
+        bool setData(bool is_high);
+        void setPulseLength(unsigned int pulseLengthMicros) { _pulseLengthMicros = pulseLengthMicros; }
+        unsigned int getPulseLength() { return _pulseLengthMicros; }
+        void enable();
+        void disable();
+        bool isEnabled() { return _isEnabled; }
+
+    protected:
+        static uint8_t _addressLines(uint8_t output);
+
+        unsigned int _pulseLengthMicros;
+        uint8_t _selectedOutput = 0;
+        bool _isEnabled = false;
+};
+
+
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::FlipTheDot_FP2800aStatic(unsigned int pulseLengthMicros)
+{
+    _pulseLengthMicros = pulseLengthMicros;
+
+    Pins::_initPins();
+
+    pinMode(PinA0, OUTPUT);
+    digitalWrite(PinA0, LOW);
+    pinMode(PinA1, OUTPUT);
+    digitalWrite(PinA1, LOW);
+    pinMode(PinA2, OUTPUT);
+    digitalWrite(PinA2, LOW);
+
+    pinMode(PinB0, OUTPUT);
+    digitalWrite(PinB0, LOW);
+    pinMode(PinB1, OUTPUT);
+    digitalWrite(PinB1, LOW);
+}
+
+
+/**
+ * define if the output should source or sink current
+ * can only be changed when enabled is low
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+bool FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::setData(bool is_high)
+{
+    if ( _isEnabled )
+    {
+        return false;
+    }
+
+    Pins::_writeData(is_high);
+    return true;
+}
+
+
+/**
+ * select the output (1 to 28 * number of ICs) which gets enabled during pulse
+ * can only be changed when enabled is low
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+bool FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::setOutput(unsigned int no)
+{
+    if ( _isEnabled || no < 1 || no > outputs )
+    {
+        return false;
+    }
+
+    // map the output to the IC, the division gets removed for single IC setups
+    uint8_t chip = (no - 1) / outputsOnChip;
+    uint8_t output = no - chip * outputsOnChip;
+
+    Pins::_selectChip(chip);
+
+    if ( _selectedOutput != output )
+    {
+        // only write the address lines which differ from the previously selected output
+        uint8_t lines = _addressLines(output);
+        uint8_t changed = lines ^ _addressLines(_selectedOutput);
+        _selectedOutput = output;
+
+        if ( changed & 0x10 ) digitalWrite(PinB1, (lines & 0x10) ? HIGH : LOW);
+        if ( changed & 0x08 ) digitalWrite(PinB0, (lines & 0x08) ? HIGH : LOW);
+        if ( changed & 0x04 ) digitalWrite(PinA2, (lines & 0x04) ? HIGH : LOW);
+        if ( changed & 0x02 ) digitalWrite(PinA1, (lines & 0x02) ? HIGH : LOW);
+        if ( changed & 0x01 ) digitalWrite(PinA0, (lines & 0x01) ? HIGH : LOW);
+    }
+
+    return true;
+}
+
+
+/**
+ * address line levels of an output (bit 0: A0, 1: A1, 2: A2, 3: B0, 4: B1), all LOW for output 0
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+uint8_t FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::_addressLines(uint8_t output)
+{
+    uint8_t lines = 0;
+
+    if ( output > 14 )
+    {
+        lines |= 0x10;
+        output -= 14;
+    }
+    if ( output > 7 )
+    {
+        lines |= 0x08;
+        output -= 7;
+    }
+    return lines | output;
+}
+
+
+/**
+ * get selected output
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+unsigned int FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::getOutput()
+{
+    return _selectedOutput + Pins::_getChip() * outputsOnChip;
+}
+
+
+/**
+ * enable the selected port to source or sink power
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+void FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::enable()
+{
+    _isEnabled = true;
+    Pins::_writeEnable(HIGH);
+}
+
+
+/**
+ * disable/close the selected port
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+void FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::disable()
+{
+    Pins::_writeEnable(LOW);
+    _isEnabled = false;
+}
+
+
+/**
+ * enable the selected port for a given time (defined by the pulse length)
+ */
+template <class Pins, uint8_t PinA0, uint8_t PinA1, uint8_t PinA2, uint8_t PinB0, uint8_t PinB1>
+void FlipTheDot_FP2800aStatic<Pins, PinA0, PinA1, PinA2, PinB0, PinB1>::pulse()
+{
+    if ( _pulseLengthMicros > 0 )
+    {
+        enable();
+        delayMicroseconds(_pulseLengthMicros);
+        disable();
+    }
+}
+
+
+
+#endif // FlipTheDot_FP2800aStatic_h
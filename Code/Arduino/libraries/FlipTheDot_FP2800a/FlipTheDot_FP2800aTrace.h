@@ -0,0 +1,227 @@
+/*
+ * FlipTheDot_FP2800aTrace Class  -- Record the pin activity of the FP2800a classes into a ring buffer
+ *
+ * Define FlipTheDot_FP2800a_TRACE before including the library to record every address change, data change,
+ * enable rise and fall and every rejected setOutput(...) or setData(...) call as a 5 byte event with a timestamp.
+ * Unlike the *_DEBUG_SERIAL prints, recording takes a few microseconds only, so the pulse timing stays intact.
+ * Without the define, the FlipTheDot_FP2800a_trace(...) calls compile to nothing.
+ *
+ * The ring buffer keeps the latest FlipTheDot_FP2800a_TRACE_SIZE events (default 64, a power of two up to 256).
+ * FlipTheDot_FP2800aTrace::dump(Serial) writes them in binary, Code/Host/Tools/TraceDecoder turns them into text
+ * or into a VCD waveform, which Code/Host/Tools/TimingCheck checks against the timing of the datasheet.
+ *
+ * Dump format (multi byte values little endian):
+ *   'F' 'T' <version 1> <count, 2 bytes> <overwritten events, 4 bytes> followed by count events:
+ *   <micros, low 16 bits> <type> <pin> <value>
+ * An event of the type TIME carries bits 16 to 31 of micros() in pin (16 - 23) and value (24 - 31). It is recorded
+ * before the first event and whenever 65536 µs or more passed since the previous event.
+ */
+
+
+#ifndef FlipTheDot_FP2800aTrace_h
+#define FlipTheDot_FP2800aTrace_h
+
+#include "Arduino.h"
+
+
+// event types
+#define FlipTheDot_FP2800a_TRACE_TIME           0   // upper bits of the time
+#define FlipTheDot_FP2800a_TRACE_ADDRESS        1   // output (1 - 28) selected, pin: A0
+#define FlipTheDot_FP2800a_TRACE_DATA           2   // data level set, pin: data pin (selected enable pin of FlipTheDot_FP2800aFixed)
+#define FlipTheDot_FP2800a_TRACE_ENABLE         3   // enable pin HIGH
+#define FlipTheDot_FP2800a_TRACE_DISABLE        4   // enable pin LOW
+#define FlipTheDot_FP2800a_TRACE_REJECT_OUTPUT  5   // setOutput(value) rejected, pin: A0
+#define FlipTheDot_FP2800a_TRACE_REJECT_DATA    6   // setData(value) rejected, pin: data pin
+
+
+#ifdef FlipTheDot_FP2800a_TRACE
+
+#ifndef FlipTheDot_FP2800a_TRACE_SIZE
+#define FlipTheDot_FP2800a_TRACE_SIZE 64
+#endif
+
+#if FlipTheDot_FP2800a_TRACE_SIZE > 256 || (FlipTheDot_FP2800a_TRACE_SIZE & (FlipTheDot_FP2800a_TRACE_SIZE - 1)) != 0
+#error "FlipTheDot_FP2800a_TRACE_SIZE has to be a power of two up to 256"
+#endif
+
+#define FlipTheDot_FP2800a_trace(type, pin, value) FlipTheDot_FP2800aTrace::record((type), (pin), (value))
+
+
+struct FlipTheDot_FP2800aTraceEvent
+{
+    uint16_t micros;
+    uint8_t type;
+    uint8_t pin;
+    uint8_t value;
+};
+
+
+class FlipTheDot_FP2800aTrace
+{
+    public:
+        static void record(uint8_t type, uint8_t pin, uint8_t value);
+        static void clear();
+        static unsigned int getCount();
+        static unsigned long getOverwrittenCount();
+        template <class T> static void dump(T &serial);
+    protected:
+        static void _append(uint16_t micros, uint8_t type, uint8_t pin, uint8_t value);
+
+        static FlipTheDot_FP2800aTraceEvent _events[FlipTheDot_FP2800a_TRACE_SIZE];
+        static uint8_t _next;
+        static unsigned int _count;
+        static unsigned long _overwritten;
+        static unsigned long _lastMicros;
+        static bool _hasTime;
+        static volatile bool _isDumping;
+};
+
+
+FlipTheDot_FP2800aTraceEvent FlipTheDot_FP2800aTrace::_events[FlipTheDot_FP2800a_TRACE_SIZE];
+uint8_t FlipTheDot_FP2800aTrace::_next = 0;
+unsigned int FlipTheDot_FP2800aTrace::_count = 0;
+unsigned long FlipTheDot_FP2800aTrace::_overwritten = 0;
+unsigned long FlipTheDot_FP2800aTrace::_lastMicros = 0;
+bool FlipTheDot_FP2800aTrace::_hasTime = false;
+volatile bool FlipTheDot_FP2800aTrace::_isDumping = false;
+
+
+void FlipTheDot_FP2800aTrace::_append(uint16_t micros, uint8_t type, uint8_t pin, uint8_t value)
+{
+    FlipTheDot_FP2800aTraceEvent &event = _events[_next];
+    event.micros = micros;
+    event.type = type;
+    event.pin = pin;
+    event.value = value;
+
+    _next = (_next + 1) & (FlipTheDot_FP2800a_TRACE_SIZE - 1);
+    if ( _count < FlipTheDot_FP2800a_TRACE_SIZE )
+    {
+        _count++;
+    }
+    else
+    {
+        _overwritten++;
+    }
+}
+
+
+/**
+ * add an event, the oldest event gets overwritten when the buffer is full
+ * interrupts are blocked, so events of an ISR (like FlipTheDot_ColumnRowControllerAsync) do not get mixed up
+ */
+void FlipTheDot_FP2800aTrace::record(uint8_t type, uint8_t pin, uint8_t value)
+{
+    uint8_t oldSREG = SREG;
+    cli();
+
+    if ( _isDumping )
+    {
+        _overwritten++;
+        SREG = oldSREG;
+        return;
+    }
+
+    unsigned long now = micros();
+    if ( !_hasTime || now - _lastMicros > 0xFFFF )
+    {
+        _append(now, FlipTheDot_FP2800a_TRACE_TIME, now >> 16, now >> 24);
+        _hasTime = true;
+    }
+    _lastMicros = now;
+    _append(now, type, pin, value);
+
+    SREG = oldSREG;
+}
+
+
+/**
+ * remove all events
+ */
+void FlipTheDot_FP2800aTrace::clear()
+{
+    uint8_t oldSREG = SREG;
+    cli();
+
+    _next = 0;
+    _count = 0;
+    _overwritten = 0;
+    _hasTime = false;
+
+    SREG = oldSREG;
+}
+
+
+/**
+ * get the number of events in the buffer
+ */
+unsigned int FlipTheDot_FP2800aTrace::getCount()
+{
+    return _count;
+}
+
+
+/**
+ * get the number of events which got lost because the buffer was full
+ */
+unsigned long FlipTheDot_FP2800aTrace::getOverwrittenCount()
+{
+    return _overwritten;
+}
+
+
+/**
+ * write all events in binary to a serial connection (or any other object with write(uint8_t)) and clear the buffer
+ * events which occur during the dump (e.g. in an interrupt) get dropped and counted as overwritten
+ */
+template <class T>
+void FlipTheDot_FP2800aTrace::dump(T &serial)
+{
+    uint8_t oldSREG = SREG;
+    cli();
+    unsigned int count = _count;
+    uint8_t first = (_next - count) & (FlipTheDot_FP2800a_TRACE_SIZE - 1);
+    unsigned long overwritten = _overwritten;
+    _isDumping = true;
+    SREG = oldSREG;
+
+    serial.write((uint8_t)'F');
+    serial.write((uint8_t)'T');
+    serial.write((uint8_t)1);
+    serial.write((uint8_t)(count & 0xFF));
+    serial.write((uint8_t)(count >> 8));
+    for ( uint8_t i = 0; i < 4; i++ )
+    {
+        serial.write((uint8_t)(overwritten >> (i * 8)));
+    }
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        FlipTheDot_FP2800aTraceEvent &event = _events[(first + i) & (FlipTheDot_FP2800a_TRACE_SIZE - 1)];
+        serial.write((uint8_t)(event.micros & 0xFF));
+        serial.write((uint8_t)(event.micros >> 8));
+        serial.write(event.type);
+        serial.write(event.pin);
+        serial.write(event.value);
+    }
+
+    oldSREG = SREG;
+    cli();
+    // keep the number of events which were dropped during the dump
+    _overwritten -= overwritten;
+    _next = 0;
+    _count = 0;
+    _hasTime = false;
+    _isDumping = false;
+    SREG = oldSREG;
+}
+
+#else
+
+#define FlipTheDot_FP2800a_trace(type, pin, value)
+
+#endif // FlipTheDot_FP2800a_TRACE
+
+
+
+#endif // FlipTheDot_FP2800aTrace_h
@@ -0,0 +1,92 @@
+/*
+  Trace
+  Record the pin activity of the FP2800a into a ring buffer and send it to the computer on request.
+
+  Unlike the debug prints (FlipTheDot_FP2800a_DEBUG_SERIAL), recording an event only takes a few
+  microseconds, so the pulses keep their length. The loop pulses the outputs like the example "Default"
+  and writes the latest events in binary as soon as any character is received.
+  Decode them on a Linux computer with Code/Host/Tools/TraceDecoder, e.g.
+    stty -F /dev/ttyACM0 9600 raw && cat /dev/ttyACM0 | TraceDecoder
+
+  This example code is in the public domain.
+ */
+
+
+// record the events, has to be defined before the include
+#define FlipTheDot_FP2800a_TRACE
+
+// number of events to keep (a power of two up to 256, 5 bytes each)
+#define FlipTheDot_FP2800a_TRACE_SIZE 64
+
+// include the library
+#include "FlipTheDot_FP2800a.h"
+
+
+// defining the Arduino pins which control the FP2800a
+const int fp2800a_pin_ENABLE    = A0;
+const int fp2800a_pin_DATA      = A1;
+
+const int fp2800a_pin_A0        = 2; // D2
+const int fp2800a_pin_A1        = 3; // D3
+const int fp2800a_pin_A2        = 4; // D4
+const int fp2800a_pin_B0        = 5; // D5
+const int fp2800a_pin_B1        = 6; // D6
+
+const int fp2800a_pulse_length  = 100; // microseconds
+
+
+// setup the FP2800a controller object
+FlipTheDot_FP2800a controller(
+                            fp2800a_pin_ENABLE,
+                            fp2800a_pin_DATA,
+                            fp2800a_pin_A0,
+                            fp2800a_pin_A1,
+                            fp2800a_pin_A2,
+                            fp2800a_pin_B0,
+                            fp2800a_pin_B1,
+                            fp2800a_pulse_length
+);
+
+
+// helper variables
+int outputNo = 0;
+boolean dataStatus = false;
+
+
+
+void setup() {
+  Serial.begin(9600);
+
+  delay(1000);
+  controller.setData( !dataStatus );
+}
+
+
+void loop() {
+  // dump the recorded events on request
+  if ( Serial.available() > 0 )
+  {
+    while ( Serial.available() > 0 )
+    {
+      Serial.read();
+    }
+    FlipTheDot_FP2800aTrace::dump(Serial);
+  }
+
+  if ( outputNo < 0 || outputNo >= controller.getOutputMax() )
+  {
+    // reset output number and invert the data flag
+    outputNo = 0;
+    dataStatus = !dataStatus;
+    controller.setData( dataStatus );
+  }
+
+  // increase output number
+  outputNo++;
+
+  // set new output number and pulse it
+  controller.setOutput( outputNo );
+  controller.pulse();
+
+  delay(500);
+}
@@ -0,0 +1,98 @@
+/*
+  Fixed-Multi Controller with shift registers
+  Iterate thru the output numbers like the example "Fixed-Multi", but all FP2800a lines are outputs of
+  two chained 74HC595 shift registers, written with the hardware SPI.
+
+  Only the SPI pins (MOSI 11, SCK 13), a latch pin and an output enable pin are used on the Arduino,
+  more column groups just need more enable lines (a third 74HC595 adds eight of them).
+  See FlipTheDot_FP2800aShiftRegister.h for the wiring of the chain.
+
+    chain output  0 - 4   column A0, A1, A2, B0, B1      chain output  9 - 13  row A0, A1, A2, B0, B1
+    chain output  5       column data                    chain output 14       row enable reset
+    chain output  6 - 8   column enable of IC 1 - 3      chain output 15       row enable set
+
+  This example code is in the public domain.
+ */
+
+
+// include the library
+#include <SPI.h>
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aMulti.h"
+#include "FlipTheDot_FP2800aShiftRegister.h"
+
+
+// defining the pulse length for the FP2800a enable pins
+const int fp2800a_pulse_length  = 100; // microseconds
+
+// defining the Arduino pins of the shift register chain
+const int shift_register_pin_LATCH  = 10; // RCLK of all 74HC595
+const int shift_register_pin_OE     = 9;  // OE of all 74HC595, with a pull-up resistor
+
+// storage for the outputs of the chain, one byte per 74HC595
+uint8_t shiftRegisterOutputs[2];
+
+// Parameter order:                                 Buffer,               Count,  Latch,                     Output enable
+FlipTheDot_FP2800aShiftRegister shiftRegister(      shiftRegisterOutputs, 2,      shift_register_pin_LATCH,  shift_register_pin_OE);
+
+// prepare the list of columns enable lines (chain outputs) for the available FP2800a ICs
+unsigned int columnEnableList[] = {
+  6, // first columns group
+  7, // second
+  8, // ...
+};
+const int columnEnableListLength = sizeof(columnEnableList)/sizeof(unsigned int);
+
+// setup the objects like in the example "Fixed-Multi", with chain outputs instead of Arduino pins and the chain as last parameter
+// Parameter order:                      Enable Reset,     Enable Set,            A0, A1, A2, B0, B1,  Pulse length,          Backend
+FlipTheDot_FP2800aFixed rowController(   14,               15,                    9,  10, 11, 12, 13,  fp2800a_pulse_length,  &shiftRegister);
+// Parameter order:                      Enable List,      Enable List length,    Data, A0, A1, A2, B0, B1,  Pulse length,          Backend
+FlipTheDot_FP2800aMulti columnController(columnEnableList, columnEnableListLength, 5,  0,  1,  2,  3,  4,   fp2800a_pulse_length,  &shiftRegister);
+
+
+// helper variables
+int rowOutputNo = 0;
+int rowOutputNoMax = rowController.getOutputMax();
+
+int columnOutputNo = 0;
+int columnOutputNoMax = columnController.getOutputMax();
+
+boolean dataStatus = false;
+
+
+void setup() {
+  delay(1000);
+  rowController.setData( dataStatus );
+  columnController.setData( !dataStatus );
+}
+
+
+void loop() {
+  // iterate thru all rows
+  for ( rowOutputNo = 1; rowOutputNo <= rowOutputNoMax; rowOutputNo++ )
+  {
+    // every call results in one transfer to the chain
+    rowController.setOutput(rowOutputNo);
+
+    // iterate thru all columns in the current row
+    for ( columnOutputNo = 1; columnOutputNo <= columnOutputNoMax; columnOutputNo++ )
+    {
+      columnController.setOutput(columnOutputNo);
+
+      // manual pulse the "enable" lines of both controllers
+      rowController.enable();
+      columnController.enable();
+      delayMicroseconds(fp2800a_pulse_length);
+      rowController.disable();
+      columnController.disable();
+
+      // remove/decrease this delay to speedup the process
+      delay(100);
+    }
+  }
+
+  // invert data flag and update the controllers
+  dataStatus = !dataStatus;
+  rowController.setData( dataStatus );
+  columnController.setData( !dataStatus );
+}
@@ -0,0 +1,508 @@
+/*
+ * Arduino.h stand-in  -- Build the Flip-The-Dot libraries on a Linux host
+ *
+ * Provides the small part of the Arduino API which is used by the libraries.
+ * The pins are mapped like on an ATmega328P (Arduino Uno) to three virtual 8 bit port registers,
+ * so digitalWrite(...) and direct port register access end up in the same place and can be compared.
+ *
+ *   D0  - D7   =>  PORTD bit 0 - 7
+ *   D8  - D13  =>  PORTB bit 0 - 5
+ *   A0  - A5   =>  PORTC bit 0 - 5  (pin 14 - 19)
+ *
+ * Hardware outside of the microcontroller (like the shift register simulator) can drive 64 external lines,
+ * FlipTheDot_Host_EXTERNAL_PIN(0 - 63). They are stored in further virtual ports and reach the observers
+ * like the pins, but digitalWrite(...) cannot change them.
+ *
+ * Time is virtual: it only advances in delay(...), delayMicroseconds(...) and by the configurable
+ * costs of the Arduino calls (see FlipTheDot_Host_costs). Observers (like the panel simulator)
+ * get informed about every pin change and every time span with a stable pin state.
+ * Direct port register writes are noticed when the status register gets restored at the end of
+ * the atomic block (SREG = oldSREG), or with the next Arduino call.
+ * A one shot timer (FlipTheDot_Host_setTimer) calls an interrupt service routine when the virtual
+ * time reaches its due time, e.g. during delay(...) or the cost of an Arduino call.
+ *
+ * Like a sketch, a host program has to consist of one translation unit.
+ */
+
+
+#ifndef FlipTheDot_Host_Arduino_h
+#define FlipTheDot_Host_Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH   0x1
+#define LOW    0x0
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PROGMEM
+#define pgm_read_byte(address) ( *(const uint8_t *)(address) )
+#define pgm_read_word(address) ( *(const uint16_t *)(address) )
+#define F(string) (string)
+
+#define NOT_A_PIN  0
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+
+const uint8_t A0 = 14;
+const uint8_t A1 = 15;
+const uint8_t A2 = 16;
+const uint8_t A3 = 17;
+const uint8_t A4 = 18;
+const uint8_t A5 = 19;
+
+const uint8_t NUM_DIGITAL_PINS = 20;
+
+// ports 0 - 4 belong to the microcontroller, the others to the external lines
+const uint8_t FlipTheDot_Host_MCU_PORTS = 5;
+const uint8_t FlipTheDot_Host_EXTERNAL_PORTS = 8;
+const uint8_t FlipTheDot_Host_PORTS = FlipTheDot_Host_MCU_PORTS + FlipTheDot_Host_EXTERNAL_PORTS;
+
+// pseudo pin numbers of the external lines, only usable with FlipTheDot_Host_pinLevel(...)
+#define FlipTheDot_Host_EXTERNAL_PIN(line) ( 64 + (line) )
+
+
+// virtual registers, indexed by the port number
+volatile uint8_t FlipTheDot_Host_PORT[FlipTheDot_Host_PORTS];
+volatile uint8_t FlipTheDot_Host_DDR[FlipTheDot_Host_PORTS];
+
+// virtual clock in nanoseconds
+unsigned long long FlipTheDot_Host_nanos = 0;
+
+// time which the Arduino calls consume, roughly like an ATmega328P at 16 MHz
+struct FlipTheDot_HostCosts
+{
+    unsigned long digitalWriteNanos;
+    unsigned long digitalReadNanos;
+    unsigned long pinModeNanos;
+    unsigned long portWriteNanos;   // atomic block with direct port register access
+};
+
+FlipTheDot_HostCosts FlipTheDot_Host_costs = { 3400, 3000, 3400, 500 };
+
+// counters for every call of the Arduino API
+struct FlipTheDot_HostCalls
+{
+    unsigned long digitalWrite;
+    unsigned long digitalRead;
+    unsigned long pinMode;
+    unsigned long portWrite;
+    unsigned long delay;
+};
+
+FlipTheDot_HostCalls FlipTheDot_Host_calls;
+
+
+/**
+ * gets informed about pin changes and the time in between
+ */
+class FlipTheDot_HostObserver
+{
+    public:
+        virtual ~FlipTheDot_HostObserver() {};
+        // called before pinsChanged(...), lets external hardware set the external ports of after from the pins
+        virtual void drivePins(const uint8_t *before, uint8_t *after) {};
+        // called after at least one pin changed, both arrays are indexed by the port number
+        virtual void pinsChanged(const uint8_t *before, const uint8_t *after, unsigned long long nanos) {};
+        // called when the time advanced without any pin change
+        virtual void timePassed(unsigned long long from, unsigned long long to) {};
+};
+
+const uint8_t FlipTheDot_Host_MAX_OBSERVERS = 8;
+FlipTheDot_HostObserver *FlipTheDot_Host_observers[FlipTheDot_Host_MAX_OBSERVERS];
+uint8_t FlipTheDot_Host_ports[FlipTheDot_Host_PORTS];
+
+
+void FlipTheDot_Host_addObserver(FlipTheDot_HostObserver *observer)
+{
+    for ( uint8_t i = 0; i < FlipTheDot_Host_MAX_OBSERVERS; i++ )
+    {
+        if ( FlipTheDot_Host_observers[i] == NULL )
+        {
+            FlipTheDot_Host_observers[i] = observer;
+            return;
+        }
+    }
+}
+
+void FlipTheDot_Host_removeObserver(FlipTheDot_HostObserver *observer)
+{
+    for ( uint8_t i = 0; i < FlipTheDot_Host_MAX_OBSERVERS; i++ )
+    {
+        if ( FlipTheDot_Host_observers[i] == observer )
+        {
+            FlipTheDot_Host_observers[i] = NULL;
+        }
+    }
+}
+
+
+/**
+ * inform the observers if any port register changed since the last call
+ */
+void FlipTheDot_Host_sync()
+{
+    uint8_t after[FlipTheDot_Host_PORTS];
+    for ( uint8_t i = 0; i < FlipTheDot_Host_PORTS; i++ )
+    {
+        after[i] = FlipTheDot_Host_PORT[i];
+    }
+
+    for ( uint8_t i = 0; i < FlipTheDot_Host_MAX_OBSERVERS; i++ )
+    {
+        if ( FlipTheDot_Host_observers[i] != NULL )
+        {
+            FlipTheDot_Host_observers[i]->drivePins(FlipTheDot_Host_ports, after);
+        }
+    }
+    for ( uint8_t i = FlipTheDot_Host_MCU_PORTS; i < FlipTheDot_Host_PORTS; i++ )
+    {
+        FlipTheDot_Host_PORT[i] = after[i];
+    }
+
+    if ( memcmp(after, FlipTheDot_Host_ports, FlipTheDot_Host_PORTS) == 0 )
+    {
+        return;
+    }
+
+    for ( uint8_t i = 0; i < FlipTheDot_Host_MAX_OBSERVERS; i++ )
+    {
+        if ( FlipTheDot_Host_observers[i] != NULL )
+        {
+            FlipTheDot_Host_observers[i]->pinsChanged(FlipTheDot_Host_ports, after, FlipTheDot_Host_nanos);
+        }
+    }
+    memcpy(FlipTheDot_Host_ports, after, FlipTheDot_Host_PORTS);
+}
+
+
+// one shot timer which calls an interrupt service routine at a given virtual time
+void (*FlipTheDot_Host_timerIsr)() = NULL;
+unsigned long long FlipTheDot_Host_timerNanos = 0;
+bool FlipTheDot_Host_inInterrupt = false;
+
+bool FlipTheDot_Host_interruptsEnabled();
+
+
+/**
+ * start the timer, the routine gets called once after the given time has passed
+ * a running timer gets restarted, 0 microseconds stop it
+ */
+void FlipTheDot_Host_setTimer(void (*isr)(), unsigned long us)
+{
+    FlipTheDot_Host_timerIsr = us == 0 ? NULL : isr;
+    FlipTheDot_Host_timerNanos = FlipTheDot_Host_nanos + us * 1000ULL;
+}
+
+
+void FlipTheDot_Host_advance(unsigned long long to)
+{
+    unsigned long long from = FlipTheDot_Host_nanos;
+    FlipTheDot_Host_nanos = to;
+
+    for ( uint8_t i = 0; i < FlipTheDot_Host_MAX_OBSERVERS; i++ )
+    {
+        if ( FlipTheDot_Host_observers[i] != NULL )
+        {
+            FlipTheDot_Host_observers[i]->timePassed(from, FlipTheDot_Host_nanos);
+        }
+    }
+}
+
+
+/**
+ * let the virtual time pass with the current pin state
+ * a due timer interrupts the time span (if interrupts are enabled), the time spent in its routine gets added to the span
+ * like the interrupted code on a microcontroller would take longer
+ */
+void FlipTheDot_Host_spend(unsigned long long nanos)
+{
+    if ( nanos == 0 )
+    {
+        return;
+    }
+
+    FlipTheDot_Host_sync();
+
+    unsigned long long end = FlipTheDot_Host_nanos + nanos;
+
+    while ( !FlipTheDot_Host_inInterrupt && FlipTheDot_Host_interruptsEnabled() && FlipTheDot_Host_timerIsr != NULL && FlipTheDot_Host_timerNanos <= end )
+    {
+        if ( FlipTheDot_Host_timerNanos > FlipTheDot_Host_nanos )
+        {
+            FlipTheDot_Host_advance(FlipTheDot_Host_timerNanos);
+        }
+
+        unsigned long long start = FlipTheDot_Host_nanos;
+        void (*isr)() = FlipTheDot_Host_timerIsr;
+        FlipTheDot_Host_timerIsr = NULL;
+
+        FlipTheDot_Host_inInterrupt = true;
+        isr();
+        FlipTheDot_Host_inInterrupt = false;
+
+        FlipTheDot_Host_sync();
+        end += FlipTheDot_Host_nanos - start;
+    }
+
+    if ( end > FlipTheDot_Host_nanos )
+    {
+        FlipTheDot_Host_advance(end);
+    }
+}
+
+
+/**
+ * status register, restoring it ends an atomic block with direct port register writes
+ */
+class FlipTheDot_HostStatusRegister
+{
+    public:
+        operator uint8_t() const { return _value; }
+
+        FlipTheDot_HostStatusRegister &operator=(uint8_t value)
+        {
+            _value = value;
+            FlipTheDot_Host_calls.portWrite++;
+            FlipTheDot_Host_sync();
+            FlipTheDot_Host_spend(FlipTheDot_Host_costs.portWriteNanos);
+            return *this;
+        }
+
+        FlipTheDot_HostStatusRegister &operator&=(uint8_t value) { _value &= value; return *this; }
+        FlipTheDot_HostStatusRegister &operator|=(uint8_t value) { _value |= value; return *this; }
+
+    protected:
+        uint8_t _value = 0x80;
+};
+
+FlipTheDot_HostStatusRegister SREG;
+
+inline void cli() { SREG &= 0x7F; }
+inline void sei() { SREG |= 0x80; }
+
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+bool FlipTheDot_Host_interruptsEnabled()
+{
+    return (SREG & 0x80) != 0;
+}
+
+
+inline uint8_t FlipTheDot_Host_pinToPort(uint8_t pin)
+{
+    if ( pin < 8 )
+    {
+        return PD;
+    }
+    if ( pin < 14 )
+    {
+        return PB;
+    }
+    if ( pin < NUM_DIGITAL_PINS )
+    {
+        return PC;
+    }
+    return NOT_A_PORT;
+}
+
+inline uint8_t FlipTheDot_Host_pinToBitMask(uint8_t pin)
+{
+    if ( pin < 8 )
+    {
+        return 1 << pin;
+    }
+    if ( pin < 14 )
+    {
+        return 1 << (pin - 8);
+    }
+    if ( pin < NUM_DIGITAL_PINS )
+    {
+        return 1 << (pin - 14);
+    }
+    return 0;
+}
+
+#define digitalPinToPort(P)    ( FlipTheDot_Host_pinToPort(P) )
+#define digitalPinToBitMask(P) ( FlipTheDot_Host_pinToBitMask(P) )
+#define portOutputRegister(P)  ( &FlipTheDot_Host_PORT[(P)] )
+#define portModeRegister(P)    ( &FlipTheDot_Host_DDR[(P)] )
+
+
+/**
+ * get the level of a pin from a port register snapshot
+ */
+uint8_t FlipTheDot_Host_pinLevel(const uint8_t *ports, uint8_t pin)
+{
+    if ( pin >= FlipTheDot_Host_EXTERNAL_PIN(0) && pin < FlipTheDot_Host_EXTERNAL_PIN(FlipTheDot_Host_EXTERNAL_PORTS * 8) )
+    {
+        uint8_t line = pin - FlipTheDot_Host_EXTERNAL_PIN(0);
+        return ( ports[FlipTheDot_Host_MCU_PORTS + line / 8] & (1 << (line % 8)) ) ? HIGH : LOW;
+    }
+
+    uint8_t port = digitalPinToPort(pin);
+    if ( port == NOT_A_PORT )
+    {
+        return LOW;
+    }
+    return ( ports[port] & digitalPinToBitMask(pin) ) ? HIGH : LOW;
+}
+
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    FlipTheDot_Host_calls.pinMode++;
+    FlipTheDot_Host_spend(FlipTheDot_Host_costs.pinModeNanos);
+
+    uint8_t port = digitalPinToPort(pin);
+    if ( port == NOT_A_PORT )
+    {
+        return;
+    }
+
+    if ( mode == OUTPUT )
+    {
+        FlipTheDot_Host_DDR[port] |= digitalPinToBitMask(pin);
+    }
+    else
+    {
+        FlipTheDot_Host_DDR[port] &= ~digitalPinToBitMask(pin);
+    }
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    FlipTheDot_Host_calls.digitalWrite++;
+    FlipTheDot_Host_spend(FlipTheDot_Host_costs.digitalWriteNanos);
+
+    uint8_t port = digitalPinToPort(pin);
+    if ( port == NOT_A_PORT )
+    {
+        return;
+    }
+
+    if ( value == LOW )
+    {
+        FlipTheDot_Host_PORT[port] &= ~digitalPinToBitMask(pin);
+    }
+    else
+    {
+        FlipTheDot_Host_PORT[port] |= digitalPinToBitMask(pin);
+    }
+
+    FlipTheDot_Host_sync();
+}
+
+
+int digitalRead(uint8_t pin)
+{
+    FlipTheDot_Host_calls.digitalRead++;
+    FlipTheDot_Host_spend(FlipTheDot_Host_costs.digitalReadNanos);
+
+    uint8_t port = digitalPinToPort(pin);
+    if ( port == NOT_A_PORT )
+    {
+        return LOW;
+    }
+    return ( FlipTheDot_Host_PORT[port] & digitalPinToBitMask(pin) ) ? HIGH : LOW;
+}
+
+
+// values returned by analogRead for A0 to A5
+int FlipTheDot_Host_analogValues[6] = {};
+
+/**
+ * conversion takes about 112 µs like on an ATmega328P with the default prescaler
+ */
+int analogRead(uint8_t pin)
+{
+    FlipTheDot_Host_spend(112000);
+
+    pin = pin >= A0 ? pin - A0 : pin;
+    return pin < 6 ? FlipTheDot_Host_analogValues[pin] : 0;
+}
+
+
+void delayMicroseconds(unsigned int us)
+{
+    FlipTheDot_Host_calls.delay++;
+    FlipTheDot_Host_spend(us * 1000ULL);
+}
+
+
+void delay(unsigned long ms)
+{
+    FlipTheDot_Host_calls.delay++;
+    FlipTheDot_Host_spend(ms * 1000000ULL);
+}
+
+
+unsigned long micros()
+{
+    FlipTheDot_Host_sync();
+    return FlipTheDot_Host_nanos / 1000;
+}
+
+
+unsigned long millis()
+{
+    FlipTheDot_Host_sync();
+    return FlipTheDot_Host_nanos / 1000000;
+}
+
+
+void randomSeed(unsigned long seed)
+{
+    srand(seed);
+}
+
+long random(long howbig)
+{
+    return howbig <= 0 ? 0 : rand() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+    return howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall);
+}
+
+
+/**
+ * serial connection which writes to stdout, used by the *_DEBUG_SERIAL defines
+ */
+class FlipTheDot_HostSerial
+{
+    public:
+        void begin(unsigned long baud) {};
+        size_t print(const char *value) { return printf("%s", value); }
+        size_t print(char value) { return printf("%c", value); }
+        size_t print(int value) { return printf("%d", value); }
+        size_t print(unsigned int value) { return printf("%u", value); }
+        size_t print(long value) { return printf("%ld", value); }
+        size_t print(unsigned long value) { return printf("%lu", value); }
+        size_t println() { return printf("\n"); }
+        template <class T> size_t println(T value) { return print(value) + println(); }
+        size_t write(uint8_t value) { return fwrite(&value, 1, 1, stdout); }
+        operator bool() { return true; }
+};
+
+FlipTheDot_HostSerial Serial;
+
+
+
+#endif // FlipTheDot_Host_Arduino_h
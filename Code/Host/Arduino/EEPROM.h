@@ -0,0 +1,64 @@
+/*
+ * EEPROM.h stand-in  -- Mock of the Arduino EEPROM library for the Arduino.h stand-in
+ *
+ * 1024 bytes like on an ATmega328P, erased (0xFF) at the start. Every write costs 3.3 ms of virtual time
+ * like the erase and write cycle of the AVR EEPROM, reads are free. The mock counts the writes of every
+ * byte (FlipTheDot_Host_eepromWrites) to check the wear levelling.
+ */
+
+
+#ifndef FlipTheDot_Host_EEPROM_h
+#define FlipTheDot_Host_EEPROM_h
+
+#include "Arduino.h"
+
+
+#define FlipTheDot_Host_EEPROM_SIZE 1024
+
+// time of one write in nanoseconds
+unsigned long FlipTheDot_Host_eepromWriteNanos = 3300000;
+
+// writes per byte since the start
+unsigned long FlipTheDot_Host_eepromWrites[FlipTheDot_Host_EEPROM_SIZE];
+
+
+class EEPROMClass
+{
+    public:
+        EEPROMClass() { memset(_data, 0xFF, sizeof(_data)); }
+
+        uint8_t read(int address)
+        {
+            return address >= 0 && address < FlipTheDot_Host_EEPROM_SIZE ? _data[address] : 0;
+        }
+
+        void write(int address, uint8_t value)
+        {
+            if ( address < 0 || address >= FlipTheDot_Host_EEPROM_SIZE )
+            {
+                return;
+            }
+            _data[address] = value;
+            FlipTheDot_Host_eepromWrites[address]++;
+            FlipTheDot_Host_spend(FlipTheDot_Host_eepromWriteNanos);
+        }
+
+        void update(int address, uint8_t value)
+        {
+            if ( read(address) != value )
+            {
+                write(address, value);
+            }
+        }
+
+        uint16_t length() { return FlipTheDot_Host_EEPROM_SIZE; }
+
+    protected:
+        uint8_t _data[FlipTheDot_Host_EEPROM_SIZE];
+};
+
+EEPROMClass EEPROM;
+
+
+
+#endif // FlipTheDot_Host_EEPROM_h
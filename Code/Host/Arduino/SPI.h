@@ -0,0 +1,147 @@
+/*
+ * SPI.h stand-in  -- Mock of the Arduino SPI library for the Arduino.h stand-in
+ *
+ * Every byte of SPI.transfer(...) goes to the connected device (FlipTheDot_Host_setSpiDevice), most significant
+ * bit first like on the wire, and costs the time of its 8 clock cycles plus a small overhead of virtual time.
+ * The clock gets limited to F_CPU / 2 (8 MHz) like on an ATmega328P.
+ *
+ * The mock counts transactions and bytes and checks the usage of the library:
+ * a transfer before SPI.begin() or outside of beginTransaction(...) / endTransaction() and nested
+ * transactions are counted as errors (FlipTheDot_Host_spi.errors).
+ */
+
+
+#ifndef FlipTheDot_Host_SPI_h
+#define FlipTheDot_Host_SPI_h
+
+#include "Arduino.h"
+
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+
+class SPISettings
+{
+    public:
+        SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {};
+        SPISettings() : clock(4000000), bitOrder(MSBFIRST), dataMode(SPI_MODE0) {};
+
+        uint32_t clock;
+        uint8_t bitOrder;
+        uint8_t dataMode;
+};
+
+
+/**
+ * gets every byte which is transferred, e.g. a shift register simulator
+ */
+class FlipTheDot_HostSpiDevice
+{
+    public:
+        virtual ~FlipTheDot_HostSpiDevice() {};
+        // value in wire order (first bit on the wire is bit 7), returns the byte for MISO
+        virtual uint8_t transfer(uint8_t value, const SPISettings &settings) = 0;
+};
+
+
+// usage counters of the mock
+struct FlipTheDot_HostSpi
+{
+    unsigned long transactions;
+    unsigned long bytes;
+    unsigned long errors;
+};
+
+FlipTheDot_HostSpi FlipTheDot_Host_spi;
+
+// overhead of every transferred byte besides its clock cycles (function call, waiting for the status flag)
+unsigned long FlipTheDot_Host_spiByteOverheadNanos = 400;
+
+FlipTheDot_HostSpiDevice *FlipTheDot_Host_spiDevice = NULL;
+
+
+void FlipTheDot_Host_setSpiDevice(FlipTheDot_HostSpiDevice *device)
+{
+    FlipTheDot_Host_spiDevice = device;
+}
+
+
+class SPIClass
+{
+    public:
+        void begin() { _isBegun = true; }
+        void end() { _isBegun = false; }
+
+        void beginTransaction(SPISettings settings)
+        {
+            if ( _inTransaction )
+            {
+                FlipTheDot_Host_spi.errors++;
+            }
+            _inTransaction = true;
+            _settings = settings;
+            _settings.clock = settings.clock > 8000000 ? 8000000 : settings.clock;
+            FlipTheDot_Host_spi.transactions++;
+        }
+
+        void endTransaction()
+        {
+            if ( !_inTransaction )
+            {
+                FlipTheDot_Host_spi.errors++;
+            }
+            _inTransaction = false;
+        }
+
+        uint8_t transfer(uint8_t value)
+        {
+            if ( !_isBegun || !_inTransaction )
+            {
+                FlipTheDot_Host_spi.errors++;
+            }
+            FlipTheDot_Host_spi.bytes++;
+
+            if ( _settings.bitOrder == LSBFIRST )
+            {
+                value = _reverse(value);
+            }
+
+            uint8_t received = FlipTheDot_Host_spiDevice != NULL ? FlipTheDot_Host_spiDevice->transfer(value, _settings) : 0;
+
+            FlipTheDot_Host_spend(8000000000ULL / _settings.clock + FlipTheDot_Host_spiByteOverheadNanos);
+            return _settings.bitOrder == LSBFIRST ? _reverse(received) : received;
+        }
+
+        void transfer(void *buffer, size_t count)
+        {
+            uint8_t *bytes = (uint8_t *)buffer;
+            for ( size_t i = 0; i < count; i++ )
+            {
+                bytes[i] = transfer(bytes[i]);
+            }
+        }
+
+    protected:
+        static uint8_t _reverse(uint8_t value)
+        {
+            uint8_t reversed = 0;
+            for ( uint8_t i = 0; i < 8; i++ )
+            {
+                reversed |= ((value >> i) & 1) << (7 - i);
+            }
+            return reversed;
+        }
+
+        bool _isBegun = false;
+        bool _inTransaction = false;
+        SPISettings _settings;
+};
+
+SPIClass SPI;
+
+
+
+#endif // FlipTheDot_Host_SPI_h
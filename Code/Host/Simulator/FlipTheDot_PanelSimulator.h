@@ -0,0 +1,359 @@
+/*
+ * FlipTheDot_PanelSimulator Class  -- Virtual flipdot panel for the Arduino.h stand-in
+ *
+ * Decodes the address, data and enable lines of any number of FP2800a chips from the virtual
+ * port registers and applies the resulting coil pulses to a grid of dots.
+ *
+ * Every chip drives the lines of one side (columns or rows) beginning at a given line offset.
+ * A dot gets current when its column line and its row line are driven with opposite levels:
+ * row HIGH (source) and column LOW (sink) shows the dot, row LOW and column HIGH hides it.
+ * The dot flips when the current flows at least as long as the configured flip time, which can differ
+ * per dot and polarity (setFlipTime) to model long traces or weak coils.
+ *
+ * Example for the wiring of the example "FixedDefault":
+ *   FlipTheDot_PanelSimulator panel(28, 13);
+ *   panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+ *   panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+ *   panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+ */
+
+
+#ifndef FlipTheDot_PanelSimulator_h
+#define FlipTheDot_PanelSimulator_h
+
+#include <vector>
+
+#include "Arduino.h"
+
+
+
+class FlipTheDot_PanelSimulator : public FlipTheDot_HostObserver
+{
+    public:
+        enum Side { COLUMNS = 0, ROWS = 1 };
+
+        // pseudo pin numbers for data lines which are wired to a fixed level
+        static const uint8_t FIXED_LOW  = 0xFE;
+        static const uint8_t FIXED_HIGH = 0xFF;
+
+        FlipTheDot_PanelSimulator(unsigned int cols, unsigned int rows, unsigned long flipNanos = 50000);
+        ~FlipTheDot_PanelSimulator();
+        void addChip(Side side, unsigned int firstLine, uint8_t pinEnable, uint8_t pinData, uint8_t pinA0, uint8_t pinA1, uint8_t pinA2, uint8_t pinB0, uint8_t pinB1);
+
+        unsigned int getColCount() { return _cols; }
+        unsigned int getRowCount() { return _rows; }
+        bool getDot(unsigned int col, unsigned int row);
+        void setDot(unsigned int col, unsigned int row, bool show);
+        void fill(bool show);
+        void print(FILE *file);
+        void setFlipTime(unsigned int col, unsigned int row, unsigned long showNanos, unsigned long hideNanos);
+        unsigned long getFlipTime(unsigned int col, unsigned int row, bool show);
+
+        // statistics
+        void resetStatistics();
+        unsigned long getPulseCount() { return _pulseCount; }
+        unsigned long getShortPulseCount() { return _shortPulseCount; }
+        unsigned long getConflictCount() { return _conflictCount; }
+        unsigned long getDotPulseCount(unsigned int col, unsigned int row);
+        unsigned long long getCoilNanos() { return _coilNanos; }
+        unsigned long long getFirstPulseNanos() { return _firstPulseNanos; }
+        unsigned long long getLastPulseNanos() { return _lastPulseNanos; }
+        bool isEnergized() { return !_energized.empty(); }
+
+        static int decodeOutput(uint8_t lines);
+
+        void pinsChanged(const uint8_t *before, const uint8_t *after, unsigned long long nanos);
+
+    protected:
+        struct Chip
+        {
+            Side side;
+            unsigned int firstLine;
+            uint8_t pinEnable;
+            uint8_t pinData;
+            uint8_t pinAddress[5];
+        };
+
+        // drive state of a line
+        enum Drive { FLOATING = 0, SOURCE = 1, SINK = 2 };
+
+        void _finishPulse(unsigned int index, unsigned long long nanos);
+
+        unsigned int _cols;
+        unsigned int _rows;
+        unsigned long _flipNanos;
+
+        std::vector<Chip> _chips;
+        std::vector<bool> _dots;
+        std::vector<unsigned long> _dotPulses;
+        std::vector<unsigned long> _flipShowNanos;
+        std::vector<unsigned long> _flipHideNanos;
+
+        // currently energized coils: dot index, polarity and start time
+        std::vector<unsigned int> _energized;
+        std::vector<int8_t> _energizedShow;
+        std::vector<unsigned long long> _energizedSince;
+
+        unsigned long _pulseCount = 0;
+        unsigned long _shortPulseCount = 0;
+        unsigned long _conflictCount = 0;
+        unsigned long long _coilNanos = 0;
+        unsigned long long _firstPulseNanos = 0;
+        unsigned long long _lastPulseNanos = 0;
+};
+
+
+
+FlipTheDot_PanelSimulator::FlipTheDot_PanelSimulator(unsigned int cols, unsigned int rows, unsigned long flipNanos)
+{
+    _cols = cols;
+    _rows = rows;
+    _flipNanos = flipNanos;
+
+    _dots.assign(cols * rows, false);
+    _dotPulses.assign(cols * rows, 0);
+    _flipShowNanos.assign(cols * rows, flipNanos);
+    _flipHideNanos.assign(cols * rows, flipNanos);
+    _energizedShow.assign(cols * rows, -1);
+    _energizedSince.assign(cols * rows, 0);
+
+    FlipTheDot_Host_addObserver(this);
+}
+
+
+FlipTheDot_PanelSimulator::~FlipTheDot_PanelSimulator()
+{
+    FlipTheDot_Host_removeObserver(this);
+}
+
+
+/**
+ * connect a FP2800a to the lines firstLine + 1 to firstLine + 28 of one side
+ * use FIXED_LOW or FIXED_HIGH as data pin for chips with a hard wired data line
+ */
+void FlipTheDot_PanelSimulator::addChip(Side side, unsigned int firstLine, uint8_t pinEnable, uint8_t pinData, uint8_t pinA0, uint8_t pinA1, uint8_t pinA2, uint8_t pinB0, uint8_t pinB1)
+{
+    Chip chip = { side, firstLine, pinEnable, pinData, { pinA0, pinA1, pinA2, pinB0, pinB1 } };
+    _chips.push_back(chip);
+}
+
+
+/**
+ * map the address lines (bit 0: A0, 1: A1, 2: A2, 3: B0, 4: B1) to the output 1 to 28
+ * returns 0 when no output gets selected (A0 - A2 all LOW)
+ */
+int FlipTheDot_PanelSimulator::decodeOutput(uint8_t lines)
+{
+    uint8_t a = lines & 0x07;
+    uint8_t b = (lines >> 3) & 0x03;
+
+    return a == 0 ? 0 : b * 7 + a;
+}
+
+
+bool FlipTheDot_PanelSimulator::getDot(unsigned int col, unsigned int row)
+{
+    if ( col < 1 || col > _cols || row < 1 || row > _rows )
+    {
+        return false;
+    }
+    return _dots[(row - 1) * _cols + col - 1];
+}
+
+
+void FlipTheDot_PanelSimulator::setDot(unsigned int col, unsigned int row, bool show)
+{
+    if ( col >= 1 && col <= _cols && row >= 1 && row <= _rows )
+    {
+        _dots[(row - 1) * _cols + col - 1] = show;
+    }
+}
+
+
+void FlipTheDot_PanelSimulator::fill(bool show)
+{
+    _dots.assign(_cols * _rows, show);
+}
+
+
+/**
+ * define the minimum pulse length which flips a dot, for each polarity
+ */
+void FlipTheDot_PanelSimulator::setFlipTime(unsigned int col, unsigned int row, unsigned long showNanos, unsigned long hideNanos)
+{
+    if ( col >= 1 && col <= _cols && row >= 1 && row <= _rows )
+    {
+        _flipShowNanos[(row - 1) * _cols + col - 1] = showNanos;
+        _flipHideNanos[(row - 1) * _cols + col - 1] = hideNanos;
+    }
+}
+
+
+unsigned long FlipTheDot_PanelSimulator::getFlipTime(unsigned int col, unsigned int row, bool show)
+{
+    if ( col < 1 || col > _cols || row < 1 || row > _rows )
+    {
+        return 0;
+    }
+    return show ? _flipShowNanos[(row - 1) * _cols + col - 1] : _flipHideNanos[(row - 1) * _cols + col - 1];
+}
+
+
+unsigned long FlipTheDot_PanelSimulator::getDotPulseCount(unsigned int col, unsigned int row)
+{
+    if ( col < 1 || col > _cols || row < 1 || row > _rows )
+    {
+        return 0;
+    }
+    return _dotPulses[(row - 1) * _cols + col - 1];
+}
+
+
+void FlipTheDot_PanelSimulator::resetStatistics()
+{
+    _pulseCount = 0;
+    _shortPulseCount = 0;
+    _conflictCount = 0;
+    _coilNanos = 0;
+    _firstPulseNanos = 0;
+    _lastPulseNanos = 0;
+    _dotPulses.assign(_cols * _rows, 0);
+}
+
+
+/**
+ * draw the dots as text, one line per row
+ */
+void FlipTheDot_PanelSimulator::print(FILE *file)
+{
+    for ( unsigned int row = 1; row <= _rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= _cols; col++ )
+        {
+            fputc(getDot(col, row) ? '#' : '.', file);
+        }
+        fputc('\n', file);
+    }
+}
+
+
+/**
+ * end the current flow thru a coil and flip the dot if it was long enough
+ */
+void FlipTheDot_PanelSimulator::_finishPulse(unsigned int index, unsigned long long nanos)
+{
+    unsigned long long duration = nanos - _energizedSince[index];
+
+    _coilNanos += duration;
+    if ( duration >= (_energizedShow[index] == 1 ? _flipShowNanos[index] : _flipHideNanos[index]) )
+    {
+        _dots[index] = _energizedShow[index] == 1;
+        _dotPulses[index]++;
+        if ( _pulseCount == 0 )
+        {
+            _firstPulseNanos = _energizedSince[index];
+        }
+        _pulseCount++;
+        _lastPulseNanos = nanos;
+    }
+    else
+    {
+        _shortPulseCount++;
+    }
+    _energizedShow[index] = -1;
+}
+
+
+/**
+ * decode all chips and update the list of energized coils
+ */
+void FlipTheDot_PanelSimulator::pinsChanged(const uint8_t *before, const uint8_t *after, unsigned long long nanos)
+{
+    std::vector<uint8_t> drive[2];
+    drive[COLUMNS].assign(_cols + 1, FLOATING);
+    drive[ROWS].assign(_rows + 1, FLOATING);
+
+    for ( unsigned int i = 0; i < _chips.size(); i++ )
+    {
+        Chip &chip = _chips[i];
+        if ( FlipTheDot_Host_pinLevel(after, chip.pinEnable) == LOW )
+        {
+            continue;
+        }
+
+        uint8_t lines = 0;
+        for ( uint8_t bit = 0; bit < 5; bit++ )
+        {
+            lines |= FlipTheDot_Host_pinLevel(after, chip.pinAddress[bit]) << bit;
+        }
+
+        int output = decodeOutput(lines);
+        unsigned int line = chip.firstLine + output;
+        if ( output == 0 || line > (chip.side == COLUMNS ? _cols : _rows) )
+        {
+            continue;
+        }
+
+        bool high = chip.pinData == FIXED_HIGH || ( chip.pinData != FIXED_LOW && FlipTheDot_Host_pinLevel(after, chip.pinData) == HIGH );
+        uint8_t level = high ? SOURCE : SINK;
+
+        if ( drive[chip.side][line] != FLOATING && drive[chip.side][line] != level )
+        {
+            // two chips drive the same line in different directions
+            _conflictCount++;
+        }
+        drive[chip.side][line] = level;
+    }
+
+    // collect the coils which get current with the new pin state
+    std::vector<unsigned int> energized;
+    for ( unsigned int row = 1; row <= _rows; row++ )
+    {
+        if ( drive[ROWS][row] == FLOATING )
+        {
+            continue;
+        }
+        for ( unsigned int col = 1; col <= _cols; col++ )
+        {
+            if ( drive[COLUMNS][col] == FLOATING || drive[COLUMNS][col] == drive[ROWS][row] )
+            {
+                continue;
+            }
+
+            unsigned int index = (row - 1) * _cols + col - 1;
+            int8_t show = drive[ROWS][row] == SOURCE ? 1 : 0;
+
+            if ( _energizedShow[index] != show )
+            {
+                if ( _energizedShow[index] != -1 )
+                {
+                    _finishPulse(index, nanos);
+                }
+                _energizedShow[index] = show;
+                _energizedSince[index] = nanos;
+            }
+            energized.push_back(index);
+        }
+    }
+
+    // finish all coils which lost their current
+    for ( unsigned int i = 0; i < _energized.size(); i++ )
+    {
+        unsigned int index = _energized[i];
+        bool still = false;
+        for ( unsigned int j = 0; j < energized.size() && !still; j++ )
+        {
+            still = energized[j] == index;
+        }
+        if ( !still && _energizedShow[index] != -1 )
+        {
+            _finishPulse(index, nanos);
+        }
+    }
+
+    _energized = energized;
+}
+
+
+
+#endif // FlipTheDot_PanelSimulator_h
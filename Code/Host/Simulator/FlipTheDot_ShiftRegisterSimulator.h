@@ -0,0 +1,140 @@
+/*
+ * FlipTheDot_ShiftRegisterSimulator Class  -- Virtual chain of 74HC595 shift registers for the SPI.h stand-in
+ *
+ * Receives the bytes of the mocked SPI into the shift stages and copies them to the outputs on the rising
+ * edge of the latch pin (RCLK). The outputs drive the external lines of the Arduino.h stand-in, output n of the
+ * chain is FlipTheDot_Host_EXTERNAL_PIN(n). So the panel simulator can decode FP2800a chips behind the chain:
+ *
+ *   FlipTheDot_ShiftRegisterSimulator chain(2, 10);
+ *   panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, chain.pin(6), chain.pin(5), chain.pin(0), ...);
+ *
+ * While the output enable pin (OE) is HIGH, all outputs are LOW (like a pull-down resistor on every line).
+ * Transfers in SPI_MODE1 and SPI_MODE2 would shift on the wrong clock edge and are counted as errors.
+ * Only one chain can be connected at a time.
+ */
+
+
+#ifndef FlipTheDot_ShiftRegisterSimulator_h
+#define FlipTheDot_ShiftRegisterSimulator_h
+
+#include <vector>
+
+#include "Arduino.h"
+#include "SPI.h"
+
+
+
+class FlipTheDot_ShiftRegisterSimulator : public FlipTheDot_HostSpiDevice, public FlipTheDot_HostObserver
+{
+    public:
+        // pseudo pin number for a chain without output enable pin (OE wired to GND)
+        static const uint8_t NO_PIN = 0xFF;
+
+        FlipTheDot_ShiftRegisterSimulator(unsigned int registerCount, uint8_t pinLatch, uint8_t pinOutputEnable = NO_PIN);
+        ~FlipTheDot_ShiftRegisterSimulator();
+
+        static uint8_t pin(unsigned int output) { return FlipTheDot_Host_EXTERNAL_PIN(output); }
+        bool getOutput(unsigned int output);
+
+        unsigned long getLatchCount() { return _latchCount; }
+        unsigned long getByteCount() { return _byteCount; }
+        unsigned long getErrorCount() { return _errorCount; }
+
+        uint8_t transfer(uint8_t value, const SPISettings &settings);
+        void drivePins(const uint8_t *before, uint8_t *after);
+
+    protected:
+        unsigned int _registerCount;
+        uint8_t _pinLatch;
+        uint8_t _pinOutputEnable;
+
+        // index 0 is the register next to the microcontroller
+        std::vector<uint8_t> _shift;
+        std::vector<uint8_t> _storage;
+
+        unsigned long _latchCount = 0;
+        unsigned long _byteCount = 0;
+        unsigned long _errorCount = 0;
+};
+
+
+
+FlipTheDot_ShiftRegisterSimulator::FlipTheDot_ShiftRegisterSimulator(unsigned int registerCount, uint8_t pinLatch, uint8_t pinOutputEnable)
+{
+    _registerCount = registerCount > FlipTheDot_Host_EXTERNAL_PORTS ? FlipTheDot_Host_EXTERNAL_PORTS : registerCount;
+    _pinLatch = pinLatch;
+    _pinOutputEnable = pinOutputEnable;
+
+    _shift.assign(_registerCount, 0);
+    _storage.assign(_registerCount, 0);
+
+    FlipTheDot_Host_setSpiDevice(this);
+    FlipTheDot_Host_addObserver(this);
+}
+
+
+FlipTheDot_ShiftRegisterSimulator::~FlipTheDot_ShiftRegisterSimulator()
+{
+    FlipTheDot_Host_setSpiDevice(NULL);
+    FlipTheDot_Host_removeObserver(this);
+}
+
+
+/**
+ * get the level of an output (0 - 7: QA - QH of the first register), LOW while the outputs are disabled
+ */
+bool FlipTheDot_ShiftRegisterSimulator::getOutput(unsigned int output)
+{
+    uint8_t ports[FlipTheDot_Host_PORTS];
+    for ( uint8_t i = 0; i < FlipTheDot_Host_PORTS; i++ )
+    {
+        ports[i] = FlipTheDot_Host_PORT[i];
+    }
+    return output < _registerCount * 8 && FlipTheDot_Host_pinLevel(ports, pin(output)) == HIGH;
+}
+
+
+/**
+ * shift a byte into the chain, the byte of the last register falls out at QH'
+ */
+uint8_t FlipTheDot_ShiftRegisterSimulator::transfer(uint8_t value, const SPISettings &settings)
+{
+    // the 74HC595 shifts on the rising edge of SRCLK, like SPI_MODE0 and SPI_MODE3 sample
+    if ( settings.dataMode == SPI_MODE1 || settings.dataMode == SPI_MODE2 )
+    {
+        _errorCount++;
+    }
+    _byteCount++;
+
+    uint8_t out = _shift[_registerCount - 1];
+    for ( unsigned int i = _registerCount - 1; i > 0; i-- )
+    {
+        _shift[i] = _shift[i - 1];
+    }
+    _shift[0] = value;
+    return out;
+}
+
+
+/**
+ * latch the shift stages on the rising edge of RCLK and drive the external lines
+ */
+void FlipTheDot_ShiftRegisterSimulator::drivePins(const uint8_t *before, uint8_t *after)
+{
+    if ( FlipTheDot_Host_pinLevel(before, _pinLatch) == LOW && FlipTheDot_Host_pinLevel(after, _pinLatch) == HIGH )
+    {
+        _storage = _shift;
+        _latchCount++;
+    }
+
+    bool isEnabled = _pinOutputEnable == NO_PIN || FlipTheDot_Host_pinLevel(after, _pinOutputEnable) == LOW;
+
+    for ( unsigned int i = 0; i < _registerCount; i++ )
+    {
+        after[FlipTheDot_Host_MCU_PORTS + i] = isEnabled ? _storage[i] : 0;
+    }
+}
+
+
+
+#endif // FlipTheDot_ShiftRegisterSimulator_h
@@ -0,0 +1,230 @@
+/*
+ * FlipTheDot_VcdWriter Class  -- Record the FP2800a lines of the Arduino.h stand-in as VCD waveform
+ *
+ * Writes every change of the registered pins with the virtual time (1 ns resolution) into a Value Change Dump
+ * file, which GTKWave and other waveform viewers open. Every FP2800a gets its own scope with the wires
+ * "enable", "data" (missing for a hard wired data line) and the vector "address" (bit 0: A0, 1: A1, 2: A2,
+ * 3: B0, 4: B1). Code/Host/Tools/TimingCheck checks such files against the timing of the datasheet.
+ *
+ * Example for the wiring of the example "FixedDefault":
+ *   FILE *file = fopen("flush.vcd", "w");
+ *   FlipTheDot_VcdWriter vcd(file);
+ *   vcd.addChip("col", A1, 8, 9, 10, 11, 12, 13);
+ *   vcd.addChip("rowReset", A0, FlipTheDot_VcdWriter::NO_PIN, 3, 4, 5, 6, 7);
+ *   vcd.addChip("rowSet", 2, FlipTheDot_VcdWriter::NO_PIN, 3, 4, 5, 6, 7);
+ *   vcd.begin();
+ *   ...
+ *   vcd.end();
+ */
+
+
+#ifndef FlipTheDot_VcdWriter_h
+#define FlipTheDot_VcdWriter_h
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+
+
+class FlipTheDot_VcdWriter : public FlipTheDot_HostObserver
+{
+    public:
+        // pin number for a data line which is not connected to the microcontroller
+        static const uint8_t NO_PIN = 0xFF;
+
+        FlipTheDot_VcdWriter(FILE *file);
+        ~FlipTheDot_VcdWriter();
+        void addChip(const char *name, uint8_t pinEnable, uint8_t pinData, uint8_t pinA0, uint8_t pinA1, uint8_t pinA2, uint8_t pinB0, uint8_t pinB1);
+        void begin();
+        void end();
+        unsigned long getChangeCount() { return _changeCount; }
+
+        void pinsChanged(const uint8_t *before, const uint8_t *after, unsigned long long nanos);
+
+    protected:
+        struct Chip
+        {
+            std::string name;
+            uint8_t pinEnable;
+            uint8_t pinData;
+            uint8_t pinAddress[5];
+        };
+
+        uint8_t _readAddress(const Chip &chip, const uint8_t *ports);
+        void _writeValues(const uint8_t *before, const uint8_t *after);
+        std::string _identifier(unsigned int chip, uint8_t wire);
+
+        FILE *_file;
+        std::vector<Chip> _chips;
+        unsigned long long _startNanos = 0;
+        unsigned long _changeCount = 0;
+        bool _isRecording = false;
+};
+
+
+
+FlipTheDot_VcdWriter::FlipTheDot_VcdWriter(FILE *file)
+{
+    _file = file;
+}
+
+
+FlipTheDot_VcdWriter::~FlipTheDot_VcdWriter()
+{
+    end();
+}
+
+
+/**
+ * register the lines of a FP2800a, use NO_PIN for a hard wired data line
+ */
+void FlipTheDot_VcdWriter::addChip(const char *name, uint8_t pinEnable, uint8_t pinData, uint8_t pinA0, uint8_t pinA1, uint8_t pinA2, uint8_t pinB0, uint8_t pinB1)
+{
+    Chip chip = { name, pinEnable, pinData, { pinA0, pinA1, pinA2, pinB0, pinB1 } };
+    _chips.push_back(chip);
+}
+
+
+/**
+ * write the header and the current levels, the time of the file starts now
+ */
+void FlipTheDot_VcdWriter::begin()
+{
+    FlipTheDot_Host_sync();
+
+    fprintf(_file, "$comment FlipTheDot_VcdWriter, virtual time of the Arduino.h stand-in $end\n");
+    fprintf(_file, "$timescale 1ns $end\n");
+    for ( unsigned int i = 0; i < _chips.size(); i++ )
+    {
+        fprintf(_file, "$scope module %s $end\n", _chips[i].name.c_str());
+        fprintf(_file, "$var wire 1 %s enable $end\n", _identifier(i, 0).c_str());
+        if ( _chips[i].pinData != NO_PIN )
+        {
+            fprintf(_file, "$var wire 1 %s data $end\n", _identifier(i, 1).c_str());
+        }
+        fprintf(_file, "$var wire 5 %s address $end\n", _identifier(i, 2).c_str());
+        fprintf(_file, "$upscope $end\n");
+    }
+    fprintf(_file, "$enddefinitions $end\n");
+
+    _startNanos = FlipTheDot_Host_nanos;
+    fprintf(_file, "#0\n$dumpvars\n");
+    _writeValues(NULL, FlipTheDot_Host_ports);
+    fprintf(_file, "$end\n");
+
+    _isRecording = true;
+    FlipTheDot_Host_addObserver(this);
+}
+
+
+/**
+ * stop recording and mark the end time
+ */
+void FlipTheDot_VcdWriter::end()
+{
+    if ( !_isRecording )
+    {
+        return;
+    }
+    FlipTheDot_Host_sync();
+    FlipTheDot_Host_removeObserver(this);
+    fprintf(_file, "#%llu\n", FlipTheDot_Host_nanos - _startNanos);
+    fflush(_file);
+    _isRecording = false;
+}
+
+
+void FlipTheDot_VcdWriter::pinsChanged(const uint8_t *before, const uint8_t *after, unsigned long long nanos)
+{
+    bool isChanged = false;
+
+    for ( unsigned int i = 0; i < _chips.size() && !isChanged; i++ )
+    {
+        const Chip &chip = _chips[i];
+        isChanged = FlipTheDot_Host_pinLevel(before, chip.pinEnable) != FlipTheDot_Host_pinLevel(after, chip.pinEnable)
+            || ( chip.pinData != NO_PIN && FlipTheDot_Host_pinLevel(before, chip.pinData) != FlipTheDot_Host_pinLevel(after, chip.pinData) )
+            || _readAddress(chip, before) != _readAddress(chip, after);
+    }
+
+    if ( isChanged )
+    {
+        fprintf(_file, "#%llu\n", nanos - _startNanos);
+        _writeValues(before, after);
+    }
+}
+
+
+uint8_t FlipTheDot_VcdWriter::_readAddress(const Chip &chip, const uint8_t *ports)
+{
+    uint8_t lines = 0;
+    for ( uint8_t bit = 0; bit < 5; bit++ )
+    {
+        lines |= FlipTheDot_Host_pinLevel(ports, chip.pinAddress[bit]) << bit;
+    }
+    return lines;
+}
+
+
+/**
+ * write the values which differ between both snapshots, all of them without before
+ */
+void FlipTheDot_VcdWriter::_writeValues(const uint8_t *before, const uint8_t *after)
+{
+    for ( unsigned int i = 0; i < _chips.size(); i++ )
+    {
+        const Chip &chip = _chips[i];
+
+        uint8_t level = FlipTheDot_Host_pinLevel(after, chip.pinEnable);
+        if ( before == NULL || FlipTheDot_Host_pinLevel(before, chip.pinEnable) != level )
+        {
+            fprintf(_file, "%u%s\n", level, _identifier(i, 0).c_str());
+            _changeCount++;
+        }
+
+        if ( chip.pinData != NO_PIN )
+        {
+            level = FlipTheDot_Host_pinLevel(after, chip.pinData);
+            if ( before == NULL || FlipTheDot_Host_pinLevel(before, chip.pinData) != level )
+            {
+                fprintf(_file, "%u%s\n", level, _identifier(i, 1).c_str());
+                _changeCount++;
+            }
+        }
+
+        uint8_t lines = _readAddress(chip, after);
+        if ( before == NULL || _readAddress(chip, before) != lines )
+        {
+            fputc('b', _file);
+            for ( int bit = 4; bit >= 0; bit-- )
+            {
+                fputc((lines >> bit) & 1 ? '1' : '0', _file);
+            }
+            fprintf(_file, " %s\n", _identifier(i, 2).c_str());
+            _changeCount++;
+        }
+    }
+}
+
+
+/**
+ * short name of a wire in the file, printable characters from '!'
+ */
+std::string FlipTheDot_VcdWriter::_identifier(unsigned int chip, uint8_t wire)
+{
+    unsigned int number = chip * 3 + wire;
+    std::string identifier;
+
+    do
+    {
+        identifier += (char)('!' + number % 94);
+        number /= 94;
+    }
+    while ( number > 0 );
+    return identifier;
+}
+
+
+
+#endif // FlipTheDot_VcdWriter_h
@@ -0,0 +1,538 @@
+/*
+  AnimationConverter
+  Convert an animated GIF and/or a sequence of PNG images into an animation for the FlipTheDot_AnimationPlayer.
+  Every pixel becomes one dot: shown if its brightness is at least the threshold (or below it with --invert).
+  Images larger than the panel get cropped, smaller ones get filled with hidden dots (top left corner aligned).
+
+  Usage: AnimationConverter [options] <image.gif|image.png>...
+    --cols <n>, --rows <n>  panel size, default: size of the first image
+    --delay <ms>            duration of PNG frames and of GIF frames without delay, default 100
+    --threshold <0-255>     default 128
+    --invert                show the dark pixels
+    --name <identifier>     name of the array in the header file, default animation
+    --format <header|binary|text>
+                            header: PROGMEM array for the sketch (default)
+                            binary: the plain animation, e.g. for a file on an SD card
+                            text:   the frames as text (# shown, . hidden), to check the conversion
+    -o <file>               output file, default stdout
+
+  Build (needs libpng):
+    g++ -std=c++11 Code/Host/Tools/Animation/AnimationConverter.cpp -lpng -o AnimationConverter
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <png.h>
+
+#include "FlipTheDot_AnimationEncoder.h"
+
+
+// one decoded image in gray levels
+struct Image
+{
+    unsigned int width;
+    unsigned int height;
+    std::vector<uint8_t> gray;
+    unsigned int durationMillis;
+};
+
+
+bool readFile(const char *path, std::vector<uint8_t> &data)
+{
+    FILE *file = fopen(path, "rb");
+    if ( file == NULL )
+    {
+        return false;
+    }
+
+    uint8_t chunk[4096];
+    size_t length;
+    while ( (length = fread(chunk, 1, sizeof(chunk), file)) > 0 )
+    {
+        data.insert(data.end(), chunk, chunk + length);
+    }
+    fclose(file);
+    return true;
+}
+
+
+bool readPng(const char *path, unsigned int delay, std::vector<Image> &images)
+{
+    png_image png;
+    memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+
+    if ( !png_image_begin_read_from_file(&png, path) )
+    {
+        fprintf(stderr, "%s: %s\n", path, png.message);
+        return false;
+    }
+
+    // transparent pixels get composed onto black
+    png.format = PNG_FORMAT_GRAY;
+    Image image = { png.width, png.height, std::vector<uint8_t>(PNG_IMAGE_SIZE(png)), delay };
+
+    if ( !png_image_finish_read(&png, NULL, image.gray.data(), 0, NULL) )
+    {
+        fprintf(stderr, "%s: %s\n", path, png.message);
+        return false;
+    }
+
+    images.push_back(image);
+    return true;
+}
+
+
+/*
+  GIF decoder: LZW image data, local and global color tables, interlacing, transparency and the disposal methods
+*/
+class GifReader
+{
+    public:
+        GifReader(const std::vector<uint8_t> &data) : _data(data) {}
+
+        bool read(unsigned int delay, std::vector<Image> &images)
+        {
+            if ( _data.size() < 13 || memcmp(_data.data(), "GIF8", 4) != 0 )
+            {
+                return false;
+            }
+
+            _width = _word(6);
+            _height = _word(8);
+            uint8_t flags = _data[10];
+            uint8_t background = _data[11];
+            _position = 13;
+
+            std::vector<uint8_t> globalColors;
+            if ( flags & 0x80 && !_colors(flags, globalColors) )
+            {
+                return false;
+            }
+
+            // the canvas keeps RGB, frames only cover a part of it
+            uint8_t backgroundRgb[3] = { 0, 0, 0 };
+            if ( background * 3u + 2 < globalColors.size() )
+            {
+                memcpy(backgroundRgb, &globalColors[background * 3], 3);
+            }
+            std::vector<uint8_t> canvas(_width * _height * 3, 0);
+            _fillRect(canvas, 0, 0, _width, _height, backgroundRgb);
+
+            unsigned int frameDelay = delay;
+            int transparent = -1;
+            uint8_t disposal = 0;
+
+            while ( _position < _data.size() )
+            {
+                uint8_t block = _data[_position++];
+
+                if ( block == 0x3B )
+                {
+                    break;
+                }
+                else if ( block == 0x21 && _position < _data.size() )
+                {
+                    uint8_t label = _data[_position++];
+                    if ( label == 0xF9 && _position + 5 < _data.size() && _data[_position] >= 4 )
+                    {
+                        // graphic control extension: disposal, delay in 1/100 s, transparent color
+                        uint8_t control = _data[_position + 1];
+                        unsigned int centis = _word(_position + 2);
+                        disposal = (control >> 2) & 0x07;
+                        transparent = control & 0x01 ? _data[_position + 4] : -1;
+                        frameDelay = centis > 0 ? centis * 10 : delay;
+                    }
+                    if ( !_skipBlocks() )
+                    {
+                        return false;
+                    }
+                }
+                else if ( block == 0x2C )
+                {
+                    if ( _position + 9 > _data.size() )
+                    {
+                        return false;
+                    }
+                    unsigned int left = _word(_position);
+                    unsigned int top = _word(_position + 2);
+                    unsigned int width = _word(_position + 4);
+                    unsigned int height = _word(_position + 6);
+                    uint8_t imageFlags = _data[_position + 8];
+                    _position += 9;
+
+                    std::vector<uint8_t> colors = globalColors;
+                    if ( imageFlags & 0x80 && !_colors(imageFlags, colors) )
+                    {
+                        return false;
+                    }
+
+                    std::vector<uint8_t> indices;
+                    if ( !_decode(width * height, indices) )
+                    {
+                        return false;
+                    }
+
+                    std::vector<uint8_t> previous = canvas;
+                    _draw(canvas, indices, colors, left, top, width, height, imageFlags & 0x40, transparent);
+
+                    Image image = { _width, _height, std::vector<uint8_t>(_width * _height), frameDelay };
+                    for ( unsigned int i = 0; i < _width * _height; i++ )
+                    {
+                        image.gray[i] = (canvas[i * 3] * 299 + canvas[i * 3 + 1] * 587 + canvas[i * 3 + 2] * 114) / 1000;
+                    }
+                    images.push_back(image);
+
+                    if ( disposal == 2 )
+                    {
+                        _fillRect(canvas, left, top, width, height, backgroundRgb);
+                    }
+                    else if ( disposal == 3 )
+                    {
+                        canvas.swap(previous);
+                    }
+
+                    frameDelay = delay;
+                    transparent = -1;
+                    disposal = 0;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    protected:
+        unsigned int _word(size_t position)
+        {
+            return _data[position] | _data[position + 1] << 8;
+        }
+
+        bool _colors(uint8_t flags, std::vector<uint8_t> &colors)
+        {
+            size_t length = 3 << ((flags & 0x07) + 1);
+            if ( _position + length > _data.size() )
+            {
+                return false;
+            }
+            colors.assign(_data.begin() + _position, _data.begin() + _position + length);
+            _position += length;
+            return true;
+        }
+
+        bool _skipBlocks()
+        {
+            while ( _position < _data.size() )
+            {
+                uint8_t length = _data[_position++];
+                if ( length == 0 )
+                {
+                    return true;
+                }
+                _position += length;
+            }
+            return false;
+        }
+
+        bool _decode(size_t pixels, std::vector<uint8_t> &indices)
+        {
+            if ( _position >= _data.size() )
+            {
+                return false;
+            }
+            unsigned int minCodeSize = _data[_position++];
+            if ( minCodeSize < 2 || minCodeSize > 11 )
+            {
+                return false;
+            }
+
+            // collect the sub blocks
+            std::vector<uint8_t> stream;
+            while ( _position < _data.size() )
+            {
+                uint8_t length = _data[_position++];
+                if ( length == 0 )
+                {
+                    break;
+                }
+                if ( _position + length > _data.size() )
+                {
+                    return false;
+                }
+                stream.insert(stream.end(), _data.begin() + _position, _data.begin() + _position + length);
+                _position += length;
+            }
+
+            const unsigned int clear = 1 << minCodeSize;
+            const unsigned int end = clear + 1;
+            std::vector<uint16_t> prefix(4096);
+            std::vector<uint8_t> suffix(4096), first(4096), run;
+            unsigned int codeSize = minCodeSize + 1;
+            unsigned int next = clear + 2;
+            int previous = -1;
+            unsigned long bits = 0;
+            unsigned int bitCount = 0;
+            size_t byte = 0;
+
+            for ( unsigned int i = 0; i < clear; i++ )
+            {
+                suffix[i] = i;
+                first[i] = i;
+            }
+
+            while ( indices.size() < pixels )
+            {
+                while ( bitCount < codeSize && byte < stream.size() )
+                {
+                    bits |= (unsigned long)stream[byte++] << bitCount;
+                    bitCount += 8;
+                }
+                if ( bitCount < codeSize )
+                {
+                    break;
+                }
+                unsigned int code = bits & ((1 << codeSize) - 1);
+                bits >>= codeSize;
+                bitCount -= codeSize;
+
+                if ( code == clear )
+                {
+                    codeSize = minCodeSize + 1;
+                    next = clear + 2;
+                    previous = -1;
+                    continue;
+                }
+                if ( code == end )
+                {
+                    break;
+                }
+                if ( previous < 0 )
+                {
+                    if ( code >= clear )
+                    {
+                        return false;
+                    }
+                    indices.push_back(code);
+                    previous = code;
+                    continue;
+                }
+                if ( code > next )
+                {
+                    return false;
+                }
+
+                // the unknown code (code == next) is the previous string plus its own first index
+                unsigned int string = code == next ? previous : code;
+                run.clear();
+                if ( code == next )
+                {
+                    run.push_back(first[previous]);
+                }
+                for ( ; string >= clear; string = prefix[string] )
+                {
+                    run.push_back(suffix[string]);
+                }
+                run.push_back(string);
+                indices.insert(indices.end(), run.rbegin(), run.rend());
+
+                if ( next < 4096 )
+                {
+                    prefix[next] = previous;
+                    suffix[next] = first[code == next ? previous : code];
+                    first[next] = first[previous];
+                    next++;
+                    if ( next == (1u << codeSize) && codeSize < 12 )
+                    {
+                        codeSize++;
+                    }
+                }
+                previous = code;
+            }
+
+            indices.resize(pixels, 0);
+            return true;
+        }
+
+        void _draw(std::vector<uint8_t> &canvas, const std::vector<uint8_t> &indices, const std::vector<uint8_t> &colors,
+                   unsigned int left, unsigned int top, unsigned int width, unsigned int height, bool isInterlaced, int transparent)
+        {
+            // interlaced images store the rows 0, 8, 16, ..., then 4, 12, ..., then 2, 6, ..., then 1, 3, ...
+            static const unsigned int starts[4] = { 0, 4, 2, 1 };
+            static const unsigned int steps[4] = { 8, 8, 4, 2 };
+            std::vector<unsigned int> rowOrder;
+
+            for ( unsigned int pass = 0; pass < (isInterlaced ? 4u : 1u); pass++ )
+            {
+                for ( unsigned int y = isInterlaced ? starts[pass] : 0; y < height; y += isInterlaced ? steps[pass] : 1 )
+                {
+                    rowOrder.push_back(y);
+                }
+            }
+
+            for ( unsigned int i = 0; i < height; i++ )
+            {
+                for ( unsigned int x = 0; x < width; x++ )
+                {
+                    unsigned int index = indices[i * width + x];
+                    unsigned int canvasX = left + x;
+                    unsigned int canvasY = top + rowOrder[i];
+
+                    if ( (int)index == transparent || canvasX >= _width || canvasY >= _height || index * 3 + 2 >= colors.size() )
+                    {
+                        continue;
+                    }
+                    memcpy(&canvas[(canvasY * _width + canvasX) * 3], &colors[index * 3], 3);
+                }
+            }
+        }
+
+        void _fillRect(std::vector<uint8_t> &canvas, unsigned int left, unsigned int top, unsigned int width, unsigned int height, const uint8_t *rgb)
+        {
+            for ( unsigned int y = top; y < top + height && y < _height; y++ )
+            {
+                for ( unsigned int x = left; x < left + width && x < _width; x++ )
+                {
+                    memcpy(&canvas[(y * _width + x) * 3], rgb, 3);
+                }
+            }
+        }
+
+        const std::vector<uint8_t> &_data;
+        size_t _position = 0;
+        unsigned int _width = 0;
+        unsigned int _height = 0;
+};
+
+
+int usage()
+{
+    fprintf(stderr, "Usage: AnimationConverter [--cols n] [--rows n] [--delay ms] [--threshold 0-255] [--invert]\n"
+                    "                          [--name identifier] [--format header|binary|text] [-o file] <image.gif|image.png>...\n");
+    return 2;
+}
+
+
+int main(int argc, char **argv)
+{
+    unsigned int cols = 0, rows = 0, delay = 100, threshold = 128;
+    bool isInverted = false;
+    std::string name = "animation", format = "header", outputPath;
+    std::vector<Image> images;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "--cols" && hasValue ) cols = atoi(argv[++i]);
+        else if ( arg == "--rows" && hasValue ) rows = atoi(argv[++i]);
+        else if ( arg == "--delay" && hasValue ) delay = atoi(argv[++i]);
+        else if ( arg == "--threshold" && hasValue ) threshold = atoi(argv[++i]);
+        else if ( arg == "--invert" ) isInverted = true;
+        else if ( arg == "--name" && hasValue ) name = argv[++i];
+        else if ( arg == "--format" && hasValue ) format = argv[++i];
+        else if ( arg == "-o" && hasValue ) outputPath = argv[++i];
+        else if ( arg[0] == '-' ) return usage();
+        else
+        {
+            std::vector<uint8_t> data;
+            if ( !readFile(argv[i], data) )
+            {
+                fprintf(stderr, "%s: cannot read file\n", argv[i]);
+                return 1;
+            }
+
+            bool isValid = data.size() >= 4 && memcmp(data.data(), "GIF8", 4) == 0
+                ? GifReader(data).read(delay, images)
+                : readPng(argv[i], delay, images);
+            if ( !isValid )
+            {
+                fprintf(stderr, "%s: no valid GIF or PNG image\n", argv[i]);
+                return 1;
+            }
+        }
+    }
+
+    if ( images.empty() || ( format != "header" && format != "binary" && format != "text" ) )
+    {
+        return usage();
+    }
+
+    cols = cols > 0 ? cols : images[0].width;
+    rows = rows > 0 ? rows : images[0].height;
+    if ( cols > 255 || rows > 255 )
+    {
+        fprintf(stderr, "panel size %ux%u: up to 255 columns and rows\n", cols, rows);
+        return 1;
+    }
+
+    FlipTheDot_AnimationEncoder encoder(cols, rows);
+    for ( size_t i = 0; i < images.size(); i++ )
+    {
+        std::vector<uint8_t> dots(cols * rows, 0);
+        for ( unsigned int y = 0; y < rows && y < images[i].height; y++ )
+        {
+            for ( unsigned int x = 0; x < cols && x < images[i].width; x++ )
+            {
+                dots[y * cols + x] = (images[i].gray[y * images[i].width + x] >= threshold) != isInverted;
+            }
+        }
+        encoder.addFrame(dots, images[i].durationMillis);
+    }
+
+    unsigned long toggles;
+    std::vector<uint8_t> animation = encoder.encode(&toggles);
+
+    FILE *out = outputPath.empty() ? stdout : fopen(outputPath.c_str(), format == "binary" ? "wb" : "w");
+    if ( out == NULL )
+    {
+        fprintf(stderr, "%s: cannot write file\n", outputPath.c_str());
+        return 1;
+    }
+
+    if ( format == "binary" )
+    {
+        fwrite(animation.data(), 1, animation.size(), out);
+    }
+    else if ( format == "text" )
+    {
+        for ( unsigned int i = 0; i < encoder.getFrameCount(); i++ )
+        {
+            fprintf(out, "frame %u %u ms\n", i + 1, encoder.getDuration(i));
+            for ( unsigned int row = 0; row < rows; row++ )
+            {
+                for ( unsigned int col = 0; col < cols; col++ )
+                {
+                    fputc(encoder.getFrame(i)[row * cols + col] ? '#' : '.', out);
+                }
+                fputc('\n', out);
+            }
+        }
+    }
+    else
+    {
+        fprintf(out, "// created by AnimationConverter: %ux%u dots, %u frames, %zu bytes\n\n", cols, rows, encoder.getFrameCount(), animation.size());
+        fprintf(out, "const uint8_t %s[] PROGMEM = {", name.c_str());
+        for ( size_t i = 0; i < animation.size(); i++ )
+        {
+            fprintf(out, "%s0x%02X%s", i % 16 == 0 ? "\n    " : " ", animation[i], i + 1 < animation.size() ? "," : "\n");
+        }
+        fprintf(out, "};\n");
+    }
+
+    if ( out != stdout )
+    {
+        fclose(out);
+    }
+
+    fprintf(stderr, "%ux%u dots, %u frames, %zu bytes, about %lu address and data line changes\n",
+        cols, rows, encoder.getFrameCount(), animation.size(), toggles);
+    return 0;
+}
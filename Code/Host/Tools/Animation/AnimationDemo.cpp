@@ -0,0 +1,202 @@
+/*
+  AnimationDemo
+  Play an animation of the AnimationConverter on the simulated 28x13 panel with the wiring of the example "FixedDefault":
+
+    player (flash)          FlipTheDot_AnimationPlayer from an array, without frame buffer
+    player (file)           FlipTheDot_AnimationPlayer from the file thru FlipTheDot_AnimationFile, with frame buffer
+    frame buffer + flush    every frame drawn into the frame buffer and flushed (optimized order of the controller)
+
+  Every mode plays all frames twice (the second time thru the wrap record) and compares the panel after every frame
+  with the frames of the text file. Exit code 1 if any dot differs or the panel counted too short or conflicting pulses.
+
+  Usage: AnimationDemo <animation.bin> <frames.txt>   (see animation.sh)
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/Animation/AnimationDemo.cpp
+ */
+
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Animation.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+std::vector<std::string> frames;
+
+
+/**
+ * stand-in for File of the SD library
+ */
+class HostFile
+{
+    public:
+        HostFile(const char *path) { _file = fopen(path, "rb"); }
+        ~HostFile() { if ( _file != NULL ) fclose(_file); }
+        bool isOpen() { return _file != NULL; }
+        int read(uint8_t *buffer, unsigned int length) { return fread(buffer, 1, length, _file); }
+        bool seek(unsigned long offset) { return fseek(_file, offset, SEEK_SET) == 0; }
+
+    protected:
+        FILE *_file;
+};
+
+
+bool readFrames(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[512];
+    std::string current;
+
+    if ( file == NULL )
+    {
+        return false;
+    }
+    while ( fgets(line, sizeof(line), file) != NULL )
+    {
+        if ( strncmp(line, "frame ", 6) == 0 )
+        {
+            if ( !current.empty() )
+            {
+                frames.push_back(current);
+            }
+            current.clear();
+            continue;
+        }
+        for ( char *c = line; *c == '#' || *c == '.'; c++ )
+        {
+            current += *c;
+        }
+    }
+    if ( !current.empty() )
+    {
+        frames.push_back(current);
+    }
+    fclose(file);
+    return !frames.empty() && frames[0].size() == columns * rows;
+}
+
+
+unsigned int countDifferences(unsigned int index)
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            bool expected = frames[index][(row - 1) * columns + col - 1] == '#';
+            differences += panel.getDot(col, row) != expected ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+/**
+ * play every frame twice with the given method, returns the number of differing dots
+ */
+unsigned int run(const char *title, FlipTheDot_AnimationSource *source, bool hasFrameBuffer)
+{
+    FlipTheDot_AnimationPlayer player(controller);
+    unsigned int differences = 0;
+    unsigned int plays = frames.size() * 2;
+
+    controller.setFrameBuffer(hasFrameBuffer ? frame : NULL, hasFrameBuffer ? shadow : NULL);
+    if ( source != NULL && !player.begin(*source) )
+    {
+        printf("%-22s cannot read the animation\n", title);
+        return columns * rows;
+    }
+
+    panel.fill(false);
+    panel.resetStatistics();
+    columnController.resetStatistics();
+    rowController.resetStatistics();
+    unsigned long long start = FlipTheDot_Host_nanos;
+
+    for ( unsigned int i = 0; i < plays; i++ )
+    {
+        unsigned int index = i % frames.size();
+
+        if ( source != NULL )
+        {
+            player.playFrame();
+        }
+        else
+        {
+            for ( unsigned int row = 1; row <= rows; row++ )
+            {
+                for ( unsigned int col = 1; col <= columns; col++ )
+                {
+                    controller.setDot(col, row, frames[index][(row - 1) * columns + col - 1] == '#');
+                }
+            }
+            controller.flush();
+        }
+        differences += countDifferences(index);
+    }
+
+    unsigned long toggles = columnController.getStatistics().addressToggles + rowController.getStatistics().addressToggles;
+    double msPerFrame = (FlipTheDot_Host_nanos - start) / 1e6 / plays;
+    printf("%-22s %7.1f dots/frame %8.1f address line changes/frame %7.2f ms/frame, %u dots differ, %lu read errors\n", title,
+        (double)panel.getPulseCount() / plays, (double)toggles / plays, msPerFrame, differences, player.getErrorCount());
+    return differences + player.getErrorCount();
+}
+
+
+int main(int argc, char **argv)
+{
+    if ( argc < 3 || !readFrames(argv[2]) )
+    {
+        fprintf(stderr, "Usage: AnimationDemo <animation.bin> <frames.txt> (%u x %u dots)\n", columns, rows);
+        return 2;
+    }
+
+    std::vector<uint8_t> data;
+    HostFile file(argv[1]);
+    uint8_t chunk[256];
+    int length;
+    while ( file.isOpen() && (length = file.read(chunk, sizeof(chunk))) > 0 )
+    {
+        data.insert(data.end(), chunk, chunk + length);
+    }
+
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    printf("%zu frames, %zu bytes (%zu bytes per frame)\n", frames.size(), data.size(), data.size() / frames.size());
+
+    // pgm_read_byte of the stand-in reads the RAM
+    FlipTheDot_AnimationProgmem flash(data.data(), data.size());
+    FlipTheDot_AnimationFile<HostFile> sdFile(file);
+
+    unsigned int differences = run("player (flash)", &flash, false);
+    differences += run("player (file)", &sdFile, true);
+    differences += run("frame buffer + flush", NULL, true);
+
+    printf("%lu short pulses, %lu conflicts\n", panel.getShortPulseCount(), panel.getConflictCount());
+
+    bool isValid = differences == 0 && panel.getShortPulseCount() == 0 && panel.getConflictCount() == 0;
+    return isValid ? 0 : 1;
+}
@@ -0,0 +1,289 @@
+/*
+ * FlipTheDot_AnimationEncoder Class  -- Create animations for the FlipTheDot_AnimationPlayer on a Linux host
+ *
+ * Collects the frames (one byte per dot, row after row, non-zero = shown) and encodes them in the format
+ * described in FlipTheDot_Animation.h. The grouping of every change list gets decided here instead of on the
+ * microcontroller: the changed dots get grouped by rows or by columns and by FP2800a, the lines get walked in the
+ * Gray code order of the FP2800a address lines (like flush() of the ColumnRowController does it) and for every record
+ * the variant with the fewest level changes on the address and data lines gets stored:
+ *   - row groups or column groups, whatever keeps more dots on the same fixed output
+ *   - hide or show first, so the data state of the previous record can stay
+ *   - the lines forward or backward, whatever is closer to the previous output
+ * The dots of a group are a mask, the player pulses them with flipRow(...) or flipColumn(...) in the order of the
+ * controller, the estimate assumes the Gray code order (setOptimizedOrder).
+ */
+
+
+#ifndef FlipTheDot_AnimationEncoder_h
+#define FlipTheDot_AnimationEncoder_h
+
+#include <stdint.h>
+#include <vector>
+
+
+class FlipTheDot_AnimationEncoder
+{
+    public:
+        FlipTheDot_AnimationEncoder(unsigned int cols, unsigned int rows) : _cols(cols), _rows(rows) {}
+
+        unsigned int getColCount() { return _cols; }
+        unsigned int getRowCount() { return _rows; }
+        unsigned int getFrameCount() { return _frames.size(); }
+        const std::vector<uint8_t> &getFrame(unsigned int index) { return _frames[index]; }
+        unsigned int getDuration(unsigned int index) { return _durations[index]; }
+
+        void addFrame(const std::vector<uint8_t> &dots, unsigned int durationMillis)
+        {
+            _frames.push_back(dots);
+            _durations.push_back(durationMillis > 0xFFFF ? 0xFFFF : durationMillis);
+        }
+
+        /**
+         * encode all frames, toggles gets the estimated level changes of the address and data lines
+         */
+        std::vector<uint8_t> encode(unsigned long *toggles = NULL)
+        {
+            std::vector<uint8_t> out;
+            State state = { 0, 0, -1, 0 };
+
+            if ( _frames.empty() )
+            {
+                return out;
+            }
+
+            out.push_back('F');
+            out.push_back('A');
+            out.push_back(_cols);
+            out.push_back(_rows);
+            _append(out, _frames.size(), 2);
+            _append(out, 0, 4);
+            _append(out, 0, 4);
+
+            unsigned long loopOffset = 0;
+            for ( size_t i = 0; i < _frames.size(); i++ )
+            {
+                if ( i == 1 )
+                {
+                    loopOffset = out.size();
+                }
+                _encodeRecord(i == 0 ? NULL : &_frames[i - 1], _frames[i], _durations[i], state, out);
+            }
+
+            unsigned long wrapOffset = out.size();
+            if ( _frames.size() == 1 )
+            {
+                loopOffset = wrapOffset;
+            }
+            _encodeRecord(&_frames.back(), _frames.front(), _durations.front(), state, out);
+
+            for ( int i = 0; i < 4; i++ )
+            {
+                out[6 + i] = loopOffset >> (8 * i);
+                out[10 + i] = wrapOffset >> (8 * i);
+            }
+
+            if ( toggles != NULL )
+            {
+                *toggles = state.toggles;
+            }
+            return out;
+        }
+
+        /**
+         * line number (1 to 28 * ICs) of a step of the Gray code walk, same as _walk of the ColumnRowController
+         */
+        static unsigned int walk(unsigned int step)
+        {
+            static const uint8_t order[28] = {
+                 1,  3,  2,  6,  7,  5,  4,
+                11, 12, 14, 13,  9, 10,  8,
+                22, 24, 23, 27, 28, 26, 25,
+                18, 19, 21, 20, 16, 17, 15
+            };
+            unsigned int chip = step / 28;
+            unsigned int index = step % 28;
+
+            return chip * 28 + order[chip & 1 ? 27 - index : index];
+        }
+
+        /**
+         * number of FP2800a address lines (A0 - A2, B0, B1) which change from output a to output b, 0 = none selected
+         */
+        static unsigned int addressToggles(unsigned int a, unsigned int b)
+        {
+            unsigned int lines = _addressLines(a) ^ _addressLines(b);
+            unsigned int count = 0;
+
+            for ( ; lines != 0; lines >>= 1 )
+            {
+                count += lines & 1;
+            }
+            return count;
+        }
+
+    protected:
+        // selected outputs and data state after the previous record
+        struct State
+        {
+            unsigned int col;
+            unsigned int row;
+            int show;             // -1: unknown
+            unsigned long toggles;
+        };
+
+        struct Group
+        {
+            bool show;
+            bool isColumn;
+            unsigned int line;
+            // first line of the FP2800a, the numbers are in its range and in the order of the walk
+            unsigned int first;
+            std::vector<uint8_t> numbers;
+        };
+
+        static unsigned int _addressLines(unsigned int no)
+        {
+            // like FlipTheDot_FP2800a_ADDRESS_TABLE: outputs 1 - 7 on B = 0, 8 - 14 on B = 1, ...
+            if ( no == 0 )
+            {
+                return 0;
+            }
+            unsigned int output = (no - 1) % 28;
+            return (output / 7) << 3 | (output % 7 + 1);
+        }
+
+        void _append(std::vector<uint8_t> &out, unsigned long value, int bytes)
+        {
+            for ( int i = 0; i < bytes; i++ )
+            {
+                out.push_back(value >> (8 * i));
+            }
+        }
+
+        /**
+         * collect the groups of one pass (all dots with the same state), fixed lines and dots in Gray code order,
+         * one group per fixed line and FP2800a of the dots
+         */
+        void _collect(const std::vector<uint8_t> *previous, const std::vector<uint8_t> &next, bool show, bool isColumn,
+                      bool isLinesReversed, State &state, std::vector<Group> &groups)
+        {
+            unsigned int lines = isColumn ? _cols : _rows;
+            unsigned int numbers = isColumn ? _rows : _cols;
+            unsigned int lineSteps = (lines + 27) / 28 * 28;
+            unsigned int numberSteps = (numbers + 27) / 28 * 28;
+
+            for ( unsigned int lineStep = 0; lineStep < lineSteps; lineStep++ )
+            {
+                unsigned int line = walk(isLinesReversed ? lineSteps - 1 - lineStep : lineStep);
+                if ( line > lines )
+                {
+                    continue;
+                }
+
+                // the walk visits the FP2800a one after the other
+                for ( unsigned int chipStep = 0; chipStep < numberSteps; chipStep += 28 )
+                {
+                    Group group = { show, isColumn, line, chipStep + 1, std::vector<uint8_t>() };
+                    for ( unsigned int step = chipStep; step < chipStep + 28; step++ )
+                    {
+                        unsigned int no = walk(step);
+                        if ( no > numbers )
+                        {
+                            continue;
+                        }
+
+                        size_t index = isColumn ? (no - 1) * _cols + line - 1 : (line - 1) * _cols + no - 1;
+                        bool isShown = next[index] != 0;
+                        if ( isShown == show && ( previous == NULL || ((*previous)[index] != 0) != show ) )
+                        {
+                            group.numbers.push_back(no);
+                        }
+                    }
+
+                    if ( !group.numbers.empty() )
+                    {
+                        _count(group, state);
+                        groups.push_back(group);
+                    }
+                }
+            }
+        }
+
+        /**
+         * add the line changes of a group to the state
+         */
+        void _count(const Group &group, State &state)
+        {
+            unsigned int &fixed = group.isColumn ? state.col : state.row;
+            unsigned int &walked = group.isColumn ? state.row : state.col;
+
+            if ( state.show != (int)group.show )
+            {
+                // the data pins of both controllers change
+                state.toggles += state.show < 0 ? 0 : 2;
+                state.show = group.show;
+            }
+
+            state.toggles += addressToggles(fixed, group.line);
+            fixed = group.line;
+
+            for ( size_t i = 0; i < group.numbers.size(); i++ )
+            {
+                state.toggles += addressToggles(walked, group.numbers[i]);
+                walked = group.numbers[i];
+            }
+        }
+
+        void _encodeRecord(const std::vector<uint8_t> *previous, const std::vector<uint8_t> &next, unsigned int durationMillis,
+                           State &state, std::vector<uint8_t> &out)
+        {
+            std::vector<Group> best;
+            State bestState = state;
+            bool isFirst = true;
+
+            for ( int variant = 0; variant < 8; variant++ )
+            {
+                bool isColumn = variant & 1;
+                bool showFirst = variant & 2;
+                bool isLinesReversed = variant & 4;
+                std::vector<Group> groups;
+                State candidate = state;
+
+                _collect(previous, next, showFirst, isColumn, isLinesReversed, candidate, groups);
+                _collect(previous, next, !showFirst, isColumn, isLinesReversed, candidate, groups);
+
+                if ( isFirst || candidate.toggles < bestState.toggles )
+                {
+                    best.swap(groups);
+                    bestState = candidate;
+                    isFirst = false;
+                }
+            }
+
+            state = bestState;
+
+            _append(out, durationMillis, 2);
+            for ( size_t i = 0; i < best.size(); i++ )
+            {
+                out.push_back(0x80 | (best[i].show ? 0x01 : 0) | (best[i].isColumn ? 0x02 : 0));
+                out.push_back(best[i].line);
+                out.push_back(best[i].first);
+
+                unsigned long mask = 0;
+                for ( size_t j = 0; j < best[i].numbers.size(); j++ )
+                {
+                    mask |= 1UL << (best[i].numbers[j] - best[i].first);
+                }
+                _append(out, mask, 4);
+            }
+            out.push_back(0);
+        }
+
+        unsigned int _cols;
+        unsigned int _rows;
+        std::vector<std::vector<uint8_t> > _frames;
+        std::vector<unsigned int> _durations;
+};
+
+
+#endif // FlipTheDot_AnimationEncoder_h
@@ -0,0 +1,21 @@
+#!/bin/bash
+# Convert an animation (default: bounce.gif) with the AnimationConverter and play it with AnimationDemo on the simulated panel.
+# Usage: ./animation.sh [image.gif|image.png...]
+
+cd "$(dirname "$0")"
+
+libraries=../../../Arduino/libraries
+build=$(mktemp -d)
+images=("${@:-bounce.gif}")
+
+g++ -std=c++11 -O2 AnimationConverter.cpp -lpng -o "$build/converter" || exit 1
+g++ -std=c++11 -O2 -I../../Arduino -I../../Simulator -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController \
+    AnimationDemo.cpp -o "$build/demo" || exit 1
+
+"$build/converter" --cols 28 --rows 13 --format binary -o "$build/animation.bin" "${images[@]}" || exit 1
+"$build/converter" --cols 28 --rows 13 --format text -o "$build/frames.txt" "${images[@]}" 2>/dev/null || exit 1
+"$build/demo" "$build/animation.bin" "$build/frames.txt"
+result=$?
+
+rm -r "$build"
+exit $result
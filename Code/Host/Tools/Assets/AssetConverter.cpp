@@ -0,0 +1,517 @@
+/*
+  AssetConverter
+  Convert BDF fonts and PNG images into a header file for FlipTheDot_Blitter: the dots in PROGMEM arrays with the
+  layout of the frame buffer (row after row, (width + 7) / 8 bytes per row, first column in the lowest bit) and
+  constexpr FlipTheDot_Bitmap and FlipTheDot_Font descriptions. The sketch draws them without any decoding, the
+  fonts work with FlipTheDot_Ticker (up to 8 rows) and FlipTheDot_Layer as well.
+
+  Images: every pixel becomes one dot, shown if its brightness is at least the threshold (or below it with --invert).
+  Fonts:  every glyph gets placed in a cell of the font height (ascent + descent), then its empty columns on both sides
+          get removed (a glyph without dots keeps its advance width minus the spacing) and glyphs with the same dots
+          are stored once.
+
+  The options apply to the files which follow them.
+
+  Usage: AssetConverter [options] <file.bdf|file.png>...
+    --name <identifier>     name of the next asset, default: file name without extension
+    --threshold <0-255>     images: default 128
+    --invert                images: show the dark pixels
+    --chars <first>-<last>  fonts: character codes to convert, default 32-126
+    --spacing <n>           fonts: hidden columns between two glyphs, default 1
+    --no-trim               fonts: keep the empty columns (fixed width like the BDF cell)
+    --format <header|text>  header: the header file for the sketch (default)
+                            text:   the assets as text (# shown, . hidden), to check the conversion
+    -o <file>               output file, default stdout
+
+  Build (needs libpng):
+    g++ -std=c++11 Code/Host/Tools/Assets/AssetConverter.cpp -lpng -o AssetConverter
+ */
+
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <png.h>
+
+
+// dots of an image or a glyph, one byte per dot
+struct Dots
+{
+    unsigned int width;
+    unsigned int height;
+    std::vector<uint8_t> dots;
+
+    bool get(unsigned int x, unsigned int y) const { return dots[y * width + x] != 0; }
+};
+
+struct Bitmap
+{
+    std::string name;
+    Dots dots;
+};
+
+struct Font
+{
+    std::string name;
+    unsigned int first;
+    unsigned int count;
+    unsigned int height;
+    unsigned int spacing;
+    std::vector<Dots> glyphs;           // after deduplication
+    std::vector<uint8_t> characters;    // glyph of every character, 0xFF: missing
+    unsigned int duplicates;
+    unsigned int trimmedColumns;
+};
+
+
+/**
+ * bytes of the frame buffer layout
+ */
+std::vector<uint8_t> pack(const Dots &dots)
+{
+    unsigned int rowBytes = (dots.width + 7) / 8;
+    std::vector<uint8_t> bytes(rowBytes * dots.height, 0);
+
+    for ( unsigned int y = 0; y < dots.height; y++ )
+    {
+        for ( unsigned int x = 0; x < dots.width; x++ )
+        {
+            bytes[y * rowBytes + x / 8] |= dots.get(x, y) ? 1 << (x % 8) : 0;
+        }
+    }
+    return bytes;
+}
+
+
+std::string nameOf(const std::string &path)
+{
+    size_t slash = path.find_last_of('/');
+    std::string name = path.substr(slash == std::string::npos ? 0 : slash + 1);
+    name = name.substr(0, name.find('.'));
+
+    for ( size_t i = 0; i < name.size(); i++ )
+    {
+        name[i] = isalnum((unsigned char)name[i]) ? name[i] : '_';
+    }
+    return name.empty() || isdigit((unsigned char)name[0]) ? "_" + name : name;
+}
+
+
+bool readPng(const char *path, unsigned int threshold, bool isInverted, Dots &image)
+{
+    png_image png;
+    memset(&png, 0, sizeof(png));
+    png.version = PNG_IMAGE_VERSION;
+
+    if ( !png_image_begin_read_from_file(&png, path) )
+    {
+        fprintf(stderr, "%s: %s\n", path, png.message);
+        return false;
+    }
+
+    // transparent pixels get composed onto black
+    png.format = PNG_FORMAT_GRAY;
+    std::vector<uint8_t> gray(PNG_IMAGE_SIZE(png));
+
+    if ( !png_image_finish_read(&png, NULL, gray.data(), 0, NULL) )
+    {
+        fprintf(stderr, "%s: %s\n", path, png.message);
+        return false;
+    }
+    if ( png.width > 255 || png.height > 255 )
+    {
+        fprintf(stderr, "%s: %ux%u pixels, up to 255 columns and rows\n", path, png.width, png.height);
+        return false;
+    }
+
+    image.width = png.width;
+    image.height = png.height;
+    image.dots.resize(gray.size());
+    for ( size_t i = 0; i < gray.size(); i++ )
+    {
+        image.dots[i] = (gray[i] >= threshold) != isInverted;
+    }
+    return true;
+}
+
+
+/*
+  BDF reader: FONTBOUNDINGBOX, FONT_ASCENT / FONT_DESCENT, and per character ENCODING, DWIDTH, BBX and BITMAP
+*/
+class BdfReader
+{
+    public:
+        bool read(const char *path, unsigned int first, unsigned int last, bool isTrimmed, Font &font)
+        {
+            FILE *file = fopen(path, "r");
+            if ( file == NULL )
+            {
+                fprintf(stderr, "%s: cannot read file\n", path);
+                return false;
+            }
+
+            char line[1024];
+            int boxHeight = 0, boxY = 0, ascent = -1, descent = -1;
+            std::vector<Glyph> glyphs;
+            Glyph glyph;
+            bool isBitmap = false;
+
+            while ( fgets(line, sizeof(line), file) != NULL )
+            {
+                int a, b, c, d;
+                if ( isBitmap )
+                {
+                    if ( strncmp(line, "ENDCHAR", 7) == 0 )
+                    {
+                        isBitmap = false;
+                        glyphs.push_back(glyph);
+                    }
+                    else
+                    {
+                        glyph.rows.push_back(strtoul(line, NULL, 16));
+                        glyph.rowDigits = strspn(line, "0123456789abcdefABCDEF");
+                    }
+                }
+                else if ( sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &a, &b, &c, &d) == 4 )
+                {
+                    boxHeight = b;
+                    boxY = d;
+                }
+                else if ( sscanf(line, "FONT_ASCENT %d", &a) == 1 )     ascent = a;
+                else if ( sscanf(line, "FONT_DESCENT %d", &a) == 1 )    descent = a;
+                else if ( strncmp(line, "STARTCHAR", 9) == 0 )          glyph = Glyph();
+                else if ( sscanf(line, "ENCODING %d", &a) == 1 )        glyph.code = a;
+                else if ( sscanf(line, "DWIDTH %d", &a) == 1 )          glyph.advance = a;
+                else if ( sscanf(line, "BBX %d %d %d %d", &a, &b, &c, &d) == 4 )
+                {
+                    glyph.width = a;
+                    glyph.height = b;
+                    glyph.x = c;
+                    glyph.y = d;
+                }
+                else if ( strncmp(line, "BITMAP", 6) == 0 )             isBitmap = true;
+            }
+            fclose(file);
+
+            // the baseline of the cell, from the bounding box if the properties are missing
+            ascent = ascent >= 0 ? ascent : boxHeight + boxY;
+            descent = descent >= 0 ? descent : -boxY;
+            if ( glyphs.empty() || ascent + descent <= 0 || ascent + descent > 255 )
+            {
+                fprintf(stderr, "%s: no valid BDF font\n", path);
+                return false;
+            }
+
+            font.first = first;
+            font.count = last - first + 1;
+            font.height = ascent + descent;
+            font.characters.assign(font.count, 0xFF);
+            font.duplicates = 0;
+            font.trimmedColumns = 0;
+
+            std::map<std::pair<unsigned int, std::vector<uint8_t> >, uint8_t> stored;
+            for ( size_t i = 0; i < glyphs.size(); i++ )
+            {
+                if ( glyphs[i].code < (int)first || glyphs[i].code > (int)last )
+                {
+                    continue;
+                }
+
+                Dots dots = _cell(glyphs[i], ascent, font.height);
+                if ( isTrimmed )
+                {
+                    font.trimmedColumns += _trim(dots, glyphs[i].advance > (int)font.spacing ? glyphs[i].advance - font.spacing : 1);
+                }
+
+                std::pair<unsigned int, std::vector<uint8_t> > key(dots.width, pack(dots));
+                if ( stored.count(key) > 0 )
+                {
+                    font.duplicates++;
+                }
+                else
+                {
+                    if ( font.glyphs.size() >= 0xFF )
+                    {
+                        fprintf(stderr, "%s: more than 254 different glyphs\n", path);
+                        return false;
+                    }
+                    stored[key] = font.glyphs.size();
+                    font.glyphs.push_back(dots);
+                }
+                font.characters[glyphs[i].code - first] = stored[key];
+            }
+            return true;
+        }
+
+    protected:
+        struct Glyph
+        {
+            int code = -1;
+            int advance = 0;
+            int width = 0;
+            int height = 0;
+            int x = 0;
+            int y = 0;
+            std::vector<unsigned long> rows;
+            unsigned int rowDigits = 0;
+        };
+
+        /**
+         * the glyph in a cell of the font height, as wide as its advance or its bitmap
+         */
+        Dots _cell(const Glyph &glyph, int ascent, unsigned int height)
+        {
+            int left = glyph.x < 0 ? -glyph.x : 0;
+            int width = std::max(glyph.advance, glyph.x + glyph.width) + left;
+            Dots dots = { (unsigned int)std::max(width, 0), height, std::vector<uint8_t>(std::max(width, 0) * height, 0) };
+
+            for ( int row = 0; row < glyph.height && row < (int)glyph.rows.size(); row++ )
+            {
+                int y = ascent - (glyph.y + glyph.height) + row;
+                for ( int col = 0; col < glyph.width; col++ )
+                {
+                    // the rows are hex numbers padded to whole bytes, the first column in the highest bit
+                    bool isSet = (glyph.rows[row] >> (glyph.rowDigits * 4 - 1 - col)) & 1;
+                    int x = glyph.x + left + col;
+                    if ( isSet && y >= 0 && y < (int)height && x >= 0 && x < width )
+                    {
+                        dots.dots[y * width + x] = 1;
+                    }
+                }
+            }
+            return dots;
+        }
+
+        /**
+         * remove the empty columns on both sides, returns the number of removed columns
+         */
+        unsigned int _trim(Dots &dots, unsigned int emptyWidth)
+        {
+            unsigned int left = dots.width, right = 0;
+            for ( unsigned int x = 0; x < dots.width; x++ )
+            {
+                for ( unsigned int y = 0; y < dots.height; y++ )
+                {
+                    if ( dots.get(x, y) )
+                    {
+                        left = std::min(left, x);
+                        right = std::max(right, x + 1);
+                    }
+                }
+            }
+
+            unsigned int width = dots.width;
+            if ( left >= right )
+            {
+                // a space keeps its width
+                dots.width = std::min(emptyWidth, width);
+                dots.dots.assign(dots.width * dots.height, 0);
+                return width - dots.width;
+            }
+
+            Dots trimmed = { right - left, dots.height, std::vector<uint8_t>((right - left) * dots.height) };
+            for ( unsigned int y = 0; y < dots.height; y++ )
+            {
+                for ( unsigned int x = left; x < right; x++ )
+                {
+                    trimmed.dots[y * trimmed.width + x - left] = dots.get(x, y);
+                }
+            }
+            dots = trimmed;
+            return width - dots.width;
+        }
+};
+
+
+void writeArray(FILE *out, const char *type, const std::string &name, const std::vector<unsigned int> &values, const char *format)
+{
+    fprintf(out, "const %s %s[] PROGMEM = {", type, name.c_str());
+    for ( size_t i = 0; i < values.size(); i++ )
+    {
+        fprintf(out, i % 12 == 0 ? "\n    " : " ");
+        fprintf(out, format, values[i]);
+        fprintf(out, i + 1 < values.size() ? "," : "\n");
+    }
+    fprintf(out, "};\n");
+}
+
+
+void writeText(FILE *out, const Dots &dots)
+{
+    for ( unsigned int y = 0; y < dots.height; y++ )
+    {
+        for ( unsigned int x = 0; x < dots.width; x++ )
+        {
+            fputc(dots.get(x, y) ? '#' : '.', out);
+        }
+        fputc('\n', out);
+    }
+}
+
+
+int usage()
+{
+    fprintf(stderr, "Usage: AssetConverter [--name identifier] [--threshold 0-255] [--invert] [--chars first-last] [--spacing n]\n"
+                    "                      [--no-trim] [--format header|text] [-o file] <file.bdf|file.png>...\n");
+    return 2;
+}
+
+
+int main(int argc, char **argv)
+{
+    unsigned int threshold = 128, first = 32, last = 126, spacing = 1;
+    bool isInverted = false, isTrimmed = true;
+    std::string name, format = "header", outputPath;
+    std::vector<Bitmap> bitmaps;
+    std::vector<Font> fonts;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( arg == "--name" && hasValue ) name = argv[++i];
+        else if ( arg == "--threshold" && hasValue ) threshold = atoi(argv[++i]);
+        else if ( arg == "--invert" ) isInverted = true;
+        else if ( arg == "--chars" && hasValue && sscanf(argv[++i], "%u-%u", &first, &last) == 2 && first <= last && last < 256 ) {}
+        else if ( arg == "--spacing" && hasValue ) spacing = atoi(argv[++i]);
+        else if ( arg == "--no-trim" ) isTrimmed = false;
+        else if ( arg == "--format" && hasValue ) format = argv[++i];
+        else if ( arg == "-o" && hasValue ) outputPath = argv[++i];
+        else if ( arg[0] == '-' ) return usage();
+        else
+        {
+            bool isFont = arg.size() > 4 && arg.compare(arg.size() - 4, 4, ".bdf") == 0;
+            std::string assetName = name.empty() ? nameOf(arg) : name;
+            name.clear();
+
+            if ( isFont )
+            {
+                Font font;
+                font.name = assetName;
+                font.spacing = spacing;
+                if ( !BdfReader().read(argv[i], first, last, isTrimmed, font) )
+                {
+                    return 1;
+                }
+                fonts.push_back(font);
+            }
+            else
+            {
+                Bitmap bitmap;
+                bitmap.name = assetName;
+                if ( !readPng(argv[i], threshold, isInverted, bitmap.dots) )
+                {
+                    return 1;
+                }
+                bitmaps.push_back(bitmap);
+            }
+        }
+    }
+
+    if ( ( bitmaps.empty() && fonts.empty() ) || ( format != "header" && format != "text" ) )
+    {
+        return usage();
+    }
+
+    FILE *out = outputPath.empty() ? stdout : fopen(outputPath.c_str(), "w");
+    if ( out == NULL )
+    {
+        fprintf(stderr, "%s: cannot write file\n", outputPath.c_str());
+        return 1;
+    }
+
+    std::string guard = outputPath.empty() ? "assets_h" : nameOf(outputPath) + "_h";
+    if ( format == "header" )
+    {
+        fprintf(out, "// created by AssetConverter, layout of the frame buffer: row after row, first column in the lowest bit\n\n");
+        fprintf(out, "#ifndef %s\n#define %s\n\n#include \"FlipTheDot_Blitter.h\"\n\n", guard.c_str(), guard.c_str());
+    }
+
+    for ( size_t i = 0; i < bitmaps.size(); i++ )
+    {
+        const Bitmap &bitmap = bitmaps[i];
+        std::vector<uint8_t> bytes = pack(bitmap.dots);
+
+        if ( format == "text" )
+        {
+            fprintf(out, "bitmap %s %ux%u\n", bitmap.name.c_str(), bitmap.dots.width, bitmap.dots.height);
+            writeText(out, bitmap.dots);
+            continue;
+        }
+
+        fprintf(out, "\n// %ux%u dots, %zu bytes\n", bitmap.dots.width, bitmap.dots.height, bytes.size());
+        writeArray(out, "uint8_t", bitmap.name + "_DATA", std::vector<unsigned int>(bytes.begin(), bytes.end()), "0x%02X");
+        fprintf(out, "constexpr FlipTheDot_Bitmap %s = { %s_DATA, %u, %u };\n",
+            bitmap.name.c_str(), bitmap.name.c_str(), bitmap.dots.width, bitmap.dots.height);
+        fprintf(stderr, "%s: %ux%u dots, %zu bytes\n", bitmap.name.c_str(), bitmap.dots.width, bitmap.dots.height, bytes.size());
+    }
+
+    for ( size_t i = 0; i < fonts.size(); i++ )
+    {
+        const Font &font = fonts[i];
+        std::vector<unsigned int> data, offsets, widths;
+
+        for ( size_t g = 0; g < font.glyphs.size(); g++ )
+        {
+            std::vector<uint8_t> bytes = pack(font.glyphs[g]);
+            offsets.push_back(data.size());
+            widths.push_back(font.glyphs[g].width);
+            data.insert(data.end(), bytes.begin(), bytes.end());
+        }
+        if ( data.size() > 0xFFFF )
+        {
+            fprintf(stderr, "%s: %zu bytes, up to 65535\n", font.name.c_str(), data.size());
+            return 1;
+        }
+
+        unsigned int characters = 0;
+        for ( size_t c = 0; c < font.characters.size(); c++ )
+        {
+            characters += font.characters[c] != 0xFF ? 1 : 0;
+        }
+        size_t total = data.size() + offsets.size() * 2 + widths.size() + font.characters.size();
+
+        if ( format == "text" )
+        {
+            fprintf(out, "font %s height %u, %u characters, %zu glyphs\n", font.name.c_str(), font.height, characters, font.glyphs.size());
+            for ( size_t c = 0; c < font.characters.size(); c++ )
+            {
+                if ( font.characters[c] != 0xFF )
+                {
+                    fprintf(out, "char %zu glyph %u\n", font.first + c, font.characters[c]);
+                    writeText(out, font.glyphs[font.characters[c]]);
+                }
+            }
+            continue;
+        }
+
+        fprintf(out, "\n// %u characters (%u - %u), %u rows, %zu glyphs (%u duplicates), %u empty columns removed, %zu bytes\n",
+            characters, font.first, font.first + font.count - 1, font.height, font.glyphs.size(), font.duplicates, font.trimmedColumns, total);
+        writeArray(out, "uint8_t", font.name + "_DATA", data, "0x%02X");
+        writeArray(out, "uint16_t", font.name + "_OFFSETS", offsets, "%u");
+        writeArray(out, "uint8_t", font.name + "_WIDTHS", widths, "%u");
+        writeArray(out, "uint8_t", font.name + "_GLYPHS", std::vector<unsigned int>(font.characters.begin(), font.characters.end()), "%u");
+        fprintf(out, "constexpr FlipTheDot_Font %s = { %s_DATA, %s_OFFSETS, %s_WIDTHS, %s_GLYPHS, %u, %u, %u, %u };\n",
+            font.name.c_str(), font.name.c_str(), font.name.c_str(), font.name.c_str(), font.name.c_str(),
+            font.first, font.count, font.height, font.spacing);
+        fprintf(stderr, "%s: %u characters, %u rows, %zu glyphs (%u duplicates), %u empty columns removed, %zu bytes\n",
+            font.name.c_str(), characters, font.height, font.glyphs.size(), font.duplicates, font.trimmedColumns, total);
+    }
+
+    if ( format == "header" )
+    {
+        fprintf(out, "\n#endif // %s\n", guard.c_str());
+    }
+    if ( out != stdout )
+    {
+        fclose(out);
+    }
+    return 0;
+}
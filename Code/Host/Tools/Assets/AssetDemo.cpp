@@ -0,0 +1,214 @@
+/*
+  AssetDemo
+  Draw the assets which assets.sh converted from font5x7.bdf and bus.png with FlipTheDot_Blitter on the simulated
+  28x13 panel (wiring of the example "FixedDefault"):
+
+    blit     the bus icon and every glyph at every position from fully left / above to fully right / below of the
+             panel, on random frame buffer content, compared with copying the bitmap dot by dot
+    text     a text with the converted font, compared with the glyphs of the fixed width FlipTheDot_Font5x7 without
+             their empty columns, then flushed and compared with the panel
+    speed    host CPU time of drawBitmap(...) and of the same bitmap with setDot(...) for every dot
+
+  Exit code 1 if any dot differs.
+
+  Build (assets.h from AssetConverter in the include path):
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController -I <directory of assets.h> Code/Host/Tools/Assets/AssetDemo.cpp
+ */
+
+
+#include <chrono>
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Blitter.h"
+#include "FlipTheDot_Font.h"
+#include "assets.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+const char text[] = "Linie 11 Hbf";
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+FlipTheDot_Blitter blitter(controller);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t expected[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+unsigned long seed = 1;
+
+
+void randomFrame()
+{
+    for ( unsigned int i = 0; i < sizeof(frame); i++ )
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        frame[i] = seed >> 16;
+    }
+    // the unused bits of every row stay hidden
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        frame[row * ((columns + 7) / 8) - 1] &= (1 << (columns % 8)) - 1;
+    }
+}
+
+
+/**
+ * draw a bitmap dot by dot into a copy of the frame buffer
+ */
+void drawSlow(const uint8_t *data, unsigned int width, unsigned int height, int col, int row)
+{
+    memcpy(expected, frame, sizeof(frame));
+    controller.setFrameBuffer(expected, shadow);
+    for ( unsigned int y = 0; y < height; y++ )
+    {
+        for ( unsigned int x = 0; x < width; x++ )
+        {
+            bool show = ( pgm_read_byte(&data[y * ((width + 7) / 8) + x / 8]) >> (x % 8) ) & 1;
+            if ( col + (int)x >= 1 && row + (int)y >= 1 )
+            {
+                controller.setDot(col + x, row + y, show);
+            }
+        }
+    }
+    controller.setFrameBuffer(frame, shadow);
+}
+
+
+/**
+ * blit at all positions, returns the number of positions with a differing frame buffer
+ */
+unsigned int checkBlit(const uint8_t *data, unsigned int width, unsigned int height)
+{
+    unsigned int differences = 0;
+    FlipTheDot_Bitmap bitmap = { data, (uint8_t)width, (uint8_t)height };
+
+    for ( int row = 1 - (int)height; row <= (int)rows + 1; row++ )
+    {
+        for ( int col = 1 - (int)width; col <= (int)columns + 1; col++ )
+        {
+            controller.setFrameBuffer(frame, shadow);
+            randomFrame();
+            drawSlow(data, width, height, col, row);
+            blitter.drawBitmap(bitmap, col, row);
+            differences += memcmp(frame, expected, sizeof(frame)) != 0 ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    unsigned int differences = checkBlit(busIcon.data, busIcon.width, busIcon.height);
+    printf("blit: bus icon %ux%u at %u positions, %u differ\n", busIcon.width, busIcon.height,
+        (columns + busIcon.width + 1) * (rows + busIcon.height + 1), differences);
+
+    unsigned int glyphDifferences = 0;
+    for ( unsigned int code = font5x7.first; code < font5x7.first + font5x7.count; code++ )
+    {
+        uint8_t glyph = pgm_read_byte(&font5x7.glyphs[code - font5x7.first]);
+        glyphDifferences += checkBlit(font5x7.data + pgm_read_word(&font5x7.offsets[glyph]), pgm_read_byte(&font5x7.widths[glyph]), font5x7.height);
+    }
+    printf("blit: %u glyphs at all positions, %u differ\n", font5x7.count, glyphDifferences);
+    differences += glyphDifferences;
+
+    // the text from the rows of FlipTheDot_Font5x7 (one byte per row) without the empty columns, one hidden column in between
+    controller.setFrameBuffer(expected, shadow);
+    controller.fill(false);
+    unsigned int x = 1;
+    for ( const char *c = text; *c != '\0'; c++ )
+    {
+        uint8_t glyph[5] = {};
+        for ( unsigned int row = 0; row < 7; row++ )
+        {
+            uint8_t bits = pgm_read_byte(&FlipTheDot_Font5x7_DATA[(*c - FlipTheDot_Font5x7.first) * 7 + row]);
+            for ( unsigned int i = 0; i < 5; i++ )
+            {
+                glyph[i] |= ( (bits >> i) & 1 ) << row;
+            }
+        }
+        unsigned int left = 5, right = 0;
+        for ( unsigned int i = 0; i < 5; i++ )
+        {
+            left = glyph[i] != 0 && i < left ? i : left;
+            right = glyph[i] != 0 ? i + 1 : right;
+        }
+        if ( x > 1 )
+        {
+            x++;
+        }
+        if ( left >= right )
+        {
+            // a space keeps its advance width minus the spacing
+            x += 5;
+            continue;
+        }
+        for ( unsigned int i = left; i < right; i++, x++ )
+        {
+            for ( unsigned int row = 0; row < 7; row++ )
+            {
+                controller.setDot(x, row + 4, (glyph[i] >> row) & 1);
+            }
+        }
+    }
+
+    controller.setFrameBuffer(frame, shadow);
+    controller.fill(false);
+    unsigned int width = blitter.drawText(text, 1, 4, font5x7);
+    unsigned int textDifferences = memcmp(frame, expected, sizeof(frame)) != 0 ? 1 : 0;
+    textDifferences += width != x - 1 || width != blitter.getTextWidth(text, font5x7) ? 1 : 0;
+    // the built-in font has the same format, with a fixed width
+    textDifferences += blitter.getTextWidth(text, FlipTheDot_Font5x7) != strlen(text) * 6 - 1 ? 1 : 0;
+    controller.flush();
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            textDifferences += panel.getDot(col, row) != controller.getDot(col, row) ? 1 : 0;
+        }
+    }
+    printf("text: \"%s\" %u columns (%u with the fixed width of FlipTheDot_Font5x7), %u differ\n",
+        text, width, (unsigned int)strlen(text) * 6 - 1, textDifferences);
+    differences += textDifferences;
+
+    // host CPU time only, the virtual time does not include code without I/O
+    const unsigned int repeat = 200000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for ( unsigned int i = 0; i < repeat; i++ )
+    {
+        blitter.drawBitmap(busIcon, 1 + i % 9, 3);
+    }
+    double blitNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / repeat;
+
+    start = std::chrono::steady_clock::now();
+    for ( unsigned int i = 0; i < repeat; i++ )
+    {
+        for ( unsigned int y = 0; y < busIcon.height; y++ )
+        {
+            for ( unsigned int dot = 0; dot < busIcon.width; dot++ )
+            {
+                controller.setDot(1 + i % 9 + dot, 3 + y, ( pgm_read_byte(&busIcon.data[y * 3 + dot / 8]) >> (dot % 8) ) & 1);
+            }
+        }
+    }
+    double dotNanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / repeat;
+    printf("speed: bus icon with drawBitmap %.0f ns, with setDot for every dot %.0f ns (host CPU)\n", blitNanos, dotNanos);
+
+    printf("%lu short pulses, %lu conflicts\n", panel.getShortPulseCount(), panel.getConflictCount());
+    return differences == 0 && panel.getShortPulseCount() == 0 && panel.getConflictCount() == 0 ? 0 : 1;
+}
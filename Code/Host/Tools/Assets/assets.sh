@@ -0,0 +1,20 @@
+#!/bin/bash
+# Convert font5x7.bdf and bus.png with the AssetConverter into a header file and draw them with AssetDemo on the simulated panel.
+# The header of the example "Assets" gets created the same way.
+# Usage: ./assets.sh
+
+cd "$(dirname "$0")"
+
+libraries=../../../Arduino/libraries
+build=$(mktemp -d)
+
+g++ -std=c++11 -O2 AssetConverter.cpp -lpng -o "$build/converter" || exit 1
+"$build/converter" --name font5x7 font5x7.bdf --name busIcon bus.png -o "$build/assets.h" || exit 1
+
+g++ -std=c++11 -O2 -I../../Arduino -I../../Simulator -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController \
+    -I"$build" AssetDemo.cpp -o "$build/demo" || exit 1
+"$build/demo"
+result=$?
+
+rm -r "$build"
+exit $result
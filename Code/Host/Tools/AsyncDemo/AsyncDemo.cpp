@@ -0,0 +1,165 @@
+/*
+  AsyncDemo
+  Run the FlipTheDot_ColumnRowControllerAsync against the simulated 28x13 panel with the wiring of the
+  example "FixedDefault". The virtual timer of the stand-in calls handleInterrupt(), while the foreground
+  keeps polling like a sketch which reads serial input. Compares the longest time the foreground was
+  blocked with the blocking flush() and checks the panel afterwards. A flush without changed dots has to call
+  the callback as well.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/AsyncDemo/AsyncDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowControllerAsync.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+
+// work of one foreground loop, e.g. checking the serial input
+const unsigned int pollMicros = 20;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowControllerAsync controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+unsigned long callbacks = 0;
+unsigned long long callbackNanos = 0;
+
+
+void timerInterrupt()
+{
+    controller.handleInterrupt();
+}
+
+void startTimer(unsigned int micros)
+{
+    FlipTheDot_Host_setTimer(timerInterrupt, micros);
+}
+
+void finished()
+{
+    callbacks++;
+    callbackNanos = FlipTheDot_Host_nanos;
+}
+
+
+unsigned long compare()
+{
+    unsigned long errors = panel.getShortPulseCount() + panel.getConflictCount();
+
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            errors += controller.getDot(col, row) != panel.getDot(col, row);
+        }
+    }
+    return errors;
+}
+
+
+/**
+ * poll like a sketch until the controller is done, report the longest gap between two polls
+ */
+void poll(const char *title)
+{
+    unsigned long long start = FlipTheDot_Host_nanos;
+    unsigned long long last = start;
+    unsigned long long longest = 0;
+    unsigned long loops = 0;
+
+    while ( controller.isBusy() )
+    {
+        delayMicroseconds(pollMicros);
+        loops++;
+
+        longest = FlipTheDot_Host_nanos - last > longest ? FlipTheDot_Host_nanos - last : longest;
+        last = FlipTheDot_Host_nanos;
+    }
+
+    printf("%-22s %5lu pulses %8.2f ms  %6lu polls  longest gap %7.1f us  callbacks %lu  errors %lu\n",
+        title, panel.getPulseCount(), (callbackNanos - start) / 1e6, loops, longest / 1e3, callbacks, compare());
+
+    panel.resetStatistics();
+    callbacks = 0;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    // unknown state after power on
+    panel.fill(true);
+
+    controller.setFrameBuffer(frame, shadow);
+    controller.setTimer(startTimer);
+    controller.setCallback(finished);
+
+    // blocking reference: the foreground is frozen for the whole refresh
+    unsigned long long start = FlipTheDot_Host_nanos;
+    controller.flush();
+    printf("%-22s %5lu pulses %8.2f ms  %6s polls  longest gap %7.1f us\n",
+        "blocking flush", panel.getPulseCount(), (FlipTheDot_Host_nanos - start) / 1e6, "-", (FlipTheDot_Host_nanos - start) / 1e3);
+    panel.resetStatistics();
+
+    controller.invalidate();
+    controller.fill(false);
+    controller.flushAsync();
+    poll("async flush (all)");
+
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        controller.setDot(row + 7, row, true);
+    }
+    controller.flushAsync();
+    poll("async flush (diagonal)");
+
+    // change the frame while the flush runs and restart it
+    controller.fill(true);
+    controller.flushAsync();
+    delay(5);
+    controller.fill(false);
+    controller.setDot(14, 7, true);
+    controller.flushAsync();
+    poll("async flush (restarted)");
+
+    // nothing differs, the callback comes right away
+    callbackNanos = FlipTheDot_Host_nanos;
+    controller.flushAsync();
+    unsigned long unchangedCallbacks = callbacks;
+    poll("async flush (unchanged)");
+
+    // more flips than fit into the queue, wait for a free place like a sketch would
+    for ( unsigned int col = 1; col <= columns; col++ )
+    {
+        while ( !controller.queue(col, 1, true) )
+        {
+            delayMicroseconds(pollMicros);
+        }
+    }
+    poll("queued flips");
+
+    if ( panel.getConflictCount() > 0 || compare() > 0 || unchangedCallbacks != 1 )
+    {
+        return 1;
+    }
+
+    panel.print(stdout);
+    return 0;
+}
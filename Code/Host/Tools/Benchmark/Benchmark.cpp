@@ -0,0 +1,548 @@
+/*
+  Benchmark
+  Measure the flip pipeline against the virtual clock of the Arduino.h stand-in.
+
+  Drivers (FlipTheDot_FP2800a, FlipTheDot_FP2800aFixed, FlipTheDot_FP2800aMulti):
+    outputs   setOutput + pulse thru all outputs and both data states, like the "Basics" examples
+
+  Controllers (FlipTheDot_ColumnRowController with the wirings of the examples
+  DefaultDefault, FixedDefault and FixedMulti on a simulated panel, FixedMulti
+  also with up to three column ICs pulsed together):
+    sweep     flip(...) for every dot, row by row, set and reset, like the examples
+    batch     flipRow(...) for every row (32 columns per call), set and reset
+    full      flush of the whole frame buffer with an unknown panel state
+    partial   flush after 5 % of the dots changed (e.g. a clock update)
+    noise     flush of random frames
+    scroll    flush of a scrolling text, one column per step
+
+  Reported per run:
+    dots/s        coil pulses (driver: enable pulses) per virtual second
+    ms/frame      virtual time per frame (sweep: per pass over all dots)
+    trans/flip    pin level changes per coil pulse
+    idle/flip     time per coil pulse outside of the pulse window (no coil / enable active)
+    errors        dots which differ between frame buffer and simulated panel
+
+  A second table compares the pin level changes and the time per frame of the frame buffer workloads
+  between the row by row flush order and the optimized order (see setOptimizedOrder).
+  A third table runs the noise and scroll workloads with a FlipTheDot_PowerBudget and reports the
+  resulting average currents of the column IC and of the coil with the most pulses.
+
+  Usage: benchmark.sh builds and runs it with digitalWrite and with FlipTheDot_FP2800a_PORT_IO.
+ */
+
+
+#define FlipTheDot_ColumnRowController_POWER_BUDGET
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aMulti.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+/**
+ * counts pin level changes and the time inside the pulse window
+ */
+class Probe : public FlipTheDot_HostObserver
+{
+    public:
+        FlipTheDot_PanelSimulator *panel = NULL;
+        uint8_t enablePins[4];
+        uint8_t enablePinCount = 0;
+
+        unsigned long long transitions = 0;
+        unsigned long long windowNanos = 0;
+        unsigned long enablePulses = 0;
+
+        void reset()
+        {
+            transitions = 0;
+            windowNanos = 0;
+            enablePulses = 0;
+        }
+
+        bool isEnabled(const uint8_t *ports)
+        {
+            for ( uint8_t i = 0; i < enablePinCount; i++ )
+            {
+                if ( FlipTheDot_Host_pinLevel(ports, enablePins[i]) == HIGH )
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void pinsChanged(const uint8_t *before, const uint8_t *after, unsigned long long nanos)
+        {
+            for ( uint8_t i = 0; i < FlipTheDot_Host_PORTS; i++ )
+            {
+                transitions += __builtin_popcount(before[i] ^ after[i]);
+            }
+            if ( !isEnabled(before) && isEnabled(after) )
+            {
+                enablePulses++;
+            }
+        }
+
+        void timePassed(unsigned long long from, unsigned long long to)
+        {
+            if ( panel != NULL ? panel->isEnergized() : isEnabled(FlipTheDot_Host_ports) )
+            {
+                windowNanos += to - from;
+            }
+        }
+};
+
+Probe probe;
+
+
+struct Run
+{
+    unsigned long long start;
+    unsigned long frames;
+    unsigned long errors;
+};
+
+Run begin()
+{
+    FlipTheDot_Host_sync();
+    probe.reset();
+    if ( probe.panel != NULL )
+    {
+        probe.panel->resetStatistics();
+    }
+
+    Run run = { FlipTheDot_Host_nanos, 0, 0 };
+    return run;
+}
+
+void end(const char *setup, const char *workload, Run &run)
+{
+    FlipTheDot_Host_sync();
+
+    unsigned long long nanos = FlipTheDot_Host_nanos - run.start;
+    unsigned long flips = probe.panel != NULL ? probe.panel->getPulseCount() : probe.enablePulses;
+    double perFlip = flips > 0 ? flips : 1;
+
+    printf("%-14s %-8s %7lu %9.0f %9.2f %10.1f %9.1f %6lu\n",
+        setup, workload, flips,
+        flips * 1e9 / nanos,
+        nanos / 1e6 / (run.frames > 0 ? run.frames : 1),
+        probe.transitions / perFlip,
+        (nanos - probe.windowNanos) / 1e3 / perFlip,
+        run.errors + (probe.panel != NULL ? probe.panel->getShortPulseCount() + probe.panel->getConflictCount() : 0));
+}
+
+
+void header()
+{
+    printf("%-14s %-8s %7s %9s %9s %10s %9s %6s\n", "setup", "workload", "flips", "dots/s", "ms/frame", "trans/flip", "idle/flip", "errors");
+}
+
+
+void resetPins()
+{
+    memset((void *)FlipTheDot_Host_PORT, 0, sizeof(FlipTheDot_Host_PORT));
+    FlipTheDot_Host_sync();
+}
+
+
+/**
+ * driver benchmark: every output with both data states
+ */
+void benchDriver(const char *setup, FlipTheDot_FP2800a &controller)
+{
+    Run run = begin();
+
+    for ( unsigned int data = 0; data < 2; data++ )
+    {
+        controller.setData(data == 1);
+        for ( unsigned int no = 1; no <= controller.getOutputMax(); no++ )
+        {
+            controller.setOutput(no);
+            controller.pulse();
+        }
+        run.frames++;
+    }
+
+    end(setup, "outputs", run);
+}
+
+
+/**
+ * count the dots which differ between the frame buffer and the panel
+ */
+unsigned long compare(FlipTheDot_ColumnRowController &controller, FlipTheDot_PanelSimulator &panel)
+{
+    unsigned long errors = 0;
+    for ( unsigned int row = 1; row <= controller.getRowCount(); row++ )
+    {
+        for ( unsigned int col = 1; col <= controller.getColCount(); col++ )
+        {
+            errors += controller.getDot(col, row) != panel.getDot(col, row);
+        }
+    }
+    return errors;
+}
+
+
+// 5x7 glyphs, one byte per column with the top row in the lowest bit
+const char scrollText[] = "BUS 42 HBF 17 ";
+const char glyphChars[] = " 0123456789BFHSU";
+const uint8_t glyphs[][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 },
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x46, 0x49, 0x49, 0x49, 0x31 },
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F }
+};
+
+uint8_t textColumn(unsigned int position)
+{
+    unsigned int length = strlen(scrollText) * 6;
+    position %= length;
+
+    const char *found = strchr(glyphChars, scrollText[position / 6]);
+    unsigned int column = position % 6;
+
+    return found == NULL || column == 5 ? 0 : glyphs[found - glyphChars][column];
+}
+
+
+/**
+ * frame buffer workloads, draw the given frame into the frame buffer
+ */
+void drawFull(FlipTheDot_ColumnRowController &controller, unsigned int frame)
+{
+    controller.fill(frame % 2 == 0);
+    controller.invalidate();
+}
+
+void drawPartial(FlipTheDot_ColumnRowController &controller, unsigned int frame)
+{
+    unsigned int cols = controller.getColCount();
+    unsigned int rows = controller.getRowCount();
+
+    for ( unsigned int n = 0; n < cols * rows / 20; n++ )
+    {
+        unsigned int col = random(1, cols + 1);
+        unsigned int row = random(1, rows + 1);
+        controller.setDot(col, row, !controller.getDot(col, row));
+    }
+}
+
+void drawNoise(FlipTheDot_ColumnRowController &controller, unsigned int frame)
+{
+    for ( unsigned int row = 1; row <= controller.getRowCount(); row++ )
+    {
+        for ( unsigned int col = 1; col <= controller.getColCount(); col++ )
+        {
+            controller.setDot(col, row, random(2) == 1);
+        }
+    }
+}
+
+void drawScroll(FlipTheDot_ColumnRowController &controller, unsigned int frame)
+{
+    unsigned int rows = controller.getRowCount();
+    unsigned int top = rows > 7 ? (rows - 7) / 2 : 0;
+
+    controller.fill(false);
+    for ( unsigned int col = 1; col <= controller.getColCount(); col++ )
+    {
+        uint8_t bits = textColumn(frame + col - 1);
+        for ( unsigned int row = 0; row < 7 && top + row < rows; row++ )
+        {
+            controller.setDot(col, top + row + 1, (bits >> row) & 1);
+        }
+    }
+}
+
+struct Workload
+{
+    const char *name;
+    void (*draw)(FlipTheDot_ColumnRowController &controller, unsigned int frame);
+    unsigned int frames;
+};
+
+const Workload workloads[] = {
+    { "full", drawFull, 2 },
+    { "partial", drawPartial, 20 },
+    { "noise", drawNoise, 10 },
+    { "scroll", drawScroll, 60 }
+};
+
+
+/**
+ * start every workload with a blank panel and the same random numbers
+ */
+Run runWorkload(FlipTheDot_ColumnRowController &controller, FlipTheDot_PanelSimulator &panel, const Workload &workload)
+{
+    controller.fill(false);
+    controller.flush();
+    srand(1);
+
+    Run run = begin();
+    for ( unsigned int frame = 0; frame < workload.frames; frame++ )
+    {
+        workload.draw(controller, frame);
+        controller.flush();
+        run.errors += compare(controller, panel);
+        run.frames++;
+    }
+    return run;
+}
+
+
+// comparison of the flush orders, printed after the main table
+char orderReport[4096];
+unsigned int columnsGrouped = 1;
+
+
+/**
+ * controller benchmark with all workloads
+ */
+void benchController(const char *setup, FlipTheDot_ColumnRowController &controller, FlipTheDot_PanelSimulator &panel)
+{
+    unsigned int cols = controller.getColCount();
+    unsigned int rows = controller.getRowCount();
+
+    uint8_t *frame = new uint8_t[FlipTheDot_ColumnRowController_BUFFER_SIZE(cols, rows)];
+    uint8_t *shadow = new uint8_t[FlipTheDot_ColumnRowController_BUFFER_SIZE(cols, rows)];
+
+    probe.panel = &panel;
+
+    {
+        Run run = begin();
+        for ( unsigned int pass = 0; pass < 2; pass++ )
+        {
+            for ( unsigned int row = 1; row <= rows; row++ )
+            {
+                for ( unsigned int col = 1; col <= cols; col++ )
+                {
+                    controller.flip(col, row, pass == 0);
+                }
+            }
+            run.frames++;
+        }
+        end(setup, "sweep", run);
+    }
+
+    {
+        Run run = begin();
+        for ( unsigned int pass = 0; pass < 2; pass++ )
+        {
+            for ( unsigned int row = 1; row <= rows; row++ )
+            {
+                for ( unsigned int first = 1; first <= cols; first += 32 )
+                {
+                    controller.flipRow(row, 0xFFFFFFFFUL, pass == 0, first);
+                }
+            }
+            run.frames++;
+        }
+        end(setup, "batch", run);
+    }
+
+    controller.setFrameBuffer(frame, shadow);
+
+    for ( unsigned int i = 0; i < sizeof(workloads) / sizeof(workloads[0]); i++ )
+    {
+        Run run = runWorkload(controller, panel, workloads[i]);
+        end(setup, workloads[i].name, run);
+    }
+
+    // same workloads in plain row by row order, the grouped flush of FixedMulti x3 has its own order
+    for ( unsigned int i = 0; i < sizeof(workloads) / sizeof(workloads[0]) && controller.isOptimizedOrder() && columnsGrouped == 1; i++ )
+    {
+        unsigned long long transitions[2];
+        unsigned long long nanos[2];
+
+        for ( uint8_t optimized = 0; optimized < 2; optimized++ )
+        {
+            controller.setOptimizedOrder(optimized == 1);
+            Run run = runWorkload(controller, panel, workloads[i]);
+            FlipTheDot_Host_sync();
+            transitions[optimized] = probe.transitions;
+            nanos[optimized] = (FlipTheDot_Host_nanos - run.start) / run.frames;
+        }
+        controller.setOptimizedOrder(true);
+
+        snprintf(orderReport + strlen(orderReport), sizeof(orderReport) - strlen(orderReport),
+            "%-14s %-8s %11llu %11llu %7.1f %% %10.2f %10.2f\n",
+            setup, workloads[i].name, transitions[0], transitions[1],
+            transitions[0] > 0 ? 100.0 * (transitions[0] - transitions[1]) / transitions[0] : 0.0,
+            nanos[0] / 1e6, nanos[1] / 1e6);
+    }
+
+    controller.setFrameBuffer(NULL, NULL);
+    probe.panel = NULL;
+
+    delete[] frame;
+    delete[] shadow;
+}
+
+
+/**
+ * FixedDefault wiring with different power budgets, reports the resulting average currents
+ * of the column IC (every pulse uses it) and of the busiest coil
+ */
+void benchBudget()
+{
+    resetPins();
+    FlipTheDot_PanelSimulator panel(28, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+
+    FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+    FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+    FlipTheDot_ColumnRowController controller(columnController, rowController, 28, 13);
+
+    uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+    uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+    uint8_t coilHeat[28 * 13];
+    controller.setFrameBuffer(frame, shadow);
+    probe.panel = &panel;
+
+    printf("\npower budget (FixedDefault, 350 mA per pulse): average current of the column IC and the busiest coil\n");
+    printf("%-22s %-8s %7s %9s %9s %9s %9s %6s\n", "budget", "workload", "flips", "dots/s", "throttled", "IC mA", "coil mA", "errors");
+
+    for ( uint8_t variant = 0; variant < 4; variant++ )
+    {
+        FlipTheDot_PowerBudget budget(28, 13, 350);
+        const char *names[] = { "none", "IC 120 mA", "coil 1 mA", "IC 120 mA, coil 1 mA" };
+
+        if ( variant & 1 )
+        {
+            budget.setChipBudget(120, 350);
+        }
+        if ( variant & 2 )
+        {
+            budget.setCoilBudget(1, 70, coilHeat);
+        }
+        controller.setPowerBudget(variant > 0 ? &budget : NULL);
+
+        for ( unsigned int i = 2; i < sizeof(workloads) / sizeof(workloads[0]); i++ )
+        {
+            Run run = runWorkload(controller, panel, workloads[i]);
+            FlipTheDot_Host_sync();
+
+            double seconds = (FlipTheDot_Host_nanos - run.start) / 1e9;
+            unsigned long busiest = 0;
+            for ( unsigned int row = 1; row <= 13; row++ )
+            {
+                for ( unsigned int col = 1; col <= 28; col++ )
+                {
+                    busiest = panel.getDotPulseCount(col, row) > busiest ? panel.getDotPulseCount(col, row) : busiest;
+                }
+            }
+
+            printf("%-22s %-8s %7lu %9.0f %8.1f%% %9.1f %9.1f %6lu\n",
+                names[variant], workloads[i].name, panel.getPulseCount(), panel.getPulseCount() / seconds,
+                budget.getPulseCount() > 0 ? 100.0 * budget.getThrottledCount() / budget.getPulseCount() : 0.0,
+                panel.getPulseCount() * 0.035 / seconds, busiest * 0.035 / seconds,
+                run.errors + panel.getShortPulseCount() + panel.getConflictCount());
+        }
+    }
+
+    controller.setPowerBudget(NULL);
+    controller.setFrameBuffer(NULL, NULL);
+    probe.panel = NULL;
+}
+
+
+/**
+ * FixedMulti wiring (84x13) with the given number of column ICs which may be pulsed together
+ */
+void benchFixedMulti(const char *setup, unsigned int maxEnabledChips)
+{
+    resetPins();
+    FlipTheDot_PanelSimulator panel(84, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 28, A2, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 56, A3, 8, 9, 10, 11, 12, 13);
+
+    unsigned int columnEnableList[] = { A1, A2, A3 };
+    FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+    FlipTheDot_FP2800aMulti columnController(columnEnableList, 3, 8, 9, 10, 11, 12, 13);
+    columnController.setMaxEnabledChips(maxEnabledChips);
+    FlipTheDot_ColumnRowController controller(columnController, rowController, 84, 13);
+    columnsGrouped = maxEnabledChips;
+    benchController(setup, controller, panel);
+    columnsGrouped = 1;
+}
+
+
+int main()
+{
+    FlipTheDot_Host_addObserver(&probe);
+
+    header();
+
+    {
+        resetPins();
+        FlipTheDot_FP2800a controller(A1, 8, 9, 10, 11, 12, 13);
+        probe.enablePins[0] = A1;
+        probe.enablePinCount = 1;
+        benchDriver("FP2800a", controller);
+    }
+    {
+        resetPins();
+        FlipTheDot_FP2800aFixed controller(A0, 2, 3, 4, 5, 6, 7);
+        probe.enablePins[0] = A0;
+        probe.enablePins[1] = 2;
+        probe.enablePinCount = 2;
+        benchDriver("FP2800aFixed", controller);
+    }
+    {
+        resetPins();
+        unsigned int enableList[] = { A1, A2, A3 };
+        FlipTheDot_FP2800aMulti controller(enableList, 3, 8, 9, 10, 11, 12, 13);
+        probe.enablePins[0] = A1;
+        probe.enablePins[1] = A2;
+        probe.enablePins[2] = A3;
+        probe.enablePinCount = 3;
+        benchDriver("FP2800aMulti", controller);
+    }
+    probe.enablePinCount = 0;
+
+    {
+        resetPins();
+        FlipTheDot_PanelSimulator panel(28, 13);
+        panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, 2, 3, 4, 5, 6, 7);
+        panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+
+        FlipTheDot_FP2800a rowController(A0, 2, 3, 4, 5, 6, 7);
+        FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+        FlipTheDot_ColumnRowController controller(columnController, rowController, 28, 13);
+        benchController("DefaultDefault", controller, panel);
+    }
+    {
+        resetPins();
+        FlipTheDot_PanelSimulator panel(28, 13);
+        panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+        panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+        panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+
+        FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+        FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+        FlipTheDot_ColumnRowController controller(columnController, rowController, 28, 13);
+        benchController("FixedDefault", controller, panel);
+    }
+    benchFixedMulti("FixedMulti", 1);
+    benchFixedMulti("FixedMulti x3", 3);
+
+    printf("\nflush order: pin level changes and ms/frame of row by row order (scan) and the optimized order (gray)\n");
+    printf("%-14s %-8s %11s %11s %9s %10s %10s\n", "setup", "workload", "trans scan", "trans gray", "saved", "ms scan", "ms gray");
+    printf("%s", orderReport);
+
+    benchBudget();
+
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/bin/bash
+# Build and run the benchmark with digitalWrite and with direct port access (FlipTheDot_FP2800a_PORT_IO).
+# Usage: ./benchmark.sh [c++ compiler] [additional compiler flags]
+
+cd "$(dirname "$0")"
+
+compiler=${1:-g++}
+libraries=../../../Arduino/libraries
+flags="-std=c++11 -O2 -I../../Arduino -I../../Simulator -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController $2"
+build=$(mktemp -d)
+
+$compiler $flags Benchmark.cpp -o "$build/digitalWrite" || exit 1
+$compiler $flags -DFlipTheDot_FP2800a_PORT_IO Benchmark.cpp -o "$build/portIO" || exit 1
+
+echo "== digitalWrite"
+"$build/digitalWrite"
+result=$?
+echo
+echo "== FlipTheDot_FP2800a_PORT_IO (each atomic port register write costs 500 ns)"
+"$build/portIO" || result=1
+
+rm -r "$build"
+exit $result
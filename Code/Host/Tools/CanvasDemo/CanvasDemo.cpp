@@ -0,0 +1,238 @@
+/*
+  CanvasDemo
+  Refresh three simulated Lawo panels of different sizes, combined to one FlipTheDot_Canvas, once panel by panel
+  (flush() of every controller) and once with the interleaved flush() of the canvas.
+
+    panel 1: 28x13, canvas column  1, not rotated     pins of the microcontroller:
+             columns: enable 2, data 3, A0 - B1 4 - 8  rows: enable reset A0, enable set A1, A0 - B1 A2 - A5, 12
+    panel 2: 28x24, canvas column 29, rotated by 90°  outputs of a chain of four 74HC595 (latch pin 10, output enable pin 9):
+             columns: A0 - B1 0 - 4, data 5, enable 6  rows: A0 - B1 8 - 12, enable reset 13, enable set 14
+    panel 3: 14x16, canvas column 53, rotated by 180° same chain:
+             columns: A0 - B1 16 - 20, data 21, enable 22  rows: A0 - B1 24 - 28, enable reset 29, enable set 30
+
+  The canvas is 66x28 dots, the dots below panel 1 and 3 are not covered.
+  Every run flushes the whole canvas and random frames and compares the panels with the frame buffers.
+  Exit code 1 if any dot differs, a corner of the canvas ends up on the wrong dot of a panel, the interleaved flush
+  is not faster or the panels counted too short or conflicting pulses.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/CanvasDemo/CanvasDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_ShiftRegisterSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aShiftRegister.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Canvas.h"
+
+
+const unsigned int frames = 10;
+
+const uint8_t pinLatch = 10;
+const uint8_t pinOutputEnable = 9;
+
+// the panels and the chain have to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel1(28, 13);
+FlipTheDot_PanelSimulator panel2(28, 24);
+FlipTheDot_PanelSimulator panel3(14, 16);
+FlipTheDot_ShiftRegisterSimulator chain(4, pinLatch, pinOutputEnable);
+
+uint8_t registers[4];
+FlipTheDot_FP2800aShiftRegister shiftRegister(registers, 4, pinLatch, pinOutputEnable);
+
+FlipTheDot_FP2800a columnController1(2, 3, 4, 5, 6, 7, 8);
+FlipTheDot_FP2800aFixed rowController1(A0, A1, A2, A3, A4, A5, 12);
+FlipTheDot_FP2800a columnController2(6, 5, 0, 1, 2, 3, 4, 100, &shiftRegister);
+FlipTheDot_FP2800aFixed rowController2(13, 14, 8, 9, 10, 11, 12, 100, &shiftRegister);
+FlipTheDot_FP2800a columnController3(22, 21, 16, 17, 18, 19, 20, 100, &shiftRegister);
+FlipTheDot_FP2800aFixed rowController3(29, 30, 24, 25, 26, 27, 28, 100, &shiftRegister);
+
+FlipTheDot_ColumnRowController controller1(columnController1, rowController1, 28, 13);
+FlipTheDot_ColumnRowController controller2(columnController2, rowController2, 28, 24);
+FlipTheDot_ColumnRowController controller3(columnController3, rowController3, 14, 16);
+
+FlipTheDot_Canvas canvas(66, 28);
+
+uint8_t frame1[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+uint8_t shadow1[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 13)];
+uint8_t frame2[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 24)];
+uint8_t shadow2[FlipTheDot_ColumnRowController_BUFFER_SIZE(28, 24)];
+uint8_t frame3[FlipTheDot_ColumnRowController_BUFFER_SIZE(14, 16)];
+uint8_t shadow3[FlipTheDot_ColumnRowController_BUFFER_SIZE(14, 16)];
+
+FlipTheDot_PanelSimulator *panels[] = { &panel1, &panel2, &panel3 };
+FlipTheDot_ColumnRowController *controllers[] = { &controller1, &controller2, &controller3 };
+
+
+unsigned int countDifferences()
+{
+    unsigned int differences = 0;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        for ( unsigned int row = 1; row <= panels[i]->getRowCount(); row++ )
+        {
+            for ( unsigned int col = 1; col <= panels[i]->getColCount(); col++ )
+            {
+                differences += panels[i]->getDot(col, row) != controllers[i]->getDot(col, row) ? 1 : 0;
+            }
+        }
+    }
+    return differences;
+}
+
+
+/**
+ * check that the top left corner of the canvas area of every panel is the expected dot of the panel
+ */
+unsigned int countWrongCorners()
+{
+    unsigned int wrong = 0;
+
+    canvas.fill(false);
+    canvas.setDot(1, 1, true);
+    canvas.setDot(29, 1, true);
+    canvas.setDot(53, 1, true);
+
+    wrong += controller1.getDot(1, 1) ? 0 : 1;
+    wrong += controller2.getDot(1, 24) ? 0 : 1;
+    wrong += controller3.getDot(14, 16) ? 0 : 1;
+
+    // the last dot of every panel area
+    canvas.setDot(28, 13, true);
+    canvas.setDot(52, 28, true);
+    canvas.setDot(66, 16, true);
+    wrong += controller1.getDot(28, 13) ? 0 : 1;
+    wrong += controller2.getDot(28, 1) ? 0 : 1;
+    wrong += controller3.getDot(1, 1) ? 0 : 1;
+
+    // not covered by a panel
+    wrong += canvas.setDot(1, 14, true) ? 1 : 0;
+    wrong += canvas.setDot(66, 17, true) ? 1 : 0;
+    return wrong;
+}
+
+
+/**
+ * flush the whole canvas and random frames, returns the virtual time per frame in ms
+ */
+double run(const char *title, bool isInterleaved, unsigned int &differences)
+{
+    unsigned long long start = FlipTheDot_Host_nanos;
+    unsigned long pulses = 0;
+
+    randomSeed(7);
+    canvas.invalidate();
+
+    for ( unsigned int i = 0; i <= frames; i++ )
+    {
+        for ( unsigned int row = 1; row <= canvas.getRowCount(); row++ )
+        {
+            for ( unsigned int col = 1; col <= canvas.getColCount(); col++ )
+            {
+                canvas.setDot(col, row, i > 0 && random(2) == 1);
+            }
+        }
+
+        if ( isInterleaved )
+        {
+            pulses += canvas.flush();
+        }
+        else
+        {
+            for ( unsigned int c = 0; c < 3; c++ )
+            {
+                pulses += controllers[c]->flush();
+            }
+        }
+        differences += countDifferences();
+    }
+
+    double msPerFrame = (FlipTheDot_Host_nanos - start) / 1e6 / (frames + 1);
+    printf("%-24s %6lu pulses, %8.2f ms/frame, %u dots differ\n", title, pulses, msPerFrame, differences);
+    return msPerFrame;
+}
+
+
+/**
+ * flush the random frames of a single panel, returns the virtual time per frame in ms
+ */
+double runSingle(unsigned int index)
+{
+    unsigned long long start = FlipTheDot_Host_nanos;
+    FlipTheDot_ColumnRowController *controller = controllers[index];
+
+    controller->invalidate();
+    for ( unsigned int i = 0; i <= frames; i++ )
+    {
+        for ( unsigned int row = 1; row <= controller->getRowCount(); row++ )
+        {
+            for ( unsigned int col = 1; col <= controller->getColCount(); col++ )
+            {
+                controller->setDot(col, row, i > 0 && random(2) == 1);
+            }
+        }
+        controller->flush();
+    }
+    return (FlipTheDot_Host_nanos - start) / 1e6 / (frames + 1);
+}
+
+
+int main()
+{
+    panel1.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, 2, 3, 4, 5, 6, 7, 8);
+    panel1.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, A2, A3, A4, A5, 12);
+    panel1.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A1, FlipTheDot_PanelSimulator::FIXED_HIGH, A2, A3, A4, A5, 12);
+
+    panel2.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, chain.pin(6), chain.pin(5), chain.pin(0), chain.pin(1), chain.pin(2), chain.pin(3), chain.pin(4));
+    panel2.addChip(FlipTheDot_PanelSimulator::ROWS, 0, chain.pin(13), FlipTheDot_PanelSimulator::FIXED_LOW, chain.pin(8), chain.pin(9), chain.pin(10), chain.pin(11), chain.pin(12));
+    panel2.addChip(FlipTheDot_PanelSimulator::ROWS, 0, chain.pin(14), FlipTheDot_PanelSimulator::FIXED_HIGH, chain.pin(8), chain.pin(9), chain.pin(10), chain.pin(11), chain.pin(12));
+
+    panel3.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, chain.pin(22), chain.pin(21), chain.pin(16), chain.pin(17), chain.pin(18), chain.pin(19), chain.pin(20));
+    panel3.addChip(FlipTheDot_PanelSimulator::ROWS, 0, chain.pin(29), FlipTheDot_PanelSimulator::FIXED_LOW, chain.pin(24), chain.pin(25), chain.pin(26), chain.pin(27), chain.pin(28));
+    panel3.addChip(FlipTheDot_PanelSimulator::ROWS, 0, chain.pin(30), FlipTheDot_PanelSimulator::FIXED_HIGH, chain.pin(24), chain.pin(25), chain.pin(26), chain.pin(27), chain.pin(28));
+
+    controller1.setFrameBuffer(frame1, shadow1);
+    controller2.setFrameBuffer(frame2, shadow2);
+    controller3.setFrameBuffer(frame3, shadow3);
+
+    canvas.addPanel(controller1, 1, 1, FlipTheDot_Canvas::ROTATE_0);
+    canvas.addPanel(controller2, 29, 1, FlipTheDot_Canvas::ROTATE_90);
+    canvas.addPanel(controller3, 53, 1, FlipTheDot_Canvas::ROTATE_180);
+
+    unsigned int wrongCorners = countWrongCorners();
+    printf("canvas %ux%u with %u panels, %u corners on a wrong dot\n", canvas.getColCount(), canvas.getRowCount(), canvas.getPanelCount(), wrongCorners);
+
+    unsigned int differences = 0;
+    double sequential = run("panel by panel", false, differences);
+    double interleaved = run("interleaved", true, differences);
+
+    randomSeed(7);
+    printf("single panels:           ");
+    double slowest = 0;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        double single = runSingle(i);
+        slowest = single > slowest ? single : slowest;
+        printf(" %ux%u %.2f ms/frame ", controllers[i]->getColCount(), controllers[i]->getRowCount(), single);
+    }
+    printf("\n");
+
+    unsigned long shortPulses = 0, conflicts = 0;
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        shortPulses += panels[i]->getShortPulseCount();
+        conflicts += panels[i]->getConflictCount();
+    }
+    printf("interleaved: %.0f %% of panel by panel, %.0f %% of the slowest panel; %lu short pulses, %lu conflicts, %lu SPI errors\n",
+        100 * interleaved / sequential, 100 * interleaved / slowest, shortPulses, conflicts, FlipTheDot_Host_spi.errors);
+
+    bool isValid = wrongCorners == 0 && differences == 0 && interleaved < sequential && shortPulses == 0 && conflicts == 0
+        && FlipTheDot_Host_spi.errors == 0 && chain.getErrorCount() == 0;
+    return isValid ? 0 : 1;
+}
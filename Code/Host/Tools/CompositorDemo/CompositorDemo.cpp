@@ -0,0 +1,209 @@
+/*
+  CompositorDemo
+  Show a destination sign on the simulated 28x13 panel (wiring of the example "FixedDefault") with three layers of a
+  FlipTheDot_Compositor and compare the dirty rectangles with composing the whole panel for every update:
+
+    route        opaque layer 11x7 at column 1, row 4 with the route number, changes once
+    destination  opaque layer with a text of 96x7 dots, scrolls thru a window of 16x7 at column 13, row 4
+    indicator    transparent sprite 3x3 from flash in the top right corner, blinks every 4 updates, moves once
+
+  Every scene runs 160 updates, once with the destination scrolling and once with the blinking indicator only.
+  After every update the panel gets compared with the layers composed dot by dot thru their public methods.
+  The composed dots stand for the CPU time of the compositor, the simulated time covers the flush only.
+  Exit code 1 if any dot differs, the dirty rectangles compose as many dots as the whole panel or the panel
+  counted too short or conflicting pulses.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/CompositorDemo/CompositorDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Compositor.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+const unsigned int updates = 160;
+
+// arrow, one byte per row
+const uint8_t indicatorImage[3] PROGMEM = { 0x02, 0x07, 0x02 };
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+uint8_t routeBuffer[FlipTheDot_Layer_BUFFER_SIZE(11, 7)];
+uint8_t destinationBuffer[FlipTheDot_Layer_BUFFER_SIZE(96, 7)];
+
+FlipTheDot_Layer *layers[3];
+unsigned int scrollCols[3];
+
+
+/**
+ * the dot which the layers show, composed without the compositor
+ */
+bool expected(unsigned int col, unsigned int row)
+{
+    bool show = false;
+
+    for ( unsigned int i = 0; i < 3; i++ )
+    {
+        FlipTheDot_Layer &layer = *layers[i];
+        int x = (int)col - layer.getPositionCol();
+        int y = (int)row - layer.getPositionRow();
+        unsigned int windowCols = &layer == layers[1] ? 16 : layer.getColCount();
+
+        if ( !layer.isVisible() || x < 0 || y < 0 || x >= (int)windowCols || y >= (int)layer.getRowCount() )
+        {
+            continue;
+        }
+
+        bool dot = layer.getDot((x + scrollCols[i]) % layer.getColCount() + 1, y + 1);
+        show = layer.getMode() == FlipTheDot_Layer::TRANSPARENT ? show || dot : dot;
+    }
+    return show;
+}
+
+
+unsigned int countDifferences()
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(col, row) != expected(col, row) ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+struct Result
+{
+    double composed;
+    double pulses;
+    double millis;
+    unsigned int differences;
+};
+
+
+/**
+ * build the scene, show it, then run the updates with dirty rectangles or composing the whole panel every time
+ */
+Result run(bool isScrolling, bool isWholePanel)
+{
+    FlipTheDot_Layer route(11, 7, routeBuffer);
+    FlipTheDot_Layer destination(96, 7, destinationBuffer);
+    FlipTheDot_Layer indicator(3, 3, NULL);
+    FlipTheDot_Compositor compositor(controller);
+
+    layers[0] = &route;
+    layers[1] = &destination;
+    layers[2] = &indicator;
+    memset(scrollCols, 0, sizeof(scrollCols));
+
+    route.setPosition(1, 4);
+    route.drawText(1, 1, "42", FlipTheDot_Font5x7);
+    destination.setPosition(13, 4);
+    destination.setWindow(16, 7);
+    destination.drawText(1, 1, "Hauptbahnhof    ", FlipTheDot_Font5x7);
+    indicator.setImage_P(indicatorImage);
+    indicator.setPosition(26, 1);
+    indicator.setMode(FlipTheDot_Layer::TRANSPARENT);
+
+    compositor.addLayer(route);
+    compositor.addLayer(destination);
+    compositor.addLayer(indicator);
+
+    controller.setFrameBuffer(frame, shadow);
+    compositor.update();
+
+    Result result = {};
+    result.differences = countDifferences();
+    panel.resetStatistics();
+    compositor.resetComposedCount();
+    unsigned long long start = FlipTheDot_Host_nanos;
+
+    for ( unsigned int i = 1; i <= updates; i++ )
+    {
+        if ( isScrolling )
+        {
+            scrollCols[1] = i % 96;
+            destination.setScroll(scrollCols[1], 0);
+        }
+        if ( i % 4 == 0 )
+        {
+            indicator.setVisible(!indicator.isVisible());
+        }
+        if ( i == updates / 2 )
+        {
+            route.fill(false);
+            route.drawText(4, 1, "7", FlipTheDot_Font5x7);
+        }
+        if ( i == updates * 3 / 4 )
+        {
+            indicator.setPosition(26, 11);
+        }
+
+        if ( isWholePanel )
+        {
+            compositor.invalidate();
+        }
+        compositor.update();
+        result.differences += countDifferences();
+    }
+
+    result.composed = (double)compositor.getComposedCount() / updates;
+    result.pulses = (double)panel.getPulseCount() / updates;
+    result.millis = (FlipTheDot_Host_nanos - start) / 1e6 / updates;
+    return result;
+}
+
+
+void print(const char *title, const Result &result)
+{
+    printf("%-32s %6.1f composed dots/update %6.1f pulses/update %7.2f ms/update, %u dots differ\n",
+        title, result.composed, result.pulses, result.millis, result.differences);
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    unsigned int differences = 0;
+    bool isSmaller = true;
+
+    const char *titles[2][2] = { { "blink, whole panel", "blink, dirty rectangles" },
+                                 { "scroll + blink, whole panel", "scroll + blink, dirty rectangles" } };
+    for ( int isScrolling = 0; isScrolling < 2; isScrolling++ )
+    {
+        Result whole = run(isScrolling, true);
+        Result dirty = run(isScrolling, false);
+        print(titles[isScrolling][0], whole);
+        print(titles[isScrolling][1], dirty);
+
+        differences += whole.differences + dirty.differences;
+        isSmaller = isSmaller && dirty.composed < whole.composed;
+    }
+
+    printf("%lu short pulses, %lu conflicts\n", panel.getShortPulseCount(), panel.getConflictCount());
+
+    bool isValid = differences == 0 && isSmaller && panel.getShortPulseCount() == 0 && panel.getConflictCount() == 0;
+    return isValid ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/*
+ * FlipTheDot_FrameEncoder Class  -- Encode frames for the FlipTheDot_FrameReceiver on a Linux host
+ *
+ * Keeps the last sent frame and encodes every new frame as delta (runs of toggled dots) or, if that is
+ * not shorter, as full frame. See FlipTheDot_FrameReceiver.h for the wire format.
+ * The frames use the layout of the ColumnRowController frame buffer: (cols + 7) / 8 bytes per row,
+ * first column in the lowest bit.
+ */
+
+
+#ifndef FlipTheDot_FrameEncoder_h
+#define FlipTheDot_FrameEncoder_h
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+
+class FlipTheDot_FrameEncoder
+{
+    public:
+        FlipTheDot_FrameEncoder(unsigned int cols, unsigned int rows)
+            : _cols(cols), _rows(rows), _rowBytes((cols + 7) / 8), _previous(_rowBytes * rows, 0)
+        {
+        }
+
+        unsigned int getFrameSize() { return _rowBytes * _rows; }
+
+        /**
+         * send the next frame as full frame, e.g. after the receiver reported an error
+         */
+        void invalidate() { _isValid = false; }
+
+        /**
+         * append the encoded frame to out, returns true for a full frame
+         */
+        bool encode(const uint8_t *frame, std::vector<uint8_t> &out)
+        {
+            std::vector<uint8_t> payload;
+
+            if ( _isValid )
+            {
+                _encodeDelta(frame, payload);
+            }
+
+            bool isFull = !_isValid || payload.size() >= getFrameSize();
+            if ( isFull )
+            {
+                payload.assign(frame, frame + getFrameSize());
+            }
+
+            uint8_t crc = 0;
+            for ( size_t i = 0; i < payload.size(); i++ )
+            {
+                crc = crc8(crc, payload[i]);
+            }
+
+            out.push_back(0xA5);
+            out.push_back(isFull ? 'F' : 'D');
+            out.insert(out.end(), payload.begin(), payload.end());
+            out.push_back(crc);
+
+            memcpy(_previous.data(), frame, getFrameSize());
+            _isValid = true;
+            return isFull;
+        }
+
+        static uint8_t crc8(uint8_t crc, uint8_t value)
+        {
+            crc ^= value;
+            for ( int i = 0; i < 8; i++ )
+            {
+                crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+            }
+            return crc;
+        }
+
+    protected:
+        bool _isChanged(const uint8_t *frame, unsigned long dot)
+        {
+            unsigned int index = (dot / _cols) * _rowBytes + (dot % _cols) / 8;
+            return ( (frame[index] ^ _previous[index]) >> (dot % _cols % 8) ) & 1;
+        }
+
+        static void _appendNumber(std::vector<uint8_t> &out, unsigned long value)
+        {
+            while ( value >= 0x80 )
+            {
+                out.push_back((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            out.push_back(value);
+        }
+
+        void _encodeDelta(const uint8_t *frame, std::vector<uint8_t> &out)
+        {
+            unsigned long dots = (unsigned long)_cols * _rows;
+            unsigned long end = 0;
+
+            for ( unsigned long dot = 0; dot < dots; dot++ )
+            {
+                if ( !_isChanged(frame, dot) )
+                {
+                    continue;
+                }
+
+                unsigned long length = 1;
+                while ( dot + length < dots && _isChanged(frame, dot + length) )
+                {
+                    length++;
+                }
+
+                _appendNumber(out, dot - end);
+                _appendNumber(out, length);
+
+                dot += length;
+                end = dot;
+            }
+
+            out.push_back(0);
+            out.push_back(0);
+        }
+
+        unsigned int _cols;
+        unsigned int _rows;
+        unsigned int _rowBytes;
+        std::vector<uint8_t> _previous;
+        bool _isValid = false;
+};
+
+
+#endif // FlipTheDot_FrameEncoder_h
@@ -0,0 +1,301 @@
+/*
+  FrameDevice
+  Run the example "FrameStream" on the simulated 28x13 panel (wiring of the example "FixedDefault") and receive the
+  frames from a pseudo terminal. The path of the terminal is printed in the first line, FrameSender writes into it.
+
+  The serial port of the microcontroller is modelled in virtual time: the bytes arrive back to back with the
+  given baud rate (10 bits per byte), so the sender is expected to keep the line busy. Like the HardwareSerial of
+  an Arduino Uno, 64 bytes are buffered and bytes which arrive while the buffer is full get lost.
+  Decoding a byte costs receiveMicros. Every complete frame is answered with 'A', every broken one with 'N'.
+  When the sender closes the terminal, the received frames per virtual second are reported and the panel gets
+  compared with the frame buffer. A broken frame must leave the frame buffer at the last complete frame. With "stall", the device stops reading for one second (real time) after 50 frames,
+  like a microcontroller which hangs or a serial adapter which got unplugged for a moment.
+  The exit code is 1 if the panel differs, a broken frame changed the frame buffer or, with the asynchronous
+  refresh, a frame got lost.
+
+  Usage: FrameDevice [baud] [async|blocking] [stall]
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/FrameStream/FrameDevice.cpp
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <deque>
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowControllerAsync.h"
+#include "FlipTheDot_FrameReceiver.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+
+// receive interrupt and decoding of one byte
+const unsigned int receiveMicros = 5;
+
+// size of the receive buffer of the HardwareSerial
+const unsigned int uartBufferSize = 64;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowControllerAsync controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t received[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+FlipTheDot_FrameReceiver receiver(controller, received);
+
+// frame buffer after the last complete frame
+uint8_t lastFrame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+unsigned long framesShown = 0;
+
+
+/**
+ * serial port of the microcontroller, fed by a pseudo terminal
+ */
+class LoopbackUart
+{
+    public:
+        LoopbackUart(int fd, unsigned long baud) : _fd(fd), _byteNanos(10000000000ULL / baud) {}
+
+        /**
+         * number of bytes which arrived until now, -1 after the sender closed the terminal
+         */
+        int available()
+        {
+            if ( _bytes.empty() && !_receive() )
+            {
+                return -1;
+            }
+
+            // bytes which arrive while the buffer is full get lost
+            unsigned long long now = FlipTheDot_Host_nanos;
+            while ( _bytes.size() > uartBufferSize && _bytes[uartBufferSize].arrival <= now )
+            {
+                _bytes.erase(_bytes.begin() + uartBufferSize);
+                lost++;
+            }
+
+            int count = 0;
+            while ( count < (int)_bytes.size() && _bytes[count].arrival <= now )
+            {
+                count++;
+            }
+            return count;
+        }
+
+        uint8_t read()
+        {
+            uint8_t value = _bytes.front().value;
+            _bytes.pop_front();
+            received++;
+            return value;
+        }
+
+        void write(uint8_t value)
+        {
+            ::write(_fd, &value, 1);
+        }
+
+        /**
+         * let the virtual time pass until the next byte arrives
+         */
+        void wait()
+        {
+            if ( !_bytes.empty() && _bytes.front().arrival > FlipTheDot_Host_nanos )
+            {
+                delayMicroseconds((_bytes.front().arrival - FlipTheDot_Host_nanos + 999) / 1000);
+            }
+        }
+
+        unsigned long long firstNanos = 0;
+        unsigned long received = 0;
+        unsigned long lost = 0;
+
+    protected:
+        struct Byte
+        {
+            uint8_t value;
+            unsigned long long arrival;
+        };
+
+        bool _receive()
+        {
+            uint8_t buffer[256];
+
+            for ( ;; )
+            {
+                ssize_t count = ::read(_fd, buffer, sizeof(buffer));
+                if ( count > 0 )
+                {
+                    if ( !_isStarted )
+                    {
+                        _isStarted = true;
+                        _lastArrival = FlipTheDot_Host_nanos;
+                        firstNanos = _lastArrival + _byteNanos;
+                    }
+                    for ( ssize_t i = 0; i < count; i++ )
+                    {
+                        _lastArrival += _byteNanos;
+                        _bytes.push_back({ buffer[i], _lastArrival });
+                    }
+                    return true;
+                }
+
+                // the master side reports EIO while no sender has the terminal open
+                if ( count < 0 && errno == EIO && !_isStarted )
+                {
+                    usleep(10000);
+                    continue;
+                }
+                if ( count < 0 && errno == EINTR )
+                {
+                    continue;
+                }
+                return false;
+            }
+        }
+
+        int _fd;
+        unsigned long long _byteNanos;
+        unsigned long long _lastArrival = 0;
+        bool _isStarted = false;
+        std::deque<Byte> _bytes;
+};
+
+
+void timerInterrupt()
+{
+    controller.handleInterrupt();
+}
+
+void startTimer(unsigned int micros)
+{
+    FlipTheDot_Host_setTimer(timerInterrupt, micros);
+}
+
+void frameShown()
+{
+    framesShown++;
+}
+
+
+unsigned long compare()
+{
+    unsigned long errors = panel.getShortPulseCount() + panel.getConflictCount();
+
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            errors += controller.getDot(col, row) != panel.getDot(col, row);
+        }
+    }
+    return errors;
+}
+
+
+int main(int argc, char **argv)
+{
+    unsigned long baud = argc > 1 ? strtoul(argv[1], NULL, 10) : 115200;
+    bool isBlocking = argc > 2 && strcmp(argv[2], "blocking") == 0;
+    bool isStalling = argc > 3 && strcmp(argv[3], "stall") == 0;
+
+    int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if ( fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0 )
+    {
+        perror("posix_openpt");
+        return 1;
+    }
+    printf("%s\n", ptsname(fd));
+    fflush(stdout);
+
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    controller.setFrameBuffer(frame, shadow);
+    controller.setTimer(startTimer);
+    controller.setCallback(frameShown);
+
+    LoopbackUart uart(fd, baud);
+    unsigned long errors = 0;
+    unsigned long changedByErrors = 0;
+
+    // like the loop() of the sketch
+    for ( ;; )
+    {
+        int count = uart.available();
+        if ( count < 0 )
+        {
+            break;
+        }
+        if ( count == 0 )
+        {
+            uart.wait();
+            continue;
+        }
+
+        uint8_t result = receiver.receive(uart.read());
+        delayMicroseconds(receiveMicros);
+
+        if ( result == FlipTheDot_FrameReceiver::FRAME_DONE )
+        {
+            memcpy(lastFrame, frame, sizeof(frame));
+            uart.write('A');
+            if ( isStalling && receiver.getFrameCount() == 50 )
+            {
+                usleep(1000000);
+            }
+
+            if ( isBlocking )
+            {
+                controller.flush();
+                framesShown++;
+            }
+            else
+            {
+                controller.flushAsync();
+            }
+        }
+        else if ( result == FlipTheDot_FrameReceiver::FRAME_ERROR )
+        {
+            uart.write('N');
+            errors++;
+            changedByErrors += memcmp(lastFrame, frame, sizeof(frame)) != 0 ? 1 : 0;
+        }
+    }
+
+    unsigned long long lastByteNanos = FlipTheDot_Host_nanos;
+    while ( controller.isBusy() )
+    {
+        delayMicroseconds(100);
+    }
+
+    // show what has been received after the last complete frame as well
+    controller.flush();
+
+    double seconds = (lastByteNanos - uart.firstNanos) / 1e9;
+    double lineBytes = seconds * baud / 10;
+
+    printf("%-8s %7lu baud: %6lu bytes (%lu lost, line %3.0f %% used)  %5lu frames in %6.2f s = %6.1f fps  %5lu shown  %lu errors (%lu changed the frame buffer)  panel %s\n",
+        isBlocking ? "blocking" : "async", baud, uart.received, uart.lost, lineBytes > 0 ? 100.0 * (uart.received + uart.lost) / lineBytes : 0.0,
+        receiver.getFrameCount(), seconds, seconds > 0 ? receiver.getFrameCount() / seconds : 0.0, framesShown, errors, changedByErrors,
+        compare() == 0 ? "ok" : "differs");
+
+    close(fd);
+
+    // lost bytes are expected with the blocking refresh
+    return compare() == 0 && changedByErrors == 0 && ( isBlocking || errors == 0 ) ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+/*
+  FrameSender
+  Stream an animation to a FlipTheDot_FrameReceiver over a serial connection (like the example "FrameStream")
+  or a pseudo terminal (see loopback.sh). Every frame is sent as delta or, if that is not shorter, as full frame.
+  When the receiver answers with 'N' (broken frame), the next frame is sent as full frame. The acknowledgements ('A')
+  are ignored, the frames are sent back to back (see Code/Host/Tools/RenderDaemon for a sender which waits for them).
+
+  Usage: FrameSender <device> [baud] [frames] [scroll|partial|noise] [columns] [rows]
+
+  Build:
+    g++ -std=c++11 Code/Host/Tools/FrameStream/FrameSender.cpp
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+
+#include "FlipTheDot_FrameEncoder.h"
+
+
+unsigned int columns = 28;
+unsigned int rows = 13;
+std::vector<uint8_t> frame;
+
+
+// 5x7 glyphs, one byte per column with the top row in the lowest bit
+const char scrollText[] = "BUS 42 HBF 17 ";
+const char glyphChars[] = " 0123456789BFHSU";
+const uint8_t glyphs[][5] = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 },
+    { 0x42, 0x61, 0x51, 0x49, 0x46 }, { 0x21, 0x41, 0x45, 0x4B, 0x31 }, { 0x18, 0x14, 0x12, 0x7F, 0x10 },
+    { 0x27, 0x45, 0x45, 0x45, 0x39 }, { 0x3C, 0x4A, 0x49, 0x49, 0x30 }, { 0x01, 0x71, 0x09, 0x05, 0x03 },
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x06, 0x49, 0x49, 0x29, 0x1E }, { 0x7F, 0x49, 0x49, 0x49, 0x36 },
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x46, 0x49, 0x49, 0x49, 0x31 },
+    { 0x3F, 0x40, 0x40, 0x40, 0x3F }
+};
+
+uint8_t textColumn(unsigned int position)
+{
+    unsigned int length = strlen(scrollText) * 6;
+    position %= length;
+
+    const char *found = strchr(glyphChars, scrollText[position / 6]);
+    unsigned int column = position % 6;
+
+    return found == NULL || column == 5 ? 0 : glyphs[found - glyphChars][column];
+}
+
+
+void setDot(unsigned int col, unsigned int row, bool show)
+{
+    unsigned int index = (row - 1) * ((columns + 7) / 8) + (col - 1) / 8;
+    uint8_t mask = 1 << ((col - 1) % 8);
+    frame[index] = show ? frame[index] | mask : frame[index] & ~mask;
+}
+
+bool getDot(unsigned int col, unsigned int row)
+{
+    return ( frame[(row - 1) * ((columns + 7) / 8) + (col - 1) / 8] >> ((col - 1) % 8) ) & 1;
+}
+
+
+/**
+ * animations, draw the given frame into the frame buffer
+ */
+void drawScroll(unsigned int number)
+{
+    unsigned int top = rows > 7 ? (rows - 7) / 2 : 0;
+
+    std::fill(frame.begin(), frame.end(), 0);
+    for ( unsigned int col = 1; col <= columns; col++ )
+    {
+        uint8_t bits = textColumn(number + col - 1);
+        for ( unsigned int row = 0; row < 7 && top + row < rows; row++ )
+        {
+            setDot(col, top + row + 1, (bits >> row) & 1);
+        }
+    }
+}
+
+void drawPartial(unsigned int number)
+{
+    for ( unsigned int n = 0; n < columns * rows / 20; n++ )
+    {
+        unsigned int col = rand() % columns + 1;
+        unsigned int row = rand() % rows + 1;
+        setDot(col, row, !getDot(col, row));
+    }
+}
+
+void drawNoise(unsigned int number)
+{
+    for ( size_t i = 0; i < frame.size(); i++ )
+    {
+        frame[i] = rand();
+    }
+}
+
+
+speed_t getSpeed(unsigned long baud)
+{
+    switch ( baud )
+    {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 500000:  return B500000;
+        case 1000000: return B1000000;
+        default:      return B115200;
+    }
+}
+
+
+void writeAll(int fd, const std::vector<uint8_t> &data)
+{
+    size_t written = 0;
+
+    while ( written < data.size() )
+    {
+        ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if ( result < 0 && errno != EINTR && errno != EAGAIN )
+        {
+            perror("write");
+            exit(1);
+        }
+        written += result > 0 ? result : 0;
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    if ( argc < 2 )
+    {
+        fprintf(stderr, "Usage: %s <device> [baud] [frames] [scroll|partial|noise] [columns] [rows]\n", argv[0]);
+        return 2;
+    }
+
+    unsigned long baud = argc > 2 ? strtoul(argv[2], NULL, 10) : 115200;
+    unsigned int frames = argc > 3 ? atoi(argv[3]) : 300;
+    const char *animation = argc > 4 ? argv[4] : "scroll";
+    columns = argc > 5 ? atoi(argv[5]) : columns;
+    rows = argc > 6 ? atoi(argv[6]) : rows;
+
+    void (*draw)(unsigned int) = drawScroll;
+    if ( strcmp(animation, "partial") == 0 )
+    {
+        draw = drawPartial;
+    }
+    else if ( strcmp(animation, "noise") == 0 )
+    {
+        draw = drawNoise;
+    }
+
+    int fd = open(argv[1], O_RDWR | O_NOCTTY);
+    if ( fd < 0 )
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    // raw 8N1, reads do not block
+    struct termios settings;
+    if ( tcgetattr(fd, &settings) == 0 )
+    {
+        cfmakeraw(&settings);
+        cfsetspeed(&settings, getSpeed(baud));
+        settings.c_cc[VMIN] = 0;
+        settings.c_cc[VTIME] = 0;
+        tcsetattr(fd, TCSANOW, &settings);
+    }
+
+    FlipTheDot_FrameEncoder encoder(columns, rows);
+    frame.assign(encoder.getFrameSize(), 0);
+    srand(1);
+
+    std::vector<uint8_t> data;
+    unsigned long bytes = 0;
+    unsigned int fullFrames = 0;
+    unsigned int errors = 0;
+
+    for ( unsigned int number = 0; number < frames; number++ )
+    {
+        uint8_t answer[64];
+        ssize_t count = read(fd, answer, sizeof(answer));
+        for ( ssize_t i = 0; i < count; i++ )
+        {
+            if ( answer[i] == 'N' )
+            {
+                errors++;
+                encoder.invalidate();
+            }
+        }
+
+        draw(number);
+
+        data.clear();
+        fullFrames += encoder.encode(frame.data(), data);
+        writeAll(fd, data);
+        bytes += data.size();
+    }
+
+    tcdrain(fd);
+    close(fd);
+
+    printf("sent %u frames (%u full), %lu bytes, %.1f bytes/frame (full frame %u bytes), %u errors reported\n",
+        frames, fullFrames, bytes, frames > 0 ? (double)bytes / frames : 0.0, encoder.getFrameSize() + 3, errors);
+    return 0;
+}
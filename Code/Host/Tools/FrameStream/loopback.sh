@@ -0,0 +1,42 @@
+#!/bin/bash
+# Stream frames from FrameSender thru a pseudo terminal into FrameDevice (simulated panel) and report the frames per second.
+# Runs every animation with the asynchronous and with the blocking refresh.
+# Usage: ./loopback.sh [baud] [frames] [c++ compiler]
+
+cd "$(dirname "$0")"
+
+baud=${1:-115200}
+frames=${2:-300}
+compiler=${3:-g++}
+libraries=../../../Arduino/libraries
+build=$(mktemp -d)
+
+$compiler -std=c++11 -O2 FrameSender.cpp -o "$build/sender" || exit 1
+$compiler -std=c++11 -O2 -I../../Arduino -I../../Simulator -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController \
+    FrameDevice.cpp -o "$build/device" || exit 1
+
+result=0
+for animation in scroll partial noise; do
+    for mode in async blocking; do
+        coproc device { "$build/device" "$baud" "$mode"; }
+        # bash closes the descriptors of the coprocess when it exits, read thru a copy
+        pid=$device_PID
+        exec {out}<&"${device[0]}"
+        read -r terminal <&$out
+
+        echo "== $animation: $("$build/sender" "$terminal" "$baud" "$frames" "$animation")"
+        report=$(cat <&$out)
+        exec {out}<&-
+        echo "$report"
+        wait $pid || result=1
+
+        # the result line of the device is the evidence of the run
+        if ! grep -q " panel " <<< "$report"; then
+            echo "no result from the device"
+            result=1
+        fi
+    done
+done
+
+rm -r "$build"
+exit $result
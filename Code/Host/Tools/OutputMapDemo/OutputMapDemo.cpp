@@ -0,0 +1,155 @@
+/*
+  OutputMapDemo
+  Drive a simulated 56x24 panel with a non-linear wiring thru output maps (FlipTheDot_FP2800a::setOutputMap):
+
+    rows:    split connector, rows 1 - 12 on the outputs 15 - 26 and rows 13 - 24 on the outputs 1 - 12 of the row IC
+    columns: two modules of 28 columns, the left one on the second column IC with its outputs in reverse order,
+             the right one on the first column IC
+
+  The wiring of the FixedMulti example (three column ICs) is used with two column ICs.
+  The demo flushes random frames and checks every dot of the panel at its physical position against the frame buffer
+  at the logical position. It checks the linear output numbers of FlipTheDot_FP2800aMulti as well (1 - 56 valid, 0 and 57 rejected).
+  Exit code 1 if any dot or output number is wrong or the panel counted too short or conflicting pulses.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/OutputMapDemo/OutputMapDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aMulti.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+const unsigned int columns = 56;
+const unsigned int rows = 24;
+const unsigned int frames = 10;
+
+// logical row -> IC and output
+const uint8_t rowMap[rows] PROGMEM = {
+    FlipTheDot_FP2800a_MAP(0, 15), FlipTheDot_FP2800a_MAP(0, 16), FlipTheDot_FP2800a_MAP(0, 17), FlipTheDot_FP2800a_MAP(0, 18),
+    FlipTheDot_FP2800a_MAP(0, 19), FlipTheDot_FP2800a_MAP(0, 20), FlipTheDot_FP2800a_MAP(0, 21), FlipTheDot_FP2800a_MAP(0, 22),
+    FlipTheDot_FP2800a_MAP(0, 23), FlipTheDot_FP2800a_MAP(0, 24), FlipTheDot_FP2800a_MAP(0, 25), FlipTheDot_FP2800a_MAP(0, 26),
+    FlipTheDot_FP2800a_MAP(0,  1), FlipTheDot_FP2800a_MAP(0,  2), FlipTheDot_FP2800a_MAP(0,  3), FlipTheDot_FP2800a_MAP(0,  4),
+    FlipTheDot_FP2800a_MAP(0,  5), FlipTheDot_FP2800a_MAP(0,  6), FlipTheDot_FP2800a_MAP(0,  7), FlipTheDot_FP2800a_MAP(0,  8),
+    FlipTheDot_FP2800a_MAP(0,  9), FlipTheDot_FP2800a_MAP(0, 10), FlipTheDot_FP2800a_MAP(0, 11), FlipTheDot_FP2800a_MAP(0, 12)
+};
+
+// logical column -> IC and output
+const uint8_t columnMap[columns] PROGMEM = {
+    FlipTheDot_FP2800a_MAP(1, 28), FlipTheDot_FP2800a_MAP(1, 27), FlipTheDot_FP2800a_MAP(1, 26), FlipTheDot_FP2800a_MAP(1, 25),
+    FlipTheDot_FP2800a_MAP(1, 24), FlipTheDot_FP2800a_MAP(1, 23), FlipTheDot_FP2800a_MAP(1, 22), FlipTheDot_FP2800a_MAP(1, 21),
+    FlipTheDot_FP2800a_MAP(1, 20), FlipTheDot_FP2800a_MAP(1, 19), FlipTheDot_FP2800a_MAP(1, 18), FlipTheDot_FP2800a_MAP(1, 17),
+    FlipTheDot_FP2800a_MAP(1, 16), FlipTheDot_FP2800a_MAP(1, 15), FlipTheDot_FP2800a_MAP(1, 14), FlipTheDot_FP2800a_MAP(1, 13),
+    FlipTheDot_FP2800a_MAP(1, 12), FlipTheDot_FP2800a_MAP(1, 11), FlipTheDot_FP2800a_MAP(1, 10), FlipTheDot_FP2800a_MAP(1,  9),
+    FlipTheDot_FP2800a_MAP(1,  8), FlipTheDot_FP2800a_MAP(1,  7), FlipTheDot_FP2800a_MAP(1,  6), FlipTheDot_FP2800a_MAP(1,  5),
+    FlipTheDot_FP2800a_MAP(1,  4), FlipTheDot_FP2800a_MAP(1,  3), FlipTheDot_FP2800a_MAP(1,  2), FlipTheDot_FP2800a_MAP(1,  1),
+    FlipTheDot_FP2800a_MAP(0,  1), FlipTheDot_FP2800a_MAP(0,  2), FlipTheDot_FP2800a_MAP(0,  3), FlipTheDot_FP2800a_MAP(0,  4),
+    FlipTheDot_FP2800a_MAP(0,  5), FlipTheDot_FP2800a_MAP(0,  6), FlipTheDot_FP2800a_MAP(0,  7), FlipTheDot_FP2800a_MAP(0,  8),
+    FlipTheDot_FP2800a_MAP(0,  9), FlipTheDot_FP2800a_MAP(0, 10), FlipTheDot_FP2800a_MAP(0, 11), FlipTheDot_FP2800a_MAP(0, 12),
+    FlipTheDot_FP2800a_MAP(0, 13), FlipTheDot_FP2800a_MAP(0, 14), FlipTheDot_FP2800a_MAP(0, 15), FlipTheDot_FP2800a_MAP(0, 16),
+    FlipTheDot_FP2800a_MAP(0, 17), FlipTheDot_FP2800a_MAP(0, 18), FlipTheDot_FP2800a_MAP(0, 19), FlipTheDot_FP2800a_MAP(0, 20),
+    FlipTheDot_FP2800a_MAP(0, 21), FlipTheDot_FP2800a_MAP(0, 22), FlipTheDot_FP2800a_MAP(0, 23), FlipTheDot_FP2800a_MAP(0, 24),
+    FlipTheDot_FP2800a_MAP(0, 25), FlipTheDot_FP2800a_MAP(0, 26), FlipTheDot_FP2800a_MAP(0, 27), FlipTheDot_FP2800a_MAP(0, 28)
+};
+
+// the panel has to exist before the controllers initialize their pins, it has a line for every output of the row IC
+FlipTheDot_PanelSimulator panel(columns, 28);
+
+unsigned int columnEnableList[] = { A1, A2 };
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800aMulti columnController(columnEnableList, 2, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+/**
+ * line of the panel (chip * 28 + output) for a logical number
+ */
+unsigned int physical(const uint8_t *map, unsigned int no)
+{
+    uint8_t entry = pgm_read_byte(&map[no - 1]);
+    return (entry >> 5) * 28 + (entry & 0x1F);
+}
+
+
+unsigned int countDifferences()
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(physical(columnMap, col), physical(rowMap, row)) != controller.getDot(col, row) ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+/**
+ * select every linear output number of the column controller and read it back
+ */
+unsigned int countWrongOutputs()
+{
+    unsigned int wrong = 0;
+
+    for ( unsigned int no = 1; no <= columns; no++ )
+    {
+        wrong += columnController.setOutput(no) && columnController.getOutput() == no ? 0 : 1;
+    }
+    wrong += columnController.setOutput(0) ? 1 : 0;
+    wrong += columnController.setOutput(columns + 1) ? 1 : 0;
+    return wrong;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 28, A2, 8, 9, 10, 11, 12, 13);
+
+    unsigned int wrongOutputs = countWrongOutputs();
+
+    rowController.setOutputMap(rowMap, rows);
+    columnController.setOutputMap(columnMap, columns);
+    // ignored by flush() while the columns are mapped
+    columnController.setMaxEnabledChips(2);
+    controller.setFrameBuffer(frame, shadow);
+
+    randomSeed(7);
+    unsigned long long start = FlipTheDot_Host_nanos;
+    unsigned int differences = 0;
+
+    for ( unsigned int i = 0; i <= frames; i++ )
+    {
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            for ( unsigned int col = 1; col <= columns; col++ )
+            {
+                controller.setDot(col, row, i > 0 && random(2) == 1);
+            }
+        }
+        controller.flush();
+        differences += countDifferences();
+    }
+
+    // a single flip goes thru the maps as well
+    controller.flip(1, 1, !controller.getDot(1, 1));
+    differences += countDifferences();
+
+    printf("%lu pulses, %.2f ms/frame, %u dots differ, %u wrong output numbers, %lu short pulses, %lu conflicts\n",
+        panel.getPulseCount(), (FlipTheDot_Host_nanos - start) / 1e6 / (frames + 1), differences, wrongOutputs,
+        panel.getShortPulseCount(), panel.getConflictCount());
+
+    bool isValid = differences == 0 && wrongOutputs == 0 && panel.getShortPulseCount() == 0 && panel.getConflictCount() == 0;
+    return isValid ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/*
+  PanelDemo
+  Run the FlipTheDot_ColumnRowController against the simulated 28x13 panel with the wiring of the
+  example "FixedDefault" and print the panel plus the virtual time after each step.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/PanelDemo/PanelDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+void report(const char *title)
+{
+    static unsigned long long last = 0;
+
+    printf("%s: %lu coil pulses, %.2f ms\n", title, panel.getPulseCount(), (FlipTheDot_Host_nanos - last) / 1e6);
+    panel.print(stdout);
+    printf("\n");
+
+    panel.resetStatistics();
+    last = FlipTheDot_Host_nanos;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    // unknown state after power on
+    panel.fill(true);
+    report("power on");
+
+    controller.setFrameBuffer(frame, shadow);
+    controller.flush();
+    report("first flush (all dots)");
+
+    for ( unsigned int col = 1; col <= columns; col++ )
+    {
+        controller.setDot(col, 1, true);
+        controller.setDot(col, rows, true);
+    }
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        controller.setDot(1, row, true);
+        controller.setDot(columns, row, true);
+        controller.setDot(row + 7, row, true);
+    }
+    controller.flush();
+    report("frame and diagonal");
+
+    controller.setDot(8, 1, false);
+    controller.setDot(20, 13, false);
+    controller.flush();
+    report("two dots changed");
+
+    controller.flip(14, 7, false);
+    report("single flip");
+
+    return panel.getConflictCount() == 0 && panel.getShortPulseCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+/*
+  PanelStateDemo
+  Restart the simulated 28x13 panel (wiring of the example "FixedDefault") with FlipTheDot_PanelStateEEPROM:
+
+    cold start            erased EEPROM, the first flush pulses every dot
+    warm start            the stored frame gets loaded, the first flush only pulses the changed dots
+    filled                fill(true) and flush, the next flush must not write the EEPROM
+    interrupted flushes   a reset at 60 points in time during a flush (while the EEPROM gets written and while
+                          the dots get pulsed), then a restart, the restore and the next frame
+    10 flushes per second a few dots change every 100 ms for 10 minutes, once saving every flush and once with a
+                          save interval of one minute, the most written byte tells the lifetime of the EEPROM
+
+  A reset gets emulated by an exception from the timer interrupt of the stand-in, which leaves the flush
+  at any point. Afterwards all pins go LOW and new controller and panel state objects get created, only the
+  EEPROM and the panel keep their content.
+  After every restart the panel gets compared with the frame buffer. Exit code 1 if any dot differs, the
+  filled frame wrote the EEPROM again or the panel counted conflicting pulses (pulses cut by a reset count as
+  short pulses and are expected).
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/PanelStateDemo/PanelStateDemo.cpp
+ */
+
+
+#define FlipTheDot_ColumnRowController_PANEL_STATE
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_PanelStateEEPROM.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+const unsigned int slots = 8;
+const unsigned int resets = 60;
+
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+// everything which gets lost by a reset
+struct Board
+{
+    FlipTheDot_FP2800aFixed rowController;
+    FlipTheDot_FP2800a columnController;
+    FlipTheDot_ColumnRowController controller;
+    FlipTheDot_PanelStateEEPROM panelState;
+    boolean isRestored;
+
+    Board()
+        : rowController(A0, 2, 3, 4, 5, 6, 7), columnController(A1, 8, 9, 10, 11, 12, 13),
+          controller(columnController, rowController, columns, rows),
+          panelState(0, slots * FlipTheDot_PanelState_SLOT_SIZE(columns, rows))
+    {
+        controller.setFrameBuffer(frame, shadow);
+        isRestored = controller.setPanelState(&panelState);
+    }
+};
+
+
+struct Reset {};
+
+void resetIsr()
+{
+    throw Reset();
+}
+
+
+/**
+ * some text-like pattern, a different one for every seed
+ */
+void draw(FlipTheDot_ColumnRowController &controller, unsigned int seed)
+{
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            controller.setDot(col, row, ((col * 7 + row * 13 + seed * 5) % 11 < 4) != ((seed + col / 6 + row / 4) % 3 == 0));
+        }
+    }
+}
+
+
+unsigned int countDifferences(FlipTheDot_ColumnRowController &controller)
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(col, row) != controller.getDot(col, row) ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+unsigned long maxWrites()
+{
+    unsigned long max = 0;
+    for ( unsigned int i = 0; i < FlipTheDot_Host_EEPROM_SIZE; i++ )
+    {
+        max = FlipTheDot_Host_eepromWrites[i] > max ? FlipTheDot_Host_eepromWrites[i] : max;
+    }
+    return max;
+}
+
+
+/**
+ * flush, returns the pulsed dots and adds the virtual time to micros
+ */
+unsigned int timedFlush(FlipTheDot_ColumnRowController &controller, double &millis)
+{
+    unsigned long long start = FlipTheDot_Host_nanos;
+    panel.resetStatistics();
+    controller.flush();
+    millis = (FlipTheDot_Host_nanos - start) / 1e6;
+    return panel.getPulseCount();
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    unsigned int differences = 0;
+    unsigned long conflicts = 0;
+    double millis;
+    unsigned int seed = 1;
+
+    // cold start: nothing stored, the panel shows random dots
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            panel.setDot(col, row, rand() & 1);
+        }
+    }
+    {
+        Board board;
+        draw(board.controller, seed);
+        unsigned int pulses = timedFlush(board.controller, millis);
+        differences += countDifferences(board.controller);
+        printf("cold start     restored %d, first flush %3u dots %8.1f ms, %lu EEPROM bytes written, %u slots\n",
+            board.isRestored, pulses, millis, board.panelState.getWriteCount(), board.panelState.getSlotCount());
+    }
+
+    // warm start: the stored frame is shown
+    {
+        Board board;
+        draw(board.controller, ++seed);
+        unsigned int pulses = timedFlush(board.controller, millis);
+        differences += countDifferences(board.controller);
+        printf("warm start     restored %d, first flush %3u dots %8.1f ms, %lu EEPROM bytes written\n",
+            board.isRestored, pulses, millis, board.panelState.getWriteCount());
+    }
+
+    // an unchanged frame writes nothing
+    {
+        Board board;
+        unsigned int pulses = timedFlush(board.controller, millis);
+        printf("unchanged      restored %d, first flush %3u dots %8.1f ms, %lu EEPROM bytes written\n",
+            board.isRestored, pulses, millis, board.panelState.getWriteCount());
+    }
+
+    // a filled frame, the unused bits behind the last column must not count as change
+    unsigned long filledWrites;
+    {
+        Board board;
+        board.controller.fill(true);
+        board.controller.flush();
+        unsigned long writes = board.panelState.getWriteCount();
+        unsigned int pulses = timedFlush(board.controller, millis);
+        filledWrites = board.panelState.getWriteCount() - writes;
+        differences += countDifferences(board.controller);
+        printf("filled         restored %d, next flush  %3u dots %8.1f ms, %lu EEPROM bytes written\n",
+            board.isRestored, pulses, millis, filledWrites);
+    }
+
+    // measure one complete flush, then reset at points spread over it
+    unsigned long long flushNanos;
+    {
+        Board board;
+        draw(board.controller, ++seed);
+        unsigned long long start = FlipTheDot_Host_nanos;
+        board.controller.flush();
+        flushNanos = FlipTheDot_Host_nanos - start;
+    }
+
+    unsigned int restored = 0;
+    unsigned long restorePulses = 0;
+    double restoreMillis = 0;
+
+    for ( unsigned int i = 0; i < resets; i++ )
+    {
+        {
+            Board board;
+            draw(board.controller, ++seed);
+            FlipTheDot_Host_setTimer(resetIsr, (flushNanos * i / resets) / 1000 + 1);
+            try
+            {
+                board.controller.flush();
+            }
+            catch ( Reset & )
+            {
+            }
+            FlipTheDot_Host_inInterrupt = false;
+            FlipTheDot_Host_setTimer(resetIsr, 0);
+
+            // all pins go LOW with the reset
+            board.columnController.disable();
+            board.rowController.disable();
+        }
+
+        conflicts += panel.getConflictCount();
+        panel.resetStatistics();
+        unsigned long long start = FlipTheDot_Host_nanos;
+
+        Board board;
+        restored += board.isRestored ? 1 : 0;
+        restorePulses += panel.getPulseCount();
+        restoreMillis += (FlipTheDot_Host_nanos - start) / 1e6;
+
+        // a failed restore leaves the frame buffer empty and the next flush pulses every dot
+        unsigned int restoreDifferences = board.isRestored ? countDifferences(board.controller) : 0;
+
+        draw(board.controller, ++seed);
+        board.controller.flush();
+        differences += restoreDifferences + countDifferences(board.controller);
+        conflicts += panel.getConflictCount();
+    }
+
+    printf("%u resets      %u restored, %.1f dots and %.1f ms to restore on average, %u dots differ\n",
+        resets, restored, (double)restorePulses / resets, restoreMillis / resets, differences);
+    printf("EEPROM         at most %lu writes per byte after %lu seeds\n", maxWrites(), (unsigned long)seed);
+
+    // a ticker-like sketch, with and without save interval
+    for ( unsigned long interval = 0; interval <= 60000; interval += 60000 )
+    {
+        unsigned long before[FlipTheDot_Host_EEPROM_SIZE];
+        memcpy(before, FlipTheDot_Host_eepromWrites, sizeof(before));
+
+        Board board;
+        board.panelState.setSaveInterval(interval);
+        const unsigned int flushes = 6000;
+        unsigned long long start = FlipTheDot_Host_nanos;
+        double flushMillis = 0;
+        for ( unsigned int i = 0; i < flushes; i++ )
+        {
+            board.controller.setDot(1 + i % columns, 1 + i / columns % rows, !board.controller.getDot(1 + i % columns, 1 + i / columns % rows));
+            unsigned long long flushStart = FlipTheDot_Host_nanos;
+            board.controller.flush();
+            flushMillis += (FlipTheDot_Host_nanos - flushStart) / 1e6;
+            delay(100);
+        }
+        board.controller.flush();
+
+        unsigned long most = 0;
+        for ( unsigned int i = 0; i < FlipTheDot_Host_EEPROM_SIZE; i++ )
+        {
+            most = FlipTheDot_Host_eepromWrites[i] - before[i] > most ? FlipTheDot_Host_eepromWrites[i] - before[i] : most;
+        }
+        double hours = (FlipTheDot_Host_nanos - start) / 3.6e12;
+        printf("10 flushes/s   save interval %5lu ms: %4lu saves skipped, %.1f ms per flush, at most %lu writes per byte, 100000 writes after %.0f hours\n",
+            interval, board.panelState.getSkippedCount(), flushMillis / flushes, most, 100000 * hours / most);
+        differences += countDifferences(board.controller);
+        conflicts += panel.getConflictCount();
+    }
+
+    printf("%lu conflicts\n", conflicts);
+
+    return differences == 0 && conflicts == 0 && filledWrites == 0 ? 0 : 1;
+}
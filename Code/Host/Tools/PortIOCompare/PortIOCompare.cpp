@@ -0,0 +1,137 @@
+/*
+  PortIOCompare
+  Drive the FP2800a classes thru all outputs and data states and print the virtual port
+  registers (PORTB, PORTC, PORTD) after every call.
+
+  The program gets compiled twice by compare.sh, once with the regular digitalWrite(...) path
+  and once with FlipTheDot_FP2800a_PORT_IO defined. Both outputs have to be identical.
+
+  The pin maps cover address lines on a single port (one masked write) and address lines
+  spread over all three ports. The output groups of FlipTheDot_FP2800aMulti switch enable pins
+  on one port and on several ports.
+ */
+
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aMulti.h"
+
+
+unsigned long step = 0;
+
+void dump(const char *action, unsigned int value)
+{
+    printf("%05lu %-10s %3u  B=%02X C=%02X D=%02X\n", step++, action, value,
+        FlipTheDot_Host_PORT[PB], FlipTheDot_Host_PORT[PC], FlipTheDot_Host_PORT[PD]);
+}
+
+void run(FlipTheDot_FP2800a &controller)
+{
+    dump("init", 0);
+
+    for ( unsigned int data = 0; data < 2; data++ )
+    {
+        controller.setData(data == 1);
+        dump("setData", data);
+
+        // all valid outputs, one below and one above the range
+        for ( unsigned int no = 0; no <= controller.getOutputMax() + 1; no++ )
+        {
+            controller.setOutput(no);
+            dump("setOutput", no);
+
+            controller.enable();
+            dump("enable", no);
+
+            // rejected while enabled
+            controller.setOutput(no == 1 ? 2 : 1);
+            dump("setOutput", no);
+
+            controller.disable();
+            dump("disable", no);
+        }
+
+        // reverse order to pass every address transition in both directions
+        for ( unsigned int no = controller.getOutputMax(); no >= 1; no-- )
+        {
+            controller.setOutput(no);
+            controller.pulse();
+            dump("pulse", no);
+        }
+    }
+}
+
+// every combination of ICs of an output group, enabled and disabled together
+void runGroups(FlipTheDot_FP2800aMulti &controller)
+{
+    controller.setMaxEnabledChips(controller.getChipCount());
+    dump("init", 0);
+
+    for ( unsigned long chipMask = 1; chipMask < (1UL << controller.getChipCount()); chipMask++ )
+    {
+        unsigned int no = 1 + chipMask % 28;
+        controller.setOutputGroup(no, chipMask);
+        dump("group", chipMask);
+
+        controller.enable();
+        dump("enable", no);
+
+        controller.disable();
+        dump("disable", no);
+    }
+
+    // a regular output ends the group
+    controller.setOutput(30);
+    controller.pulse();
+    dump("pulse", 30);
+}
+
+// the ports get cleared between the setups to start each one from a known state
+void reset()
+{
+    memset((void *)FlipTheDot_Host_PORT, 0, sizeof(FlipTheDot_Host_PORT));
+}
+
+
+int main()
+{
+    {
+        // address lines on PORTD only
+        reset();
+        //                          Enable, Data, A0, A1, A2, B0, B1
+        FlipTheDot_FP2800a controller(A1,   8,    2,  3,  4,  5,  6);
+        run(controller);
+    }
+    {
+        // address lines spread over all ports and not in bit order
+        reset();
+        FlipTheDot_FP2800a controller(7,    A5,   13, A0, 2,  9,  A3);
+        run(controller);
+    }
+    {
+        reset();
+        //                                 Enable Reset, Enable Set, A0, A1, A2, B0, B1
+        FlipTheDot_FP2800aFixed controller(A0,           2,          3,  4,  5,  6,  7);
+        run(controller);
+    }
+    {
+        reset();
+        unsigned int enableList[] = { A1, A2, A3 };
+        //                                 Enable List, Length, Data, A0, A1, A2, B0, B1
+        FlipTheDot_FP2800aMulti controller(enableList,  3,      8,    9,  10, 11, 12, 13);
+        run(controller);
+        runGroups(controller);
+    }
+    {
+        // enable pins of the output groups spread over all ports
+        reset();
+        unsigned int enableList[] = { A1, 7, 2, 13 };
+        FlipTheDot_FP2800aMulti controller(enableList,  4,      8,    9,  10, 11, 12, A0);
+        runGroups(controller);
+    }
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/bin/bash
+# Build PortIOCompare with and without FlipTheDot_FP2800a_PORT_IO and compare the pin states.
+# Usage: ./compare.sh [c++ compiler]
+
+cd "$(dirname "$0")"
+
+compiler=${1:-g++}
+libraries=../../../Arduino/libraries
+flags="-std=c++11 -Wall -I../../Arduino -I$libraries/FlipTheDot_FP2800a"
+build=$(mktemp -d)
+
+$compiler $flags PortIOCompare.cpp -o "$build/digitalWrite" || exit 1
+$compiler $flags -DFlipTheDot_FP2800a_PORT_IO PortIOCompare.cpp -o "$build/portIO" || exit 1
+
+"$build/digitalWrite" > "$build/digitalWrite.txt"
+"$build/portIO" > "$build/portIO.txt"
+
+if diff -u "$build/digitalWrite.txt" "$build/portIO.txt" ; then
+	echo "identical: $(wc -l < "$build/portIO.txt") pin states compared"
+	result=0
+else
+	echo "pin states differ"
+	result=1
+fi
+
+rm -r "$build"
+exit $result
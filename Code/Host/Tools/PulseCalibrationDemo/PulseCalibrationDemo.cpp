@@ -0,0 +1,350 @@
+/*
+  PulseCalibrationDemo
+  Calibrate the pulse lengths of a simulated 28x13 panel (wiring of the example "FixedDefault") and compare
+  the refresh time with one pulse length for all dots.
+
+  The simulated dots need different pulse lengths (at 24 V): 30 µs to show plus up to 18 µs for the rows
+  at the far end of the traces, up to 16 µs along the columns, 15 µs more for four columns of older dots,
+  up to 6 µs of spread per dot and 8 µs more to hide. Every dot takes longer at a lower supply voltage.
+
+    measure     find the shortest pulse which flips each dot (like a camera in front of a real panel would)
+    fit         derive the base per polarity, the column and the row table, plus a margin of 10 %
+    compare     full refreshes and random frames with 100 µs (default), with the shortest pulse length
+                which flips every dot, and with the calibration, at 24 V and at other supply voltages
+
+  Exit code 1 if the calibration leaves any dot in the wrong state or causes a short pulse.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/PulseCalibrationDemo/PulseCalibrationDemo.cpp
+ */
+
+
+#define FlipTheDot_ColumnRowController_PULSE_CALIBRATION
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_PulseCalibration.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+const unsigned int nominalMillivolts = 24000;
+const unsigned int frames = 50;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+// flip time of every dot at the nominal voltage in nanoseconds, [polarity][row][col]
+unsigned long need[2][rows + 1][columns + 1];
+
+uint8_t rowExtra[rows];
+uint8_t colExtra[columns];
+FlipTheDot_PulseCalibration calibration(columns, rows);
+
+
+unsigned long next(unsigned long &seed)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (seed >> 16) & 0x7FFF;
+}
+
+
+/**
+ * the flip times of the simulated panel at a supply voltage
+ */
+void setSupply(unsigned int millivolts)
+{
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            panel.setFlipTime(col, row,
+                (unsigned long long)need[1][row][col] * nominalMillivolts / millivolts,
+                (unsigned long long)need[0][row][col] * nominalMillivolts / millivolts);
+        }
+    }
+}
+
+
+/**
+ * check if a single pulse of the given length moves a dot into the state show
+ */
+bool isFlipping(unsigned int col, unsigned int row, boolean show, unsigned int micros)
+{
+    controller.setPulseLength(1000);
+    controller.flip(col, row, !show);
+    controller.setPulseLength(micros);
+    controller.flip(col, row, show);
+    return panel.getDot(col, row) == (show == true);
+}
+
+
+/**
+ * shortest pulse which flips a dot, in whole microseconds
+ */
+unsigned int measure(unsigned int col, unsigned int row, boolean show)
+{
+    unsigned int low = 1;
+    unsigned int high = 200;
+
+    while ( low < high )
+    {
+        unsigned int middle = (low + high) / 2;
+        if ( isFlipping(col, row, show, middle) )
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+    return low;
+}
+
+
+void draw(unsigned int seed)
+{
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            controller.setDot(col, row, ((col * 7 + row * 13 + seed * 5) % 11 < 4) != ((seed + col / 6 + row / 4) % 3 == 0));
+        }
+    }
+}
+
+
+unsigned int countDifferences()
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(col, row) != controller.getDot(col, row) ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+struct Result
+{
+    double fullMillis;
+    double frameMillis;
+    double pulseMillis;
+    unsigned int differences;
+    unsigned long shortPulses;
+};
+
+
+/**
+ * two full refreshes (all dots shown, all hidden) and the random frames
+ */
+Result run()
+{
+    Result result = {};
+    unsigned long long start = FlipTheDot_Host_nanos;
+
+    panel.resetStatistics();
+    controller.resetStatistics();
+    for ( uint8_t show = 1; show <= 2; show++ )
+    {
+        controller.fill(show == 1);
+        controller.invalidate();
+        controller.flush();
+        result.differences += countDifferences();
+    }
+    result.fullMillis = (FlipTheDot_Host_nanos - start) / 2e6;
+
+    start = FlipTheDot_Host_nanos;
+    controller.resetStatistics();
+    for ( unsigned int i = 0; i < frames; i++ )
+    {
+        draw(i);
+        controller.flush();
+        result.differences += countDifferences();
+    }
+    result.frameMillis = (FlipTheDot_Host_nanos - start) / 1e6 / frames;
+    result.pulseMillis = controller.getStatistics().pulseMicros / 1e3 / frames;
+    result.shortPulses = panel.getShortPulseCount();
+
+    // the dots which did not flip stay wrong until a full refresh
+    controller.invalidate();
+    controller.setPulseLength(1000);
+    controller.setPulseCalibration(NULL);
+    controller.flush();
+    return result;
+}
+
+
+void print(const char *title, const Result &result)
+{
+    printf("%-34s full refresh %6.1f ms, frame %5.2f ms (pulses %5.2f ms), %3u dots differ, %4lu short pulses\n",
+        title, result.fullMillis, result.frameMillis, result.pulseMillis, result.differences, result.shortPulses);
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    controller.setFrameBuffer(frame, shadow);
+
+    unsigned long seed = 1;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            unsigned long show = 30000 + (row - 1) * 1500 + (col - 1) * 600 + next(seed) % 6000;
+            show += col >= 20 && col <= 23 ? 15000 : 0;
+            need[1][row][col] = show;
+            need[0][row][col] = show + 8000;
+        }
+    }
+    setSupply(nominalMillivolts);
+
+    // measure every dot and polarity
+    unsigned int measured[2][rows + 1][columns + 1];
+    unsigned int base[2] = { 0xFFFF, 0xFFFF };
+    unsigned int longest = 0;
+
+    for ( uint8_t show = 0; show < 2; show++ )
+    {
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            for ( unsigned int col = 1; col <= columns; col++ )
+            {
+                measured[show][row][col] = measure(col, row, show);
+                base[show] = measured[show][row][col] < base[show] ? measured[show][row][col] : base[show];
+                longest = measured[show][row][col] > longest ? measured[show][row][col] : longest;
+            }
+        }
+    }
+
+    // fit: what every dot of a column needs goes into the column table, the rest of the worst dot into the row table
+    unsigned int excess[rows + 1][columns + 1];
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            unsigned int hide = measured[0][row][col] - base[0];
+            unsigned int show = measured[1][row][col] - base[1];
+            excess[row][col] = hide > show ? hide : show;
+        }
+    }
+    for ( unsigned int col = 1; col <= columns; col++ )
+    {
+        unsigned int extra = 0xFFFF;
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            extra = excess[row][col] < extra ? excess[row][col] : extra;
+        }
+        colExtra[col - 1] = extra;
+    }
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        unsigned int extra = 0;
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            extra = excess[row][col] - colExtra[col - 1] > extra ? excess[row][col] - colExtra[col - 1] : extra;
+        }
+        rowExtra[row - 1] = extra;
+    }
+
+    // margin of 10 %, rounded up
+    for ( unsigned int i = 0; i < rows; i++ )
+    {
+        rowExtra[i] = (rowExtra[i] * 11 + 9) / 10;
+    }
+    for ( unsigned int i = 0; i < columns; i++ )
+    {
+        colExtra[i] = (colExtra[i] * 11 + 9) / 10;
+    }
+    calibration.setPolarity((base[1] * 11 + 9) / 10, (base[0] * 11 + 9) / 10);
+    calibration.setRowTable(rowExtra);
+    calibration.setColumnTable(colExtra);
+    calibration.setVoltage(nominalMillivolts, nominalMillivolts);
+
+    unsigned long sum = 0;
+    for ( uint8_t show = 0; show < 2; show++ )
+    {
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            for ( unsigned int col = 1; col <= columns; col++ )
+            {
+                sum += calibration.getPulseLength(col, row, show);
+            }
+        }
+    }
+
+    printf("measured       %u to %u µs, base show %u µs, hide %u µs (with margin)\n", base[1] < base[0] ? base[1] : base[0], longest,
+        calibration.getPolarity(true), calibration.getPolarity(false));
+    printf("row table     ");
+    for ( unsigned int i = 0; i < rows; i++ )
+    {
+        printf(" %u", rowExtra[i]);
+    }
+    printf("\ncolumn table  ");
+    for ( unsigned int i = 0; i < columns; i++ )
+    {
+        printf(" %u", colExtra[i]);
+    }
+    printf("\naverage        %.1f µs per pulse with the calibration\n\n", sum / (2.0 * rows * columns));
+
+    unsigned int differences = 0;
+    unsigned long shortPulses = 0;
+    unsigned int globalMicros = (longest * 11 + 9) / 10;
+    char title[64];
+    Result result;
+
+    controller.setPulseCalibration(NULL);
+    controller.setPulseLength(100);
+    print("24.0 V, 100 µs for all dots", run());
+
+    controller.setPulseLength(globalMicros);
+    snprintf(title, sizeof(title), "24.0 V, %u µs for all dots", globalMicros);
+    print(title, run());
+
+    controller.setPulseCalibration(&calibration);
+    result = run();
+    print("24.0 V, calibrated", result);
+    differences += result.differences;
+    shortPulses += result.shortPulses;
+
+    // the calibration follows the supply voltage
+    const unsigned int supplies[] = { 26400, 21600 };
+    for ( uint8_t i = 0; i < 2; i++ )
+    {
+        setSupply(supplies[i]);
+
+        controller.setPulseCalibration(&calibration);
+        calibration.setSupplyVoltage(nominalMillivolts);
+        snprintf(title, sizeof(title), "%.1f V, calibrated for 24.0 V", supplies[i] / 1000.0);
+        print(title, run());
+
+        controller.setPulseCalibration(&calibration);
+        calibration.setSupplyVoltage(supplies[i]);
+        snprintf(title, sizeof(title), "%.1f V, calibrated, supply %.1f V", supplies[i] / 1000.0, supplies[i] / 1000.0);
+        result = run();
+        print(title, result);
+        differences += result.differences;
+        shortPulses += result.shortPulses;
+    }
+
+    return differences == 0 && shortPulses == 0 ? 0 : 1;
+}
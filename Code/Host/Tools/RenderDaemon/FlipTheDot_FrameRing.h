@@ -0,0 +1,107 @@
+/*
+ * FlipTheDot_FrameRing Class  -- Lock-free queue of frames from one renderer thread to one sender thread
+ *
+ * A ring of a fixed number of frame slots, allocated once. The producer claims a slot, draws into it and
+ * publishes it; the consumer takes the latest published frame and releases all older ones at the same time,
+ * so frames which the link had no time for get dropped instead of queued.
+ * Neither side ever waits for the other: claim() returns NULL while the ring is full (the renderer skips the
+ * frame and counts it), takeLatest() returns false while the ring is empty.
+ *
+ * Exactly one thread may produce and exactly one thread may consume.
+ */
+
+
+#ifndef FlipTheDot_FrameRing_h
+#define FlipTheDot_FrameRing_h
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <vector>
+
+
+class FlipTheDot_FrameRing
+{
+    public:
+        /**
+         * slots frames of frameSize bytes, one more slot is kept free to tell a full ring from an empty one
+         */
+        FlipTheDot_FrameRing(unsigned int slots, unsigned int frameSize)
+            : _slotCount(slots + 1), _frameSize(frameSize), _frames(_slotCount * frameSize), _stamps(_slotCount)
+        {
+        }
+
+        unsigned int getFrameSize() { return _frameSize; }
+
+        /**
+         * producer: slot for the next frame, NULL if the consumer has not released enough frames yet
+         */
+        uint8_t *claim()
+        {
+            unsigned int head = _head.load(std::memory_order_relaxed);
+            if ( _advance(head) == _tail.load(std::memory_order_acquire) )
+            {
+                _droppedCount++;
+                return NULL;
+            }
+            return &_frames[head * _frameSize];
+        }
+
+        /**
+         * producer: hand the claimed slot to the consumer, stamp is passed along (e.g. the render time)
+         */
+        void publish(uint64_t stamp)
+        {
+            unsigned int head = _head.load(std::memory_order_relaxed);
+            _stamps[head] = stamp;
+            _head.store(_advance(head), std::memory_order_release);
+            _publishedCount++;
+        }
+
+        /**
+         * consumer: copy the latest frame into frame and release it with all older frames,
+         * skipped counts the released frames which were never taken
+         */
+        bool takeLatest(uint8_t *frame, uint64_t &stamp, unsigned int &skipped)
+        {
+            unsigned int tail = _tail.load(std::memory_order_relaxed);
+            unsigned int head = _head.load(std::memory_order_acquire);
+            if ( tail == head )
+            {
+                return false;
+            }
+
+            unsigned int latest = head == 0 ? _slotCount - 1 : head - 1;
+            skipped = (head + _slotCount - tail) % _slotCount - 1;
+            memcpy(frame, &_frames[latest * _frameSize], _frameSize);
+            stamp = _stamps[latest];
+            _tail.store(head, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * producer side counters, read them after the producer stopped
+         */
+        unsigned long getPublishedCount() { return _publishedCount; }
+        unsigned long getDroppedCount() { return _droppedCount; }
+
+    protected:
+        unsigned int _advance(unsigned int index) { return index + 1 == _slotCount ? 0 : index + 1; }
+
+        unsigned int _slotCount;
+        unsigned int _frameSize;
+        std::vector<uint8_t> _frames;
+        std::vector<uint64_t> _stamps;
+
+        // the producer side and the consumer side (next slot to take) on separate cache lines
+        char _paddingHead[64];
+        std::atomic<unsigned int> _head{0};
+        unsigned long _publishedCount = 0;
+        unsigned long _droppedCount = 0;
+        char _paddingTail[64];
+        std::atomic<unsigned int> _tail{0};
+        char _paddingEnd[64];
+};
+
+
+#endif // FlipTheDot_FrameRing_h
@@ -0,0 +1,486 @@
+/*
+  RenderDaemon
+  Render content in several threads on a Linux host and stream it to a FlipTheDot_FrameReceiver (example "FrameStream")
+  over a serial connection or a pseudo terminal (see daemon.sh).
+
+  Every renderer thread owns a strip of columns of the panel and draws at its own rate into its own
+  FlipTheDot_FrameRing, which never blocks it. The sender thread takes the latest frame of every ring (older ones are
+  coalesced), combines the strips and, when the previous frame got acknowledged ('A'), encodes the difference to it
+  with FlipTheDot_FrameEncoder. A broken frame ('N') or a missing acknowledgement (timeout) makes the next frame a
+  full frame. Only one frame is on the link at any time, so a stalled link holds one encoded frame and the rings,
+  nothing else, and a stalled renderer just keeps its strip unchanged.
+
+    renderer 0   bouncing bar,              10 frames per second
+    renderer 1   counter, one bit per row,  30 frames per second
+    renderer 2   falling dots,             100 frames per second
+    renderer 3   bouncing bar,             250 frames per second
+
+  Usage: RenderDaemon <device> [--baud 115200] [--seconds 3] [--renderers 3] [--slots 4] [--timeout 200]
+                               [--stall ms] [--columns 28] [--rows 13]
+    --stall ms   renderer 0 stops for ms milliseconds once per second
+
+  Exit code 1 if the last frame did not get acknowledged.
+
+  Build:
+    g++ -std=c++11 -O2 -pthread -I Code/Host/Tools/FrameStream Code/Host/Tools/RenderDaemon/RenderDaemon.cpp
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "FlipTheDot_FrameEncoder.h"
+#include "FlipTheDot_FrameRing.h"
+
+
+const unsigned int maxRenderers = 4;
+const unsigned int renderRates[maxRenderers] = { 10, 30, 100, 250 };
+
+unsigned int columns = 28;
+unsigned int rows = 13;
+unsigned int rendererCount = 3;
+unsigned int stallMillis = 0;
+
+std::atomic<bool> isRendering(true);
+
+
+uint64_t nowNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+void setDot(uint8_t *frame, unsigned int col, unsigned int row, bool show)
+{
+    unsigned int index = (row - 1) * ((columns + 7) / 8) + (col - 1) / 8;
+    uint8_t mask = 1 << ((col - 1) % 8);
+    frame[index] = show ? frame[index] | mask : frame[index] & ~mask;
+}
+
+bool getDot(const uint8_t *frame, unsigned int col, unsigned int row)
+{
+    return ( frame[(row - 1) * ((columns + 7) / 8) + (col - 1) / 8] >> ((col - 1) % 8) ) & 1;
+}
+
+
+/**
+ * first and last column of the strip of a renderer
+ */
+void getStrip(unsigned int renderer, unsigned int &first, unsigned int &last)
+{
+    first = renderer * columns / rendererCount + 1;
+    last = (renderer + 1) * columns / rendererCount;
+}
+
+
+/**
+ * draw frame number of a renderer into its strip, the rest of the frame stays hidden
+ */
+void draw(unsigned int renderer, unsigned long number, uint8_t *frame)
+{
+    unsigned int first, last;
+    getStrip(renderer, first, last);
+    unsigned int width = last - first + 1;
+
+    memset(frame, 0, (columns + 7) / 8 * rows);
+    for ( unsigned int col = first; col <= last; col++ )
+    {
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            bool show = false;
+            switch ( renderer % 3 )
+            {
+                case 0:
+                {
+                    unsigned int position = number % (2 * width - 2 > 0 ? 2 * width - 2 : 1);
+                    show = col - first == (position < width ? position : 2 * width - 2 - position);
+                    break;
+                }
+                case 1:
+                    show = ( (number >> (row - 1)) & 1 ) && (col - first) % 2 == 0;
+                    break;
+                default:
+                    show = (number * (1 + col % 3) / 3 + col * 5) % rows == row - 1;
+            }
+            setDot(frame, col, row, show);
+        }
+    }
+}
+
+
+void render(unsigned int renderer, FlipTheDot_FrameRing *ring)
+{
+    uint64_t interval = 1000000000ULL / renderRates[renderer];
+    uint64_t next = nowNanos();
+    uint64_t nextStall = next + 1000000000ULL;
+    unsigned long number = 0;
+
+    while ( isRendering )
+    {
+        uint8_t *frame = ring->claim();
+        if ( frame != NULL )
+        {
+            draw(renderer, number, frame);
+            ring->publish(nowNanos());
+        }
+        number++;
+
+        // a renderer which hangs, e.g. waiting for a slow data source
+        if ( renderer == 0 && stallMillis > 0 && nowNanos() >= nextStall )
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(stallMillis));
+            nextStall = nowNanos() + 1000000000ULL;
+        }
+
+        next += interval;
+        uint64_t now = nowNanos();
+        if ( next > now )
+        {
+            std::this_thread::sleep_for(std::chrono::nanoseconds(next - now));
+        }
+        else
+        {
+            next = now;
+        }
+    }
+}
+
+
+struct LinkStatistics
+{
+    unsigned long sent[maxRenderers];
+    unsigned long coalesced[maxRenderers];
+    unsigned long frames;
+    unsigned long fullFrames;
+    unsigned long bytes;
+    unsigned long acks;
+    unsigned long errors;
+    unsigned long timeouts;
+    uint64_t latencySum;
+    uint64_t latencyMax;
+    unsigned long latencyCount;
+    size_t pendingMax;
+    bool isLastAcknowledged;
+};
+
+
+class Sender
+{
+    public:
+        Sender(int fd, FlipTheDot_FrameRing **rings, unsigned long baud, unsigned int timeoutMillis)
+            : _fd(fd), _rings(rings), _byteNanos(10000000000ULL / baud), _timeoutNanos(timeoutMillis * 1000000ULL), _encoder(columns, rows),
+              _panel(_encoder.getFrameSize(), 0), _strip(_encoder.getFrameSize()), _acknowledged(_encoder.getFrameSize())
+        {
+            memset(&statistics, 0, sizeof(statistics));
+        }
+
+        /**
+         * run until stop() got called and the last frame got acknowledged (or timed out)
+         */
+        void run()
+        {
+            for ( ;; )
+            {
+                _collect();
+                _receive();
+
+                if ( _isWaiting && _pending.empty() && nowNanos() - _sentNanos > _timeoutNanos )
+                {
+                    // bytes got lost without a broken frame, e.g. the sync byte
+                    _isWaiting = false;
+                    _isValid = false;
+                    _encoder.invalidate();
+                    statistics.timeouts++;
+                    if ( _isStopping )
+                    {
+                        break;
+                    }
+                }
+
+                // a pseudo terminal takes the bytes faster than a serial port, wait for the line like a real one would
+                if ( !_isWaiting && _pending.empty() && nowNanos() >= _lineNanos )
+                {
+                    if ( _isChanged || !_isValid )
+                    {
+                        _encode();
+                    }
+                    else if ( _isStopping )
+                    {
+                        statistics.isLastAcknowledged = true;
+                        break;
+                    }
+                }
+
+                _write();
+
+                struct pollfd events = { _fd, (short)(POLLIN | (_pending.empty() ? 0 : POLLOUT)), 0 };
+                poll(&events, 1, 1);
+            }
+        }
+
+        void stop() { _isStopping = true; }
+
+        LinkStatistics statistics;
+
+    protected:
+        /**
+         * take the latest frame of every renderer into its strip of the panel frame
+         */
+        void _collect()
+        {
+            uint64_t stamp;
+            unsigned int skipped;
+
+            for ( unsigned int i = 0; i < rendererCount; i++ )
+            {
+                if ( !_rings[i]->takeLatest(_strip.data(), stamp, skipped) )
+                {
+                    continue;
+                }
+                // a frame which is still waiting for the link gets replaced
+                statistics.coalesced[i] += skipped + (_isWaitingStrip[i] ? 1 : 0);
+                _isWaitingStrip[i] = true;
+                _stamp = std::max(_stamp, stamp);
+
+                unsigned int first, last;
+                getStrip(i, first, last);
+                for ( unsigned int row = 1; row <= rows; row++ )
+                {
+                    for ( unsigned int col = first; col <= last; col++ )
+                    {
+                        setDot(_panel.data(), col, row, getDot(_strip.data(), col, row));
+                    }
+                }
+                _isChanged = true;
+            }
+        }
+
+        void _receive()
+        {
+            uint8_t answers[64];
+            ssize_t count = read(_fd, answers, sizeof(answers));
+
+            for ( ssize_t i = 0; i < count; i++ )
+            {
+                if ( answers[i] == 'A' && _isWaiting )
+                {
+                    _isWaiting = false;
+                    statistics.acks++;
+
+                    // from drawing the latest strip of the frame until the panel received it
+                    if ( _sentStamp > 0 )
+                    {
+                        uint64_t latency = nowNanos() - _sentStamp;
+                        statistics.latencySum += latency;
+                        statistics.latencyMax = std::max(statistics.latencyMax, latency);
+                        statistics.latencyCount++;
+                    }
+                }
+                else if ( answers[i] == 'N' )
+                {
+                    _isWaiting = false;
+                    _isValid = false;
+                    _encoder.invalidate();
+                    statistics.errors++;
+                }
+            }
+        }
+
+        /**
+         * encode the panel frame, as difference to the acknowledged one if it is valid
+         */
+        void _encode()
+        {
+            if ( _isValid && memcmp(_panel.data(), _acknowledged.data(), _panel.size()) == 0 )
+            {
+                _isChanged = false;
+                return;
+            }
+
+            for ( unsigned int i = 0; i < rendererCount; i++ )
+            {
+                statistics.sent[i] += _isWaitingStrip[i] ? 1 : 0;
+                _isWaitingStrip[i] = false;
+            }
+            statistics.fullFrames += _encoder.encode(_panel.data(), _pending);
+            statistics.frames++;
+            memcpy(_acknowledged.data(), _panel.data(), _panel.size());
+            _sentStamp = _stamp;
+            _lineNanos = std::max(nowNanos(), _lineNanos) + _pending.size() * _byteNanos;
+            _isChanged = false;
+            _isValid = true;
+            _isWaiting = true;
+            statistics.pendingMax = std::max(statistics.pendingMax, _pending.size());
+        }
+
+        void _write()
+        {
+            if ( _pending.empty() )
+            {
+                return;
+            }
+
+            ssize_t written = write(_fd, _pending.data(), _pending.size());
+            if ( written > 0 )
+            {
+                _pending.erase(_pending.begin(), _pending.begin() + written);
+                statistics.bytes += written;
+                if ( _pending.empty() )
+                {
+                    _sentNanos = nowNanos();
+                }
+            }
+            else if ( written < 0 && errno != EAGAIN && errno != EINTR )
+            {
+                perror("write");
+                exit(1);
+            }
+        }
+
+        int _fd;
+        FlipTheDot_FrameRing **_rings;
+        uint64_t _byteNanos;
+        uint64_t _timeoutNanos;
+        FlipTheDot_FrameEncoder _encoder;
+
+        // combined strips, the frame which is sent or acknowledged and the bytes which are not written yet
+        std::vector<uint8_t> _panel;
+        std::vector<uint8_t> _strip;
+        std::vector<uint8_t> _acknowledged;
+        std::vector<uint8_t> _pending;
+
+        bool _isWaitingStrip[maxRenderers] = {};
+        bool _isChanged = false;
+        bool _isValid = false;
+        bool _isWaiting = false;
+        std::atomic<bool> _isStopping{false};
+
+        // render time of the latest strip and of the frame on the link, end of the last write,
+        // time when the line has transmitted all written bytes (10 bits per byte)
+        uint64_t _stamp = 0;
+        uint64_t _sentStamp = 0;
+        uint64_t _sentNanos = 0;
+        uint64_t _lineNanos = 0;
+};
+
+
+speed_t getSpeed(unsigned long baud)
+{
+    switch ( baud )
+    {
+        case 9600:    return B9600;
+        case 19200:   return B19200;
+        case 38400:   return B38400;
+        case 57600:   return B57600;
+        case 230400:  return B230400;
+        case 460800:  return B460800;
+        case 500000:  return B500000;
+        case 1000000: return B1000000;
+        default:      return B115200;
+    }
+}
+
+
+int main(int argc, char **argv)
+{
+    if ( argc < 2 || argv[1][0] == '-' )
+    {
+        fprintf(stderr, "Usage: %s <device> [--baud 115200] [--seconds 3] [--renderers 3] [--slots 4] [--timeout 200]\n"
+                        "                   [--stall ms] [--columns 28] [--rows 13]\n", argv[0]);
+        return 2;
+    }
+
+    unsigned long baud = 115200;
+    double seconds = 3;
+    unsigned int slots = 4;
+    unsigned int timeoutMillis = 200;
+
+    for ( int i = 2; i + 1 < argc; i += 2 )
+    {
+        if ( strcmp(argv[i], "--baud") == 0 )           baud = strtoul(argv[i + 1], NULL, 10);
+        else if ( strcmp(argv[i], "--seconds") == 0 )   seconds = atof(argv[i + 1]);
+        else if ( strcmp(argv[i], "--renderers") == 0 ) rendererCount = std::min((unsigned int)atoi(argv[i + 1]), maxRenderers);
+        else if ( strcmp(argv[i], "--slots") == 0 )     slots = atoi(argv[i + 1]);
+        else if ( strcmp(argv[i], "--timeout") == 0 )   timeoutMillis = atoi(argv[i + 1]);
+        else if ( strcmp(argv[i], "--stall") == 0 )     stallMillis = atoi(argv[i + 1]);
+        else if ( strcmp(argv[i], "--columns") == 0 )   columns = atoi(argv[i + 1]);
+        else if ( strcmp(argv[i], "--rows") == 0 )      rows = atoi(argv[i + 1]);
+    }
+    rendererCount = std::max(rendererCount, 1U);
+
+    int fd = open(argv[1], O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if ( fd < 0 )
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    // raw 8N1
+    struct termios settings;
+    if ( tcgetattr(fd, &settings) == 0 )
+    {
+        cfmakeraw(&settings);
+        cfsetspeed(&settings, getSpeed(baud));
+        tcsetattr(fd, TCSANOW, &settings);
+    }
+
+    unsigned int frameSize = (columns + 7) / 8 * rows;
+    FlipTheDot_FrameRing *rings[maxRenderers];
+    for ( unsigned int i = 0; i < rendererCount; i++ )
+    {
+        rings[i] = new FlipTheDot_FrameRing(slots, frameSize);
+    }
+
+    Sender sender(fd, rings, baud, timeoutMillis);
+    std::thread senderThread(&Sender::run, &sender);
+    std::thread renderThreads[maxRenderers];
+    for ( unsigned int i = 0; i < rendererCount; i++ )
+    {
+        renderThreads[i] = std::thread(render, i, rings[i]);
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds((long)(seconds * 1000)));
+
+    // the last frame of every renderer still gets sent
+    isRendering = false;
+    for ( unsigned int i = 0; i < rendererCount; i++ )
+    {
+        renderThreads[i].join();
+    }
+    sender.stop();
+    senderThread.join();
+
+    const LinkStatistics &statistics = sender.statistics;
+    for ( unsigned int i = 0; i < rendererCount; i++ )
+    {
+        unsigned int first, last;
+        getStrip(i, first, last);
+        printf("renderer %u: columns %2u - %2u, %5lu frames (%5.1f fps), %5lu sent, %5lu coalesced, %lu dropped (ring full)\n",
+            i, first, last, rings[i]->getPublishedCount(), rings[i]->getPublishedCount() / seconds, statistics.sent[i],
+            statistics.coalesced[i], rings[i]->getDroppedCount());
+    }
+    printf("link: %lu frames (%lu full, %.1f fps), %lu bytes (%.1f bytes/frame, line %.0f %% used), %lu acknowledged, %lu errors, "
+           "%lu timeouts, latency %.1f ms avg / %.1f ms max, %zu bytes pending max, %s\n",
+        statistics.frames, statistics.fullFrames, statistics.frames / seconds, statistics.bytes,
+        statistics.frames > 0 ? (double)statistics.bytes / statistics.frames : 0.0, 100.0 * statistics.bytes * 10 / baud / seconds,
+        statistics.acks, statistics.errors, statistics.timeouts,
+        statistics.latencyCount > 0 ? statistics.latencySum / 1e6 / statistics.latencyCount : 0.0, statistics.latencyMax / 1e6,
+        statistics.pendingMax, statistics.isLastAcknowledged ? "last frame acknowledged" : "last frame NOT acknowledged");
+
+    close(fd);
+    for ( unsigned int i = 0; i < rendererCount; i++ )
+    {
+        delete rings[i];
+    }
+    return statistics.isLastAcknowledged ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#!/bin/bash
+# Stream the renderers of RenderDaemon thru a pseudo terminal into FrameDevice (simulated panel, see Code/Host/Tools/FrameStream).
+# Runs with the asynchronous and the blocking refresh, with a renderer which hangs and with a device which stops reading.
+# Usage: ./daemon.sh [baud] [seconds] [c++ compiler]
+
+cd "$(dirname "$0")"
+
+baud=${1:-115200}
+seconds=${2:-3}
+compiler=${3:-g++}
+libraries=../../../Arduino/libraries
+build=$(mktemp -d)
+
+$compiler -std=c++11 -O2 -pthread -I../FrameStream RenderDaemon.cpp -o "$build/daemon" || exit 1
+$compiler -std=c++11 -O2 -I../../Arduino -I../../Simulator -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController \
+    ../FrameStream/FrameDevice.cpp -o "$build/device" || exit 1
+
+result=0
+run() {
+    local title=$1 mode=$2 stall=$3
+    shift 3
+
+    coproc device { "$build/device" "$baud" "$mode" $stall; }
+    # bash closes the descriptors of the coprocess when it exits, read thru a copy
+    local out pid=$device_PID
+    exec {out}<&"${device[0]}"
+    read -r terminal <&$out
+
+    echo "== $title"
+    "$build/daemon" "$terminal" --baud "$baud" --seconds "$seconds" "$@" || result=1
+    local report
+    report=$(cat <&$out)
+    exec {out}<&-
+    echo "$report"
+    wait $pid || result=1
+
+    # the result line of the device is the evidence of the run
+    if ! grep -q " panel " <<< "$report"; then
+        echo "no result from the device"
+        result=1
+    fi
+}
+
+run "async" async ""
+run "blocking" blocking ""
+run "async, renderer 0 hangs for 500 ms every second" async "" --stall 500
+run "async, device stops reading for 1 s" async stall
+
+rm -r "$build"
+exit $result
@@ -0,0 +1,184 @@
+/*
+  SchedulerDemo
+  Run a clock and an animation side by side on the simulated 28x13 panel (wiring of the example "FixedDefault") with
+  FlipTheDot_Scheduler and a pulse rate limit of 2000 dots per second, for 30 seconds of virtual time each:
+
+    clock        region 12x7 at column 17, row 4, two digits which change on every second
+    animation    region 16x13 at column 1, dots falling down, a new frame every 100 ms (50 ms after the clock)
+
+  Every scene runs once in call order (the same deadline of one second and priority for both regions, so the
+  earliest deadline is the region which got scheduled first) and once with the deadlines of the content (clock
+  20 ms with priority 1, animation 100 ms). The "busy" scene changes about 60 dots per animation frame, the "overload" scene inverts the whole
+  animation region (208 dots) on every frame, more than the rate limit allows.
+  After every scene the panel gets compared with the frame buffer.
+  Exit code 1 if any dot differs, the clock misses a second with deadlines or the panel counted too short or
+  conflicting pulses.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/SchedulerDemo/SchedulerDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Scheduler.h"
+#include "FlipTheDot_Blitter.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+const unsigned int seconds = 30;
+const unsigned long clockDeadline = 20000;
+const unsigned long frameDeadline = 100000;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+FlipTheDot_Blitter blitter(controller);
+
+unsigned long seed = 1;
+
+
+unsigned int nextRandom(unsigned int range)
+{
+    seed = seed * 1103515245UL + 12345UL;
+    return (seed >> 16) % range;
+}
+
+
+void drawDigit(unsigned int col, unsigned int digit)
+{
+    char text[2] = { (char)('0' + digit), '\0' };
+    blitter.drawText(text, col, 4, FlipTheDot_Font5x7);
+}
+
+
+/**
+ * next frame of the animation: every dot falls one row, new dots on top
+ * overload: invert the whole region instead
+ */
+void drawFrame(boolean overload)
+{
+    for ( unsigned int col = 1; col <= 16; col++ )
+    {
+        for ( unsigned int row = rows; row >= 1; row-- )
+        {
+            if ( overload )
+            {
+                controller.setDot(col, row, !controller.getDot(col, row));
+            }
+            else
+            {
+                controller.setDot(col, row, row > 1 ? controller.getDot(col, row - 1) : nextRandom(3) == 0);
+            }
+        }
+    }
+}
+
+
+/**
+ * returns the number of seconds which the clock showed later than 20 ms
+ */
+unsigned int run(const char *name, boolean overload, boolean deadlines)
+{
+    FlipTheDot_Scheduler scheduler(controller);
+    int clock = scheduler.addRegion(17, 4, 12, 7, deadlines ? 1 : 0);
+    int animation = scheduler.addRegion(1, 1, 16, 13, 0);
+    scheduler.setPulseRate(2000, 10);
+
+    controller.fill(false);
+    controller.flush();
+    panel.resetStatistics();
+
+    unsigned long start = micros();
+    unsigned long clockScheduled = 0;
+    unsigned long clockLatency = 0;
+    unsigned int clockLate = 0;
+    unsigned int second = 0;
+    unsigned int step = 0;
+
+    while ( micros() - start < seconds * 1000000UL )
+    {
+        unsigned long now = micros() - start;
+
+        if ( now >= step * 100000UL + 50000 )
+        {
+            drawFrame(overload);
+            scheduler.schedule(animation, deadlines ? frameDeadline : 1000000);
+            step++;
+        }
+        if ( now >= second * 1000000UL )
+        {
+            drawDigit(18, second / 10 % 10);
+            drawDigit(24, second % 10);
+            scheduler.schedule(clock, deadlines ? clockDeadline : 1000000);
+            clockScheduled = micros();
+            second++;
+        }
+
+        boolean wasPending = scheduler.isPending(clock);
+        scheduler.update();
+        if ( wasPending && !scheduler.isPending(clock) )
+        {
+            unsigned long latency = micros() - clockScheduled;
+            clockLatency = latency > clockLatency ? latency : clockLatency;
+            clockLate += latency > clockDeadline ? 1 : 0;
+        }
+
+        // the rest of the loop
+        delayMicroseconds(200);
+    }
+
+    // show the rest without limit
+    scheduler.setPulseRate(0);
+    scheduler.update();
+
+    const FlipTheDot_SchedulerStatistics &frames = scheduler.getStatistics(animation);
+    printf("%-8s %-10s clock: %2u of %u seconds later than 20 ms, max %5.1f ms   animation: %3lu of %3lu frames completed, "
+        "%3lu replaced, %3lu missed, max latency %6.1f ms\n",
+        name, deadlines ? "deadlines" : "call order", clockLate, second, clockLatency / 1000.0,
+        frames.completed, frames.scheduled, frames.replaced, frames.missed, frames.maxLatencyMicros / 1000.0);
+
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(col, row) != controller.getDot(col, row) ? 1 : 0;
+        }
+    }
+    if ( differences > 0 || panel.getShortPulseCount() > 0 || panel.getConflictCount() > 0 )
+    {
+        printf("%u dots differ, %lu short pulses, %lu conflicts\n", differences, panel.getShortPulseCount(), panel.getConflictCount());
+        return seconds + 1;
+    }
+    return clockLate;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    controller.setFrameBuffer(frame, shadow);
+
+    unsigned int result = 0;
+    run("busy", false, false);
+    result += run("busy", false, true);
+    run("overload", true, false);
+    result += run("overload", true, true);
+
+    return result == 0 ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/*
+  ShiftRegisterDemo
+  Drive the simulated 84x13 panel of the example "FixedMulti" thru a chain of two 74HC595 shift registers
+  (FlipTheDot_FP2800aShiftRegister) on the mocked SPI, wired like the example "Basics/ShiftRegister":
+
+    chain output  0 - 4   column A0, A1, A2, B0, B1      chain output  9 - 13  row A0, A1, A2, B0, B1
+    chain output  5       column data                    chain output 14       row enable reset
+    chain output  6 - 8   column enable of IC 1 - 3      chain output 15       row enable set
+
+  Only the latch pin (10), the output enable pin (9) and the SPI pins are used on the microcontroller.
+  The demo flushes the whole panel and random frames, once with one column IC at a time and once with all three
+  column ICs pulsed together, and compares the panel with the frame buffer.
+  Exit code 1 if any dot differs or the SPI, the chain or the panel counted errors.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/ShiftRegisterDemo/ShiftRegisterDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "SPI.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_ShiftRegisterSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aMulti.h"
+#include "FlipTheDot_FP2800aShiftRegister.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+const unsigned int columns = 84;
+const unsigned int rows = 13;
+const unsigned int frames = 20;
+
+const uint8_t pinLatch = 10;
+const uint8_t pinOutputEnable = 9;
+
+// the panel and the chain have to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+FlipTheDot_ShiftRegisterSimulator chain(2, pinLatch, pinOutputEnable);
+
+uint8_t registers[2];
+FlipTheDot_FP2800aShiftRegister shiftRegister(registers, 2, pinLatch, pinOutputEnable);
+
+unsigned int columnEnableList[] = { 6, 7, 8 };
+FlipTheDot_FP2800aMulti columnController(columnEnableList, 3, 5, 0, 1, 2, 3, 4, 100, &shiftRegister);
+FlipTheDot_FP2800aFixed rowController(14, 15, 9, 10, 11, 12, 13, 100, &shiftRegister);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+unsigned int countDifferences()
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(col, row) != controller.getDot(col, row) ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+/**
+ * flush the whole panel and random frames, returns the number of dots which differ afterwards
+ */
+unsigned int run(const char *title)
+{
+    unsigned long transfers = shiftRegister.getTransferCount();
+    unsigned long bytes = FlipTheDot_Host_spi.bytes;
+    unsigned long long start = FlipTheDot_Host_nanos;
+    unsigned int differences = 0;
+
+    panel.resetStatistics();
+    controller.invalidate();
+    controller.flush();
+
+    for ( unsigned int i = 0; i < frames; i++ )
+    {
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            for ( unsigned int col = 1; col <= columns; col++ )
+            {
+                controller.setDot(col, row, random(2) == 1);
+            }
+        }
+        controller.flush();
+        differences += countDifferences();
+    }
+
+    unsigned long pulses = panel.getPulseCount();
+    printf("%-28s %6lu pulses, %6lu transfers (%.2f per pulse), %7lu SPI bytes, %8.2f ms/frame, %u dots differ\n",
+        title, pulses, shiftRegister.getTransferCount() - transfers, (double)(shiftRegister.getTransferCount() - transfers) / pulses,
+        FlipTheDot_Host_spi.bytes - bytes, (FlipTheDot_Host_nanos - start) / 1e6 / (frames + 1), differences);
+    return differences;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, chain.pin(6), chain.pin(5), chain.pin(0), chain.pin(1), chain.pin(2), chain.pin(3), chain.pin(4));
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 28, chain.pin(7), chain.pin(5), chain.pin(0), chain.pin(1), chain.pin(2), chain.pin(3), chain.pin(4));
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 56, chain.pin(8), chain.pin(5), chain.pin(0), chain.pin(1), chain.pin(2), chain.pin(3), chain.pin(4));
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, chain.pin(14), FlipTheDot_PanelSimulator::FIXED_LOW, chain.pin(9), chain.pin(10), chain.pin(11), chain.pin(12), chain.pin(13));
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, chain.pin(15), FlipTheDot_PanelSimulator::FIXED_HIGH, chain.pin(9), chain.pin(10), chain.pin(11), chain.pin(12), chain.pin(13));
+
+    randomSeed(7);
+    controller.setFrameBuffer(frame, shadow);
+
+    unsigned int differences = run("one column IC at a time");
+    columnController.setMaxEnabledChips(3);
+    differences += run("three column ICs together");
+
+    printf("SPI: %lu transactions, %lu bytes, %lu errors; chain: %lu latches, %lu errors; panel: %lu short pulses, %lu conflicts\n",
+        FlipTheDot_Host_spi.transactions, FlipTheDot_Host_spi.bytes, FlipTheDot_Host_spi.errors, chain.getLatchCount(), chain.getErrorCount(),
+        panel.getShortPulseCount(), panel.getConflictCount());
+
+    bool isValid = differences == 0 && FlipTheDot_Host_spi.errors == 0 && chain.getErrorCount() == 0
+        && chain.getLatchCount() == shiftRegister.getTransferCount() && panel.getShortPulseCount() == 0 && panel.getConflictCount() == 0;
+    return isValid ? 0 : 1;
+}
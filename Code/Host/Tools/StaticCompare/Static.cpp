@@ -0,0 +1,21 @@
+/*
+  StaticCompare: FixedMulti wiring with FlipTheDot_FP2800aStatic
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_FP2800aStatic.h"
+#include "FlipTheDot_ColumnRowControllerStatic.h"
+#include "Sweep.h"
+
+
+FlipTheDot_FP2800aStatic< FlipTheDot_FP2800aPinsFixed<A0, 2>, 3, 4, 5, 6, 7 > rowController;
+FlipTheDot_FP2800aStatic< FlipTheDot_FP2800aPinsMulti<8, A1, A2, A3>, 9, 10, 11, 12, 13 > columnController;
+
+FlipTheDot_ColumnRowControllerStatic< decltype(columnController), decltype(rowController) > controller(columnController, rowController);
+
+
+int main()
+{
+    return sweep(controller, 84, 13);
+}
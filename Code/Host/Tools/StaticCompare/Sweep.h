@@ -0,0 +1,44 @@
+/*
+  Shared part of the StaticCompare programs: the row and column sweep of the example "FixedMulti"
+  with a checksum of all pin states, the digitalWrite calls and the measured host time per flip.
+  The host time includes the bookkeeping of the Arduino.h stand-in, which is the same for both variants.
+ */
+
+
+#include <stdio.h>
+#include <time.h>
+
+
+const unsigned int sweeps = 2000;
+
+template <class Controller>
+int sweep(Controller &controller, unsigned int cols, unsigned int rows)
+{
+    unsigned long checksum = 0;
+    bool dataStatus = true;
+
+    FlipTheDot_Host_calls.digitalWrite = 0;
+
+    timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for ( unsigned int i = 0; i < sweeps; i++ )
+    {
+        for ( unsigned int row = 1; row <= rows; row++ )
+        {
+            for ( unsigned int col = 1; col <= cols; col++ )
+            {
+                controller.flip(col, row, dataStatus);
+                checksum = checksum * 31 + FlipTheDot_Host_PORT[PB] + (FlipTheDot_Host_PORT[PC] << 8) + (FlipTheDot_Host_PORT[PD] << 16);
+            }
+        }
+        dataStatus = !dataStatus;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+    printf("checksum %08lx  %.1f digitalWrite and %.1f ns host time per flip\n", checksum & 0xFFFFFFFF,
+        (double)FlipTheDot_Host_calls.digitalWrite / (sweeps * cols * rows), ns / (sweeps * cols * rows));
+    return 0;
+}
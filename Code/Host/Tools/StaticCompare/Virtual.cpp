@@ -0,0 +1,24 @@
+/*
+  StaticCompare: FixedMulti wiring with the virtual class hierarchy
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_FP2800aMulti.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "Sweep.h"
+
+
+unsigned int columnEnableList[] = { A1, A2, A3 };
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800aMulti columnController(columnEnableList, 3, 8, 9, 10, 11, 12, 13);
+
+FlipTheDot_ColumnRowController controller(columnController, rowController, 84, 13);
+
+
+int main()
+{
+    return sweep(controller, controller.getColCount(), controller.getRowCount());
+}
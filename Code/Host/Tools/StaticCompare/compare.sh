@@ -0,0 +1,32 @@
+#!/bin/bash
+# Build the FixedMulti sweep with the virtual classes and with FlipTheDot_FP2800aStatic,
+# then compare the pin states, the code size and the host time per flip.
+# Usage: ./compare.sh [c++ compiler]
+
+cd "$(dirname "$0")"
+
+compiler=${1:-g++}
+libraries=../../../Arduino/libraries
+flags="-std=c++11 -Os -I../../Arduino -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController"
+build=$(mktemp -d)
+
+for variant in Virtual Static ; do
+	$compiler $flags -c $variant.cpp -o "$build/$variant.o" || exit 1
+	$compiler "$build/$variant.o" -o "$build/$variant" || exit 1
+done
+
+echo "code size (text data bss of the object file):"
+cd "$build" && size Virtual.o Static.o | awk 'NR > 1 { printf "  %-10s %6d %6d %6d\n", $6, $1, $2, $3 }' && cd - > /dev/null
+
+echo "pin state checksum and host time:"
+virtual=$("$build/Virtual")
+static=$("$build/Static")
+echo "  Virtual    $virtual"
+echo "  Static     $static"
+
+rm -r "$build"
+
+if [[ "$(echo $virtual | cut -d' ' -f2)" != "$(echo $static | cut -d' ' -f2)" ]] ; then
+	echo "pin states differ"
+	exit 1
+fi
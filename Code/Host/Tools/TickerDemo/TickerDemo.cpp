@@ -0,0 +1,163 @@
+/*
+  TickerDemo
+  Scroll a text over the simulated 28x13 panel with the wiring of the example "FixedDefault" in four ways:
+
+    redraw + invalidate   draw every step into the frame buffer and pulse all dots (invalidate + flush)
+    redraw + flush        draw every step into the frame buffer, flush() pulses the changed dots
+    ticker + frame buffer FlipTheDot_Ticker writes the changed dots into the frame buffer and flushes them
+    ticker                FlipTheDot_Ticker without frame buffer, flipColumn(...) for the changed dots
+
+  After every step the panel gets compared with the expected text position.
+  Exit code 1 if any dot differs or the panel counted too short or conflicting pulses.
+
+  Build:
+    g++ -std=c++11 -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/TickerDemo/TickerDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+#include "FlipTheDot_Ticker.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+const unsigned int top = 4;
+const unsigned int steps = 150;
+
+const char text[] PROGMEM = "Bus 42 Hbf";
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t window[columns];
+
+
+/**
+ * column k of the scrolling text, the text repeats after a gap of the panel width
+ */
+uint8_t streamColumn(long k)
+{
+    long length = strlen(text) * 6;
+
+    if ( k < 0 || k % (length + columns) >= length )
+    {
+        return 0;
+    }
+    k %= length + columns;
+
+    uint8_t code = text[k / 6];
+    uint8_t bits = 0;
+    for ( unsigned int y = 0; y < 7 && k % 6 != 5; y++ )
+    {
+        // the built-in font has one byte per glyph row
+        bits |= ( (pgm_read_byte(&FlipTheDot_Font5x7_DATA[(code - 32) * 7 + y]) >> (k % 6)) & 1 ) << y;
+    }
+    return bits;
+}
+
+
+/**
+ * expected state of a dot after the given number of steps
+ */
+bool expected(unsigned int step, unsigned int col, unsigned int row)
+{
+    if ( row < top || row >= top + 7 )
+    {
+        return false;
+    }
+    return (streamColumn((long)step - columns + col - 1) >> (row - top)) & 1;
+}
+
+
+unsigned int countDifferences(unsigned int step)
+{
+    unsigned int differences = 0;
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            differences += panel.getDot(col, row) != expected(step, col, row) ? 1 : 0;
+        }
+    }
+    return differences;
+}
+
+
+/**
+ * blank the panel, then scroll the text with the given method, returns the number of differing dots
+ */
+unsigned int run(const char *title, int mode)
+{
+    controller.setFrameBuffer(frame, shadow);
+    controller.fill(false);
+    controller.flush();
+    if ( mode == 3 )
+    {
+        controller.setFrameBuffer(NULL, NULL);
+    }
+
+    FlipTheDot_Ticker ticker(controller, window, FlipTheDot_Font5x7, top);
+    ticker.setText_P(text);
+
+    panel.resetStatistics();
+    unsigned long long start = FlipTheDot_Host_nanos;
+    unsigned int differences = 0;
+
+    for ( unsigned int step = 1; step <= steps; step++ )
+    {
+        if ( mode < 2 )
+        {
+            for ( unsigned int row = 1; row <= rows; row++ )
+            {
+                for ( unsigned int col = 1; col <= columns; col++ )
+                {
+                    controller.setDot(col, row, expected(step, col, row));
+                }
+            }
+            if ( mode == 0 )
+            {
+                controller.invalidate();
+            }
+            controller.flush();
+        }
+        else
+        {
+            ticker.update();
+        }
+        differences += countDifferences(step);
+    }
+
+    double msPerStep = (FlipTheDot_Host_nanos - start) / 1e6 / steps;
+    printf("%-22s %7.1f dots/step %8.2f ms/step %8.1f steps/s, %u dots differ\n", title,
+        (double)panel.getPulseCount() / steps, msPerStep, 1000 / msPerStep, differences);
+    return differences;
+}
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    unsigned int differences = run("redraw + invalidate", 0);
+    differences += run("redraw + flush", 1);
+    differences += run("ticker + frame buffer", 2);
+    differences += run("ticker", 3);
+
+    printf("%lu short pulses, %lu conflicts\n", panel.getShortPulseCount(), panel.getConflictCount());
+
+    bool isValid = differences == 0 && panel.getShortPulseCount() == 0 && panel.getConflictCount() == 0;
+    return isValid ? 0 : 1;
+}
@@ -0,0 +1,562 @@
+/*
+  TimingCheck
+  Check a VCD waveform of FP2800a lines against the timing of the datasheet (see FlipTheDot_FP2800a.h) and
+  report the idle gaps between the pulses. Every scope with a wire "enable" is a FP2800a, its wires "data"
+  and "address" (any width) are its inputs, like FlipTheDot_VcdWriter and "TraceDecoder --vcd" write them.
+
+  Rules:
+    change while enabled   address or data changes while enable is HIGH (always a violation)
+    setup                  enable rises less than --setup µs after the last address or data change
+                           (default 50 µs, the maximum output select time of the datasheet)
+    turn-off               address or data changes less than --off µs after enable fell, while the output
+                           may still be on (default 150 µs, the maximum turn-off time of the datasheet)
+  The datasheet gives maximum times, a real IC is usually much faster: measure it and pass the values.
+  Changes at the same time get ordered like: enable falls, address and data change, enable rises.
+
+  Usage: TimingCheck [--setup us] [--off us] [--list count] file.vcd
+  Exit code 1 if any rule is violated, 2 if the file cannot be read.
+
+  Build:
+    g++ -std=c++11 Code/Host/Tools/TimingCheck/TimingCheck.cpp
+ */
+
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+
+enum Rule { CHANGE_WHILE_ENABLED = 0, SETUP = 1, TURN_OFF = 2, RULES = 3 };
+const char *ruleNames[RULES] = { "change while enabled", "setup", "turn-off" };
+
+enum Kind { ENABLE = 0, DATA = 1, ADDRESS = 2 };
+
+
+struct Statistics
+{
+    unsigned long count = 0;
+    double minimum = 0;
+    double maximum = 0;
+    double total = 0;
+
+    void add(double value)
+    {
+        minimum = count == 0 || value < minimum ? value : minimum;
+        maximum = count == 0 || value > maximum ? value : maximum;
+        total += value;
+        count++;
+    }
+
+    void print(const char *unit)
+    {
+        if ( count == 0 )
+        {
+            printf("%26s", "-");
+            return;
+        }
+        printf("%8.1f %8.1f %8.1f %s", minimum, total / count, maximum, unit);
+    }
+};
+
+
+struct Chip
+{
+    std::string name;
+    bool isEnabled = false;
+    std::string data = "x";
+    std::string address = "x";
+
+    // an input changed since the last rise of enable
+    bool isChanged = false;
+    double changed = 0;
+    bool hasFallen = false;
+    double fallen = 0;
+    double risen = 0;
+
+    Statistics width;
+    Statistics setup;
+    unsigned long violations[RULES] = {};
+};
+
+
+struct Wire
+{
+    unsigned int chip;
+    Kind kind;
+};
+
+
+struct Change
+{
+    Wire wire;
+    std::string value;
+};
+
+
+struct Violation
+{
+    double time;
+    unsigned int chip;
+    Rule rule;
+    double value;
+};
+
+
+std::vector<Chip> chips;
+std::map<std::string, Wire> wires;
+std::vector<Violation> violations;
+
+double setupMicros = 50;
+double offMicros = 150;
+
+// all ICs together: the time between the last enable fall and the next rise
+unsigned int enabledCount = 0;
+bool hasIdleStart = false;
+double idleStart = 0;
+double busyStart = 0;
+double busyMicros = 0;
+Statistics gaps;
+std::vector<std::pair<double, double> > largestGaps;
+
+
+void violate(double time, unsigned int chip, Rule rule, double value)
+{
+    Violation violation = { time, chip, rule, value };
+    violations.push_back(violation);
+    chips[chip].violations[rule]++;
+}
+
+
+void applyInput(double time, const Change &change)
+{
+    Chip &chip = chips[change.wire.chip];
+    std::string &current = change.wire.kind == DATA ? chip.data : chip.address;
+
+    if ( change.value == current || change.value.find_first_of("xXzZ") != std::string::npos )
+    {
+        current = change.value;
+        return;
+    }
+    current = change.value;
+
+    if ( chip.isEnabled )
+    {
+        violate(time, change.wire.chip, CHANGE_WHILE_ENABLED, 0);
+    }
+    else if ( chip.hasFallen && time - chip.fallen < offMicros )
+    {
+        violate(time, change.wire.chip, TURN_OFF, time - chip.fallen);
+    }
+    chip.isChanged = true;
+    chip.changed = time;
+}
+
+
+void applyEnable(double time, const Change &change)
+{
+    Chip &chip = chips[change.wire.chip];
+    bool isHigh = change.value == "1";
+
+    if ( isHigh == chip.isEnabled )
+    {
+        return;
+    }
+    chip.isEnabled = isHigh;
+
+    if ( isHigh )
+    {
+        if ( chip.isChanged )
+        {
+            chip.setup.add(time - chip.changed);
+            if ( time - chip.changed < setupMicros )
+            {
+                violate(time, change.wire.chip, SETUP, time - chip.changed);
+            }
+            chip.isChanged = false;
+        }
+        chip.risen = time;
+
+        if ( enabledCount++ == 0 )
+        {
+            busyStart = time;
+            if ( hasIdleStart )
+            {
+                gaps.add(time - idleStart);
+                largestGaps.push_back(std::make_pair(time - idleStart, idleStart));
+            }
+        }
+    }
+    else
+    {
+        chip.width.add(time - chip.risen);
+        chip.hasFallen = true;
+        chip.fallen = time;
+
+        if ( enabledCount > 0 && --enabledCount == 0 )
+        {
+            busyMicros += time - busyStart;
+            hasIdleStart = true;
+            idleStart = time;
+        }
+    }
+}
+
+
+/**
+ * apply the changes of one point in time: enable falls, address and data changes, enable rises
+ */
+void applyChanges(double time, std::vector<Change> &changes)
+{
+    for ( uint8_t step = 0; step < 3; step++ )
+    {
+        for ( unsigned int i = 0; i < changes.size(); i++ )
+        {
+            const Change &change = changes[i];
+            if ( change.wire.kind != ENABLE && step == 1 )
+            {
+                applyInput(time, change);
+            }
+            else if ( change.wire.kind == ENABLE && change.value != "1" && step == 0 )
+            {
+                applyEnable(time, change);
+            }
+            else if ( change.wire.kind == ENABLE && change.value == "1" && step == 2 )
+            {
+                applyEnable(time, change);
+            }
+        }
+    }
+    changes.clear();
+}
+
+
+/**
+ * read the next white space separated token, false at the end of the file
+ */
+bool readToken(FILE *file, std::string &token)
+{
+    int value;
+    token.clear();
+
+    while ( (value = fgetc(file)) != EOF && isspace(value) )
+    {
+    }
+    while ( value != EOF && !isspace(value) )
+    {
+        token += (char)value;
+        value = fgetc(file);
+    }
+    return !token.empty();
+}
+
+
+/**
+ * skip the tokens up to $end, returns them without $end
+ */
+std::vector<std::string> readSection(FILE *file)
+{
+    std::vector<std::string> tokens;
+    std::string token;
+
+    while ( readToken(file, token) && token != "$end" )
+    {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+
+/**
+ * µs per step of the file, 0 for an unknown unit
+ */
+double parseTimescale(const std::vector<std::string> &tokens)
+{
+    std::string text;
+    for ( unsigned int i = 0; i < tokens.size(); i++ )
+    {
+        text += tokens[i];
+    }
+
+    const char *units[] = { "fs", "ps", "ns", "us", "ms", "s" };
+    const double factors[] = { 1e-9, 1e-6, 1e-3, 1, 1e3, 1e6 };
+    char *rest;
+    double number = strtod(text.c_str(), &rest);
+
+    for ( uint8_t i = 0; i < 6; i++ )
+    {
+        if ( strcmp(rest, units[i]) == 0 )
+        {
+            return number * factors[i];
+        }
+    }
+    return 0;
+}
+
+
+/**
+ * read the definitions and apply the changes, first and end get the time of the first change and the end
+ */
+bool readFile(FILE *file, double &scale, double &first, double &end)
+{
+    std::string token;
+    std::vector<std::string> scopes;
+    std::vector<Change> changes;
+    bool isDefinition = true;
+    bool isInitial = false;
+    double time = 0;
+    bool hasChange = false;
+    scale = 1e-3;
+    first = 0;
+    end = 0;
+
+    while ( readToken(file, token) )
+    {
+        if ( isDefinition )
+        {
+            if ( token == "$timescale" )
+            {
+                scale = parseTimescale(readSection(file));
+                if ( scale == 0 )
+                {
+                    fprintf(stderr, "unknown timescale\n");
+                    return false;
+                }
+            }
+            else if ( token == "$scope" )
+            {
+                std::vector<std::string> tokens = readSection(file);
+                scopes.push_back(tokens.size() > 1 ? tokens[1] : "");
+            }
+            else if ( token == "$upscope" )
+            {
+                readSection(file);
+                if ( !scopes.empty() )
+                {
+                    scopes.pop_back();
+                }
+            }
+            else if ( token == "$var" )
+            {
+                // type, width, identifier, name
+                std::vector<std::string> tokens = readSection(file);
+                if ( tokens.size() < 4 || scopes.empty() )
+                {
+                    continue;
+                }
+
+                std::string name = tokens[3];
+                Kind kind = name == "enable" ? ENABLE : name == "data" ? DATA : ADDRESS;
+                if ( kind == ADDRESS && name != "address" )
+                {
+                    continue;
+                }
+
+                unsigned int index = 0;
+                while ( index < chips.size() && chips[index].name != scopes.back() )
+                {
+                    index++;
+                }
+                if ( index == chips.size() )
+                {
+                    Chip chip;
+                    chip.name = scopes.back();
+                    chips.push_back(chip);
+                }
+
+                Wire wire = { index, kind };
+                wires[tokens[2]] = wire;
+            }
+            else if ( token == "$enddefinitions" )
+            {
+                readSection(file);
+                isDefinition = false;
+            }
+            else if ( token[0] == '$' )
+            {
+                readSection(file);
+            }
+            continue;
+        }
+
+        if ( token[0] == '#' )
+        {
+            double next = strtod(token.c_str() + 1, NULL) * scale;
+            if ( next != time )
+            {
+                applyChanges(time, changes);
+                time = next;
+            }
+            end = time;
+            continue;
+        }
+        if ( token == "$dumpvars" )
+        {
+            isInitial = true;
+            continue;
+        }
+        if ( token == "$end" )
+        {
+            isInitial = false;
+            continue;
+        }
+        if ( token[0] == '$' )
+        {
+            readSection(file);
+            continue;
+        }
+
+        std::string value;
+        std::string identifier;
+        if ( token[0] == 'b' || token[0] == 'B' || token[0] == 'r' || token[0] == 'R' )
+        {
+            value = token.substr(1);
+            if ( !readToken(file, identifier) )
+            {
+                break;
+            }
+        }
+        else
+        {
+            value = token.substr(0, 1);
+            identifier = token.substr(1);
+        }
+
+        std::map<std::string, Wire>::iterator it = wires.find(identifier);
+        if ( it == wires.end() )
+        {
+            continue;
+        }
+
+        Chip &chip = chips[it->second.chip];
+        if ( isInitial )
+        {
+            // initial levels are no changes
+            if ( it->second.kind == ENABLE )
+            {
+                chip.isEnabled = value == "1";
+                enabledCount += chip.isEnabled ? 1 : 0;
+            }
+            else
+            {
+                (it->second.kind == DATA ? chip.data : chip.address) = value;
+            }
+            continue;
+        }
+
+        Change change = { it->second, value };
+        changes.push_back(change);
+        if ( !hasChange )
+        {
+            first = time;
+            hasChange = true;
+        }
+    }
+
+    applyChanges(time, changes);
+    return !isDefinition;
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+    unsigned int listCount = 10;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        if ( strcmp(argv[i], "--setup") == 0 && i + 1 < argc )
+        {
+            setupMicros = atof(argv[++i]);
+        }
+        else if ( strcmp(argv[i], "--off") == 0 && i + 1 < argc )
+        {
+            offMicros = atof(argv[++i]);
+        }
+        else if ( strcmp(argv[i], "--list") == 0 && i + 1 < argc )
+        {
+            listCount = atoi(argv[++i]);
+        }
+        else if ( argv[i][0] != '-' && path == NULL )
+        {
+            path = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--setup us] [--off us] [--list count] file.vcd\n", argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *file = path != NULL ? fopen(path, "r") : NULL;
+    if ( file == NULL )
+    {
+        fprintf(stderr, "usage: %s [--setup us] [--off us] [--list count] file.vcd\n", argv[0]);
+        return 2;
+    }
+
+    double scale;
+    double first;
+    double end;
+    bool isRead = readFile(file, scale, first, end);
+    fclose(file);
+    if ( !isRead || chips.empty() )
+    {
+        fprintf(stderr, "%s: no FP2800a found (scope with a wire \"enable\")\n", path);
+        return 2;
+    }
+
+    double span = end - first;
+    printf("%s: %u ICs, %.1f ms from the first change, rules: setup >= %.0f us, turn-off >= %.0f us\n", path,
+        (unsigned int)chips.size(), span / 1000, setupMicros, offMicros);
+    printf("%-12s %7s %30s %30s %10s %8s %8s\n", "IC", "pulses", "width min/avg/max", "setup min/avg/max",
+        "on-change", "setup", "turn-off");
+    for ( unsigned int i = 0; i < chips.size(); i++ )
+    {
+        Chip &chip = chips[i];
+        printf("%-12s %7lu ", chip.name.c_str(), chip.width.count);
+        chip.width.print("us");
+        printf(" ");
+        chip.setup.print("us");
+        printf(" %10lu %8lu %8lu\n", chip.violations[CHANGE_WHILE_ENABLED], chip.violations[SETUP], chip.violations[TURN_OFF]);
+    }
+
+    printf("enabled      %.1f ms of %.1f ms (%.1f %%)\n", busyMicros / 1000, span / 1000, span > 0 ? busyMicros * 100 / span : 0);
+    if ( gaps.count > 0 )
+    {
+        printf("idle gaps    %lu, min %.1f us, avg %.1f us, max %.1f us, %.1f ms in total\n", gaps.count, gaps.minimum,
+            gaps.total / gaps.count, gaps.maximum, gaps.total / 1000);
+
+        std::sort(largestGaps.begin(), largestGaps.end());
+        printf("largest      ");
+        for ( unsigned int i = 0; i < 3 && i < largestGaps.size(); i++ )
+        {
+            const std::pair<double, double> &gap = largestGaps[largestGaps.size() - 1 - i];
+            printf("%s%.1f us at %.1f us", i > 0 ? ", " : "", gap.first, gap.second);
+        }
+        printf("\n");
+    }
+
+    printf("violations   %u\n", (unsigned int)violations.size());
+    for ( unsigned int i = 0; i < listCount && i < violations.size(); i++ )
+    {
+        const Violation &violation = violations[i];
+        printf("  %12.1f us  %-12s %s", violation.time, chips[violation.chip].name.c_str(), ruleNames[violation.rule]);
+        if ( violation.rule != CHANGE_WHILE_ENABLED )
+        {
+            printf(" after %.1f us", violation.value);
+        }
+        printf("\n");
+    }
+    if ( violations.size() > listCount )
+    {
+        printf("  ... %u more\n", (unsigned int)(violations.size() - listCount));
+    }
+
+    return violations.empty() ? 0 : 1;
+}
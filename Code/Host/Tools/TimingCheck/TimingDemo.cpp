@@ -0,0 +1,84 @@
+/*
+  TimingDemo
+  Flush two frames on the simulated 28x13 panel (wiring of the example "FixedDefault"), record the FP2800a lines
+  as VCD waveform with FlipTheDot_VcdWriter and, built with FlipTheDot_FP2800a_TRACE, dump the trace buffer
+  with the latest events in binary to stdout. See timing.sh to check both with TimingCheck.
+
+  Usage: TimingDemo file.vcd
+
+  Build:
+    g++ -std=c++11 -DFlipTheDot_FP2800a_TRACE -DFlipTheDot_FP2800a_TRACE_SIZE=256 -I Code/Host/Arduino -I Code/Host/Simulator \
+        -I Code/Arduino/libraries/FlipTheDot_FP2800a -I Code/Arduino/libraries/FlipTheDot_ColumnRowController \
+        Code/Host/Tools/TimingCheck/TimingDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_VcdWriter.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+uint8_t frame[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+uint8_t shadow[FlipTheDot_ColumnRowController_BUFFER_SIZE(columns, rows)];
+
+
+int main(int argc, char **argv)
+{
+    FILE *file = argc > 1 ? fopen(argv[1], "w") : NULL;
+    if ( file == NULL )
+    {
+        fprintf(stderr, "usage: %s file.vcd\n", argv[0]);
+        return 1;
+    }
+
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    FlipTheDot_VcdWriter vcd(file);
+    vcd.addChip("col", A1, 8, 9, 10, 11, 12, 13);
+    vcd.addChip("rowReset", A0, FlipTheDot_VcdWriter::NO_PIN, 3, 4, 5, 6, 7);
+    vcd.addChip("rowSet", 2, FlipTheDot_VcdWriter::NO_PIN, 3, 4, 5, 6, 7);
+    vcd.begin();
+
+    #ifdef FlipTheDot_FP2800a_TRACE
+    FlipTheDot_FP2800aTrace::clear();
+    #endif
+
+    // every dot, then a text-like frame
+    controller.setFrameBuffer(frame, shadow);
+    controller.fill(true);
+    controller.flush();
+
+    for ( unsigned int row = 1; row <= rows; row++ )
+    {
+        for ( unsigned int col = 1; col <= columns; col++ )
+        {
+            controller.setDot(col, row, (col * 7 + row * 13) % 11 < 4);
+        }
+    }
+    controller.flush();
+
+    vcd.end();
+    fclose(file);
+
+    #ifdef FlipTheDot_FP2800a_TRACE
+    FlipTheDot_FP2800aTrace::dump(Serial);
+    #endif
+
+    fprintf(stderr, "%lu value changes recorded, %lu coil pulses\n", vcd.getChangeCount(), panel.getPulseCount());
+    return panel.getConflictCount() == 0 && panel.getShortPulseCount() == 0 ? 0 : 1;
+}
@@ -0,0 +1,55 @@
+#!/bin/bash
+# Record a flush on the simulated panel as VCD (digitalWrite and FlipTheDot_FP2800a_PORT_IO), convert the trace
+# buffer of the same run into VCD and check all of them with TimingCheck.
+# Every recording has to keep the select and turn-off times of the target ICs, default: the simulated ICs which switch
+# at once (--setup 0 --off 0), so only the order of the lines gets checked. Pass the measured times of real ICs.
+# --datasheet reports the recordings against the worst case of the datasheet (50 / 150 us) in addition, without
+# failing, the drivers do not wait that long.
+# Exit code 1 if a recording breaks the timing or the lines change while enabled.
+# Usage: ./timing.sh [--setup us] [--off us] [--datasheet] [c++ compiler] [directory to keep the VCD files]
+
+cd "$(dirname "$0")"
+
+setup=0
+off=0
+isDatasheet=0
+while [ "${1:0:2}" = "--" ]; do
+	case "$1" in
+		--setup) setup=$2; shift ;;
+		--off) off=$2; shift ;;
+		--datasheet) isDatasheet=1 ;;
+		*) echo "usage: timing.sh [--setup us] [--off us] [--datasheet] [c++ compiler] [directory to keep the VCD files]" >&2; exit 2 ;;
+	esac
+	shift
+done
+
+compiler=${1:-g++}
+libraries=../../../Arduino/libraries
+flags="-std=c++11 -Wall -DFlipTheDot_FP2800a_TRACE -DFlipTheDot_FP2800a_TRACE_SIZE=256 -I../../Arduino -I../../Simulator \
+    -I$libraries/FlipTheDot_FP2800a -I$libraries/FlipTheDot_ColumnRowController"
+build=$(mktemp -d)
+
+$compiler -std=c++11 -Wall TimingCheck.cpp -o "$build/check" || exit 1
+$compiler -std=c++11 -Wall ../TraceDecoder/TraceDecoder.cpp -o "$build/decoder" || exit 1
+$compiler $flags TimingDemo.cpp -o "$build/digitalWrite" || exit 1
+$compiler $flags -DFlipTheDot_FP2800a_PORT_IO TimingDemo.cpp -o "$build/portIO" || exit 1
+
+result=0
+"$build/digitalWrite" "$build/digitalWrite.vcd" > "$build/dump.bin" || result=1
+"$build/portIO" "$build/portIO.vcd" > /dev/null || result=1
+"$build/decoder" --vcd "$build/trace.vcd" --chip col=15,8,9 --chip rowReset=14,,3 --chip rowSet=2,,3 "$build/dump.bin" > /dev/null || result=1
+
+for vcd in digitalWrite portIO trace; do
+	if [ $isDatasheet = 1 ]; then
+		"$build/check" --setup 50 --off 150 --list 3 "$build/$vcd.vcd"
+	fi
+	"$build/check" --setup "$setup" --off "$off" --list 3 "$build/$vcd.vcd" || result=1
+	echo
+done
+
+if [ -n "$2" ]; then
+	cp "$build"/*.vcd "$2"/
+fi
+
+rm -r "$build"
+exit $result
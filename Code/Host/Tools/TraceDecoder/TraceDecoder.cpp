@@ -0,0 +1,343 @@
+/*
+  TraceDecoder
+  Print the binary dumps of FlipTheDot_FP2800aTrace::dump(...) as text, one line per event with the time since
+  the start of the dump, followed by the pulse lengths of every enable pin. Everything between the dumps
+  (like text of the sketch) gets skipped, so the output of a serial port can be passed as it is.
+
+  Usage: TraceDecoder [--vcd out.vcd --chip name=enable[,data[,A0]] ...] [file]
+    reads stdin without a file, e.g. cat /dev/ttyACM0 | TraceDecoder
+
+  --vcd writes the dump as VCD waveform as well (1 µs resolution, the later dumps into out-2.vcd and so on),
+  for GTKWave or Code/Host/Tools/TimingCheck. The events only carry one pin each, --chip tells which pins
+  belong to one FP2800a: the enable pin, the data pin (empty for a hard wired data line) and the pin A0
+  (the same one for ICs which share the address lines).
+  Example for the wiring of "FixedDefault": --chip col=15,8,9 --chip rowReset=14,,3 --chip rowSet=2,,3
+
+  Build:
+    g++ -std=c++11 Code/Host/Tools/TraceDecoder/TraceDecoder.cpp
+ */
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+
+const char *eventNames[] = { "time", "address", "data", "enable", "disable", "reject output", "reject data" };
+
+
+struct PulseStatistics
+{
+    unsigned long count = 0;
+    unsigned long minimum = 0;
+    unsigned long maximum = 0;
+    unsigned long long total = 0;
+    unsigned long rise = 0;
+    bool isHigh = false;
+};
+
+
+// pins of one FP2800a for the VCD output, -1 if not connected
+struct VcdChip
+{
+    std::string name;
+    int pinEnable;
+    int pinData;
+    int pinA0;
+};
+
+std::vector<VcdChip> vcdChips;
+const char *vcdPath = NULL;
+
+
+/**
+ * parse name=enable[,data[,A0]]
+ */
+bool parseChip(const char *text, VcdChip &chip)
+{
+    const char *equals = strchr(text, '=');
+    if ( equals == NULL || equals == text )
+    {
+        return false;
+    }
+
+    chip.name = std::string(text, equals - text);
+    int *pins[3] = { &chip.pinEnable, &chip.pinData, &chip.pinA0 };
+    const char *field = equals + 1;
+
+    for ( uint8_t i = 0; i < 3; i++ )
+    {
+        *pins[i] = *field != '\0' && *field != ',' ? atoi(field) : -1;
+        field = strchr(field, ',');
+        field = field != NULL ? field + 1 : "";
+    }
+    return chip.pinEnable >= 0;
+}
+
+
+/**
+ * open the VCD file of a dump and write the header, all values unknown at the start
+ */
+FILE *openVcd(unsigned int number)
+{
+    std::string path = vcdPath;
+    if ( number > 1 )
+    {
+        size_t dot = path.rfind('.');
+        std::string suffix = "-" + std::to_string(number);
+        path = dot == std::string::npos ? path + suffix : path.substr(0, dot) + suffix + path.substr(dot);
+    }
+
+    FILE *vcd = fopen(path.c_str(), "w");
+    if ( vcd == NULL )
+    {
+        perror(path.c_str());
+        return NULL;
+    }
+
+    fprintf(vcd, "$comment TraceDecoder, dump %u $end\n$timescale 1us $end\n", number);
+    for ( unsigned int i = 0; i < vcdChips.size(); i++ )
+    {
+        fprintf(vcd, "$scope module %s $end\n$var wire 1 e%u enable $end\n", vcdChips[i].name.c_str(), i);
+        if ( vcdChips[i].pinData >= 0 )
+        {
+            fprintf(vcd, "$var wire 1 d%u data $end\n", i);
+        }
+        fprintf(vcd, "$var wire 5 a%u address $end\n$upscope $end\n", i);
+    }
+    fprintf(vcd, "$enddefinitions $end\n#0\n$dumpvars\n");
+    for ( unsigned int i = 0; i < vcdChips.size(); i++ )
+    {
+        fprintf(vcd, "xe%u\n", i);
+        if ( vcdChips[i].pinData >= 0 )
+        {
+            fprintf(vcd, "xd%u\n", i);
+        }
+        fprintf(vcd, "bxxxxx a%u\n", i);
+    }
+    fprintf(vcd, "$end\n");
+    return vcd;
+}
+
+
+/**
+ * write the value changes of an event, the time line only if anything changes
+ */
+void writeVcd(FILE *vcd, unsigned long time, unsigned long &lastTime, uint8_t type, uint8_t pin, uint8_t value)
+{
+    for ( unsigned int i = 0; i < vcdChips.size(); i++ )
+    {
+        const VcdChip &chip = vcdChips[i];
+        char line[32] = "";
+
+        if ( (type == 3 || type == 4) && pin == chip.pinEnable )
+        {
+            snprintf(line, sizeof(line), "%ue%u", type == 3 ? 1 : 0, i);
+        }
+        else if ( type == 2 && pin == chip.pinData )
+        {
+            snprintf(line, sizeof(line), "%ud%u", value ? 1 : 0, i);
+        }
+        else if ( type == 1 && value >= 1 && value <= 28 && pin == chip.pinA0 )
+        {
+            // same lines as FlipTheDot_FP2800a_ADDRESS_TABLE
+            uint8_t lines = (value - 1) / 7 << 3 | ((value - 1) % 7 + 1);
+            snprintf(line, sizeof(line), "b%u%u%u%u%u a%u", lines >> 4 & 1, lines >> 3 & 1, lines >> 2 & 1, lines >> 1 & 1, lines & 1, i);
+        }
+
+        if ( line[0] != '\0' )
+        {
+            if ( time != lastTime )
+            {
+                fprintf(vcd, "#%lu\n", time);
+                lastTime = time;
+            }
+            fprintf(vcd, "%s\n", line);
+        }
+    }
+}
+
+
+bool readBytes(FILE *file, uint8_t *buffer, size_t length)
+{
+    return fread(buffer, 1, length, file) == length;
+}
+
+
+/**
+ * decode one dump after the header "FT", returns false at the end of the input
+ */
+bool decode(FILE *file, unsigned int number)
+{
+    uint8_t header[7];
+    if ( !readBytes(file, header, sizeof(header)) )
+    {
+        return false;
+    }
+    if ( header[0] != 1 )
+    {
+        fprintf(stderr, "dump %u: unknown version %u\n", number, header[0]);
+        return true;
+    }
+
+    unsigned int count = header[1] | header[2] << 8;
+    unsigned long overwritten = header[3] | header[4] << 8 | header[5] << 16 | (unsigned long)header[6] << 24;
+
+    printf("== dump %u: %u events, %lu overwritten\n", number, count, overwritten);
+    printf("%12s %10s %5s  %s\n", "time [us]", "delta", "pin", "event");
+
+    std::map<unsigned int, PulseStatistics> pulses;
+    FILE *vcd = vcdPath != NULL ? openVcd(number) : NULL;
+    unsigned long vcdTime = 0;
+    unsigned long time = 0;
+    unsigned long start = 0;
+    unsigned long previous = 0;
+    bool hasTime = false;
+
+    for ( unsigned int i = 0; i < count; i++ )
+    {
+        uint8_t event[5];
+        if ( !readBytes(file, event, sizeof(event)) )
+        {
+            fprintf(stderr, "dump %u: truncated after %u events\n", number, i);
+            if ( vcd != NULL )
+            {
+                fclose(vcd);
+            }
+            return false;
+        }
+
+        uint16_t low = event[0] | event[1] << 8;
+        uint8_t type = event[2];
+        uint8_t pin = event[3];
+        uint8_t value = event[4];
+
+        if ( type == 0 )
+        {
+            time = (unsigned long)pin << 16 | (unsigned long)value << 24 | low;
+            if ( !hasTime )
+            {
+                start = time;
+                previous = time;
+                hasTime = true;
+            }
+            continue;
+        }
+
+        // the events are less than 65536 µs apart, otherwise a time event is in between
+        time += (uint16_t)(low - (uint16_t)time);
+
+        printf("%12lu %10lu %5u  %s", time - start, time - previous, pin, type < 7 ? eventNames[type] : "unknown");
+        if ( type == 1 || type == 5 )
+        {
+            printf(" %u", value);
+        }
+        else if ( type == 2 || type == 6 )
+        {
+            printf(" %s", value ? "HIGH" : "LOW");
+        }
+        printf("\n");
+        previous = time;
+
+        if ( vcd != NULL )
+        {
+            writeVcd(vcd, time - start, vcdTime, type, pin, value);
+        }
+
+        PulseStatistics &pulse = pulses[pin];
+        if ( type == 3 )
+        {
+            pulse.rise = time;
+            pulse.isHigh = true;
+        }
+        else if ( type == 4 && pulse.isHigh )
+        {
+            unsigned long length = time - pulse.rise;
+            pulse.minimum = pulse.count == 0 || length < pulse.minimum ? length : pulse.minimum;
+            pulse.maximum = length > pulse.maximum ? length : pulse.maximum;
+            pulse.total += length;
+            pulse.count++;
+            pulse.isHigh = false;
+        }
+    }
+
+    if ( vcd != NULL )
+    {
+        fprintf(vcd, "#%lu\n", time - start + 1);
+        fclose(vcd);
+    }
+
+    for ( std::map<unsigned int, PulseStatistics>::iterator it = pulses.begin(); it != pulses.end(); ++it )
+    {
+        if ( it->second.count > 0 )
+        {
+            printf("enable pin %u: %lu pulses, length min %lu us, avg %.1f us, max %lu us\n", it->first, it->second.count,
+                it->second.minimum, (double)it->second.total / it->second.count, it->second.maximum);
+        }
+    }
+    return true;
+}
+
+
+int main(int argc, char **argv)
+{
+    const char *path = NULL;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        VcdChip chip;
+        if ( strcmp(argv[i], "--vcd") == 0 && i + 1 < argc )
+        {
+            vcdPath = argv[++i];
+        }
+        else if ( strcmp(argv[i], "--chip") == 0 && i + 1 < argc && parseChip(argv[i + 1], chip) )
+        {
+            vcdChips.push_back(chip);
+            i++;
+        }
+        else if ( argv[i][0] != '-' && path == NULL )
+        {
+            path = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "usage: %s [--vcd out.vcd --chip name=enable[,data[,A0]] ...] [file]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    FILE *file = path != NULL ? fopen(path, "rb") : stdin;
+    if ( file == NULL )
+    {
+        perror(path);
+        return 1;
+    }
+
+    unsigned int dumps = 0;
+    int last = EOF;
+    int value;
+
+    while ( (value = fgetc(file)) != EOF )
+    {
+        if ( last == 'F' && value == 'T' )
+        {
+            if ( !decode(file, ++dumps) )
+            {
+                break;
+            }
+            value = EOF;
+        }
+        last = value;
+    }
+
+    if ( dumps == 0 )
+    {
+        fprintf(stderr, "no trace dump found\n");
+        return 1;
+    }
+    return 0;
+}
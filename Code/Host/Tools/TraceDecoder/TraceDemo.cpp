@@ -0,0 +1,57 @@
+/*
+  TraceDemo
+  Record the pin activity of a few flips on the simulated 28x13 panel (wiring of the example "FixedDefault")
+  with FlipTheDot_FP2800a_TRACE and dump it in binary to stdout, like a sketch would dump it to Serial.
+  The dump contains a rejected setOutput(...) as well. See trace.sh to decode it.
+
+  Build:
+    g++ -std=c++11 -DFlipTheDot_FP2800a_TRACE -I Code/Host/Arduino -I Code/Host/Simulator -I Code/Arduino/libraries/FlipTheDot_FP2800a \
+        -I Code/Arduino/libraries/FlipTheDot_ColumnRowController Code/Host/Tools/TraceDecoder/TraceDemo.cpp
+ */
+
+
+#include "Arduino.h"
+#include "FlipTheDot_PanelSimulator.h"
+#include "FlipTheDot_FP2800a.h"
+#include "FlipTheDot_FP2800aFixed.h"
+#include "FlipTheDot_ColumnRowController.h"
+
+
+const unsigned int columns = 28;
+const unsigned int rows = 13;
+
+// the panel has to exist before the controllers initialize their pins
+FlipTheDot_PanelSimulator panel(columns, rows);
+
+FlipTheDot_FP2800aFixed rowController(A0, 2, 3, 4, 5, 6, 7);
+FlipTheDot_FP2800a columnController(A1, 8, 9, 10, 11, 12, 13);
+FlipTheDot_ColumnRowController controller(columnController, rowController, columns, rows);
+
+
+int main()
+{
+    panel.addChip(FlipTheDot_PanelSimulator::COLUMNS, 0, A1, 8, 9, 10, 11, 12, 13);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, A0, FlipTheDot_PanelSimulator::FIXED_LOW, 3, 4, 5, 6, 7);
+    panel.addChip(FlipTheDot_PanelSimulator::ROWS, 0, 2, FlipTheDot_PanelSimulator::FIXED_HIGH, 3, 4, 5, 6, 7);
+
+    // only the flips below
+    FlipTheDot_FP2800aTrace::clear();
+
+    controller.show(1, 1);
+    controller.show(2, 1);
+    controller.hide(1, 1);
+
+    // the output cannot change while the IC is enabled
+    columnController.enable();
+    columnController.setOutput(5);
+    columnController.disable();
+
+    delay(100);
+    controller.show(28, 13);
+
+    // some text of the sketch before the dump, the decoder skips it
+    Serial.print("dump follows\n");
+    FlipTheDot_FP2800aTrace::dump(Serial);
+
+    return panel.getDot(2, 1) && panel.getDot(28, 13) && !panel.getDot(1, 1) ? 0 : 1;
+}
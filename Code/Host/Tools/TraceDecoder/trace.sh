@@ -0,0 +1,20 @@
+#!/bin/bash
+# Build TraceDemo with FlipTheDot_FP2800a_TRACE and decode its dump with TraceDecoder.
+# Usage: ./trace.sh [c++ compiler]
+
+cd "$(dirname "$0")"
+
+compiler=${1:-g++}
+libraries=../../../Arduino/libraries
+build=$(mktemp -d)
+
+$compiler -std=c++11 -Wall TraceDecoder.cpp -o "$build/decoder" || exit 1
+$compiler -std=c++11 -Wall -DFlipTheDot_FP2800a_TRACE -I../../Arduino -I../../Simulator -I$libraries/FlipTheDot_FP2800a \
+    -I$libraries/FlipTheDot_ColumnRowController TraceDemo.cpp -o "$build/demo" || exit 1
+
+"$build/demo" > "$build/dump.bin"
+result=$?
+"$build/decoder" "$build/dump.bin" || result=1
+
+rm -r "$build"
+exit $result